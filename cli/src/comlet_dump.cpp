@@ -404,77 +404,101 @@ std::unique_ptr<nlohmann::json> ComletDump::run() {
                     return convertResult;
                 }
             }
-            auto tempdeviceJsons = this->coreStub->getStatistics(targetId);
-            deviceJsons[deviceId] = combineTileAndDeviceLevel(*tempdeviceJsons);
+            auto& data = deviceDatas[deviceId];
+            data.stats = this->coreStub->getStatisticsData(targetId);
+            combineTileAndDeviceLevel(data);
         }
     }
     return json;
 }
 
-std::unique_ptr<nlohmann::json> ComletDump::combineTileAndDeviceLevel(nlohmann::json rawJson){
-    auto json = std::unique_ptr<nlohmann::json>(new nlohmann::json());
-    *json = rawJson;
-    if (!json->contains("tile_level"))
-        return json;
-    if (!json->contains("device_level"))
-        rawJson["device_level"] = {};
-    std::vector<nlohmann::json> deviceLevelStatsDataList = rawJson["device_level"];
-    std::vector<nlohmann::json> tileLevelStatsDataList = rawJson["tile_level"];
-    std::set<std::string> deviceMetrics;
-    for (auto deviceLevelStatsData: deviceLevelStatsDataList) 
-        deviceMetrics.insert(deviceLevelStatsData["metrics_type"].get<std::string>());
-    std::set<std::string> tileMetrics;
-    for (auto tileLevelStatsData: tileLevelStatsDataList) {
-        nlohmann::json StatsData = tileLevelStatsData["data_list"];
-        for (auto data: StatsData) 
-            tileMetrics.insert(data["metrics_type"].get<std::string>());
+static DumpValue toDumpValue(const MetricStatsData& metric) {
+    DumpValue dv;
+    uint64_t value;
+    if (metric.hasStats) {
+        value = metric.isCounter ? metric.value : metric.avg;
+        dv.current = metric.value;
+    } else {
+        value = metric.isCounter ? metric.accumulated : metric.value;
+        dv.current = value;
     }
-    std::set<std::string> metricsList;
-    std::set_difference( tileMetrics.begin(), tileMetrics.end(), deviceMetrics.begin(), deviceMetrics.end(), std::inserter(metricsList, metricsList.begin()));
-    nlohmann::json tmpJson;
-    for (auto metric: metricsList){
-        int c = 0; // count of current tiles which contain the certain metric
-        for (auto tileLevelStatsData: tileLevelStatsDataList) {
-            nlohmann::json StatsData = tileLevelStatsData["data_list"];
-            for (std::size_t i = 0; i < StatsData.size(); i++) {
-                if(metric == StatsData[i]["metrics_type"]){
-                    std::string met = "value";
-                    if (StatsData[i].contains("avg"))
-                        met = "avg";
-                    if ( c == 0 ) {
-                        tmpJson[metric]["metrics_type"] = StatsData[i]["metrics_type"];
-                        tmpJson[metric][met] = StatsData[i][met];
-                    }
-                    else{
-                        if (sumMetricsList.find(metric) != sumMetricsList.end()){
-                            if(StatsData[i][met].is_number_float())
-                                tmpJson[metric][met] = tmpJson[metric][met].get<double>() + StatsData[i][met].get<double>();
-                            else
-                                tmpJson[metric][met] = tmpJson[metric][met].get<uint64_t>() + StatsData[i][met].get<uint64_t>();
-                        }
-                        else{
-                            auto doubleNumber = (tmpJson[metric][met].get<double>() * c + StatsData[i][met].get<double>())/ (double)( c + 1 );
-                            tmpJson[metric][met] = round(doubleNumber * 100) /100;
-                        }
-                    }
-                    c += 1;
+    if (metric.scale == 1) {
+        dv.value = value;
+    } else {
+        dv.value = (double)value / metric.scale;
+        dv.isFloat = true;
+    }
+    return dv;
+}
+
+static DumpMetrics toDumpMetrics(const std::vector<MetricStatsData>& metrics) {
+    DumpMetrics dumpMetrics;
+    for (auto& metric : metrics) {
+        dumpMetrics[metric.metricsType] = toDumpValue(metric);
+    }
+    return dumpMetrics;
+}
+
+void ComletDump::combineTileAndDeviceLevel(DumpDeviceData& data) {
+    data.metrics = toDumpMetrics(data.stats->metrics);
+    data.tileMetrics.clear();
+    for (auto& tile : data.stats->tiles) {
+        data.tileMetrics[tile.tileId] = toDumpMetrics(tile.metrics);
+    }
+
+    // metrics only reported per tile are summed or averaged into the device level
+    DumpMetrics combined;
+    std::map<xpum_stats_type_t, int> counts; // count of current tiles which contain the certain metric
+    for (auto& tile : data.stats->tiles) {
+        for (auto& item : data.tileMetrics[tile.tileId]) {
+            if (data.metrics.find(item.first) != data.metrics.end())
+                continue;
+            int& c = counts[item.first];
+            if (c == 0) {
+                combined[item.first] = item.second;
+            } else {
+                auto& dv = combined[item.first];
+                if (sumMetricsList.find(CoreStub::metricsTypeToString(item.first)) != sumMetricsList.end()) {
+                    dv.value += item.second.value;
+                    dv.isFloat = dv.isFloat || item.second.isFloat;
+                } else {
+                    dv.value = round((dv.value * c + item.second.value) / (double)(c + 1) * 100) / 100;
+                    dv.isFloat = true;
                 }
             }
+            c += 1;
         }
     }
-    for (auto& item : tmpJson.items())
-        (*json)["device_level"].push_back(item.value());
-    //engine metrics
-    if (!json->contains("engine_util")) {
-        (*json)["engine_util"]={};
-        for (auto tileLevelStatsData: tileLevelStatsDataList) {
-            int t = tileLevelStatsData["tile_id"].get<int>();
-            if (tileLevelStatsData.contains("engine_util")){
-                (*json)["engine_util"]["tile_id_"+std::to_string(t)] = tileLevelStatsData["engine_util"];
+    data.metrics.insert(combined.begin(), combined.end());
+}
+
+const EngineStatsData* ComletDump::findEngine(int tileIdx, xpum_engine_type_t engineType, int engineIdx) const {
+    const std::vector<EngineStatsData>* engines = nullptr;
+    if (curTile != nullptr) {
+        engines = &curTile->engines;
+    } else if (curDevice != nullptr) {
+        auto& stats = *curDevice->stats;
+        if (tileIdx == -1) {
+            engines = &stats.engines;
+        } else if (stats.engines.empty()) {
+            // per tile engines are only shown when the device level is not reported
+            for (auto& tile : stats.tiles) {
+                if (tile.tileId == tileIdx) {
+                    engines = &tile.engines;
+                    break;
+                }
             }
         }
     }
-    return json;
+    if (engines == nullptr) {
+        return nullptr;
+    }
+    for (auto& engine : *engines) {
+        if (engine.engineType == engineType && engine.engineId == engineIdx) {
+            return &engine;
+        }
+    }
+    return nullptr;
 }
 
 void ComletDump::getJsonResult(std::ostream &out, bool raw) {
@@ -597,6 +621,25 @@ std::string getJsonValue(nlohmann::json obj, int scale) {
     }
 }
 
+std::string getDumpValue(double value, bool isFloat, int scale) {
+    if (isFloat || scale != 1) {
+        return keepTwoDecimalPrecision(value / scale);
+    }
+    return std::to_string((int64_t)value);
+}
+
+std::string getDumpValue(const StatsData& data, int scale) {
+#ifndef DAEMONLESS
+    uint64_t value = data.hasStats ? data.avg : data.value;
+#else
+    uint64_t value = data.value;
+#endif
+    if (data.scale == 1) {
+        return getDumpValue(value, false, scale);
+    }
+    return getDumpValue((double)value / data.scale, true, scale);
+}
+
 std::unique_ptr<nlohmann::json> ComletDump::getMetricsFromSysfs() {
     auto json = std::unique_ptr<nlohmann::json>(new nlohmann::json());
     std::vector<std::string> bdfs;
@@ -966,17 +1009,10 @@ void ComletDump::printByLine(std::ostream &out) {
             DumpColumn dc{
                 std::string(config.name),
                 [config, this]() {
-                    std::string metricKey = config.key;
-                    if (statsJson != nullptr) {
-                        for (auto metricObj : (*statsJson)) {
-                            if (metricObj["metrics_type"].get<std::string>().compare(metricKey) == 0) {
-                                if (metricObj.contains("avg")) {
-                                    return getJsonValue(metricObj["avg"], config.scale);
-                                } else {
-                                    // counter type
-                                    return getJsonValue(metricObj["value"], config.scale);
-                                }
-                            }
+                    if (curMetrics != nullptr) {
+                        auto it = curMetrics->find(config.metricsType);
+                        if (it != curMetrics->end()) {
+                            return getDumpValue(it->second.value, it->second.isFloat, config.scale);
                         }
                     }
                     return std::string();
@@ -1029,21 +1065,9 @@ void ComletDump::printByLine(std::ostream &out) {
                         DumpColumn dc{
                             header,
                             [config, tileIdx, engineIdx, this]() {
-                                if (engineUtilJson != nullptr) {
-                                    nlohmann::json engineUtilByType;
-                                    if (tileIdx == -1)
-                                        engineUtilByType = (*engineUtilJson)[config.key];
-                                    else
-                                        engineUtilByType = (*engineUtilJson)["tile_id_"+std::to_string(tileIdx)][config.key];
-                                    for (auto u : engineUtilByType) {
-                                        if (u["engine_id"].get<int>() == engineIdx) {
-                                            #ifndef DAEMONLESS
-                                            return getJsonValue(u["avg"], config.scale);
-                                            #else
-                                            return getJsonValue(u["value"], config.scale);
-                                            #endif
-                                        }
-                                    }
+                                auto engine = findEngine(tileIdx, config.engineType, engineIdx);
+                                if (engine != nullptr) {
+                                    return getDumpValue(*engine, config.scale);
                                 }
                                 return std::string();
                             }};
@@ -1090,21 +1114,27 @@ void ComletDump::printByLine(std::ostream &out) {
                     std::stringstream ss;
                     std::string key;
                     std::string header;
+                    uint32_t tileId = obj["tile_id"].get<uint32_t>();
+                    uint32_t remoteDeviceId = obj["remote_device_id"].get<uint32_t>();
+                    uint32_t remoteTileId = obj["remote_tile_id"].get<uint32_t>();
                     // tx
                     ss << deviceId << "/" << obj["tile_id"];
                     ss << "->" << obj["remote_device_id"] << "/" << obj["remote_tile_id"];
                     key = ss.str();
                     header = "XL " + key + " (kB/s)";
                     columnSchemaList.push_back({header,
-                                                [config, key, this]() {
-                                                    if (fabricThroughputJson != nullptr) {
-                                                        for (auto tp : (*fabricThroughputJson)) {
-                                                            if (key.compare(tp["name"].get<std::string>())==0) {
+                                                [config, tileId, remoteDeviceId, remoteTileId, this]() {
+                                                    if (curDevice != nullptr) {
+                                                        for (auto& fabric : curDevice->stats->fabrics) {
+                                                            if (fabric.type == XPUM_FABRIC_THROUGHPUT_TYPE_TRANSMITTED && fabric.tileId == tileId
+                                                                && fabric.remoteDeviceId == remoteDeviceId && fabric.remoteTileId == remoteTileId) {
                                                                 #ifndef DAEMONLESS
-                                                                return getJsonValue(tp["avg"], config.scale);
+                                                                uint64_t value = fabric.hasStats ? fabric.avg : fabric.value;
                                                                 #else
-                                                                return getJsonValue(tp["value"], config.scale);     
+                                                                uint64_t value = fabric.value;
                                                                 #endif
+                                                                double throughput = round((double)value / (fabric.scale * 1000) * 100) / 100;
+                                                                return getDumpValue(throughput, true, config.scale);
                                                             }
                                                         }
                                                     }
@@ -1118,15 +1148,18 @@ void ComletDump::printByLine(std::ostream &out) {
                     key = ss.str();
                     header = "XL " + key + " (kB/s)";
                     columnSchemaList.push_back({header,
-                                                [config, key, this]() {
-                                                    if (fabricThroughputJson != nullptr) {
-                                                        for (auto tp : (*fabricThroughputJson)) {
-                                                            if (!key.compare(tp["name"].get<std::string>())) {
+                                                [config, tileId, remoteDeviceId, remoteTileId, this]() {
+                                                    if (curDevice != nullptr) {
+                                                        for (auto& fabric : curDevice->stats->fabrics) {
+                                                            if (fabric.type == XPUM_FABRIC_THROUGHPUT_TYPE_RECEIVED && fabric.tileId == tileId
+                                                                && fabric.remoteDeviceId == remoteDeviceId && fabric.remoteTileId == remoteTileId) {
                                                                 #ifndef DAEMONLESS
-                                                                return getJsonValue(tp["avg"], config.scale);
+                                                                uint64_t value = fabric.hasStats ? fabric.avg : fabric.value;
                                                                 #else
-                                                                return getJsonValue(tp["value"], config.scale);
+                                                                uint64_t value = fabric.value;
                                                                 #endif
+                                                                double throughput = round((double)value / (fabric.scale * 1000) * 100) / 100;
+                                                                return getDumpValue(throughput, true, config.scale);
                                                             }
                                                         }
                                                     }
@@ -1145,38 +1178,36 @@ void ComletDump::printByLine(std::ostream &out) {
             DumpColumn dc{
                 std::string(config.name),
                 [config, this]() {
-                    std::string metricKey = config.key;
-                    if (statsJson != nullptr) {
-                        for (auto metricObj : (*statsJson)) {
-                            if (metricObj["metrics_type"].get<std::string>().compare(metricKey) == 0) {
-                                const uint64_t flags = metricObj["value"].get<uint64_t>();
-                                std::string ss;
-                                if (flags & xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_AVE_PWR_CAP) {
-                                    ss += "Average Power Excursion | ";
-                                }
-                                if (flags & xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_BURST_PWR_CAP) {
-                                    ss += "Burst Power Excursion | ";
-                                }
-                                if (flags & xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_CURRENT_LIMIT) {
-                                    ss += "Current Excursion | ";
-                                }
-                                if (flags & xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_THERMAL_LIMIT) {
-                                    ss += "Thermal Excursion | ";
-                                }
-                                if (flags & xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_PSU_ALERT) {
-                                    ss += "Power Supply Assertion | ";
-                                }
-                                if (flags & xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_SW_RANGE) {
-                                    ss += "Software Supplied Frequency Range | ";
-                                }
-                                if (flags & xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_HW_RANGE) {
-                                    ss += "Sub Block that has a Lower Frequency | ";
-                                }
-                                if (flags == 0) {
-                                    ss = "Not Throttled | ";
-                                }
-                                return ss.substr(0, ss.size() - 3);
+                    if (curMetrics != nullptr) {
+                        auto it = curMetrics->find(config.metricsType);
+                        if (it != curMetrics->end()) {
+                            const uint64_t flags = it->second.current;
+                            std::string ss;
+                            if (flags & xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_AVE_PWR_CAP) {
+                                ss += "Average Power Excursion | ";
+                            }
+                            if (flags & xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_BURST_PWR_CAP) {
+                                ss += "Burst Power Excursion | ";
+                            }
+                            if (flags & xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_CURRENT_LIMIT) {
+                                ss += "Current Excursion | ";
                             }
+                            if (flags & xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_THERMAL_LIMIT) {
+                                ss += "Thermal Excursion | ";
+                            }
+                            if (flags & xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_PSU_ALERT) {
+                                ss += "Power Supply Assertion | ";
+                            }
+                            if (flags & xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_SW_RANGE) {
+                                ss += "Software Supplied Frequency Range | ";
+                            }
+                            if (flags & xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_HW_RANGE) {
+                                ss += "Sub Block that has a Lower Frequency | ";
+                            }
+                            if (flags == 0) {
+                                ss = "Not Throttled | ";
+                            }
+                            return ss.substr(0, ss.size() - 3);
                         }
                     }
                     return std::string();
@@ -1229,30 +1260,25 @@ void ComletDump::printByLine(std::ostream &out) {
         }
         for (auto deviceId : this->opts->deviceIds) {
             curDeviceId = deviceId;
-            statsJson = nullptr;
-            engineUtilJson = nullptr;
-            fabricThroughputJson = std::make_shared<nlohmann::json>((*deviceJsons[deviceId])["fabric_throughput"]);
+            curDevice = &deviceDatas[deviceId];
+            curMetrics = nullptr;
+            curTile = nullptr;
+            if (curDevice->stats == nullptr || !curDevice->stats->error.empty()) {
+                curDevice = nullptr;
+            }
 
             for(auto tile : this->opts->deviceTileIds){
                 curTileId = tile;
-                if (this->opts->deviceTileIds.size() == 1 && this->opts->deviceTileIds[0] == "-1") {
-                    if (deviceJsons[deviceId]->contains("device_level")) {
-                        statsJson = std::make_shared<nlohmann::json>((*deviceJsons[deviceId])["device_level"]);
-                    }
-                    if (deviceJsons[deviceId]->contains("engine_util")) {
-                        engineUtilJson = std::make_shared<nlohmann::json>((*deviceJsons[deviceId])["engine_util"]);
-                    }
+                if (curDevice == nullptr) {
+                    // no data for this device, print N/A
+                } else if (this->opts->deviceTileIds.size() == 1 && this->opts->deviceTileIds[0] == "-1") {
+                    curMetrics = &curDevice->metrics;
                 } else {
-                    if (deviceJsons[deviceId]->contains("tile_level")) {
-                        auto tiles = (*deviceJsons[deviceId])["tile_level"].get<std::vector<nlohmann::json>>();
-                        for (auto tile : tiles) {
-                            if (tile.contains("tile_id") && tile["tile_id"].get<int>() == std::stoi(curTileId) && tile.contains("data_list")) {
-                                statsJson = std::make_shared<nlohmann::json>(tile["data_list"]);
-                                if (tile.contains("engine_util")) {
-                                    engineUtilJson = std::make_shared<nlohmann::json>(tile["engine_util"]);
-                                }
-                                break;
-                            }
+                    for (auto& tileStats : curDevice->stats->tiles) {
+                        if (tileStats.tileId == std::stoi(curTileId)) {
+                            curMetrics = &curDevice->tileMetrics.at(tileStats.tileId);
+                            curTile = &tileStats;
+                            break;
                         }
                     }
                 }
@@ -13,6 +13,7 @@
 #include <string>
 
 #include "comlet_base.h"
+#include "core_stub.h"
 #include "internal_dump_raw_data.h"
 #include "xpum_structs.h"
 #include <dirent.h>
@@ -40,14 +41,31 @@ struct ComletDumpOptions {
     int dumpTaskId = -1;
 };
 
+// metric value as displayed, already divided by the core scale
+struct DumpValue {
+    double value = 0;
+    bool isFloat = false;
+    uint64_t current = 0;
+};
+
+typedef std::map<xpum_stats_type_t, DumpValue> DumpMetrics;
+
+struct DumpDeviceData {
+    std::unique_ptr<DeviceStatsData> stats;
+    DumpMetrics metrics;
+    std::map<int32_t, DumpMetrics> tileMetrics;
+};
+
 class ComletDump : public ComletBase {
    private:
     std::unique_ptr<ComletDumpOptions> opts;
 
     std::shared_ptr<nlohmann::json> statsJson;
-    std::shared_ptr<nlohmann::json> engineUtilJson;
-    std::shared_ptr<nlohmann::json> fabricThroughputJson;
     std::map<std::string, std::unique_ptr<nlohmann::json>> deviceJsons;
+    std::map<std::string, DumpDeviceData> deviceDatas;
+    const DumpDeviceData* curDevice = nullptr;
+    const DumpMetrics* curMetrics = nullptr;
+    const TileStatsData* curTile = nullptr;
     std::string curDeviceId;
     std::string curTileId;
 
@@ -95,6 +113,8 @@ class ComletDump : public ComletBase {
         return opts->deviceIds;
     }
 
-    std::unique_ptr<nlohmann::json> combineTileAndDeviceLevel(nlohmann::json rawJson);
+    void combineTileAndDeviceLevel(DumpDeviceData& data);
+
+    const EngineStatsData* findEngine(int tileIdx, xpum_engine_type_t engineType, int engineIdx) const;
 };
 } // end namespace xpum::cli
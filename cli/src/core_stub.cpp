@@ -9,6 +9,7 @@
 #include <cassert>
 #include <chrono>
 #include <cstdlib>
+#include <cmath>
 #include <ctime>
 #include <map>
 #include <nlohmann/json.hpp>
@@ -97,6 +98,193 @@ std::string CoreStub::getCardUUID(const std::string& rawUUID) {
     }
 }
 
+int32_t CoreStub::getCliScale(xpum_stats_type_t metricsType) {
+    switch (metricsType) {
+        case XPUM_STATS_ENERGY:
+            return 1000;
+        case XPUM_STATS_MEMORY_USED:
+            return 1048576;
+        default:
+            return 1;
+    }
+}
+
+static const char* engineTypeToKey(xpum_engine_type_t engineType) {
+    switch (engineType) {
+        case XPUM_ENGINE_TYPE_COMPUTE:
+            return "compute";
+        case XPUM_ENGINE_TYPE_RENDER:
+            return "render";
+        case XPUM_ENGINE_TYPE_DECODE:
+            return "decoder";
+        case XPUM_ENGINE_TYPE_ENCODE:
+            return "encoder";
+        case XPUM_ENGINE_TYPE_COPY:
+            return "copy";
+        case XPUM_ENGINE_TYPE_MEDIA_ENHANCEMENT:
+            return "media_enhancement";
+        case XPUM_ENGINE_TYPE_3D:
+            return "3d";
+        default:
+            return nullptr;
+    }
+}
+
+static nlohmann::json metricStatsToJson(const MetricStatsData& data, int32_t scale) {
+    nlohmann::json obj;
+    obj["metrics_type"] = CoreStub::metricsTypeToString(data.metricsType);
+    if (data.hasStats) {
+        if (scale == 1) {
+            obj["value"] = data.value;
+            if (!data.isCounter) {
+                obj["avg"] = data.avg;
+                obj["min"] = data.min;
+                obj["max"] = data.max;
+            } else {
+                obj["total"] = data.accumulated;
+            }
+        } else {
+            obj["value"] = (double)data.value / scale;
+            if (!data.isCounter) {
+                obj["avg"] = (double)data.avg / scale;
+                obj["min"] = (double)data.min / scale;
+                obj["max"] = (double)data.max / scale;
+            } else {
+                obj["total"] = (double)data.accumulated / scale;
+            }
+        }
+    } else {
+        uint64_t value = data.isCounter ? data.accumulated : data.value;
+        if (scale == 1) {
+            obj["value"] = value;
+        } else {
+            obj["value"] = (double)value / scale;
+        }
+    }
+    return obj;
+}
+
+static nlohmann::json engineStatsToJson(const std::vector<EngineStatsData>& engines) {
+    nlohmann::json json;
+    json["compute"] = nlohmann::json::array();
+    json["render"] = nlohmann::json::array();
+    json["decoder"] = nlohmann::json::array();
+    json["encoder"] = nlohmann::json::array();
+    json["copy"] = nlohmann::json::array();
+    json["media_enhancement"] = nlohmann::json::array();
+    json["3d"] = nlohmann::json::array();
+    for (auto& engine : engines) {
+        auto key = engineTypeToKey(engine.engineType);
+        if (key == nullptr) {
+            continue;
+        }
+        nlohmann::json obj;
+        if (engine.scale == 1) {
+            obj["value"] = engine.value;
+            if (engine.hasStats) {
+                obj["min"] = engine.min;
+                obj["max"] = engine.max;
+                obj["avg"] = engine.avg;
+            }
+        } else {
+            obj["value"] = (double)engine.value / engine.scale;
+            if (engine.hasStats) {
+                obj["min"] = (double)engine.min / engine.scale;
+                obj["max"] = (double)engine.max / engine.scale;
+                obj["avg"] = (double)engine.avg / engine.scale;
+            }
+        }
+        obj["engine_id"] = engine.engineId;
+        json[key].push_back(obj);
+    }
+    return json;
+}
+
+static nlohmann::json fabricStatsToJson(int32_t deviceId, const std::vector<FabricStatsData>& fabrics) {
+    nlohmann::json json = nlohmann::json::array();
+    for (auto& fabric : fabrics) {
+        std::string name;
+        if (fabric.type == XPUM_FABRIC_THROUGHPUT_TYPE_TRANSMITTED) {
+            name = std::to_string(deviceId) + "/" + std::to_string(fabric.tileId) + "->" + std::to_string(fabric.remoteDeviceId) + "/" + std::to_string(fabric.remoteTileId);
+        } else if (fabric.type == XPUM_FABRIC_THROUGHPUT_TYPE_RECEIVED) {
+            name = std::to_string(fabric.remoteDeviceId) + "/" + std::to_string(fabric.remoteTileId) + "->" + std::to_string(deviceId) + "/" + std::to_string(fabric.tileId);
+        } else {
+            continue;
+        }
+        nlohmann::json obj;
+        int32_t scale = fabric.scale * 1000; // kB
+        obj["value"] = round((double)fabric.value / scale * 100) / 100;
+        if (fabric.hasStats) {
+            obj["min"] = round((double)fabric.min / scale * 100) / 100;
+            obj["max"] = round((double)fabric.max / scale * 100) / 100;
+            obj["avg"] = round((double)fabric.avg / scale * 100) / 100;
+        }
+        obj["name"] = name;
+        obj["tile_id"] = fabric.tileId;
+        json.push_back(obj);
+    }
+    return json;
+}
+
+std::unique_ptr<nlohmann::json> CoreStub::statisticsToJson(const DeviceStatsData& stats, bool enableScale) {
+    auto json = std::unique_ptr<nlohmann::json>(new nlohmann::json());
+    if (!stats.error.empty()) {
+        (*json)["error"] = stats.error;
+        if (stats.errorNo != 0) {
+            (*json)["errno"] = stats.errorNo;
+        }
+        return json;
+    }
+
+    if (stats.hasFabrics) {
+        (*json)["fabric_throughput"] = fabricStatsToJson(stats.deviceId, stats.fabrics);
+    }
+
+    if (stats.hasTimeRange) {
+        (*json)["begin"] = isotimestamp(stats.begin);
+        (*json)["end"] = isotimestamp(stats.end);
+        (*json)["elapsed_time"] = (stats.end - stats.begin) / 1000;
+    }
+
+    std::vector<nlohmann::json> deviceLevelStatsDataList;
+    for (auto& metric : stats.metrics) {
+        int32_t scale = enableScale ? metric.scale * getCliScale(metric.metricsType) : metric.scale;
+        deviceLevelStatsDataList.push_back(metricStatsToJson(metric, scale));
+    }
+
+    std::vector<nlohmann::json> tileLevelStatsDataList;
+    for (auto& tile : stats.tiles) {
+        std::vector<nlohmann::json> dataList;
+        for (auto& metric : tile.metrics) {
+            int32_t scale = enableScale ? metric.scale * getCliScale(metric.metricsType) : metric.scale;
+            dataList.push_back(metricStatsToJson(metric, scale));
+        }
+        auto tmp = nlohmann::json();
+        tmp["tile_id"] = tile.tileId;
+        tmp["data_list"] = dataList;
+        if (!tile.engines.empty()) {
+            tmp["engine_util"] = engineStatsToJson(tile.engines);
+        }
+        tileLevelStatsDataList.push_back(tmp);
+    }
+
+    if (!stats.engines.empty()) {
+        (*json)["engine_util"] = engineStatsToJson(stats.engines);
+    }
+    (*json)["device_level"] = deviceLevelStatsDataList;
+    if (tileLevelStatsDataList.size() > 0)
+        (*json)["tile_level"] = tileLevelStatsDataList;
+
+    (*json)["device_id"] = stats.deviceId;
+
+    return json;
+}
+
+std::unique_ptr<nlohmann::json> CoreStub::getStatistics(int deviceId, bool enableFilter, bool enableScale) {
+    auto stats = getStatisticsData(deviceId, enableFilter);
+    return statisticsToJson(*stats, enableScale);
+}
+
 std::string CoreStub::schedulerModeToString(int mode) {
     std::string ret = "null"; //"SCHEDULER_MODE_NULL";
     switch (mode) {
@@ -13,6 +13,7 @@
 #include <string>
 #include <thread>
 #include <cstdint>
+#include <vector>
 
 #include "xpum_structs.h"
 
@@ -27,6 +28,60 @@ struct PolicyData {
     bool isDeletePolicy;
 };
 
+/*
+  Typed statistics returned by the core stubs. Values are kept as reported
+  by the core and must be divided by scale for display. hasStats is set
+  when min/avg/max over the session are available, which is the case with
+  the daemon only.
+*/
+
+struct StatsData {
+    uint64_t value = 0;
+    uint64_t min = 0;
+    uint64_t avg = 0;
+    uint64_t max = 0;
+    int32_t scale = 1;
+    bool hasStats = false;
+};
+
+struct MetricStatsData : StatsData {
+    xpum_stats_type_t metricsType;
+    bool isCounter = false;
+    uint64_t accumulated = 0;
+};
+
+struct EngineStatsData : StatsData {
+    xpum_engine_type_t engineType;
+    int32_t engineId = 0;
+};
+
+struct FabricStatsData : StatsData {
+    xpum_fabric_throughput_type_t type;
+    uint32_t tileId = 0;
+    uint32_t remoteDeviceId = 0;
+    uint32_t remoteTileId = 0;
+};
+
+struct TileStatsData {
+    int32_t tileId = 0;
+    std::vector<MetricStatsData> metrics;
+    std::vector<EngineStatsData> engines;
+};
+
+struct DeviceStatsData {
+    int32_t deviceId = -1;
+    bool hasTimeRange = false;
+    uint64_t begin = 0;
+    uint64_t end = 0;
+    std::vector<MetricStatsData> metrics;
+    std::vector<EngineStatsData> engines;
+    bool hasFabrics = false;
+    std::vector<FabricStatsData> fabrics;
+    std::vector<TileStatsData> tiles;
+    std::string error;
+    int errorNo = 0;
+};
+
 class CoreStub {
    public:
 
@@ -72,7 +127,8 @@ class CoreStub {
     virtual std::unique_ptr<nlohmann::json> setHealthConfig(int deviceId, int cfgtype, int threshold)=0;
     virtual std::unique_ptr<nlohmann::json> setHealthConfigByGroup(uint32_t groupId, int cfgtype, int threshold)=0;
 
-    virtual std::unique_ptr<nlohmann::json> getStatistics(int deviceId, bool enableFilter = false, bool enableScale = false)=0;
+    virtual std::unique_ptr<DeviceStatsData> getStatisticsData(int deviceId, bool enableFilter = false)=0;
+    virtual std::unique_ptr<nlohmann::json> getStatistics(int deviceId, bool enableFilter = false, bool enableScale = false);
     virtual std::unique_ptr<nlohmann::json> getStatisticsByGroup(uint32_t groupId, bool enableFilter = false, bool enableScale = false)=0;
     virtual std::shared_ptr<nlohmann::json> getEngineStatistics(int deviceId)=0;
     virtual std::shared_ptr<std::map<int, std::map<int, int>>> getEngineCount(int deviceId)=0;
@@ -148,5 +204,9 @@ class CoreStub {
 
    protected:
     std::string getCardUUID(const std::string& rawUUID);
+
+    static int32_t getCliScale(xpum_stats_type_t metricsType);
+
+    static std::unique_ptr<nlohmann::json> statisticsToJson(const DeviceStatsData& stats, bool enableScale);
 };
 } // end namespace xpum::cli
@@ -398,108 +398,114 @@ std::unique_ptr<nlohmann::json> LibCoreStub::getXelinkThroughputAndUtilMatrix(){
     return json;
 }
 
-static int32_t getCliScale(xpum_stats_type_t metricsType) {
-    switch (metricsType) {
-        case XPUM_STATS_ENERGY:
-            return 1000;
-        case XPUM_STATS_MEMORY_USED:
-            return 1048576;
+static std::string statsErrorMessage(xpum_result_t res) {
+    switch (res) {
+        case XPUM_RESULT_DEVICE_NOT_FOUND:
+            return "device not found";
+        case XPUM_LEVEL_ZERO_INITIALIZATION_ERROR:
+            return "Level Zero Initialization Error";
         default:
-            return 1;
+            return "Error";
     }
 }
 
-std::unique_ptr<nlohmann::json> LibCoreStub::getStatistics(int deviceId, bool enableFilter, bool enableScale) {
-    auto json = std::unique_ptr<nlohmann::json>(new nlohmann::json());
+std::unique_ptr<DeviceStatsData> LibCoreStub::getStatisticsData(int deviceId, bool enableFilter) {
+    auto stats = std::unique_ptr<DeviceStatsData>(new DeviceStatsData());
+    stats->deviceId = deviceId;
     xpum_device_id_t xpum_device_id = deviceId;
     uint64_t sessionId = 0;
-    uint32_t count = 5;
-    xpum_device_stats_t dataList[count];
+    uint32_t count = 0;
     uint64_t begin, end;
-    xpum_result_t res = xpumGetStats(xpum_device_id, dataList, &count, &begin, &end, sessionId);
-    if (res != XPUM_OK || count < 0) {
-        switch (res) {
-            case XPUM_RESULT_DEVICE_NOT_FOUND:
-                (*json)["error"] = "device not found";
-                (*json)["errno"] = errorNumTranslate(res);
-                break;
-            case XPUM_LEVEL_ZERO_INITIALIZATION_ERROR:
-                (*json)["error"] = "Level Zero Initialization Error";
-                (*json)["errno"] = errorNumTranslate(res);
-                break;
-            default:
-                (*json)["error"] = "Error";
-                (*json)["errno"] = errorNumTranslate(res);
-                break;
-        }
-        return json;
+    std::vector<xpum_device_stats_t> dataList;
+    xpum_result_t res = xpumGetStats(xpum_device_id, nullptr, &count, &begin, &end, sessionId);
+    if (res == XPUM_OK) {
+        dataList.resize(count);
+        res = xpumGetStats(xpum_device_id, dataList.data(), &count, &begin, &end, sessionId);
+    }
+    if (res != XPUM_OK) {
+        stats->error = statsErrorMessage(res);
+        stats->errorNo = errorNumTranslate(res);
+        return stats;
     }
 
     // get engine stats
-    auto engineStatsJson = getEngineStatistics(deviceId);
-    if (engineStatsJson->contains("error")) {
-        return std::make_unique<nlohmann::json>(*engineStatsJson);
+    uint32_t engineCount = 128;
+    xpum_device_engine_stats_t engineList[engineCount];
+    res = xpumGetEngineStats(xpum_device_id, engineList, &engineCount, &begin, &end, sessionId);
+    if (res == XPUM_METRIC_NOT_SUPPORTED || res == XPUM_METRIC_NOT_ENABLED) {
+        engineCount = 0;
+    } else if (res != XPUM_OK) {
+        stats->error = res == XPUM_LEVEL_ZERO_INITIALIZATION_ERROR ? "Level Zero Initialization Error" : "Error";
+        stats->errorNo = errorNumTranslate(res);
+        return stats;
+    }
+    std::map<int32_t, std::vector<EngineStatsData>> tileEngines;
+    for (uint32_t i = 0; i < engineCount; i++) {
+        xpum_device_engine_stats_t& engineInfo = engineList[i];
+        EngineStatsData engine;
+        engine.engineType = engineInfo.type;
+        engine.engineId = engineInfo.index;
+        engine.value = engineInfo.value;
+        engine.scale = engineInfo.scale;
+        if (engineInfo.isTileData) {
+            tileEngines[engineInfo.tileId].push_back(engine);
+        } else {
+            stats->engines.push_back(engine);
+        }
     }
 
     // get fabric stats
-    auto fabricStatsJson = getFabricStatistics(deviceId);
-    if (!fabricStatsJson->contains("error") && !fabricStatsJson->empty()) {
-        json->update(*fabricStatsJson);
-        // return std::make_unique<nlohmann::json>(*fabricStatsJson);
+    uint32_t fabricCount = 0;
+    res = xpumGetFabricThroughputStats(xpum_device_id, nullptr, &fabricCount, &begin, &end, sessionId);
+    if (res == XPUM_OK) {
+        std::vector<xpum_device_fabric_throughput_stats_t> fabricList(fabricCount);
+        res = xpumGetFabricThroughputStats(xpum_device_id, fabricList.data(), &fabricCount, &begin, &end, sessionId);
+        if (res == XPUM_OK) {
+            stats->hasFabrics = true;
+            for (uint32_t i = 0; i < fabricCount; i++) {
+                xpum_device_fabric_throughput_stats_t& fabricInfo = fabricList[i];
+                FabricStatsData fabric;
+                fabric.type = fabricInfo.type;
+                fabric.tileId = fabricInfo.tile_id;
+                fabric.remoteDeviceId = fabricInfo.remote_device_id;
+                fabric.remoteTileId = fabricInfo.remote_device_tile_id;
+                fabric.value = fabricInfo.value;
+                fabric.scale = fabricInfo.scale;
+                stats->fabrics.push_back(fabric);
+            }
+        }
     }
 
-    std::vector<nlohmann::json> deviceLevelStatsDataList;
-    std::vector<nlohmann::json> tileLevelStatsDataList;
-
     for (uint32_t i = 0; i < count; i++) {
         xpum_device_stats_t& stats_info = dataList[i];
-        std::vector<nlohmann::json> dataList;
+        std::vector<MetricStatsData> metrics;
         for (int j = 0; j < stats_info.count; j++) {
             xpum_device_stats_data_t& stats_data = stats_info.dataList[j];
             if (enableFilter && !metricsTypeAllowList(stats_data.metricsType))
                 continue;
-            auto tmp = nlohmann::json();
-            xpum_stats_type_t metricsType = stats_data.metricsType;
-            tmp["metrics_type"] = metricsTypeToString(metricsType);
-            int32_t cliScale = getCliScale(metricsType);
-            int32_t scale = enableScale ? stats_data.scale * cliScale : stats_data.scale;
-            if (scale == 1) {
-                tmp["value"] = stats_data.value;
-                if (stats_data.isCounter) {
-                    tmp["value"] = stats_data.accumulated;
-                }
-            } else {
-                tmp["value"] = (double)stats_data.value / scale;
-                if (stats_data.isCounter) {
-                    tmp["value"] = (double)stats_data.accumulated / scale;
-                }
-            }
-            dataList.push_back(tmp);
+            MetricStatsData metric;
+            metric.metricsType = stats_data.metricsType;
+            metric.isCounter = stats_data.isCounter;
+            metric.value = stats_data.value;
+            metric.accumulated = stats_data.accumulated;
+            metric.scale = stats_data.scale;
+            metrics.push_back(metric);
         }
         if (stats_info.isTileData) {
-            auto tmp = nlohmann::json();
-            tmp["tile_id"] = stats_info.tileId;
-            tmp["data_list"] = dataList;
-            auto strTileId = std::to_string(stats_info.tileId);
-            if (engineStatsJson->contains(strTileId)) {
-                tmp["engine_util"] = (*engineStatsJson)[strTileId];
+            TileStatsData tile;
+            tile.tileId = stats_info.tileId;
+            tile.metrics = std::move(metrics);
+            auto it = tileEngines.find(stats_info.tileId);
+            if (it != tileEngines.end()) {
+                tile.engines = std::move(it->second);
             }
-            tileLevelStatsDataList.push_back(tmp);
+            stats->tiles.push_back(std::move(tile));
         } else {
-            deviceLevelStatsDataList.insert(deviceLevelStatsDataList.end(), dataList.begin(), dataList.end());
+            stats->metrics.insert(stats->metrics.end(), metrics.begin(), metrics.end());
         }
     }
 
-    if (engineStatsJson->contains("device")) {
-        (*json)["engine_util"] = (*engineStatsJson)["device"];
-    }
-    (*json)["device_level"] = deviceLevelStatsDataList;
-    if (tileLevelStatsDataList.size() > 0)
-        (*json)["tile_level"] = tileLevelStatsDataList;
-
-    (*json)["device_id"] = deviceId;
-
-    return json;
+    return stats;
 }
 
 std::unique_ptr<nlohmann::json> LibCoreStub::getStatisticsByGroup(uint32_t groupId, bool enableFilter, bool enableScale) {
@@ -330,21 +330,11 @@ std::unique_ptr<nlohmann::json> GrpcCoreStub::getXelinkThroughputAndUtilMatrix()
     return json;
 }
 
-static int32_t getCliScale(xpum_stats_type_t metricsType) {
-    switch (metricsType) {
-        case XPUM_STATS_ENERGY:
-            return 1000;
-        case XPUM_STATS_MEMORY_USED:
-            return 1048576;
-        default:
-            return 1;
-    }
-}
-
-std::unique_ptr<nlohmann::json> GrpcCoreStub::getStatistics(int deviceId, bool enableFilter, bool enableScale) {
+std::unique_ptr<DeviceStatsData> GrpcCoreStub::getStatisticsData(int deviceId, bool enableFilter) {
     assert(this->stub != nullptr);
 
-    auto json = std::unique_ptr<nlohmann::json>(new nlohmann::json());
+    auto stats = std::unique_ptr<DeviceStatsData>(new DeviceStatsData());
+    stats->deviceId = deviceId;
 
     grpc::ClientContext context;
     XpumGetStatsResponse response;
@@ -355,95 +345,118 @@ std::unique_ptr<nlohmann::json> GrpcCoreStub::getStatistics(int deviceId, bool e
     grpc::Status status = stub->getStatisticsNotForPrometheus(&context, request, &response);
 
     if (!status.ok()) {
-        (*json)["error"] = status.error_message();
-        (*json)["errno"] = XPUM_CLI_ERROR_GENERIC_ERROR;
-        return json;
+        stats->error = status.error_message();
+        stats->errorNo = XPUM_CLI_ERROR_GENERIC_ERROR;
+        return stats;
     }
 
     if (response.errormsg().length() != 0) {
-        (*json)["error"] = response.errormsg();
-        (*json)["errno"] = errorNumTranslate(response.errorno());
-        return json;
+        stats->error = response.errormsg();
+        stats->errorNo = errorNumTranslate(response.errorno());
+        return stats;
     }
 
     // get engine stats
-    auto engineStatsJson = getEngineStatistics(deviceId);
-    if (engineStatsJson->contains("error")) {
-        return std::make_unique<nlohmann::json>(*engineStatsJson);
+    std::map<int32_t, std::vector<EngineStatsData>> tileEngines;
+    {
+        grpc::ClientContext engineContext;
+        XpumGetEngineStatsRequest engineRequest;
+        XpumGetEngineStatsResponse engineResponse;
+        engineRequest.set_deviceid(deviceId);
+        engineRequest.set_sessionid(0);
+        status = stub->getEngineStatistics(&engineContext, engineRequest, &engineResponse);
+        if (!status.ok()) {
+            stats->error = status.error_message();
+            return stats;
+        }
+        if (engineResponse.errormsg().length() != 0) {
+            if (engineResponse.errorno() != XPUM_METRIC_NOT_SUPPORTED && engineResponse.errorno() != XPUM_METRIC_NOT_ENABLED) {
+                stats->error = engineResponse.errormsg();
+                return stats;
+            }
+        } else {
+            for (auto &engineInfo : engineResponse.datalist()) {
+                EngineStatsData engine;
+                engine.engineType = (xpum_engine_type_t)engineInfo.enginetype();
+                engine.engineId = engineInfo.engineid();
+                engine.value = engineInfo.value();
+                engine.min = engineInfo.min();
+                engine.avg = engineInfo.avg();
+                engine.max = engineInfo.max();
+                engine.scale = engineInfo.scale();
+                engine.hasStats = true;
+                if (engineInfo.istiledata()) {
+                    tileEngines[engineInfo.tileid()].push_back(engine);
+                } else {
+                    stats->engines.push_back(engine);
+                }
+            }
+        }
     }
 
     // get fabric stats
-    auto fabricStatsJson = getFabricStatistics(deviceId);
-    if (!fabricStatsJson->contains("error") && !fabricStatsJson->empty()) {
-        json->update(*fabricStatsJson);
-        // return std::make_unique<nlohmann::json>(*fabricStatsJson);
+    {
+        grpc::ClientContext fabricContext;
+        GetFabricStatsRequest fabricRequest;
+        GetFabricStatsResponse fabricResponse;
+        fabricRequest.set_deviceid(deviceId);
+        fabricRequest.set_sessionid(0);
+        status = stub->getFabricStatistics(&fabricContext, fabricRequest, &fabricResponse);
+        if (status.ok() && fabricResponse.errormsg().length() == 0) {
+            stats->hasFabrics = true;
+            for (auto &fabricInfo : fabricResponse.datalist()) {
+                FabricStatsData fabric;
+                fabric.type = (xpum_fabric_throughput_type_t)fabricInfo.type();
+                fabric.tileId = fabricInfo.tileid();
+                fabric.remoteDeviceId = fabricInfo.remote_device_id();
+                fabric.remoteTileId = fabricInfo.remote_device_tile_id();
+                fabric.value = fabricInfo.value();
+                fabric.min = fabricInfo.min();
+                fabric.avg = fabricInfo.avg();
+                fabric.max = fabricInfo.max();
+                fabric.scale = fabricInfo.scale();
+                fabric.hasStats = true;
+                stats->fabrics.push_back(fabric);
+            }
+        }
     }
 
-    std::vector<nlohmann::json> deviceJsonList;
-    uint64_t begin = response.begin();
-    uint64_t end = response.end();
-    (*json)["begin"] = isotimestamp(begin);
-    (*json)["end"] = isotimestamp(end);
-
-    (*json)["elapsed_time"] = (end - begin) / 1000;
-
-    std::vector<nlohmann::json> deviceLevelStatsDataList;
-    std::vector<nlohmann::json> tileLevelStatsDataList;
+    stats->hasTimeRange = true;
+    stats->begin = response.begin();
+    stats->end = response.end();
 
     for (int i{0}; i < response.datalist_size(); i++) {
         auto &stats_info = response.datalist(i);
-        std::vector<nlohmann::json> dataList;
+        std::vector<MetricStatsData> metrics;
         for (int j = 0; j < stats_info.datalist_size(); j++) {
             auto &stats_data = stats_info.datalist(j);
-            auto tmp = nlohmann::json();
-            xpum_stats_type_t metricsType = (xpum_stats_type_t)stats_data.metricstype().value();
-            tmp["metrics_type"] = metricsTypeToString(metricsType);
-            int32_t cliScale = getCliScale(metricsType);
-            int32_t scale = enableScale ? stats_data.scale() * cliScale : stats_data.scale();
-            if (scale == 1) {
-                tmp["value"] = stats_data.value();
-                if (!stats_data.iscounter()) {
-                    tmp["avg"] = stats_data.avg();
-                    tmp["min"] = stats_data.min();
-                    tmp["max"] = stats_data.max();
-                } else {
-                    tmp["total"] = stats_data.accumulated();
-                }
-            } else {
-                tmp["value"] = (double)stats_data.value() / scale;
-                if (!stats_data.iscounter()) {
-                    tmp["avg"] = (double)stats_data.avg() / scale;
-                    tmp["min"] = (double)stats_data.min() / scale;
-                    tmp["max"] = (double)stats_data.max() / scale;
-                } else {
-                    tmp["total"] = (double)stats_data.accumulated() / scale;
-                }
-            }
-            dataList.push_back(tmp);
+            MetricStatsData metric;
+            metric.metricsType = (xpum_stats_type_t)stats_data.metricstype().value();
+            metric.isCounter = stats_data.iscounter();
+            metric.value = stats_data.value();
+            metric.min = stats_data.min();
+            metric.avg = stats_data.avg();
+            metric.max = stats_data.max();
+            metric.accumulated = stats_data.accumulated();
+            metric.scale = stats_data.scale();
+            metric.hasStats = true;
+            metrics.push_back(metric);
         }
         if (stats_info.istiledata()) {
-            auto tmp = nlohmann::json();
-            tmp["tile_id"] = stats_info.tileid();
-            tmp["data_list"] = dataList;
-            auto strTileId = std::to_string(stats_info.tileid());
-            if (engineStatsJson->contains(strTileId)) {
-                tmp["engine_util"] = (*engineStatsJson)[strTileId];
+            TileStatsData tile;
+            tile.tileId = stats_info.tileid();
+            tile.metrics = std::move(metrics);
+            auto it = tileEngines.find(stats_info.tileid());
+            if (it != tileEngines.end()) {
+                tile.engines = std::move(it->second);
             }
-            tileLevelStatsDataList.push_back(tmp);
+            stats->tiles.push_back(std::move(tile));
         } else {
-            deviceLevelStatsDataList.insert(deviceLevelStatsDataList.end(), dataList.begin(), dataList.end());
+            stats->metrics.insert(stats->metrics.end(), metrics.begin(), metrics.end());
         }
     }
-    if (engineStatsJson->contains("device")) {
-        (*json)["engine_util"] = (*engineStatsJson)["device"];
-    }
-    (*json)["device_level"] = deviceLevelStatsDataList;
-    if (tileLevelStatsDataList.size() > 0)
-        (*json)["tile_level"] = tileLevelStatsDataList;
-
-    (*json)["device_id"] = deviceId;
 
-    return json;
+    return stats;
 }
 
 std::unique_ptr<nlohmann::json> GrpcCoreStub::getStatisticsByGroup(uint32_t groupId, bool enableFilter, bool enableScale) {
@@ -0,0 +1,303 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file fake_ipmi_device.h
+ */
+
+#pragma once
+
+#include <errno.h>
+#include <string.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ipmi/bsmc_interface.h"
+#include "ipmi/bsmc_ipmi_oem_cmd.h"
+#include "ipmi/ipmi_channel.h"
+#include "ipmi/sdr.h"
+
+namespace xpum {
+
+/*
+  An IPMI device answering like an OpenBMC with AMC cards behind SlotIPMB,
+  to run the IPMI code without a BMC. The cards are in the first slots at
+  CARD_FIRST_I2C_ADDR and have a full sensor record per sensor.
+
+  A response is ready latency after its request, the BMC working on up to
+  concurrency requests at a time. The timer fd polls readable when the
+  first response is ready.
+
+  The cards take firmware images like the BSMC: after the start and after
+  the last chunk they answer a few syncs with IPMI_FW_UPDATE_WAIT, then ask
+  for the image size and for the image in FIRMWARE_WINDOW bytes parts.
+*/
+
+class FakeIpmiDevice : public IpmiDevice {
+   public:
+    typedef std::chrono::steady_clock Clock;
+
+    FakeIpmiDevice(int cards, int sensors, std::chrono::microseconds latency, int concurrency)
+        : cards(cards),
+          sensors(sensors),
+          latency(latency),
+          busy_until(std::max(concurrency, 1), Clock::time_point()),
+          request_count(0) {
+        timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    }
+
+    ~FakeIpmiDevice() {
+        close(timer);
+    }
+
+    int fd() override {
+        return timer;
+    }
+
+    int send(struct ipmi_req* req) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto slot = std::min_element(busy_until.begin(), busy_until.end());
+        auto ready = std::max(Clock::now(), *slot) + latency;
+        *slot = ready;
+        Response response;
+        response.msgid = req->msgid;
+        response.netfn = req->msg.netfn | 1;
+        response.cmd = req->msg.cmd;
+        response.data = respond(req->msg.netfn, req->msg.cmd, req->msg.data, req->msg.data_len);
+        responses.insert(std::make_pair(ready, response));
+        request_count++;
+        arm();
+        return 0;
+    }
+
+    int receive(struct ipmi_recv* recv) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        uint64_t expirations;
+        if (read(timer, &expirations, sizeof(expirations)) < 0 && errno != EAGAIN) {
+            return -1;
+        }
+        if (responses.empty() || responses.begin()->first > Clock::now()) {
+            arm();
+            errno = EAGAIN;
+            return -1;
+        }
+        Response response = responses.begin()->second;
+        responses.erase(responses.begin());
+        arm();
+
+        recv->recv_type = IPMI_RESPONSE_RECV_TYPE;
+        recv->msgid = response.msgid;
+        recv->msg.netfn = response.netfn;
+        recv->msg.cmd = response.cmd;
+        recv->msg.data_len = std::min((std::size_t)recv->msg.data_len, response.data.size());
+        memcpy(recv->msg.data, response.data.data(), recv->msg.data_len);
+        return 0;
+    }
+
+    uint64_t requests() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return request_count;
+    }
+
+    // the image received by the card, once its update is complete
+    std::vector<unsigned char> firmwareImage(int card) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = firmware.find(card);
+        if (it == firmware.end() || it->second.status != IPMI_FW_UPDATE_COMPLETE) {
+            return {};
+        }
+        return it->second.image;
+    }
+
+   private:
+    static const uint32_t FIRMWARE_WINDOW = 1024;
+
+    static const int FIRMWARE_WAIT_SYNCS = 3;
+
+    struct FirmwareUpdate {
+        uint8_t status;
+        int wait_syncs;
+        uint32_t image_size;
+        // end of the part of the image asked for by the last sync
+        uint32_t window_end;
+        std::vector<unsigned char> image;
+    };
+
+    struct Response {
+        long msgid;
+        unsigned char netfn;
+        unsigned char cmd;
+        std::vector<unsigned char> data;
+    };
+
+    void arm() {
+        struct itimerspec spec;
+        memset(&spec, 0, sizeof(spec));
+        if (!responses.empty()) {
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(responses.begin()->first.time_since_epoch()).count();
+            // zero would disarm the timer
+            ns = std::max(ns, (decltype(ns))1);
+            spec.it_value.tv_sec = ns / 1000000000;
+            spec.it_value.tv_nsec = ns % 1000000000;
+        }
+        timerfd_settime(timer, TFD_TIMER_ABSTIME, &spec, nullptr);
+    }
+
+    std::vector<unsigned char> respond(unsigned char netfn, unsigned char cmd, const unsigned char* data, unsigned short data_len) {
+        if (netfn == IPMI_GET_DEVID_OEM_NETFN && cmd == IPMI_FW_GET_INFO_CMD) {
+            return {IPMI_CC_SUCCESS, OPEN_BMC_DEV_ID};
+        }
+        // SlotIPMB: bus, slot, i2c address, netfn, cmd and the request data
+        if (data_len < REQUEST_HEADER_SIZE) {
+            return {IPMI_CC_INVALID_COMMAND};
+        }
+        if (data[1] >= cards || data[2] != CARD_FIRST_I2C_ADDR) {
+            return {IPMB_CC_NAK_ON_WRITE};
+        }
+        std::vector<unsigned char> res{IPMI_CC_SUCCESS, IPMI_CC_SUCCESS};
+        const unsigned char* req = data + REQUEST_HEADER_SIZE;
+        unsigned short req_len = data_len - REQUEST_HEADER_SIZE;
+        if (data[3] == IPMI_INTEL_OEM_NETFN && data[4] == IPMI_CARD_GET_INFO_CMD) {
+            card_get_info_res info;
+            memset(&info, 0, sizeof(info));
+            memcpy(info.project_codename, NNP_PROJECT_CODENAME, sizeof(info.project_codename));
+            res.insert(res.end(), (unsigned char*)&info + 1, (unsigned char*)&info + sizeof(info) - sizeof(info.bar0_address));
+        } else if (data[3] == 0x4 && data[4] == 0x20) {
+            res.push_back(sensors);
+        } else if (data[3] == 0x4 && data[4] == 0x21 && req_len >= 6) {
+            uint16_t id = req[2] | (req[3] << 8);
+            uint16_t next = id + 1 < sensors ? id + 1 : 0xffff;
+            auto record = sensorRecord(id);
+            res.push_back(next & 0xff);
+            res.push_back(next >> 8);
+            std::size_t begin = std::min((std::size_t)req[4], record.size());
+            std::size_t end = std::min(begin + req[5], record.size());
+            res.insert(res.end(), record.begin() + begin, record.begin() + end);
+        } else if (data[3] == IPMI_INTEL_OEM_NETFN && (data[4] == IPMI_FW_UPDATE_START_CMD ||
+                                                       data[4] == IPMI_FW_UPDATE_SYNC_CMD ||
+                                                       data[4] == IPMI_FW_UPDATE_SEND_DATA_CMD ||
+                                                       data[4] == IPMI_TRANSFER_SIZE_DETECT)) {
+            unsigned char cc = updateFirmware(data[1], data[4], req, req_len, res);
+            res[1] = cc;
+        } else if (data[3] == 0x4 && data[4] == 0x2d && req_len >= 1) {
+            // reading, scanning enabled, no threshold crossed
+            res.push_back((req[0] * 7 + request_count) % 100);
+            res.push_back(0x40);
+            res.push_back(0);
+        } else {
+            res[1] = IPMI_CC_INVALID_COMMAND;
+        }
+        return res;
+    }
+
+    unsigned char updateFirmware(int card, unsigned char cmd, const unsigned char* req, unsigned short req_len, std::vector<unsigned char>& res) {
+        if (cmd == IPMI_TRANSFER_SIZE_DETECT) {
+            uint16_t received = std::min(req_len, (unsigned short)IPMI_TRANSFER_SIZE_BIG);
+            res.push_back(received & 0xff);
+            res.push_back(received >> 8);
+            return IPMI_CC_SUCCESS;
+        }
+        if (cmd == IPMI_FW_UPDATE_START_CMD) {
+            FirmwareUpdate& update = firmware[card];
+            update.status = IPMI_FW_UPDATE_GET_FILE_SIZE;
+            update.wait_syncs = FIRMWARE_WAIT_SYNCS;
+            update.image_size = 0;
+            update.window_end = 0;
+            update.image.clear();
+            return IPMI_CC_SUCCESS;
+        }
+        auto it = firmware.find(card);
+        if (it == firmware.end()) {
+            return IPMI_CC_INVALID_COMMAND;
+        }
+        FirmwareUpdate& update = it->second;
+
+        if (cmd == IPMI_FW_UPDATE_SYNC_CMD) {
+            fw_update_sync_res sync;
+            memset(&sync, 0, sizeof(sync));
+            sync.status = update.status;
+            if (update.wait_syncs > 0) {
+                update.wait_syncs--;
+                sync.status = IPMI_FW_UPDATE_WAIT;
+            } else if (update.status == IPMI_FW_UPDATE_GET_FILE_SIZE) {
+                sync.size = sizeof(uint32_t);
+            } else if (update.status == IPMI_FW_UPDATE_READ) {
+                update.window_end = std::min(update.image_size, (uint32_t)update.image.size() + FIRMWARE_WINDOW);
+                sync.offset = update.image.size();
+                sync.size = update.window_end - sync.offset;
+            }
+            res.insert(res.end(), (unsigned char*)&sync + 1, (unsigned char*)&sync + sizeof(sync));
+            return IPMI_CC_SUCCESS;
+        }
+
+        // IPMI_FW_UPDATE_SEND_DATA_CMD
+        if (update.status == IPMI_FW_UPDATE_GET_FILE_SIZE) {
+            if (req_len < sizeof(uint32_t)) {
+                return IPMI_CC_INV_DATA_FIELD_IN_REQ;
+            }
+            memcpy(&update.image_size, req, sizeof(uint32_t));
+            update.status = IPMI_FW_UPDATE_READ;
+            return IPMI_CC_SUCCESS;
+        }
+        if (update.status != IPMI_FW_UPDATE_READ || req_len > IPMI_TRANSFER_SIZE_BIG ||
+            update.image.size() + req_len > update.window_end) {
+            return IPMI_CC_INV_DATA_FIELD_IN_REQ;
+        }
+        update.image.insert(update.image.end(), req, req + req_len);
+        if (update.image.size() == update.image_size) {
+            // verifying and writing the image to the flash
+            update.status = IPMI_FW_UPDATE_COMPLETE;
+            update.wait_syncs = FIRMWARE_WAIT_SYNCS;
+        }
+        return IPMI_CC_SUCCESS;
+    }
+
+    std::vector<unsigned char> sensorRecord(uint16_t id) {
+        struct sdr_record_full_sensor sensor;
+        memset(&sensor, 0, sizeof(sensor));
+        std::string name = "Temp " + std::to_string(id);
+        sensor.cmn.keys.sensor_num = id;
+        sensor.cmn.event_type = 1;
+        sensor.cmn.unit.analog = SDR_UNIT_FMT_UNSIGNED;
+        sensor.cmn.unit.type.base = 1;
+        sensor.mtol = 1;
+        sensor.analog_flag.normal_max = 1;
+        sensor.analog_flag.normal_min = 1;
+        sensor.normal_max = 90;
+        sensor.normal_min = 10;
+        sensor.id_code = 0xc0 | name.size();
+        memcpy(sensor.id_string, name.data(), name.size());
+        std::size_t length = sizeof(sensor) - sizeof(sensor.id_string) + name.size();
+
+        std::vector<unsigned char> record{(unsigned char)(id & 0xff), (unsigned char)(id >> 8), 0x51, SDR_RECORD_TYPE_FULL_SENSOR, (unsigned char)length};
+        record.insert(record.end(), (unsigned char*)&sensor, (unsigned char*)&sensor + length);
+        return record;
+    }
+
+    int cards;
+
+    int sensors;
+
+    std::chrono::microseconds latency;
+
+    std::mutex mutex;
+
+    int timer;
+
+    std::vector<Clock::time_point> busy_until;
+
+    std::multimap<Clock::time_point, Response> responses;
+
+    std::map<int, FirmwareUpdate> firmware;
+
+    uint64_t request_count;
+};
+
+} // namespace xpum
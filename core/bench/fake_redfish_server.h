@@ -0,0 +1,259 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file fake_redfish_server.h
+ */
+
+#pragma once
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace xpum {
+
+/*
+  A Redfish service on 127.0.0.1 answering like a BMC, to run the Redfish
+  client without one. It speaks plain HTTP/1.1 with keep-alive, a thread
+  per connection.
+
+  A response is sent latency after its request, the BMC working on up to
+  concurrency requests at a time. The connections and the requests are
+  counted, so the reuse of the connections by the client shows.
+
+    /redfish/v1/Chassis/Slot_<n>       a chassis with a serial number
+    /redfish/v1/TaskService/Tasks/<n>  a task running for task_polls polls,
+                                       then completed
+*/
+
+class FakeRedfishServer {
+   public:
+    FakeRedfishServer(std::chrono::microseconds latency, int concurrency, int task_polls)
+        : latency(latency),
+          concurrency(std::max(concurrency, 1)),
+          task_polls(task_polls),
+          listen_fd(-1),
+          port(0),
+          stopped(false),
+          busy(0),
+          max_busy(0),
+          connection_count(0),
+          request_count(0) {
+        listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (listen_fd < 0) {
+            return;
+        }
+        struct sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        socklen_t len = sizeof(addr);
+        if (bind(listen_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+            listen(listen_fd, 64) != 0 ||
+            getsockname(listen_fd, (struct sockaddr*)&addr, &len) != 0) {
+            close(listen_fd);
+            listen_fd = -1;
+            return;
+        }
+        port = ntohs(addr.sin_port);
+        acceptor = std::thread(&FakeRedfishServer::acceptConnections, this);
+    }
+
+    ~FakeRedfishServer() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = true;
+            for (auto fd : connection_fds) {
+                shutdown(fd, SHUT_RDWR);
+            }
+        }
+        cond.notify_all();
+        if (listen_fd >= 0) {
+            shutdown(listen_fd, SHUT_RDWR);
+        }
+        if (acceptor.joinable()) {
+            acceptor.join();
+        }
+        for (auto& t : connection_threads) {
+            t.join();
+        }
+        if (listen_fd >= 0) {
+            close(listen_fd);
+        }
+    }
+
+    // empty if the server could not listen
+    std::string baseUrl() const {
+        if (port == 0) {
+            return "";
+        }
+        return "http://127.0.0.1:" + std::to_string(port);
+    }
+
+    uint64_t connections() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return connection_count;
+    }
+
+    uint64_t requests() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return request_count;
+    }
+
+    // the most requests the server was working on at the same time
+    int maxConcurrentRequests() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return max_busy;
+    }
+
+   private:
+    void acceptConnections() {
+        while (true) {
+            int fd = accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (fd < 0 || stopped) {
+                if (fd >= 0) {
+                    close(fd);
+                }
+                if (stopped || (errno != EINTR && errno != ECONNABORTED)) {
+                    return;
+                }
+                continue;
+            }
+            connection_count++;
+            connection_fds.push_back(fd);
+            connection_threads.push_back(std::thread(&FakeRedfishServer::serve, this, fd));
+        }
+    }
+
+    void serve(int fd) {
+        std::string buffer;
+        char chunk[4096];
+        while (true) {
+            std::size_t end = buffer.find("\r\n\r\n");
+            if (end == std::string::npos) {
+                ssize_t n = read(fd, chunk, sizeof(chunk));
+                if (n <= 0) {
+                    break;
+                }
+                buffer.append(chunk, n);
+                continue;
+            }
+            std::string request = buffer.substr(0, end);
+            buffer.erase(0, end + 4);
+            std::string path;
+            std::size_t begin = request.find(' ');
+            if (begin != std::string::npos) {
+                path = request.substr(begin + 1, request.find(' ', begin + 1) - begin - 1);
+            }
+            if (!work()) {
+                break;
+            }
+            std::string response = respond(path);
+            if (write(fd, response.data(), response.size()) != (ssize_t)response.size()) {
+                break;
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        connection_fds.erase(std::remove(connection_fds.begin(), connection_fds.end(), fd), connection_fds.end());
+        close(fd);
+    }
+
+    // takes one of the concurrency slots of the BMC for latency
+    bool work() {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [this]() { return stopped || busy < concurrency; });
+            if (stopped) {
+                return false;
+            }
+            busy++;
+            max_busy = std::max(max_busy, busy);
+            request_count++;
+        }
+        std::this_thread::sleep_for(latency);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busy--;
+        }
+        cond.notify_one();
+        return true;
+    }
+
+    std::string respond(const std::string& path) {
+        static const std::string slot_prefix = "/redfish/v1/Chassis/Slot_";
+        static const std::string task_prefix = "/redfish/v1/TaskService/Tasks/";
+        std::string status = "200 OK";
+        std::string body;
+        if (path.compare(0, slot_prefix.size(), slot_prefix) == 0) {
+            std::string slot = path.substr(slot_prefix.size());
+            body = "{\"Id\":\"Slot_" + slot + "\",\"SerialNumber\":\"BENCH" + slot + "\"}";
+        } else if (path.compare(0, task_prefix.size(), task_prefix) == 0) {
+            std::string task = path.substr(task_prefix.size());
+            int polls;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                polls = ++task_poll_counts[task];
+            }
+            bool completed = polls > task_polls;
+            body = std::string("{\"Id\":\"") + task + "\",\"TaskState\":\"" + (completed ? "Completed" : "Running") +
+                   "\",\"PercentComplete\":" + std::to_string(completed ? 100 : polls * 100 / (task_polls + 1)) + "}";
+        } else {
+            status = "404 Not Found";
+            body = "{}";
+        }
+        return "HTTP/1.1 " + status + "\r\n"
+               "Content-Type: application/json\r\n"
+               "Content-Length: " + std::to_string(body.size()) + "\r\n"
+               "Connection: keep-alive\r\n"
+               "\r\n" + body;
+    }
+
+    std::chrono::microseconds latency;
+
+    int concurrency;
+
+    int task_polls;
+
+    int listen_fd;
+
+    uint16_t port;
+
+    std::thread acceptor;
+
+    std::mutex mutex;
+
+    std::condition_variable cond;
+
+    bool stopped;
+
+    int busy;
+
+    int max_busy;
+
+    uint64_t connection_count;
+
+    uint64_t request_count;
+
+    std::vector<int> connection_fds;
+
+    std::vector<std::thread> connection_threads;
+
+    std::map<std::string, int> task_poll_counts;
+};
+
+} // namespace xpum
@@ -0,0 +1,127 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file ipmi_sweep.cpp
+ */
+
+#include "ipmi_sweep.h"
+
+#include <time.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+#include "fake_ipmi_device.h"
+#include "ipmi/ipmi.h"
+#include "ipmi/tool.h"
+
+namespace xpum {
+
+typedef std::chrono::steady_clock Clock;
+
+static double elapsedSeconds(Clock::time_point begin) {
+    return std::chrono::duration<double>(Clock::now() - begin).count();
+}
+
+static double threadCpuSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+  read_sensor() of the AMC manager on a fake BMC. The first sweep also
+  discovers the cards and reads their SDRs. The responses are waited for
+  in the calling thread, so its CPU time is the cost of the transport.
+*/
+
+std::vector<std::pair<std::string, double>> ipmiSweep(const IpmiSweepOptions& options) {
+    auto device = new FakeIpmiDevice(options.cards, options.sensors, std::chrono::microseconds(options.latency_us), options.concurrency);
+    ipmi_set_channel(std::make_shared<IpmiChannel>(std::unique_ptr<IpmiDevice>(device)));
+    clean_data();
+
+    auto begin = Clock::now();
+    std::size_t readings = read_sensor().size();
+    double discovery_ms = elapsedSeconds(begin) * 1e3;
+
+    std::vector<double> sweeps;
+    uint64_t requests = device->requests();
+    double cpu = threadCpuSeconds();
+    begin = Clock::now();
+    for (uint32_t i = 0; i < options.sweeps; i++) {
+        auto sweep_begin = Clock::now();
+        read_sensor();
+        sweeps.push_back(elapsedSeconds(sweep_begin) * 1e3);
+    }
+    double seconds = elapsedSeconds(begin);
+    cpu = threadCpuSeconds() - cpu;
+    requests = device->requests() - requests;
+
+    clean_data();
+    ipmi_set_channel(nullptr);
+
+    std::sort(sweeps.begin(), sweeps.end());
+    std::vector<std::pair<std::string, double>> result;
+    result.emplace_back("readings", readings);
+    result.emplace_back("discovery_ms", discovery_ms);
+    if (!sweeps.empty()) {
+        result.emplace_back("sweep_ms_p50", sweeps[sweeps.size() / 2]);
+        result.emplace_back("sweep_ms_max", sweeps.back());
+    }
+    result.emplace_back("requests_per_second", seconds > 0 ? requests / seconds : 0);
+    result.emplace_back("cpu_us_per_request", requests > 0 ? cpu / requests * 1e6 : 0);
+    return result;
+}
+
+/*
+  The firmware image transfer of fw_update_cards on a fake BMC, to all
+  the cards together and then one card after the other. The images the
+  cards received are compared with the one sent.
+*/
+
+std::vector<std::pair<std::string, double>> amcFlash(const AmcFlashOptions& options) {
+    auto device = new FakeIpmiDevice(options.cards, 0, std::chrono::microseconds(options.latency_us), options.concurrency);
+    ipmi_set_channel(std::make_shared<IpmiChannel>(std::unique_ptr<IpmiDevice>(device)));
+    clean_data();
+
+    std::vector<unsigned char> image(options.image_kb * 1024);
+    for (std::size_t i = 0; i < image.size(); i++) {
+        image[i] = (i * 131) >> 3;
+    }
+
+    std::vector<std::pair<std::string, double>> result;
+    std::unique_ptr<nrv_list> cards(new nrv_list());
+    if (get_card_list(cards.get(), CARD_SELECT_ALL) == NRV_SUCCESS) {
+        std::vector<nrv_card*> all;
+        for (int i = 0; i < cards->count; i++) {
+            all.push_back(&cards->card[i]);
+        }
+
+        auto begin = Clock::now();
+        int err = fw_update_cards(all.data(), all.size(), image.data(), image.size(), FW_UPDATE_TYPE_BSMC);
+        double concurrent_s = elapsedSeconds(begin);
+        int verified = 0;
+        for (int i = 0; i < cards->count; i++) {
+            verified += device->firmwareImage(cards->card[i].ipmi_address.slot) == image;
+        }
+
+        begin = Clock::now();
+        for (auto card : all) {
+            err |= fw_update_cards(&card, 1, image.data(), image.size(), FW_UPDATE_TYPE_BSMC);
+        }
+        double one_by_one_s = elapsedSeconds(begin);
+
+        result.emplace_back("cards", cards->count);
+        result.emplace_back("images_verified", err ? 0 : verified);
+        result.emplace_back("flash_ms", concurrent_s * 1e3);
+        result.emplace_back("flash_ms_one_by_one", one_by_one_s * 1e3);
+        result.emplace_back("bytes_per_second", concurrent_s > 0 ? image.size() * all.size() / concurrent_s : 0);
+    }
+
+    clean_data();
+    ipmi_set_channel(nullptr);
+    return result;
+}
+
+} // namespace xpum
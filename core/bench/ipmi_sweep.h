@@ -0,0 +1,39 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file ipmi_sweep.h
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace xpum {
+
+struct IpmiSweepOptions {
+    uint32_t cards;
+    uint32_t sensors;
+    uint32_t latency_us;
+    uint32_t concurrency;
+    uint32_t sweeps;
+};
+
+struct AmcFlashOptions {
+    uint32_t cards;
+    uint32_t image_kb;
+    uint32_t latency_us;
+    uint32_t concurrency;
+};
+
+/*
+  The IPMI code is built apart from the rest of the benchmark, both
+  declaring an xpum::pci_address_t.
+*/
+std::vector<std::pair<std::string, double>> ipmiSweep(const IpmiSweepOptions& options);
+
+std::vector<std::pair<std::string, double>> amcFlash(const AmcFlashOptions& options);
+
+} // namespace xpum
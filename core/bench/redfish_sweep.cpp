@@ -0,0 +1,94 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file redfish_sweep.cpp
+ */
+
+#include "redfish_sweep.h"
+
+#include <chrono>
+
+#include "fake_redfish_server.h"
+#include "redfish/redfish_client.h"
+
+namespace xpum {
+
+typedef std::chrono::steady_clock Clock;
+
+static double elapsedSeconds(Clock::time_point begin) {
+    return std::chrono::duration<double>(Clock::now() - begin).count();
+}
+
+/*
+  The slot queries of the SMC manager on a fake BMC: one GET after the
+  other, then all of them through getAll(), which is repeated to show that
+  the later sweeps reuse the connections of the first one. Last a task is
+  polled with the Backoff of the managers until it completes.
+*/
+
+std::vector<std::pair<std::string, double>> redfishSweep(const RedfishSweepOptions& options) {
+    std::vector<std::pair<std::string, double>> result;
+    FakeRedfishServer server(std::chrono::microseconds(options.latency_us), options.concurrency, options.task_polls);
+    if (server.baseUrl().empty()) {
+        return result;
+    }
+    RedfishClient::reset();
+    RedfishClient client(server.baseUrl(), "bench", "bench");
+    std::vector<std::string> paths;
+    for (uint32_t i = 0; i < options.slots; i++) {
+        paths.push_back("/redfish/v1/Chassis/Slot_" + std::to_string(i));
+    }
+
+    uint32_t failed = 0;
+    auto begin = Clock::now();
+    for (auto& path : paths) {
+        failed += client.get(path).status != 200;
+    }
+    double sequential_ms = elapsedSeconds(begin) * 1e3;
+
+    begin = Clock::now();
+    for (auto& response : client.getAll(paths)) {
+        failed += response.status != 200;
+    }
+    double concurrent_ms = elapsedSeconds(begin) * 1e3;
+
+    uint64_t connections = server.connections();
+    uint64_t requests = server.requests();
+    begin = Clock::now();
+    for (uint32_t i = 0; i < options.sweeps; i++) {
+        for (auto& response : client.getAll(paths)) {
+            failed += response.status != 200;
+        }
+    }
+    double sweeps_s = elapsedSeconds(begin);
+    connections = server.connections() - connections;
+    requests = server.requests() - requests;
+
+    uint32_t polls = 0;
+    Backoff backoff(std::chrono::milliseconds(500), std::chrono::milliseconds(5000));
+    begin = Clock::now();
+    while (true) {
+        polls++;
+        RedfishResponse response = client.get("/redfish/v1/TaskService/Tasks/1");
+        if (response.status != 200 || response.body.find("\"Completed\"") != std::string::npos) {
+            break;
+        }
+        backoff.wait();
+    }
+    double task_ms = elapsedSeconds(begin) * 1e3;
+
+    result.emplace_back("slots", options.slots);
+    result.emplace_back("failed_requests", failed);
+    result.emplace_back("sequential_ms", sequential_ms);
+    result.emplace_back("concurrent_ms", concurrent_ms);
+    result.emplace_back("max_concurrent_requests", server.maxConcurrentRequests());
+    result.emplace_back("sweep_ms", options.sweeps > 0 ? sweeps_s / options.sweeps * 1e3 : 0);
+    result.emplace_back("new_connections_per_request", requests > 0 ? (double)connections / requests : 0);
+    result.emplace_back("task_polls", polls);
+    result.emplace_back("task_ms", task_ms);
+
+    RedfishClient::reset();
+    return result;
+}
+
+} // namespace xpum
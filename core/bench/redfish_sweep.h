@@ -0,0 +1,26 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file redfish_sweep.h
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace xpum {
+
+struct RedfishSweepOptions {
+    uint32_t slots;
+    uint32_t latency_us;
+    uint32_t concurrency;
+    uint32_t sweeps;
+    uint32_t task_polls;
+};
+
+std::vector<std::pair<std::string, double>> redfishSweep(const RedfishSweepOptions& options);
+
+} // namespace xpum
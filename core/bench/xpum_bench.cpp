@@ -0,0 +1,497 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file xpum_bench.cpp
+ */
+
+/*
+  Benchmarks of the telemetry hot paths, run against simulated devices so
+  that the numbers can be compared between machines and releases:
+
+    pipeline      monitor tasks -> data logic -> event bus, samples per
+                  second and scheduler skew of the sampling streams
+    query         latency percentiles of xpumGetStats and
+                  xpumGetRealtimeMetrics
+    ingest        storeMeasurementData in a tight loop, samples per second
+                  and heap allocations per sample
+    log_overhead  the ingest loop with the log level at INFO and at DEBUG
+    precheck_scan the kernel log scan of precheck on a synthetic log, full
+                  and incremental
+    ipmi_sweep    AMC sensor sweeps through the IPMI channel on a fake BMC,
+                  sweep latency and CPU time per IPMI request
+    amc_flash     AMC firmware image transfer to the cards of the fake BMC,
+                  all cards together and one after the other
+    redfish_sweep slot queries of a fake Redfish BMC, one after the other
+                  and concurrent, connection reuse and task polling
+
+  Usage: xpum_bench [--devices N] [--tiles N] [--latency-us N] [--duration S]
+                    [--queries N] [--samples N] [--log-lines N]
+                    [--amc-cards N] [--amc-sensors N] [--bmc-latency-us N]
+                    [--bmc-concurrency N] [--sweeps N] [--amc-image-kb N]
+                    [--task-polls N] [--filter NAME] [--json FILE]
+*/
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "core/core.h"
+#include "diagnostic/precheck.h"
+#include "infrastructure/logger.h"
+#include "infrastructure/utility.h"
+#include "infrastructure/version.h"
+#include "ipmi_sweep.h"
+#include "redfish_sweep.h"
+#include "spdlog/sinks/null_sink.h"
+#include "spdlog/spdlog.h"
+#include "xpum_api.h"
+
+using namespace xpum;
+
+// per thread, so that the monitor tasks sampling in the background do not
+// add to the allocations of the benchmark loop
+static thread_local uint64_t allocation_count = 0;
+
+void* operator new(std::size_t size) {
+    allocation_count++;
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+struct Options {
+    uint32_t devices = 8;
+    uint32_t tiles = 2;
+    uint32_t latency_us = 0;
+    uint32_t duration = 10;
+    uint32_t queries = 2000;
+    uint32_t samples = 200000;
+    uint32_t log_lines = 1000000;
+    uint32_t amc_cards = 8;
+    uint32_t amc_sensors = 32;
+    uint32_t bmc_latency_us = 2000;
+    uint32_t bmc_concurrency = 4;
+    uint32_t sweeps = 20;
+    uint32_t amc_image_kb = 64;
+    uint32_t task_polls = 2;
+    std::string filter;
+    std::string json_file;
+};
+
+typedef std::vector<std::pair<std::string, double>> Result;
+
+typedef std::chrono::steady_clock Clock;
+
+double elapsedSeconds(Clock::time_point begin) {
+    return std::chrono::duration<double>(Clock::now() - begin).count();
+}
+
+double percentile(std::vector<double> values, double p) {
+    if (values.empty()) {
+        return 0;
+    }
+    std::size_t rank = std::min(values.size() - 1, (std::size_t)(p / 100 * values.size()));
+    std::nth_element(values.begin(), values.begin() + rank, values.end());
+    return values[rank];
+}
+
+void addPercentiles(Result& result, const std::string& prefix, const std::vector<double>& values) {
+    result.emplace_back(prefix + "_p50", percentile(values, 50));
+    result.emplace_back(prefix + "_p90", percentile(values, 90));
+    result.emplace_back(prefix + "_p99", percentile(values, 99));
+    result.emplace_back(prefix + "_max", values.empty() ? 0 : *std::max_element(values.begin(), values.end()));
+}
+
+std::vector<xpum_device_id_t> deviceIds() {
+    std::vector<xpum_device_id_t> ids;
+    xpum_device_basic_info devices[XPUM_MAX_NUM_DEVICES];
+    int count = XPUM_MAX_NUM_DEVICES;
+    if (xpumGetDeviceList(devices, &count) == XPUM_OK) {
+        for (int i = 0; i < count; i++) {
+            ids.push_back(devices[i].deviceId);
+        }
+    }
+    return ids;
+}
+
+/*
+  Every (device, metric) pair is a stream sampled by its monitor task at a
+  fixed period. The skew of a sample is how far its interval from the
+  previous sample of the stream is off the median interval of the stream.
+*/
+
+Result benchPipeline(const Options& options) {
+    typedef std::pair<std::string, MeasurementType> Stream;
+    std::mutex mutex;
+    std::map<Stream, std::vector<Timestamp_t>> streams;
+    uint64_t events = 0;
+    uint64_t dropped = 0;
+
+    auto p_event_bus = Core::instance().getDataLogic()->getEventBus();
+    uint32_t subscription_id = p_event_bus->subscribe(EventFilter(), [&](std::vector<MeasurementEvent>& batch, uint64_t batch_dropped) {
+        std::unique_lock<std::mutex> lock(mutex);
+        events += batch.size();
+        dropped += batch_dropped;
+        for (auto& event : batch) {
+            streams[Stream(event.device_id, event.type)].push_back(event.time);
+        }
+    });
+    auto begin = Clock::now();
+    std::this_thread::sleep_for(std::chrono::seconds(options.duration));
+    p_event_bus->unsubscribe(subscription_id);
+    double seconds = elapsedSeconds(begin);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    std::vector<double> skews;
+    for (auto& stream : streams) {
+        auto& times = stream.second;
+        if (times.size() < 3) {
+            continue;
+        }
+        std::vector<double> intervals;
+        for (std::size_t i = 1; i < times.size(); i++) {
+            intervals.push_back(times[i] - times[i - 1]);
+        }
+        double median = percentile(intervals, 50);
+        for (double interval : intervals) {
+            skews.push_back(std::abs(interval - median));
+        }
+    }
+    Result result;
+    result.emplace_back("samples_per_second", events / seconds);
+    result.emplace_back("streams", streams.size());
+    result.emplace_back("dropped", dropped);
+    addPercentiles(result, "skew_ms", skews);
+    return result;
+}
+
+Result benchQuery(const Options& options) {
+    Result result;
+    auto ids = deviceIds();
+    if (ids.empty()) {
+        return result;
+    }
+    std::vector<double> stats_latencies;
+    std::vector<double> metrics_latencies;
+    std::vector<xpum_device_stats_t> stats(options.tiles + 1);
+    std::vector<xpum_device_realtime_metrics_t> metrics(options.tiles + 1);
+    for (uint32_t i = 0; i < options.queries; i++) {
+        xpum_device_id_t id = ids[i % ids.size()];
+        uint32_t count = stats.size();
+        uint64_t begin_time, end_time;
+        auto begin = Clock::now();
+        xpumGetStats(id, stats.data(), &count, &begin_time, &end_time, 0);
+        stats_latencies.push_back(elapsedSeconds(begin) * 1e6);
+
+        count = metrics.size();
+        begin = Clock::now();
+        xpumGetRealtimeMetrics(id, metrics.data(), &count);
+        metrics_latencies.push_back(elapsedSeconds(begin) * 1e6);
+    }
+    addPercentiles(result, "get_stats_us", stats_latencies);
+    addPercentiles(result, "get_realtime_metrics_us", metrics_latencies);
+    return result;
+}
+
+/*
+  Stores samples shaped like the ones of the monitor tasks: one map per
+  metric holding every device, with a value per tile. The allocations made
+  to build the maps are measured separately and not charged to the data
+  logic.
+*/
+
+const MeasurementType ingest_types[] = {
+    METRIC_POWER,
+    METRIC_FREQUENCY,
+    METRIC_TEMPERATURE,
+    METRIC_MEMORY_USED,
+    METRIC_MEMORY_UTILIZATION,
+    METRIC_COMPUTATION,
+};
+
+std::shared_ptr<std::map<std::string, std::shared_ptr<MeasurementData>>> buildSamples(const Options& options, uint64_t value) {
+    auto datas = std::make_shared<std::map<std::string, std::shared_ptr<MeasurementData>>>();
+    for (uint32_t device = 0; device < options.devices; device++) {
+        auto p_data = std::make_shared<MeasurementData>();
+        p_data->setCurrent(value);
+        for (uint32_t tile = 0; tile < options.tiles; tile++) {
+            p_data->setSubdeviceDataCurrent(tile, value);
+        }
+        (*datas)[std::to_string(device)] = p_data;
+    }
+    return datas;
+}
+
+Result benchIngest(const Options& options) {
+    auto p_data_logic = Core::instance().getDataLogic();
+    const uint32_t type_count = sizeof(ingest_types) / sizeof(ingest_types[0]);
+    uint32_t rounds = std::max(1u, options.samples / std::max(1u, options.devices));
+
+    uint64_t build_allocations = allocation_count;
+    for (uint32_t i = 0; i < rounds; i++) {
+        buildSamples(options, i);
+    }
+    build_allocations = allocation_count - build_allocations;
+
+    uint64_t allocations = allocation_count;
+    auto begin = Clock::now();
+    for (uint32_t i = 0; i < rounds; i++) {
+        Timestamp_t time = Utility::getCurrentMillisecond();
+        p_data_logic->storeMeasurementData(ingest_types[i % type_count], time, buildSamples(options, i));
+    }
+    double seconds = elapsedSeconds(begin);
+    allocations = allocation_count - allocations;
+
+    uint64_t samples = (uint64_t)rounds * options.devices;
+    Result result;
+    result.emplace_back("samples_per_second", samples / seconds);
+    result.emplace_back("allocations_per_sample", (double)(allocations - std::min(allocations, build_allocations)) / samples);
+    return result;
+}
+
+Result benchLogOverhead(const Options& options) {
+    Result result;
+    auto previous_logger = spdlog::default_logger();
+    auto previous_level = spdlog::get_level();
+    // formatting is what is measured, not the terminal
+    spdlog::set_default_logger(std::make_shared<spdlog::logger>("bench", std::make_shared<spdlog::sinks::null_sink_mt>()));
+
+    spdlog::set_level(spdlog::level::info);
+    double info = benchIngest(options)[0].second;
+    spdlog::set_level(spdlog::level::debug);
+    double debug = benchIngest(options)[0].second;
+
+    spdlog::set_default_logger(previous_logger);
+    spdlog::set_level(previous_level);
+    result.emplace_back("samples_per_second_info", info);
+    result.emplace_back("samples_per_second_debug", debug);
+    result.emplace_back("debug_slowdown", debug > 0 ? info / debug : 0);
+    return result;
+}
+
+/*
+  A dmesg like log where one line in a thousand mentions a targeted word
+  and one in ten thousand is an actual i915 error.
+*/
+
+std::string writeSyntheticLog(uint32_t lines) {
+    char path[] = "/tmp/xpum_bench_log_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        return "";
+    }
+    close(fd);
+    std::ofstream ofs(path);
+    char line[256];
+    for (uint32_t i = 0; i < lines; i++) {
+        const char* message;
+        if (i % 10000 == 9999) {
+            message = "i915 0000:4d:00.0: [drm] *ERROR* GT0: GUC: Engine reset failed";
+        } else if (i % 1000 == 999) {
+            message = "i915 0000:4d:00.0: [drm] GT0: GuC firmware i915/pvc_guc_70.bin version 70.5.1";
+        } else {
+            message = "pcieport 0000:00:01.0: PME: Signaling with IRQ 25 on a quiet bus";
+        }
+        snprintf(line, sizeof(line), "2026-01-01T00:%02u:%02u,%06u+00:00 node kernel: %s\n", (i / 60) % 60, i % 60, i % 1000000, message);
+        ofs << line;
+    }
+    return path;
+}
+
+Result benchPrecheckScan(const Options& options) {
+    Result result;
+    std::string path = writeSyntheticLog(options.log_lines);
+    if (path.empty()) {
+        return result;
+    }
+    std::vector<double> full;
+    std::vector<double> incremental;
+    for (int i = 0; i < 3; i++) {
+        // a new path starts a fresh scan state
+        std::string copy = path + "." + std::to_string(i);
+        if (link(path.c_str(), copy.c_str()) != 0) {
+            continue;
+        }
+        auto begin = Clock::now();
+        PrecheckManager::scanLogFile(copy);
+        full.push_back(elapsedSeconds(begin) * 1e3);
+        begin = Clock::now();
+        PrecheckManager::scanLogFile(copy);
+        incremental.push_back(elapsedSeconds(begin) * 1e3);
+        unlink(copy.c_str());
+    }
+    unlink(path.c_str());
+    double full_ms = percentile(full, 50);
+    result.emplace_back("full_scan_ms", full_ms);
+    result.emplace_back("incremental_scan_ms", percentile(incremental, 50));
+    result.emplace_back("lines_per_second", full_ms > 0 ? options.log_lines / full_ms * 1e3 : 0);
+    return result;
+}
+
+Result benchIpmiSweep(const Options& options) {
+    IpmiSweepOptions sweep_options;
+    sweep_options.cards = options.amc_cards;
+    sweep_options.sensors = options.amc_sensors;
+    sweep_options.latency_us = options.bmc_latency_us;
+    sweep_options.concurrency = options.bmc_concurrency;
+    sweep_options.sweeps = options.sweeps;
+    return ipmiSweep(sweep_options);
+}
+
+Result benchAmcFlash(const Options& options) {
+    AmcFlashOptions flash_options;
+    flash_options.cards = options.amc_cards;
+    flash_options.image_kb = options.amc_image_kb;
+    flash_options.latency_us = options.bmc_latency_us;
+    flash_options.concurrency = options.bmc_concurrency;
+    return amcFlash(flash_options);
+}
+
+Result benchRedfishSweep(const Options& options) {
+    RedfishSweepOptions sweep_options;
+    sweep_options.slots = options.amc_cards;
+    sweep_options.latency_us = options.bmc_latency_us;
+    sweep_options.concurrency = options.bmc_concurrency;
+    sweep_options.sweeps = options.sweeps;
+    sweep_options.task_polls = options.task_polls;
+    return redfishSweep(sweep_options);
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    std::map<std::string, uint32_t*> numbers = {
+        {"--devices", &options.devices},
+        {"--tiles", &options.tiles},
+        {"--latency-us", &options.latency_us},
+        {"--duration", &options.duration},
+        {"--queries", &options.queries},
+        {"--samples", &options.samples},
+        {"--log-lines", &options.log_lines},
+        {"--amc-cards", &options.amc_cards},
+        {"--amc-sensors", &options.amc_sensors},
+        {"--bmc-latency-us", &options.bmc_latency_us},
+        {"--bmc-concurrency", &options.bmc_concurrency},
+        {"--sweeps", &options.sweeps},
+        {"--amc-image-kb", &options.amc_image_kb},
+        {"--task-polls", &options.task_polls},
+    };
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            fprintf(stderr, "Missing value of %s\n", arg.c_str());
+            return false;
+        }
+        std::string value = argv[++i];
+        if (arg == "--filter") {
+            options.filter = value;
+        } else if (arg == "--json") {
+            options.json_file = value;
+        } else if (numbers.count(arg) > 0) {
+            try {
+                *numbers[arg] = std::stoul(value);
+            } catch (std::exception&) {
+                fprintf(stderr, "Invalid value of %s: %s\n", arg.c_str(), value.c_str());
+                return false;
+            }
+        } else {
+            fprintf(stderr, "Unknown option %s\n", arg.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+    setenv("XPUM_SIMULATED_DEVICES", std::to_string(options.devices).c_str(), 1);
+    setenv("XPUM_SIMULATED_TILES", std::to_string(options.tiles).c_str(), 1);
+    setenv("XPUM_SIMULATED_LATENCY_US", std::to_string(options.latency_us).c_str(), 1);
+    if (getenv("SPDLOG_LEVEL") == nullptr) {
+        setenv("SPDLOG_LEVEL", "warn", 1);
+    }
+    if (xpumInit() != XPUM_OK) {
+        fprintf(stderr, "Failed to initialize xpum\n");
+        return 1;
+    }
+
+    std::vector<std::pair<std::string, Result (*)(const Options&)>> benchmarks = {
+        {"pipeline", benchPipeline},
+        {"query", benchQuery},
+        {"ingest", benchIngest},
+        {"log_overhead", benchLogOverhead},
+        {"precheck_scan", benchPrecheckScan},
+        {"ipmi_sweep", benchIpmiSweep},
+        {"amc_flash", benchAmcFlash},
+        {"redfish_sweep", benchRedfishSweep},
+    };
+    nlohmann::json report;
+    report["version"] = Version::getVersion();
+    report["devices"] = options.devices;
+    report["tiles"] = options.tiles;
+    report["latency_us"] = options.latency_us;
+    for (auto& benchmark : benchmarks) {
+        if (!options.filter.empty() && benchmark.first.find(options.filter) == std::string::npos) {
+            continue;
+        }
+        Result result = benchmark.second(options);
+        for (auto& metric : result) {
+            printf("%-16s %-32s %14.3f\n", benchmark.first.c_str(), metric.first.c_str(), metric.second);
+            report["benchmarks"][benchmark.first][metric.first] = metric.second;
+        }
+    }
+    xpumShutdown();
+
+    if (!options.json_file.empty()) {
+        std::ofstream ofs(options.json_file);
+        ofs << report.dump(4) << std::endl;
+        if (!ofs) {
+            fprintf(stderr, "Failed to write %s\n", options.json_file.c_str());
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -621,6 +621,19 @@ XPUM_API xpum_result_t xpumApplyPPR(xpum_device_id_t deviceId, xpum_diag_result_
  */
 XPUM_API xpum_result_t xpumResetDevice(xpum_device_id_t deviceId, bool force);
 
+/**
+ * @brief Get the statistics of the operation lock of the device
+ * @details Firmware flash, reset and PPR lock the device for themselves, the telemetry of the device is paused meanwhile. An AMC firmware flash locks the devices against these operations only.
+ *
+ * @param deviceId          IN: The device Id
+ * @param stats             OUT: The lock statistics of the device
+ * @return xpum_result_t
+ *      - \ref XPUM_OK                       if query successfully
+ *      - \ref XPUM_RESULT_DEVICE_NOT_FOUND  if the device is not found
+ * @note Support Platform: Linux
+ */
+XPUM_API xpum_result_t xpumGetDeviceOperationStats(xpum_device_id_t deviceId, xpum_device_operation_stats_t* stats);
+
 /**
  * @brief Get the GPU function component occupancy ratio of the device
  * @details This function is used to get the gpu function component occupancy ratio of the device
@@ -1243,6 +1256,24 @@ XPUM_API xpum_result_t xpumGetStatsByGroup(xpum_group_id_t groupId,
                                   uint64_t *begin,
                                   uint64_t *end,
                                   uint64_t sessionId);
+
+/**
+ * @brief Get the aggregates of the latest metric values over the devices of a group
+ * 
+ * The aggregates are maintained by the core as samples are collected, so the cost of this call does not depend on the number of devices in the group. Only gauge metrics with device level data are aggregated, counters are not. A device whose metric was not sampled for three intervals of the metric is left out.
+ * 
+ * @param groupId       IN: Group id
+ * @param dataList     OUT: The array to store one aggregate per metric type. First pass NULL to query the number of aggregates. Then pass array with desired length to store the aggregates.
+ * @param count     IN/OUT: When \a dataList is NULL, \a count will be filled with the number of available entries, and return. When \a dataList is not NULL, \a count denotes the length of \a dataList, \a count should be equal to or larger than the number of available entries, when return, the \a count will store real number of entries returned by \a dataList
+ * @return xpum_result_t 
+ *      - \ref XPUM_OK                      if query successfully
+ *      - \ref XPUM_RESULT_GROUP_NOT_FOUND  if \a groupId is invalid
+ *      - \ref XPUM_BUFFER_TOO_SMALL        if \a count is smaller than needed
+ * @note Support Platform: Linux
+ */
+XPUM_API xpum_result_t xpumGetStatsAggregateByGroup(xpum_group_id_t groupId,
+                                           xpum_group_stats_data_t dataList[],
+                                           uint32_t *count);
 /// @endcond                                  
 
 /** @} */ // Closing for STATISTICS_API
@@ -1556,6 +1587,23 @@ XPUM_API xpum_result_t xpumGetRealtimeMetrics(xpum_device_id_t deviceId, xpum_de
  */
 XPUM_API xpum_result_t xpumGetRealtimeMetricsEx(xpum_device_id_t deviceIdList[], uint32_t deviceCount, xpum_device_realtime_metrics_t dataList[], uint32_t* count);
 
+ /**
+  * @brief Get selected realtime metrics (not including per engine utilization) of a device list in one pass
+  *
+  * @param deviceIdList      IN: Device id list
+  * @param deviceCount       IN: Device id count
+  * @param metricsTypeList   IN: Metric types to return, NULL to return all enabled metric types
+  * @param metricsTypeCount  IN: Count of \a metricsTypeList
+  * @param dataList         OUT: The array to store realtime metrics, one entry per device followed by one entry per tile of that device. First pass NULL to query the needed length, no metric data is read in this case. Then pass array with desired length to store realtime metrics.
+  * @param count         IN/OUT: When \a dataList is NULL, \a count will be filled with the number of entries needed, and return. When \a dataList is not NULL, \a count denotes the length of \a dataList, when return, the \a count will store real number of entries returned by \a dataList
+  * @return xpum_result_t
+  *      - \ref XPUM_OK                       if query successfully
+  *      - \ref XPUM_RESULT_DEVICE_NOT_FOUND  if a device in \a deviceIdList is not found
+  *      - \ref XPUM_BUFFER_TOO_SMALL         if \a count is smaller than needed
+  * @note Support Platform: Linux
+ */
+XPUM_API xpum_result_t xpumGetRealtimeMetricsBatch(xpum_device_id_t deviceIdList[], uint32_t deviceCount, xpum_realtime_metric_type_t metricsTypeList[], uint32_t metricsTypeCount, xpum_device_realtime_metrics_t dataList[], uint32_t* count);
+
 /** @} */ // Closing for REALTIME_METRIC_API
 
 #if defined(__cplusplus)
@@ -472,6 +472,11 @@ typedef struct xpum_diag_component_info_t {
     bool finished;
     xpum_diag_task_result_t result;
     char message[XPUM_MAX_STR_LENGTH];
+    uint64_t setupTime;          ///< Setup time of the last run in milliseconds, 0 if not measured
+    uint64_t runTime;            ///< Run time of the last run in milliseconds, 0 if not measured
+    uint64_t cleanupTime;        ///< Cleanup time of the last run in milliseconds, 0 if not measured
+    uint64_t startTime;          ///< Start time of the component in milliseconds since epoch
+    uint64_t endTime;            ///< End time of the component in milliseconds since epoch
 } xpum_diag_component_info_t;
 
 typedef struct xpum_diag_task_info_t {
@@ -529,7 +534,8 @@ typedef struct xpum_diag_xe_link_throughput_t {
  * 
  */
 typedef enum xpum_agent_config_enum {
-    XPUM_AGENT_CONFIG_SAMPLE_INTERVAL = 0 ///< Agent sample interval, in milliseconds, options are [100, 200, 500, 1000], default is 1000. Value type in xpumSetAgentConfig is int64_t
+    XPUM_AGENT_CONFIG_SAMPLE_INTERVAL = 0, ///< Agent sample interval, in milliseconds, options are [100, 200, 500, 1000], default is 1000. Value type in xpumSetAgentConfig is int64_t
+    XPUM_AGENT_CONFIG_METRIC_INTERVAL = 1  ///< Sample interval of one metric, in milliseconds, at least 5, or 0 to sample it at the agent sample interval. Value type is xpum_agent_metric_interval_t, xpumGetAgentConfig fills the interval of the given metricsType
 } xpum_agent_config_t;
 
 /**************************************************************************/
@@ -586,6 +592,15 @@ typedef enum xpum_stats_type_enum {
     XPUM_STATS_MAX
 } xpum_stats_type_t;
 
+/**
+ * @brief Value of the agent config XPUM_AGENT_CONFIG_METRIC_INTERVAL
+ * 
+ */
+typedef struct xpum_agent_metric_interval_t {
+    xpum_stats_type_t metricsType; ///< Metric type
+    int64_t interval;              ///< Sample interval in milliseconds, 0 for the agent sample interval
+} xpum_agent_metric_interval_t;
+
 /**
  * @brief Struct to store statistics data for different metric types
  * 
@@ -613,6 +628,24 @@ typedef struct xpum_device_stats_t {
     xpum_device_stats_data_t dataList[XPUM_STATS_MAX];
 } xpum_device_stats_t;
 
+/**
+ * @brief Struct to store the aggregate of one metric over the devices of a group
+ * 
+ */
+typedef struct xpum_group_stats_data_t {
+    xpum_stats_type_t metricsType; ///< Metric type
+    uint32_t deviceCount;          ///< The count of devices in the group which reported this metric
+    uint64_t timestamp;            ///< Timestamp in milliseconds of the latest sample included in the aggregate
+    uint64_t sum;                  ///< The sum of the latest values of the devices
+    uint64_t avg;                  ///< The average of the latest values of the devices
+    uint64_t min;                  ///< The min of the latest values of the devices
+    uint64_t max;                  ///< The max of the latest values of the devices
+    uint64_t p50;                  ///< The estimated median of the latest values of the devices
+    uint64_t p90;                  ///< The estimated 90th percentile of the latest values of the devices
+    uint64_t p99;                  ///< The estimated 99th percentile of the latest values of the devices
+    uint32_t scale;                ///< The magnification of the sum, avg, min, max and percentile fields
+} xpum_group_stats_data_t;
+
 /**
  * @brief Engine types
  * 
@@ -1239,6 +1272,19 @@ typedef struct xpum_precheck_component_info_t {
     char errorDetail[XPUM_MAX_STR_LENGTH];
 } xpum_precheck_component_info_t;
 
+/**
+ * Statistics of the operation lock of a device
+ */
+typedef struct xpum_device_operation_stats_t {
+    xpum_device_id_t deviceId;          ///< Device id
+    bool locked;                        ///< A firmware flash, reset or PPR is running
+    uint64_t pausedReads;               ///< Telemetry reads skipped while the device was locked
+    uint64_t operationCount;            ///< Operations that got the lock
+    uint64_t refusedOperationCount;     ///< Operations that did not get the lock in time
+    uint64_t waitTime;                  ///< Total time the operations waited for the lock, in microseconds
+    uint64_t maxWaitTime;               ///< Longest time an operation waited for the lock, in microseconds
+} xpum_device_operation_stats_t;
+
 #if defined(__cplusplus)
 } // extern "C"
 } // end namespace xpum
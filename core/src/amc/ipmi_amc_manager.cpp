@@ -14,10 +14,12 @@
 
 namespace xpum {
 
-static void percent_callback(uint32_t percent, void* pAmcManager) {
+static void percent_callback(uint32_t percent, uint32_t bytes_per_second, void* pAmcManager) {
     IpmiAmcManager* p = (IpmiAmcManager*)pAmcManager;
-    if (p->percent.load() < (int)percent)
+    if (p->percent.load() < (int)percent) {
         p->percent.store(percent);
+        XPUM_LOG_DEBUG("AMC firmware update {}%, {} bytes/s", percent, bytes_per_second);
+    }
 }
 
 bool IpmiAmcManager::preInit(){
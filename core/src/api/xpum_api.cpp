@@ -7,6 +7,8 @@
 #include "xpum_api.h"
 
 #include <algorithm>
+#include <chrono>
+#include <climits>
 #include <string>
 #include <cstring>
 #include <fstream>
@@ -1121,7 +1123,7 @@ xpum_result_t xpumGetStats(xpum_device_id_t deviceId,
 
     char* env = std::getenv("XPUM_DISABLE_PERIODIC_METRIC_MONITOR");
     std::string xpum_disable_periodic_metric_monitor{env != NULL ? env : ""};
-    if (xpum_disable_periodic_metric_monitor == "1") {
+    if (xpum_disable_periodic_metric_monitor == "1" && dataList != nullptr) {
         if (!Core::instance().getMonitorManager()->initOneTimeMetricMonitorTasks(MeasurementType::METRIC_MAX)) {
             return XPUM_GENERIC_ERROR;
         }
@@ -1160,7 +1162,7 @@ xpum_result_t xpumGetStatsEx(xpum_device_id_t deviceIdList[],
 
     char *env = std::getenv("XPUM_DISABLE_PERIODIC_METRIC_MONITOR");
     std::string xpum_disable_periodic_metric_monitor{env != NULL ? env : ""};
-    if (xpum_disable_periodic_metric_monitor == "1") {
+    if (xpum_disable_periodic_metric_monitor == "1" && dataList != nullptr) {
         if (!Core::instance().getMonitorManager()->initOneTimeMetricMonitorTasks(MeasurementType::METRIC_MAX)) {
             return XPUM_GENERIC_ERROR;
         }
@@ -1223,7 +1225,7 @@ xpum_result_t xpumGetEngineStats(xpum_device_id_t deviceId,
 
     char* env = std::getenv("XPUM_DISABLE_PERIODIC_METRIC_MONITOR");
     std::string xpum_disable_periodic_metric_monitor{env != NULL ? env : ""};
-    if (xpum_disable_periodic_metric_monitor == "1") {
+    if (xpum_disable_periodic_metric_monitor == "1" && dataList != nullptr) {
         if (!Core::instance().getMonitorManager()->initOneTimeMetricMonitorTasks(MeasurementType::METRIC_ENGINE_UTILIZATION)) {
             return XPUM_GENERIC_ERROR;
         }
@@ -1263,7 +1265,7 @@ xpum_result_t xpumGetEngineStatsEx(xpum_device_id_t deviceIdList[],
 
     char *env = std::getenv("XPUM_DISABLE_PERIODIC_METRIC_MONITOR");
     std::string xpum_disable_periodic_metric_monitor{env != NULL ? env : ""};
-    if (xpum_disable_periodic_metric_monitor == "1") {
+    if (xpum_disable_periodic_metric_monitor == "1" && dataList != nullptr) {
         if (!Core::instance().getMonitorManager()->initOneTimeMetricMonitorTasks(MeasurementType::METRIC_ENGINE_UTILIZATION)) {
             return XPUM_GENERIC_ERROR;
         }
@@ -1369,7 +1371,7 @@ xpum_result_t xpumGetFabricThroughputStats(xpum_device_id_t deviceId,
 
     char* env = std::getenv("XPUM_DISABLE_PERIODIC_METRIC_MONITOR");
     std::string xpum_disable_periodic_metric_monitor{env != NULL ? env : ""};
-    if (xpum_disable_periodic_metric_monitor == "1") {
+    if (xpum_disable_periodic_metric_monitor == "1" && dataList != nullptr) {
         if (!Core::instance().getMonitorManager()->initOneTimeMetricMonitorTasks(MeasurementType::METRIC_FABRIC_THROUGHPUT)) {
             return XPUM_GENERIC_ERROR;
         }
@@ -1431,7 +1433,7 @@ xpum_result_t xpumGetFabricThroughputStatsEx(xpum_device_id_t deviceIdList[],
 
     char *env = std::getenv("XPUM_DISABLE_PERIODIC_METRIC_MONITOR");
     std::string xpum_disable_periodic_metric_monitor{env != NULL ? env : ""};
-    if (xpum_disable_periodic_metric_monitor == "1") {
+    if (xpum_disable_periodic_metric_monitor == "1" && dataList != nullptr) {
         if (!Core::instance().getMonitorManager()->initOneTimeMetricMonitorTasks(MeasurementType::METRIC_FABRIC_THROUGHPUT)) {
             return XPUM_GENERIC_ERROR;
         }
@@ -1727,6 +1729,21 @@ xpum_result_t xpumGetStatsByGroup(xpum_group_id_t groupId,
     return res;
 }
 
+xpum_result_t xpumGetStatsAggregateByGroup(xpum_group_id_t groupId,
+                                           xpum_group_stats_data_t dataList[],
+                                           uint32_t *count) {
+    xpum_result_t res = Core::instance().apiAccessPreCheck();
+    if (res != XPUM_OK) {
+        return res;
+    }
+
+    if (count == nullptr) {
+        return XPUM_GENERIC_ERROR;
+    }
+
+    return Core::instance().getGroupManager()->getGroupStatistics(groupId, dataList, count);
+}
+
 std::set<int64_t> monitor_freq_set{5, 10, 20, 50, 100, 200, 500, 1000};
 
 xpum_result_t xpumSetAgentConfig(xpum_agent_config_t key, void *value) {
@@ -1750,6 +1767,19 @@ xpum_result_t xpumSetAgentConfig(xpum_agent_config_t key, void *value) {
             Core::instance().getPolicyManager()->resetCheckFrequency();
             return XPUM_OK;
         }
+        case xpum_agent_config_t::XPUM_AGENT_CONFIG_METRIC_INTERVAL: {
+            xpum_agent_metric_interval_t *metric_interval = (xpum_agent_metric_interval_t *)value;
+            auto type = Utility::measurementTypeFromXpumStatsType(metric_interval->metricsType);
+            if (type == MeasurementType::METRIC_MAX) {
+                return XPUM_RESULT_AGENT_SET_INVALID_VALUE;
+            }
+            if (metric_interval->interval < 0 || (metric_interval->interval > 0 && metric_interval->interval < *monitor_freq_set.begin())
+                    || metric_interval->interval > INT_MAX) {
+                return XPUM_RESULT_AGENT_SET_INVALID_VALUE;
+            }
+            Core::instance().getMonitorManager()->setMetricInterval(type, (int)metric_interval->interval);
+            return XPUM_OK;
+        }
         default:
             break;
     }
@@ -1766,6 +1796,15 @@ xpum_result_t xpumGetAgentConfig(xpum_agent_config_t key, void *value) {
         case xpum_agent_config_t::XPUM_AGENT_CONFIG_SAMPLE_INTERVAL:
             *((int64_t *)value) = (int64_t)Configuration::TELEMETRY_DATA_MONITOR_FREQUENCE;
             return XPUM_OK;
+        case xpum_agent_config_t::XPUM_AGENT_CONFIG_METRIC_INTERVAL: {
+            xpum_agent_metric_interval_t *metric_interval = (xpum_agent_metric_interval_t *)value;
+            auto type = Utility::measurementTypeFromXpumStatsType(metric_interval->metricsType);
+            if (type == MeasurementType::METRIC_MAX) {
+                return XPUM_RESULT_AGENT_SET_INVALID_VALUE;
+            }
+            metric_interval->interval = Configuration::getMetricInterval(Utility::capabilityFromMeasurementType(type));
+            return XPUM_OK;
+        }
         default:
             break;
     }
@@ -1913,13 +1952,8 @@ xpum_result_t xpumRunDiagnosticsByGroup(xpum_group_id_t groupId, xpum_diag_level
         }
     }
 
-    for (int i = 0; i < xpum_group_info.count; i++) {
-        ret = Core::instance().getDiagnosticManager()->runLevelDiagnostics(xpum_group_info.deviceList[i], level);
-        if (ret != XPUM_OK)
-            return ret;
-    }
-
-    return ret;
+    std::vector<xpum_device_id_t> deviceIds(xpum_group_info.deviceList, xpum_group_info.deviceList + xpum_group_info.count);
+    return Core::instance().getDiagnosticManager()->runLevelDiagnosticsByGroup(deviceIds, level);
 }
 
 xpum_result_t xpumRunMultipleSpecificDiagnostics(xpum_device_id_t deviceId, xpum_diag_task_type_t types[], int count) {
@@ -1949,13 +1983,8 @@ xpum_result_t xpumRunMultipleSpecificDiagnosticsByGroup(xpum_group_id_t groupId,
         }
     }
 
-    for (int i = 0; i < xpum_group_info.count; i++) {
-        ret = Core::instance().getDiagnosticManager()->runMultipleSpecificDiagnostics(xpum_group_info.deviceList[i], types, count);
-        if (ret != XPUM_OK)
-            return ret;
-    }
-
-    return ret;
+    std::vector<xpum_device_id_t> deviceIds(xpum_group_info.deviceList, xpum_group_info.deviceList + xpum_group_info.count);
+    return Core::instance().getDiagnosticManager()->runMultipleSpecificDiagnosticsByGroup(deviceIds, types, count);
 }
 
 xpum_result_t xpumGetDiagnosticsResult(xpum_device_id_t deviceId, xpum_diag_task_info_t *result) {
@@ -2594,19 +2623,17 @@ xpum_result_t xpumApplyPPR(xpum_device_id_t deviceId, xpum_diag_result_t* diagRe
         return XPUM_RESULT_UNSUPPORTED_DEVICE;
     }
 
-    if (p_device->isUpgradingFw()) {
-        return XPUM_UPDATE_FIRMWARE_TASK_RUNNING;
-    }
-
-    if (Core::instance().getFirmwareManager() && Core::instance().getFirmwareManager()->isUpgradingFw()) {
-        return XPUM_UPDATE_FIRMWARE_TASK_RUNNING;
-    }
-
     zes_diag_handle_t diagHandle{};
     if(!Core::instance().getDeviceManager()->getPPRDiagHandle(std::to_string(deviceId), diagHandle)){
         return XPUM_PPR_NOT_FOUND;
     }
 
+    // waits for the telemetry reads, fails while a firmware flash runs
+    std::chrono::milliseconds timeout(Configuration::DEVICE_OPERATION_TIMEOUT);
+    if (!p_device->getOperationLock().lockExclusive(DEVICE_OPERATION_PPR, timeout)) {
+        return XPUM_UPDATE_FIRMWARE_TASK_RUNNING;
+    }
+
     xpumShutdown();
     zes_diag_result_t diagRes{};
     auto res = zesDiagnosticsRunTests(diagHandle, 0, 0, &diagRes);
@@ -2660,21 +2687,15 @@ xpum_result_t xpumApplyPPR(xpum_device_id_t deviceId, xpum_diag_result_t* diagRe
         XPUM_LOG_WARN("Failed to call zesDeviceEnumMemoryModules");
     }
     *healthState = status;
+    p_device->getOperationLock().unlockExclusive();
     return XPUM_OK;
 }
 
 xpum_result_t xpumResetDevice(xpum_device_id_t deviceId, bool force) {
-    std::shared_ptr<Device> device = Core::instance().getDeviceManager()->getDevice(std::to_string(deviceId));
-    if (device == nullptr) {
+    std::shared_ptr<Device> p_device = Core::instance().getDeviceManager()->getDevice(std::to_string(deviceId));
+    if (p_device == nullptr) {
         return XPUM_RESULT_DEVICE_NOT_FOUND;
     }
-    if (device->isUpgradingFw()) {
-        return XPUM_UPDATE_FIRMWARE_TASK_RUNNING;
-    }
-
-    if (Core::instance().getFirmwareManager() && Core::instance().getFirmwareManager()->isUpgradingFw()) {
-        return XPUM_UPDATE_FIRMWARE_TASK_RUNNING;
-    }
 
     uint32_t driver_count = 0;
     auto res = zeDriverGet(&driver_count, nullptr);
@@ -2697,8 +2718,14 @@ xpum_result_t xpumResetDevice(xpum_device_id_t deviceId, bool force) {
             return XPUM_RESULT_DEVICE_NOT_FOUND;
         for (auto device : devices) {
             if (idx == deviceId) {
+                // waits for the telemetry reads, fails while a firmware flash or PPR runs
+                std::chrono::milliseconds timeout(Configuration::DEVICE_OPERATION_TIMEOUT);
+                if (!p_device->getOperationLock().lockExclusive(DEVICE_OPERATION_RESET, timeout)) {
+                    return XPUM_UPDATE_FIRMWARE_TASK_RUNNING;
+                }
                 xpumShutdown();
                 res = zesDeviceReset(device, true);
+                p_device->getOperationLock().unlockExclusive();
                 XPUM_LOG_INFO("reset result: {}", res);
                 if (res == ZE_RESULT_SUCCESS) {
                     return XPUM_OK;
@@ -2713,6 +2740,31 @@ xpum_result_t xpumResetDevice(xpum_device_id_t deviceId, bool force) {
     return XPUM_RESULT_DEVICE_NOT_FOUND;
 }
 
+xpum_result_t xpumGetDeviceOperationStats(xpum_device_id_t deviceId, xpum_device_operation_stats_t *stats) {
+    xpum_result_t res = Core::instance().apiAccessPreCheck();
+    if (res != XPUM_OK) {
+        return res;
+    }
+    if (stats == nullptr) {
+        return XPUM_GENERIC_ERROR;
+    }
+
+    std::shared_ptr<Device> device = Core::instance().getDeviceManager()->getDevice(std::to_string(deviceId));
+    if (device == nullptr) {
+        return XPUM_RESULT_DEVICE_NOT_FOUND;
+    }
+    auto& lock = device->getOperationLock();
+    auto lock_stats = lock.getStats();
+    stats->deviceId = deviceId;
+    stats->locked = lock.isLockedExclusive();
+    stats->pausedReads = lock_stats.shared_refused;
+    stats->operationCount = lock_stats.exclusive_count;
+    stats->refusedOperationCount = lock_stats.exclusive_refused;
+    stats->waitTime = lock_stats.exclusive_wait_us;
+    stats->maxWaitTime = lock_stats.exclusive_max_wait_us;
+    return XPUM_OK;
+}
+
 xpum_result_t xpumGetFreqAvailableClocks(xpum_device_id_t deviceId, uint32_t tileId, double *dataArray, uint32_t *count) {
     xpum_result_t res = Core::instance().apiAccessPreCheck();
     if (res != XPUM_OK) {
@@ -0,0 +1,241 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file device_hotplug_monitor.cpp
+ */
+
+#include "device_hotplug_monitor.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/netlink.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cctype>
+#include <chrono>
+#include <vector>
+
+#include "device/platform_inventory.h"
+#include "infrastructure/configuration.h"
+#include "infrastructure/logger.h"
+
+namespace xpum {
+
+// the multicast group of the uevents sent by the kernel, not by udevd
+static const unsigned int KERNEL_UEVENT_GROUP = 1;
+
+static const std::size_t UEVENT_BUFFER_SIZE = 8192;
+
+DeviceHotplugMonitor& DeviceHotplugMonitor::instance() {
+    static DeviceHotplugMonitor monitor;
+    return monitor;
+}
+
+DeviceHotplugMonitor::~DeviceHotplugMonitor() {
+    close();
+}
+
+void DeviceHotplugMonitor::start(std::shared_ptr<DeviceManagerInterface> p_device_manager,
+                                 std::shared_ptr<GroupManagerInterface> p_group_manager) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (worker.joinable()) {
+        return;
+    }
+    sock = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+    if (sock < 0) {
+        XPUM_LOG_DEBUG("Cannot open uevent socket, errno: {}({})", errno, strerror(errno));
+        return;
+    }
+    struct sockaddr_nl addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = KERNEL_UEVENT_GROUP;
+    if (bind(sock, (struct sockaddr*)&addr, sizeof(addr)) < 0 || pipe2(wake, O_CLOEXEC) < 0) {
+        XPUM_LOG_DEBUG("Cannot listen to uevents, errno: {}({})", errno, strerror(errno));
+        ::close(sock);
+        sock = -1;
+        return;
+    }
+    this->p_device_manager = p_device_manager;
+    this->p_group_manager = p_group_manager;
+    worker = std::thread(&DeviceHotplugMonitor::run, this);
+}
+
+void DeviceHotplugMonitor::close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!worker.joinable()) {
+        return;
+    }
+    char c = 0;
+    if (write(wake[1], &c, 1) < 0) {
+        XPUM_LOG_WARN("Cannot wake up the hot-plug monitor, errno: {}({})", errno, strerror(errno));
+    }
+    worker.join();
+    ::close(sock);
+    ::close(wake[0]);
+    ::close(wake[1]);
+    sock = wake[0] = wake[1] = -1;
+    p_device_manager = nullptr;
+    p_group_manager = nullptr;
+}
+
+void DeviceHotplugMonitor::run() {
+    std::vector<char> buf(UEVENT_BUFFER_SIZE);
+    std::set<std::string> bdfs;
+    auto last_event = std::chrono::steady_clock::now();
+    while (true) {
+        // waits until the events on the GPUs stop before discovering them
+        int timeout = -1;
+        if (!bdfs.empty()) {
+            auto quiet = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - last_event).count();
+            if (quiet >= Configuration::DEVICE_HOTPLUG_SETTLE_TIME) {
+                update(bdfs);
+                bdfs.clear();
+                continue;
+            }
+            timeout = Configuration::DEVICE_HOTPLUG_SETTLE_TIME - quiet;
+        }
+
+        struct pollfd fds[2];
+        fds[0].fd = sock;
+        fds[0].events = POLLIN;
+        fds[0].revents = 0;
+        fds[1].fd = wake[0];
+        fds[1].events = POLLIN;
+        fds[1].revents = 0;
+        int ret = poll(fds, 2, timeout);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            XPUM_LOG_WARN("Poll on uevent socket return error, errno: {}({})", errno, strerror(errno));
+            return;
+        }
+        if (fds[1].revents != 0) {
+            return;
+        }
+
+        while (ret > 0) {
+            struct sockaddr_nl sender;
+            socklen_t sender_len = sizeof(sender);
+            ssize_t len = recvfrom(sock, buf.data(), buf.size() - 1, MSG_DONTWAIT, (struct sockaddr*)&sender, &sender_len);
+            if (len < 0) {
+                if (errno == ENOBUFS) {
+                    XPUM_LOG_WARN("Uevents have been lost, all the GPUs are checked");
+                    auto all = allBDFs();
+                    bdfs.insert(all.begin(), all.end());
+                    last_event = std::chrono::steady_clock::now();
+                    continue;
+                }
+                break;
+            }
+            if (sender.nl_pid != 0) {
+                continue;
+            }
+            buf[len] = '\0';
+            auto bdf = eventBDF(buf.data(), len);
+            if (!bdf.empty()) {
+                bdfs.insert(bdf);
+                last_event = std::chrono::steady_clock::now();
+            }
+        }
+    }
+}
+
+static bool isBDF(const std::string& name) {
+    // dddd:bb:dd.f
+    if (name.size() != 12 || name[4] != ':' || name[7] != ':' || name[10] != '.') {
+        return false;
+    }
+    for (std::size_t i = 0; i < name.size(); i++) {
+        if (i != 4 && i != 7 && i != 10 && !std::isxdigit((unsigned char)name[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string DeviceHotplugMonitor::eventBDF(const char* buf, std::size_t len) {
+    std::string action, devpath, subsystem, pci_id;
+    // "action@devpath" then "KEY=value" strings, each ended by a null
+    for (const char* p = buf + strlen(buf) + 1; p < buf + len; p += strlen(p) + 1) {
+        if (strncmp(p, "ACTION=", 7) == 0) {
+            action = p + 7;
+        } else if (strncmp(p, "DEVPATH=", 8) == 0) {
+            devpath = p + 8;
+        } else if (strncmp(p, "SUBSYSTEM=", 10) == 0) {
+            subsystem = p + 10;
+        } else if (strncmp(p, "PCI_ID=", 7) == 0) {
+            pci_id = p + 7;
+        }
+    }
+    if (action != "add" && action != "remove" && action != "bind" && action != "unbind") {
+        return "";
+    }
+    if (subsystem == "pci") {
+        if (pci_id.compare(0, 5, "8086:") != 0) {
+            return "";
+        }
+    } else if (subsystem != "drm" && subsystem != "mei") {
+        return "";
+    }
+
+    // the GPU is the last PCI device of the path, the card or the MEI
+    // device being under it
+    std::string bdf;
+    std::size_t begin = 0;
+    while (begin < devpath.size()) {
+        std::size_t end = devpath.find('/', begin);
+        if (end == std::string::npos) {
+            end = devpath.size();
+        }
+        std::string name = devpath.substr(begin, end - begin);
+        if (isBDF(name)) {
+            bdf = name;
+        }
+        begin = end + 1;
+    }
+    return bdf;
+}
+
+std::set<std::string> DeviceHotplugMonitor::allBDFs() {
+    std::set<std::string> bdfs;
+    DIR* pdir = opendir("/sys/bus/pci/devices");
+    if (pdir != nullptr) {
+        struct dirent* pdirent;
+        while ((pdirent = readdir(pdir)) != nullptr) {
+            std::string drm = std::string("/sys/bus/pci/devices/") + pdirent->d_name + "/drm";
+            if (isBDF(pdirent->d_name) && access(drm.c_str(), F_OK) == 0) {
+                bdfs.insert(pdirent->d_name);
+            }
+        }
+        closedir(pdir);
+    }
+    std::vector<std::shared_ptr<Device>> devices;
+    p_device_manager->getDeviceList(devices);
+    for (auto& p_device : devices) {
+        Property prop;
+        if (p_device->getProperty(XPUM_DEVICE_PROPERTY_INTERNAL_PCI_BDF_ADDRESS, prop)) {
+            bdfs.insert(prop.getValue());
+        }
+    }
+    return bdfs;
+}
+
+void DeviceHotplugMonitor::update(const std::set<std::string>& bdfs) {
+    // the MEI devices and DRM cards have changed too
+    PlatformInventory::refresh();
+
+    std::vector<std::string> removed;
+    p_device_manager->refreshDevices(bdfs, removed);
+    if (removed.empty()) {
+        return;
+    }
+    p_group_manager->removeDevices(removed);
+}
+
+} // namespace xpum
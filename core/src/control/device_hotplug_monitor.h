@@ -0,0 +1,74 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file device_hotplug_monitor.h
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+#include "control/device_manager_interface.h"
+#include "group/group_manager_interface.h"
+
+namespace xpum {
+
+/*
+  Drops the GPUs that are gone from the device list after an unplug, an
+  unbind or a VF removal. It listens to the kernel uevents of the drm, pci
+  and mei subsystems and, once no event has come for
+  Configuration::DEVICE_HOTPLUG_SETTLE_TIME, hands the PCI addresses of
+  the GPUs they are about to DeviceManager::refreshDevices. Only these
+  GPUs are checked, and the devices removed leave their groups.
+
+  The monitor tasks collect the devices of the device list, so a device
+  removed is not read anymore. Level Zero enumerates the devices at
+  zeInit only, so a GPU plugged is available after a restart.
+*/
+
+class DeviceHotplugMonitor {
+   public:
+    static DeviceHotplugMonitor& instance();
+
+    // nothing is done when the uevent socket cannot be opened
+    void start(std::shared_ptr<DeviceManagerInterface> p_device_manager,
+               std::shared_ptr<GroupManagerInterface> p_group_manager);
+
+    void close();
+
+   private:
+    DeviceHotplugMonitor() = default;
+
+    ~DeviceHotplugMonitor();
+
+    void run();
+
+    // PCI address of the GPU the uevent is about, empty for the other events
+    static std::string eventBDF(const char* buf, std::size_t len);
+
+    // PCI addresses of the GPUs known to the driver or to the device list,
+    // for when uevents have been lost
+    std::set<std::string> allBDFs();
+
+    void update(const std::set<std::string>& bdfs);
+
+    std::mutex mutex;
+
+    std::thread worker;
+
+    int sock = -1;
+
+    // written by close() to wake the worker up
+    int wake[2] = {-1, -1};
+
+    std::shared_ptr<DeviceManagerInterface> p_device_manager;
+
+    std::shared_ptr<GroupManagerInterface> p_group_manager;
+};
+
+} // namespace xpum
@@ -7,13 +7,18 @@
 #include "device_manager.h"
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <vector>
 #include <regex>
+#include <unistd.h>
 
 #include "device/gpu/gpu_device_stub.h"
+#include "device/gpu/ras_sampler.h"
+#include "device/sim/sim_device_stub.h"
 #include "infrastructure/configuration.h"
 #include "infrastructure/device_process.h"
 #include "infrastructure/device_util_by_proc.h"
@@ -64,7 +69,7 @@ void DeviceManager::init() {
     std::atomic<bool> ready(false);
     std::weak_ptr<DeviceManager> this_weak_ptr = shared_from_this();
 
-    GPUDeviceStub::instance().discoverDevices([&cv, &ready, this_weak_ptr](std::shared_ptr<void> ret, std::shared_ptr<BaseException> e) {
+    Callback_t on_discovered = [&cv, &ready, this_weak_ptr](std::shared_ptr<void> ret, std::shared_ptr<BaseException> e) {
         auto p_this = this_weak_ptr.lock();
         if (p_this == nullptr) {
             return;
@@ -87,7 +92,22 @@ void DeviceManager::init() {
 
         ready = true;
         cv.notify_all();
-    });
+    };
+
+    if (SimulatedDeviceStub::isEnabled()) {
+        SimulatedDeviceStub::instance().discoverDevices(on_discovered);
+        // the ports of simulated devices are linked at discovery
+        std::lock_guard<std::mutex> fabric_lock(this->fabric_mutex);
+        for (auto& p_device : this->devices) {
+            if (p_device->getFabricID() != std::numeric_limits<uint32_t>::max()) {
+                fabric_ids[p_device->getFabricID()] = p_device->getId();
+            }
+        }
+        fabric_ids_has_built = true;
+        return;
+    }
+
+    GPUDeviceStub::instance().discoverDevices(on_discovered);
 
     while (!ready) {
         cv.wait(lock);
@@ -136,42 +156,20 @@ std::shared_ptr<MeasurementData> DeviceManager::getRealtimeMeasurementData(
     }
 
     DeviceCapability capability = Utility::capabilityFromMeasurementType(type);
-    auto method = Device::getDeviceMethod(capability, p_device.get());
-    if (method == nullptr) {
+    if (Device::getDeviceMethod(capability, p_device.get()) == nullptr) {
         throw IlegalParameterException("method does not exist");
     }
 
-    std::shared_ptr<MeasurementData> p_data;
-    std::shared_ptr<BaseException> exception;
-    std::condition_variable data_cv;
-    std::mutex data_mutex;
-    std::atomic<bool> ready(false);
-    std::weak_ptr<DeviceManager> this_weak_ptr = shared_from_this();
-
-    method([p_device, this_weak_ptr, &p_data, &data_cv, &exception, &ready](std::shared_ptr<void> ret, std::shared_ptr<BaseException> e) mutable {
-        auto p_this = this_weak_ptr.lock();
-        if (p_this == nullptr) {
-            return;
-        }
-
-        if (e == nullptr && ret != nullptr) {
-            p_data = std::static_pointer_cast<MeasurementData>(ret);
-        } else if (e != nullptr) {
-            exception = e;
-        }
-
-        ready = true;
-        data_cv.notify_all();
-    });
-
-    std::unique_lock<std::mutex> lock(data_mutex);
-    while (!ready) {
-        data_cv.wait(lock);
+    if (!p_device->getOperationLock().tryLockShared()) {
+        throw BaseException("device is busy");
     }
-
-    if (exception != nullptr) {
-        throw(*exception);
+    MeasurementRead read;
+    p_device->readMeasurement(capability, read);
+    p_device->getOperationLock().unlockShared();
+    if (read.error != nullptr) {
+        throw(*read.error);
     }
+    std::shared_ptr<MeasurementData> p_data = read.data;
 
     auto subdeviceAdditionalDataTypes = p_data->getSubdeviceAdditionalDataTypes();
     if (subdeviceAdditionalDataTypes.find(type) != subdeviceAdditionalDataTypes.end()) {
@@ -216,6 +214,64 @@ std::shared_ptr<Device> DeviceManager::getDevicebyBDF(const std::string& bdf) {
     return nullptr;
  }
 
+static std::string getDeviceBDF(const std::shared_ptr<Device>& p_device) {
+    Property prop;
+    if (!p_device->getProperty(XPUM_DEVICE_PROPERTY_INTERNAL_PCI_BDF_ADDRESS, prop)) {
+        return "";
+    }
+    return prop.getValue();
+}
+
+// the PCI function is there and bound to a GPU driver
+static bool isGPUPresent(const std::string& bdf) {
+    return access(("/sys/bus/pci/devices/" + bdf + "/drm").c_str(), F_OK) == 0;
+}
+
+void DeviceManager::refreshDevices(const std::set<std::string>& bdfs, std::vector<std::string>& removed) {
+    if (SimulatedDeviceStub::isEnabled()) {
+        return;
+    }
+
+    std::set<std::string> plugged;
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        std::set<std::string> known;
+        for (auto it = this->devices.begin(); it != this->devices.end();) {
+            std::string bdf = getDeviceBDF(*it);
+            // a GPU unbound and bound again within the settle time is still
+            // present, but its Level Zero handles are lost
+            if (bdfs.find(bdf) == bdfs.end() || (isGPUPresent(bdf) && GPUDeviceStub::isDeviceReachable((*it)->getDeviceHandle()))) {
+                known.insert(bdf);
+                ++it;
+                continue;
+            }
+            XPUM_LOG_INFO("Device {} at {} is removed", (*it)->getId(), bdf);
+            removed.push_back((*it)->getId());
+            RasSampler::instance().forget((*it)->getDeviceHandle());
+            it = this->devices.erase(it);
+        }
+        for (auto& bdf : bdfs) {
+            if (known.find(bdf) == known.end() && isGPUPresent(bdf)) {
+                plugged.insert(bdf);
+            }
+        }
+    }
+    for (auto& bdf : plugged) {
+        XPUM_LOG_INFO("GPU at {} is plugged, it is available after a restart", bdf);
+    }
+    if (removed.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> fabric_lock(this->fabric_mutex);
+    for (auto it = fabric_ids.begin(); it != fabric_ids.end();) {
+        if (std::find(removed.begin(), removed.end(), it->second) != removed.end()) {
+            it = fabric_ids.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 void DeviceManager::getDeviceSchedulers(const std::string& id, std::vector<Scheduler>& schedulers) {
     std::unique_lock<std::mutex> lock(this->mutex);
     zes_device_handle_t device = getDeviceHandle(id);
@@ -437,68 +493,24 @@ bool DeviceManager::discoverFabricLinks() {
     return fabric_ids_has_built;
 }
 
-bool DeviceManager::tryLockDevices(const std::vector<std::string>& deviceList) {
-    std::unique_lock<std::mutex> lock(this->mutex);
-    std::vector<std::shared_ptr<Device>> tryLockDeviceList;
-    for (auto deviceId : deviceList) {
-        std::shared_ptr<Device> pDeviceToFind = nullptr;
-        for (auto& p_device : this->devices) {
-            if (deviceId.compare(p_device->getId()) == 0) {
-                pDeviceToFind = p_device;
-                break;
-            }
-        }
-        if (pDeviceToFind)
-            tryLockDeviceList.push_back(pDeviceToFind);
-        else
-            return false;
-    }
-    std::vector<std::shared_ptr<Device>> lockedDeviceList;
-    for (auto p_device : tryLockDeviceList) {
-        if (p_device->try_lock()) {
-            lockedDeviceList.push_back(p_device);
-        } else {
-            for (auto pDeviceToUnlock : lockedDeviceList) {
-                pDeviceToUnlock->unlock();
-            }
-            return false;
-        }
-    }
-    return true;
-}
-
-bool DeviceManager::tryLockDevices(std::vector<std::shared_ptr<Device>>& deviceList) {
-    std::unique_lock<std::mutex> lock(this->mutex);
+bool DeviceManager::lockDevices(std::vector<std::shared_ptr<Device>>& deviceList, DeviceOperation operation) {
+    // no lock of the device manager, the operations wait for the running reads
+    std::chrono::milliseconds timeout(Configuration::DEVICE_OPERATION_TIMEOUT);
     std::vector<std::shared_ptr<Device>> lockedDeviceList;
     for (auto p_device : deviceList) {
-        if (p_device->try_lock()) {
+        if (p_device->getOperationLock().lockExclusive(operation, timeout)) {
             lockedDeviceList.push_back(p_device);
         } else {
-            for (auto pDeviceToUnlock : lockedDeviceList) {
-                pDeviceToUnlock->unlock();
-            }
+            unlockDevices(lockedDeviceList);
             return false;
         }
     }
     return true;
 }
 
-void DeviceManager::unlockDevices(const std::vector<std::string>& deviceList) {
-    std::unique_lock<std::mutex> lock(this->mutex);
-    for (auto deviceId : deviceList) {
-        for (auto& p_device : this->devices) {
-            if (deviceId.compare(p_device->getId()) == 0) {
-                p_device->unlock();
-                break;
-            }
-        }
-    }
-}
-
 void DeviceManager::unlockDevices(std::vector<std::shared_ptr<Device>>& deviceList) {
-    std::unique_lock<std::mutex> lock(this->mutex);
     for (auto& p_device : deviceList) {
-        p_device->unlock();
+        p_device->getOperationLock().unlockExclusive();
     }
 }
 
@@ -7,6 +7,7 @@
 #pragma once
 #include <map>
 #include <mutex>
+#include <set>
 #include <vector>
 
 #include "data_logic/data_logic_interface.h"
@@ -110,15 +111,13 @@ class DeviceManager : public DeviceManagerInterface,
 
     std::shared_ptr<Device> getDevicebyBDF(const std::string& bdf);
 
+    void refreshDevices(const std::set<std::string>& bdfs, std::vector<std::string>& removed) override;
+
     bool discoverFabricLinks();
 
     std::string getDeviceIDByFabricID(uint64_t fabric_id);
 
-    bool tryLockDevices(const std::vector<std::string>& deviceList);
-
-    bool tryLockDevices(std::vector<std::shared_ptr<Device>>& deviceList);
-
-    void unlockDevices(const std::vector<std::string>& deviceList);
+    bool lockDevices(std::vector<std::shared_ptr<Device>>& deviceList, DeviceOperation operation);
 
     void unlockDevices(std::vector<std::shared_ptr<Device>>& deviceList);
 
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <mutex>
+#include <set>
 #include <vector>
 
 #include "device/device.h"
@@ -123,15 +124,23 @@ class DeviceManagerInterface : public InitCloseInterface {
 
     virtual std::shared_ptr<Device> getDevicebyBDF(const std::string& bdf) = 0;
 
-    virtual bool discoverFabricLinks() = 0;
+    /*
+      Removes the devices at the PCI addresses bdfs that are gone, after a
+      hot-plug. The other devices are not probed again.
 
-    virtual std::string getDeviceIDByFabricID(uint64_t fabric_id) = 0;
+      Level Zero enumerates the devices once, at zeInit, so a device is
+      never added here. A GPU plugged, or whose driver was unbound and
+      bound again, is logged as available after a restart. A device
+      keeps its handles while the driver keeps it, e.g. across a reset.
+    */
+    virtual void refreshDevices(const std::set<std::string>& bdfs, std::vector<std::string>& removed) = 0;
 
-    virtual bool tryLockDevices(const std::vector<std::string>& deviceList) = 0;
+    virtual bool discoverFabricLinks() = 0;
 
-    virtual bool tryLockDevices(std::vector<std::shared_ptr<Device>>& deviceList) = 0;
+    virtual std::string getDeviceIDByFabricID(uint64_t fabric_id) = 0;
 
-    virtual void unlockDevices(const std::vector<std::string>& deviceList) = 0;
+    // locks all the devices for the operation or none of them
+    virtual bool lockDevices(std::vector<std::shared_ptr<Device>>& deviceList, DeviceOperation operation) = 0;
 
     virtual void unlockDevices(std::vector<std::shared_ptr<Device>>& deviceList) = 0;
 
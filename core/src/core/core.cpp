@@ -6,9 +6,13 @@
 
 #include "core.h"
 
+#include "control/device_hotplug_monitor.h"
 #include "control/device_manager.h"
 #include "data_logic/data_logic.h"
+#include "device/capability_cache.h"
+#include "device/device_reader.h"
 #include "device/gpu/gpu_device_stub.h"
+#include "device/gpu/ras_sampler.h"
 #include "diagnostic/diagnostic_manager.h"
 #include "group/group_manager.h"
 #include "health/health_manager.h"
@@ -132,6 +136,12 @@ void Core::init() {
     p_monitor_manager = std::make_shared<MonitorManager>(p_device_manager, p_data_logic);
     p_monitor_manager->init();
 
+    // xpu-smi runs too short for devices to come and go
+    if (Configuration::XPUM_MODE != "xpu-smi" && Configuration::DEVICE_HOTPLUG_SETTLE_TIME >= 0) {
+        XPUM_LOG_INFO("start device hot-plug monitor");
+        DeviceHotplugMonitor::instance().start(p_device_manager, p_group_manager);
+    }
+
     p_vgpu_manager = std::make_shared<VgpuManager>();
 
     XPUM_LOG_INFO("xpumd core initialization completed");
@@ -148,6 +158,10 @@ void Core::close() {
 
     p_dump_raw_data_manager = nullptr;
 
+    DeviceHotplugMonitor::instance().close();
+
+    CapabilityCache::instance().close();
+
     Topology::clearTopology();
 
     close(std::dynamic_pointer_cast<InitCloseInterface>(p_policy_manager),
@@ -160,10 +174,12 @@ void Core::close() {
           "Failed to close health manager");
     close(std::dynamic_pointer_cast<InitCloseInterface>(p_monitor_manager),
           "Failed to close monitor manager");
+    DeviceReader::instance().close();
     close(std::dynamic_pointer_cast<InitCloseInterface>(p_device_manager),
           "Failed to close device manager");
     close(std::dynamic_pointer_cast<InitCloseInterface>(p_data_logic),
           "Failed to close data logic");
+    RasSampler::instance().close();
     GPUDeviceStub::pcie_manager.close();
 }
 
@@ -49,12 +49,10 @@ void DataHandler::preHandleData(std::shared_ptr<SharedData>& p_data) noexcept {
         try {
             this->p_persistency->storeMeasurementData(this->type, p_data->getTime(), p_data->getData());
         } catch (std::exception& e) {
-            std::string error = "Failed to persist measurement data:";
-            error += e.what();
-            XPUM_LOG_ERROR(error);
+            // called for every sample of every metric
+            XPUM_LOG_RATE_LIMITED(XPUM_LOG_ERROR, 1, 10, "Failed to persist measurement data:{}", e.what());
         } catch (...) {
-            std::string error = "Failed to persist measurement data: unexpected exception";
-            XPUM_LOG_ERROR(error);
+            XPUM_LOG_RATE_LIMITED(XPUM_LOG_ERROR, 1, 10, "Failed to persist measurement data: unexpected exception");
         }
     }
 }
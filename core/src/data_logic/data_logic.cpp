@@ -53,6 +53,13 @@ void DataLogic::storeMeasurementData(MeasurementType type, Timestamp_t time,
     p_raw_data_manager->storeMeasurementData(type, time, datas);
 }
 
+void DataLogic::storeMeasurementBatch(Timestamp_t time, const MeasurementBatch& batch) {
+    if (p_raw_data_manager == nullptr) {
+        throw IlegalStateException("initialization is not done!");
+    }
+    p_raw_data_manager->storeMeasurementBatch(time, batch);
+}
+
 std::shared_ptr<MeasurementData> DataLogic::getLatestData(MeasurementType type,
                                                           std::string& device_id) {
     if (p_raw_data_manager == nullptr) {
@@ -311,6 +318,104 @@ void DataLogic::getLatestMetrics(xpum_device_id_t deviceId,
     }
 }
 
+xpum_result_t DataLogic::getLatestMetricsEx(xpum_device_id_t deviceIdList[],
+                                            uint32_t deviceCount,
+                                            const std::set<MeasurementType>& types,
+                                            xpum_device_realtime_metrics_t dataList[],
+                                            uint32_t* count) {
+    std::vector<std::shared_ptr<Device>> devices;
+    std::vector<uint32_t> subdevice_nums;
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < deviceCount; i++) {
+        auto p_device = Core::instance().getDeviceManager()->getDevice(std::to_string(deviceIdList[i]));
+        if (p_device == nullptr) {
+            return XPUM_RESULT_DEVICE_NOT_FOUND;
+        }
+        Property prop;
+        p_device->getProperty(XPUM_DEVICE_PROPERTY_INTERNAL_NUMBER_OF_SUBDEVICE, prop);
+        uint32_t num_subdevice = prop.getValueInt();
+        devices.push_back(p_device);
+        subdevice_nums.push_back(num_subdevice);
+        total += num_subdevice + 1;
+    }
+    if (dataList == nullptr) {
+        *count = total;
+        return XPUM_OK;
+    }
+    if (*count < total) {
+        return XPUM_BUFFER_TOO_SMALL;
+    }
+
+    std::vector<std::pair<MeasurementType, std::map<std::string, std::shared_ptr<MeasurementData>>>> type_datas;
+    for (auto type : Configuration::getEnabledMetrics()) {
+        if (type == METRIC_ENGINE_UTILIZATION || type == METRIC_FABRIC_THROUGHPUT) {
+            continue;
+        }
+        if (!types.empty() && types.find(type) == types.end()) {
+            continue;
+        }
+        type_datas.emplace_back(type, std::map<std::string, std::shared_ptr<MeasurementData>>());
+        getLatestData(type, type_datas.back().second);
+    }
+
+    uint32_t index = 0;
+    for (uint32_t i = 0; i < deviceCount; i++) {
+        std::string device_id = std::to_string(deviceIdList[i]);
+        std::vector<xpum::DeviceCapability> capabilities;
+        devices[i]->getCapability(capabilities);
+
+        xpum_device_realtime_metrics_t& device_metrics = dataList[index++];
+        device_metrics.deviceId = deviceIdList[i];
+        device_metrics.isTileData = false;
+        device_metrics.tileId = 0;
+        device_metrics.count = 0;
+        xpum_device_realtime_metrics_t* subdevice_metrics = dataList + index;
+        for (uint32_t j = 0; j < subdevice_nums[i]; j++) {
+            subdevice_metrics[j].deviceId = deviceIdList[i];
+            subdevice_metrics[j].isTileData = true;
+            subdevice_metrics[j].tileId = j;
+            subdevice_metrics[j].count = 0;
+        }
+        index += subdevice_nums[i];
+
+        for (auto& type_data : type_datas) {
+            MeasurementType type = type_data.first;
+            auto capability = Utility::capabilityFromMeasurementType(type);
+            if (std::find(capabilities.begin(), capabilities.end(), capability) == capabilities.end()) {
+                continue;
+            }
+            auto it = type_data.second.find(device_id);
+            if (it == type_data.second.end() || it->second == nullptr) {
+                continue;
+            }
+            auto& p_data = it->second;
+            xpum_device_realtime_metric_t metric_data;
+            metric_data.metricsType = Utility::xpumStatsTypeFromMeasurementType(type);
+            metric_data.isCounter = Utility::isCounterMetric(type);
+            metric_data.scale = p_data->getScale();
+            if (p_data->hasDataOnDevice() && device_metrics.count < XPUM_STATS_MAX) {
+                metric_data.value = p_data->getCurrent();
+                device_metrics.dataList[device_metrics.count++] = metric_data;
+            }
+            if (!p_data->hasSubdeviceData()) {
+                continue;
+            }
+            for (auto& sub : *p_data->getSubdeviceDatas()) {
+                if (sub.first >= subdevice_nums[i] || sub.second.current == std::numeric_limits<uint64_t>::max()) {
+                    continue;
+                }
+                auto& tile_metrics = subdevice_metrics[sub.first];
+                if (tile_metrics.count < XPUM_STATS_MAX) {
+                    metric_data.value = sub.second.current;
+                    tile_metrics.dataList[tile_metrics.count++] = metric_data;
+                }
+            }
+        }
+    }
+    *count = index;
+    return XPUM_OK;
+}
+
 xpum_result_t DataLogic::getEngineStatistics(xpum_device_id_t deviceId,
                                              xpum_device_engine_stats_t dataList[],
                                              uint32_t* count,
@@ -355,29 +460,28 @@ xpum_result_t DataLogic::getEngineStatistics(xpum_device_id_t deviceId,
         *count = 0;
         return XPUM_OK;
     }
-    auto engine_datas_iter = std::static_pointer_cast<EngineCollectionMeasurementData>(p_data)->getDatas()->begin();
+    auto& engine_datas = *std::static_pointer_cast<EngineCollectionMeasurementData>(p_data)->getEngineRawDatas();
+    auto& stats_datas = *std::static_pointer_cast<EngineCollectionMeasurementData>(p_data)->getDatas();
     uint32_t index = 0;
-    while (engine_datas_iter != std::static_pointer_cast<EngineCollectionMeasurementData>(p_data)->getDatas()->end()) {
-        uint32_t engine_index = Core::instance().getDeviceManager()->getDevice(std::to_string(deviceId))->getEngineIndex(engine_datas_iter->first);
-        if (engine_index != std::numeric_limits<uint32_t>::max() && engine_datas_iter->second.current != std::numeric_limits<uint64_t>::max()) {
-            xpum_device_engine_stats_t data;
-            data.isTileData = engine_datas_iter->second.on_subdevice;
-            data.tileId = engine_datas_iter->second.subdevice_id;
-            data.value = engine_datas_iter->second.current;
-            data.min = engine_datas_iter->second.min;
-            data.avg = engine_datas_iter->second.avg;
-            data.max = engine_datas_iter->second.max;
-            data.index = engine_index;
-            data.scale = p_data->getScale();
-            data.type = Utility::toXPUMEngineType(std::static_pointer_cast<EngineCollectionMeasurementData>(p_data)->getEngineType(engine_datas_iter->first));
-            data.deviceId = deviceId;
-            if (index >= *count) {
-                return XPUM_BUFFER_TOO_SMALL;
-            }
-            dataList[index] = data;
-            ++index;
+    for (auto& engine_data : engine_datas) {
+        auto stats_iter = stats_datas.find(engine_data.handle);
+        if (stats_iter == stats_datas.end() || stats_iter->second.current == std::numeric_limits<uint64_t>::max()) {
+            continue;
         }
-        ++engine_datas_iter;
+        if (index >= *count) {
+            return XPUM_BUFFER_TOO_SMALL;
+        }
+        xpum_device_engine_stats_t& data = dataList[index++];
+        data.isTileData = engine_data.on_subdevice;
+        data.tileId = engine_data.subdevice_id;
+        data.value = stats_iter->second.current;
+        data.min = stats_iter->second.min;
+        data.avg = stats_iter->second.avg;
+        data.max = stats_iter->second.max;
+        data.index = engine_data.index;
+        data.scale = p_data->getScale();
+        data.type = Utility::toXPUMEngineType(engine_data.type);
+        data.deviceId = deviceId;
     }
     *count = index;
     return XPUM_OK;
@@ -422,26 +526,23 @@ xpum_result_t DataLogic::getEngineUtilizations(xpum_device_id_t deviceId,
         *count = 0;
         return XPUM_OK;
     }
-    auto engine_datas_iter = std::static_pointer_cast<EngineCollectionMeasurementData>(p_data)->getDatas()->begin();
-    uint32_t index = 0;
-    while (engine_datas_iter != std::static_pointer_cast<EngineCollectionMeasurementData>(p_data)->getDatas()->end()) {
-        uint32_t engine_index = Core::instance().getDeviceManager()->getDevice(std::to_string(deviceId))->getEngineIndex(engine_datas_iter->first);
-        if (engine_index != std::numeric_limits<uint32_t>::max()) {
-            xpum_device_engine_metric_t data;
-            data.isTileData = engine_datas_iter->second.on_subdevice;
-            data.tileId = engine_datas_iter->second.subdevice_id;
-            data.value = engine_datas_iter->second.current;
-            data.index = engine_index;
-            data.scale = p_data->getScale();
-            data.type = Utility::toXPUMEngineType(std::static_pointer_cast<EngineCollectionMeasurementData>(p_data)->getEngineType(engine_datas_iter->first));
-            if (index >= *count) {
-                return XPUM_BUFFER_TOO_SMALL;
-            }
-            dataList[index] = data;
-            ++index;
-        }
-        ++engine_datas_iter;
+    // the raw datas are already laid out in the order of the returned list
+    auto& engine_datas = *std::static_pointer_cast<EngineCollectionMeasurementData>(p_data)->getEngineRawDatas();
+    if (engine_datas.size() > *count) {
+        return XPUM_BUFFER_TOO_SMALL;
     }
+    uint32_t scale = p_data->getScale();
+    for (std::size_t i = 0; i < engine_datas.size(); i++) {
+        auto& engine_data = engine_datas[i];
+        xpum_device_engine_metric_t& data = dataList[i];
+        data.isTileData = engine_data.on_subdevice;
+        data.tileId = engine_data.subdevice_id;
+        data.value = engine_data.utilization;
+        data.index = engine_data.index;
+        data.scale = scale;
+        data.type = Utility::toXPUMEngineType(engine_data.type);
+    }
+    *count = engine_datas.size();
     return XPUM_OK;
 }
 
@@ -735,4 +836,11 @@ uint64_t DataLogic::getFabricStatsTimestamp(uint32_t session_id, uint32_t device
     return p_raw_data_manager->getFabricStatsTimestamp(session_id, device_id);
 }
 
+std::shared_ptr<EventBus> DataLogic::getEventBus() {
+    if (p_raw_data_manager == nullptr) {
+        throw IlegalStateException("initialization is not done!");
+    }
+    return p_raw_data_manager->getEventBus();
+}
+
 } // end namespace xpum
@@ -33,6 +33,8 @@ class DataLogic : public DataLogicInterface {
         Timestamp_t time,
         std::shared_ptr<std::map<std::string, std::shared_ptr<MeasurementData>>> datas) override;
 
+    void storeMeasurementBatch(Timestamp_t time, const MeasurementBatch& batch) override;
+
     std::shared_ptr<MeasurementData> getLatestData(
         MeasurementType type,
         std::string& device_id) override;
@@ -76,6 +78,19 @@ class DataLogic : public DataLogicInterface {
                           xpum_device_metrics_t dataList[],
                           int* count);
 
+    /*
+      Fills the latest metrics of all devices in deviceIdList into the flat
+      dataList, one entry per device followed by one per tile. The store is
+      read once per metric type for all devices. An empty types set means all
+      enabled metrics. With dataList == nullptr only the entry count is
+      returned and no data is read.
+    */
+    xpum_result_t getLatestMetricsEx(xpum_device_id_t deviceIdList[],
+                                     uint32_t deviceCount,
+                                     const std::set<MeasurementType>& types,
+                                     xpum_device_realtime_metrics_t dataList[],
+                                     uint32_t* count) override;
+
     xpum_result_t getEngineUtilizations(xpum_device_id_t deviceId,
                                         xpum_device_engine_metric_t dataList[],
                                         uint32_t* count);
@@ -100,6 +115,8 @@ class DataLogic : public DataLogicInterface {
 
     uint64_t getFabricStatsTimestamp(uint32_t session_id, uint32_t device_id);
 
+    std::shared_ptr<EventBus> getEventBus() override;
+
    private:
     std::unique_ptr<RawDataManager> p_raw_data_manager;
 
@@ -8,6 +8,9 @@
 
 #include <map>
 #include <deque>
+#include <set>
+#include <utility>
+#include <vector>
 
 #include "infrastructure/const.h"
 #include "infrastructure/measurement_data.h"
@@ -16,9 +19,13 @@
 #include "infrastructure/init_close_interface.h"
 #include "../include/xpum_structs.h"
 #include "api/internal_api_structs.h"
+#include "event/event_bus.h"
 
 namespace xpum {
 
+// the data of several measurement types sampled at the same time
+typedef std::vector<std::pair<MeasurementType, std::shared_ptr<std::map<std::string, std::shared_ptr<MeasurementData>>>>> MeasurementBatch;
+
 class DataLogicInterface : public InitCloseInterface {
     public:
         virtual ~DataLogicInterface(){};
@@ -26,6 +33,7 @@ class DataLogicInterface : public InitCloseInterface {
                 MeasurementType type,
                 Timestamp_t time,
                 std::shared_ptr<std::map<std::string, std::shared_ptr<MeasurementData>>> datas) = 0;
+        virtual void storeMeasurementBatch(Timestamp_t time, const MeasurementBatch& batch) = 0;
         virtual std::shared_ptr<MeasurementData> getLatestData(MeasurementType type,
                 std::string &device_id) = 0;
         virtual void getLatestData(MeasurementType type,
@@ -46,6 +54,11 @@ class DataLogicInterface : public InitCloseInterface {
         virtual void getLatestMetrics(xpum_device_id_t deviceId,
                 xpum_device_metrics_t dataList[],
                 int *count) = 0;
+        virtual xpum_result_t getLatestMetricsEx(xpum_device_id_t deviceIdList[],
+                uint32_t deviceCount,
+                const std::set<MeasurementType> &types,
+                xpum_device_realtime_metrics_t dataList[],
+                uint32_t *count) = 0;
         virtual xpum_result_t getEngineUtilizations(xpum_device_id_t deviceId,
                 xpum_device_engine_metric_t dataList[],
                 uint32_t *count) = 0;
@@ -71,6 +84,7 @@ class DataLogicInterface : public InitCloseInterface {
         virtual uint64_t getEngineStatsTimestamp(uint32_t session_id, uint32_t device_id) = 0;
         virtual void updateFabricStatsTimestamp(uint32_t session_id, uint32_t device_id) = 0;
         virtual uint64_t getFabricStatsTimestamp(uint32_t session_id, uint32_t device_id) = 0;
+        virtual std::shared_ptr<EventBus> getEventBus() = 0;
 };
 
 } // end namespace xpum
@@ -29,28 +29,37 @@ void EngineUtilizationDataHandler::calculateData(std::shared_ptr<SharedData>& p_
     while (iter != p_data->getData().end()) {
         auto pre_iter = p_preData->getData().find(iter->first);
         if (pre_iter != p_preData->getData().end()) {
-            auto cur_engine_datas = std::static_pointer_cast<EngineCollectionMeasurementData>(iter->second)->getEngineRawDatas();
-            auto pre_engine_datas = std::static_pointer_cast<EngineCollectionMeasurementData>(pre_iter->second)->getEngineRawDatas();
-            auto cur_engine_datas_iter = cur_engine_datas->begin();
-            while (cur_engine_datas_iter != cur_engine_datas->end()) {
-                auto pre_engine_datas_iter = pre_engine_datas->find(cur_engine_datas_iter->first);
-                if (pre_engine_datas_iter != pre_engine_datas->end()) {
-                    auto cur_active_time = cur_engine_datas_iter->second.raw_active_time;
-                    auto cur_timestamp = cur_engine_datas_iter->second.raw_timestamp;
-                    auto pre_active_time = pre_engine_datas_iter->second.raw_active_time;
-                    auto pre_timestamp = pre_engine_datas_iter->second.raw_timestamp;
-                    if (cur_timestamp - pre_timestamp != 0) {
-                        uint64_t val = Configuration::DEFAULT_MEASUREMENT_DATA_SCALE * 100 * (cur_active_time - pre_active_time) / (cur_timestamp - pre_timestamp);
-                        if (val > Configuration::DEFAULT_MEASUREMENT_DATA_SCALE * 100) {
-                            val = Configuration::DEFAULT_MEASUREMENT_DATA_SCALE * 100;
-                        }
-                        std::static_pointer_cast<EngineCollectionMeasurementData>(iter->second)->setDataCur(cur_engine_datas_iter->first, val);
-                        iter->second->setScale(Configuration::DEFAULT_MEASUREMENT_DATA_SCALE);
-                    }
+            auto p_cur = std::static_pointer_cast<EngineCollectionMeasurementData>(iter->second);
+            auto& cur_engine_datas = *p_cur->getEngineRawDatas();
+            auto& pre_engine_datas = *std::static_pointer_cast<EngineCollectionMeasurementData>(pre_iter->second)->getEngineRawDatas();
+            // both samples are ordered by (tile, type, index) with the indexes
+            // given at discovery, so an engine missing from one of them only
+            // leaves that engine without utilization
+            const uint64_t full = Configuration::DEFAULT_MEASUREMENT_DATA_SCALE * 100;
+            std::size_t j = 0;
+            for (auto& cur : cur_engine_datas) {
+                while (j < pre_engine_datas.size() && EngineCollectionMeasurementData::engineBefore(pre_engine_datas[j], cur)) {
+                    j++;
+                }
+                if (j == pre_engine_datas.size()) {
+                    break;
+                }
+                auto& pre = pre_engine_datas[j];
+                if (pre.handle != cur.handle) {
+                    continue;
+                }
+                if (cur.raw_timestamp - pre.raw_timestamp != 0) {
+                    uint64_t val = full * (cur.raw_active_time - pre.raw_active_time) / (cur.raw_timestamp - pre.raw_timestamp);
+                    cur.utilization = val > full ? full : val;
+                }
+            }
+            // session statistics are maintained per engine handle by the base handler
+            for (auto& cur : cur_engine_datas) {
+                if (cur.utilization != std::numeric_limits<uint64_t>::max()) {
+                    p_cur->setDataCur(cur.handle, cur.utilization);
                 }
-
-                ++cur_engine_datas_iter;
             }
+            p_cur->setScale(Configuration::DEFAULT_MEASUREMENT_DATA_SCALE);
         }
         ++iter;
     }
@@ -28,6 +28,7 @@ namespace xpum {
 
 RawDataManager::RawDataManager(std::shared_ptr<Persistency>& persistency)
     : p_persistency(persistency) {
+    p_event_bus = std::make_shared<EventBus>(Configuration::EVENT_BUS_QUEUE_CAPACITY, Configuration::EVENT_BUS_BATCH_SIZE);
 }
 
 RawDataManager::~RawDataManager() {
@@ -37,6 +38,8 @@ RawDataManager::~RawDataManager() {
 void RawDataManager::init() {
     std::unique_lock<std::mutex> lock(mutex);
 
+    p_event_bus->init();
+
     data_handlers[MeasurementType::METRIC_TEMPERATURE] =
         std::make_shared<MetricStatisticsDataHandler>(MeasurementType::METRIC_TEMPERATURE, p_persistency);
     data_handlers[MeasurementType::METRIC_TEMPERATURE]->init();
@@ -186,6 +189,7 @@ void RawDataManager::init() {
 }
 
 void RawDataManager::close() {
+    p_event_bus->close();
 }
 
 void RawDataManager::storeMeasurementData(
@@ -201,6 +205,26 @@ void RawDataManager::storeMeasurementData(
         p_handler->preHandleData(p_shared_data);
         p_handler->handleData(p_shared_data);
         updateCaches(type, p_shared_data);
+        p_event_bus->publish(type, time, p_shared_data->getData());
+    }
+}
+
+void RawDataManager::storeMeasurementBatch(Timestamp_t time, const MeasurementBatch& batch) {
+    std::vector<std::shared_ptr<DataHandler>> handlers;
+    std::unique_lock<std::mutex> lock(mutex);
+    for (auto& item : batch) {
+        handlers.push_back(data_handlers[item.first]);
+    }
+    lock.unlock();
+
+    for (std::size_t i = 0; i < batch.size(); i++) {
+        if (handlers[i] != nullptr) {
+            auto p_shared_data = std::make_shared<SharedData>(time, batch[i].second);
+            handlers[i]->preHandleData(p_shared_data);
+            handlers[i]->handleData(p_shared_data);
+            updateCaches(batch[i].first, p_shared_data);
+            p_event_bus->publish(batch[i].first, time, p_shared_data->getData());
+        }
     }
 }
 
@@ -367,4 +391,8 @@ uint64_t RawDataManager::getFabricStatsTimestamp(uint32_t session_id, uint32_t d
     return time;
 }
 
+std::shared_ptr<EventBus> RawDataManager::getEventBus() {
+    return p_event_bus;
+}
+
 } // end namespace xpum
@@ -10,6 +10,8 @@
 #include <mutex>
 
 #include "data_handler.h"
+#include "data_logic_interface.h"
+#include "event/event_bus.h"
 #include "infrastructure/measurement_cache_data.h"
 #include "infrastructure/measurement_type.h"
 #include "persistency.h"
@@ -48,6 +50,8 @@ class RawDataManager {
         Timestamp_t time,
         std::shared_ptr<std::map<std::string, std::shared_ptr<MeasurementData>>> datas);
 
+    void storeMeasurementBatch(Timestamp_t time, const MeasurementBatch& batch);
+
     std::shared_ptr<MeasurementData> getLatestData(
         MeasurementType type,
         std::string& device_id) noexcept;
@@ -78,6 +82,8 @@ class RawDataManager {
 
     uint64_t getFabricStatsTimestamp(uint32_t session_id, uint32_t device_id);
 
+    std::shared_ptr<EventBus> getEventBus();
+
    private:
     RawDataManager() = default;
 
@@ -88,6 +94,8 @@ class RawDataManager {
 
     std::shared_ptr<Persistency> p_persistency;
 
+    std::shared_ptr<EventBus> p_event_bus;
+
     std::map<uint32_t, std::map<MeasurementType, std::deque<MeasurementCacheData>>> caches;
 
     std::deque<RawDataCollectionTask> raw_data_collection_tasks;
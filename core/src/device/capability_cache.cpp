@@ -0,0 +1,194 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file capability_cache.cpp
+ */
+
+#include "capability_cache.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <sstream>
+
+#include "device/platform_inventory.h"
+#include "infrastructure/configuration.h"
+#include "infrastructure/logger.h"
+#include "infrastructure/version.h"
+
+using namespace nlohmann;
+
+namespace xpum {
+
+static const int CAPABILITY_CACHE_VERSION = 1;
+
+static const std::string CAPABILITY_CACHE_FILE("capabilities.json");
+
+// leaves the startup to the monitoring before probing the devices again
+static const std::chrono::seconds REVALIDATION_DELAY(60);
+
+CapabilityCache& CapabilityCache::instance() {
+    static CapabilityCache cache;
+    return cache;
+}
+
+CapabilityCache::~CapabilityCache() {
+    close();
+}
+
+std::string CapabilityCache::key(const ze_device_properties_t& props, const ze_driver_properties_t& driver_props) {
+    std::stringstream ss;
+    for (int i = ZE_MAX_DEVICE_UUID_SIZE - 1; i >= 0; i--) {
+        ss << std::hex << (props.uuid.id[i] >> 4) << (props.uuid.id[i] & 0xf);
+    }
+    ss << std::dec << "/" << props.deviceId;
+    ss << "/" << driver_props.driverVersion;
+    ss << "/" << PlatformInventory::get()->driverVersion();
+    ss << "/" << Version::getVersion();
+    ss << "/" << Configuration::XPUM_MODE;
+    // PCIe and EU probes only run for the enabled metrics
+    ss << "/";
+    for (auto metric : Configuration::getEnabledMetrics()) {
+        ss << metric << ",";
+    }
+    return ss.str();
+}
+
+void CapabilityCache::load() {
+    loaded = true;
+    if (Configuration::CACHE_DIR.empty()) {
+        return;
+    }
+    std::ifstream ifs(Configuration::CACHE_DIR + CAPABILITY_CACHE_FILE);
+    if (!ifs.good()) {
+        return;
+    }
+    try {
+        json cache = json::parse(ifs);
+        if (cache["version"].get<int>() != CAPABILITY_CACHE_VERSION) {
+            return;
+        }
+        for (auto& item : cache["devices"].items()) {
+            std::vector<DeviceCapability> capabilities;
+            for (auto& cap : item.value()) {
+                capabilities.push_back((DeviceCapability)cap.get<int>());
+            }
+            entries[item.key()] = capabilities;
+        }
+    } catch (std::exception& e) {
+        XPUM_LOG_WARN("Ignore invalid capability cache: {}", e.what());
+        entries.clear();
+    }
+}
+
+bool CapabilityCache::lookup(const std::string& key, std::vector<DeviceCapability>& capabilities) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!loaded) {
+        load();
+    }
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+        return false;
+    }
+    capabilities.insert(capabilities.end(), it->second.begin(), it->second.end());
+    return true;
+}
+
+void CapabilityCache::store(const std::string& key, const std::vector<DeviceCapability>& capabilities) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!loaded) {
+        load();
+    }
+    entries[key] = capabilities;
+    dirty = true;
+}
+
+void CapabilityCache::flush() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!dirty || Configuration::CACHE_DIR.empty()) {
+        return;
+    }
+    dirty = false;
+    json cache;
+    cache["version"] = CAPABILITY_CACHE_VERSION;
+    cache["devices"] = json::object();
+    for (auto& entry : entries) {
+        json capabilities = json::array();
+        for (auto cap : entry.second) {
+            capabilities.push_back((int)cap);
+        }
+        cache["devices"][entry.first] = capabilities;
+    }
+    mkdir(Configuration::CACHE_DIR.c_str(), 0755);
+    std::string file_path = Configuration::CACHE_DIR + CAPABILITY_CACHE_FILE;
+    std::string tmp_path = file_path + "." + std::to_string(getpid());
+    std::ofstream ofs(tmp_path);
+    if (!ofs.good()) {
+        XPUM_LOG_DEBUG("Cannot write capability cache to {}", Configuration::CACHE_DIR);
+        return;
+    }
+    ofs << cache.dump();
+    ofs.close();
+    if (ofs.fail() || rename(tmp_path.c_str(), file_path.c_str()) != 0) {
+        unlink(tmp_path.c_str());
+    }
+}
+
+void CapabilityCache::revalidateLater(const std::string& key, Probe probe) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stop) {
+        return;
+    }
+    pending[key] = probe;
+    if (!running) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+        running = true;
+        worker = std::thread(&CapabilityCache::revalidate, this);
+    }
+}
+
+void CapabilityCache::revalidate() {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait_for(lock, REVALIDATION_DELAY, [this] { return stop; });
+    while (!stop && !pending.empty()) {
+        auto key = pending.begin()->first;
+        auto probe = pending.begin()->second;
+        pending.erase(pending.begin());
+        lock.unlock();
+        auto capabilities = probe();
+        lock.lock();
+        if (entries[key] != capabilities) {
+            XPUM_LOG_INFO("Device capabilities changed, they will be used from the next start");
+            entries[key] = capabilities;
+            dirty = true;
+        }
+        if (pending.empty()) {
+            lock.unlock();
+            flush();
+            lock.lock();
+        }
+    }
+    running = false;
+}
+
+void CapabilityCache::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    cv.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.clear();
+    stop = false;
+}
+
+} // namespace xpum
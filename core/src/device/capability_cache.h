@@ -0,0 +1,83 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file capability_cache.h
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "infrastructure/device_capability.h"
+#include "level_zero/ze_api.h"
+
+namespace xpum {
+
+/*
+  Capabilities found by probing the devices at discovery, saved to
+  Configuration::CACHE_DIR so that the next discoveries skip the probes.
+  An entry is keyed by the device UUID and PCI device id, the Level Zero
+  and i915 driver versions, the xpum version and the settings the probes
+  depend on, so a driver update or a configuration change probes again.
+
+  A device found in the cache is probed again in the background some time
+  after the start. When the result differs, for example after a firmware
+  update, the cache is updated and the new capabilities are used from the
+  next start on.
+*/
+
+class CapabilityCache {
+   public:
+    typedef std::function<std::vector<DeviceCapability>()> Probe;
+
+    static CapabilityCache& instance();
+
+    static std::string key(const ze_device_properties_t& props, const ze_driver_properties_t& driver_props);
+
+    bool lookup(const std::string& key, std::vector<DeviceCapability>& capabilities);
+
+    void store(const std::string& key, const std::vector<DeviceCapability>& capabilities);
+
+    // writes the entries stored since the last flush
+    void flush();
+
+    void revalidateLater(const std::string& key, Probe probe);
+
+    // stops the background revalidation
+    void close();
+
+   private:
+    CapabilityCache() = default;
+
+    ~CapabilityCache();
+
+    void load();
+
+    void revalidate();
+
+    std::mutex mutex;
+
+    bool loaded = false;
+
+    bool dirty = false;
+
+    std::map<std::string, std::vector<DeviceCapability>> entries;
+
+    std::map<std::string, Probe> pending;
+
+    std::thread worker;
+
+    bool running = false;
+
+    std::condition_variable cv;
+
+    bool stop = false;
+};
+
+} // namespace xpum
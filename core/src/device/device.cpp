@@ -10,6 +10,7 @@
 
 #include "infrastructure/exception/ilegal_parameter_exception.h"
 #include "infrastructure/logger.h"
+#include "infrastructure/measurement_data.h"
 #include "api/device_model.h"
 
 namespace xpum {
@@ -185,6 +186,21 @@ std::function<void(Callback_t)> Device::getDeviceMethod(DeviceCapability& capabi
     return nullptr;
 }
 
+void Device::readMeasurement(DeviceCapability capability, MeasurementRead& read) noexcept {
+    auto method = getDeviceMethod(capability, this);
+    if (method == nullptr) {
+        read.error = std::make_shared<BaseException>("method does not exist");
+        return;
+    }
+    method([&read](std::shared_ptr<void> ret, std::shared_ptr<BaseException> e) {
+        read.data = std::static_pointer_cast<MeasurementData>(ret);
+        read.error = e;
+    });
+    if (read.data == nullptr && read.error == nullptr) {
+        read.error = std::make_shared<BaseException>("no data read");
+    }
+}
+
 void Device::addEngine(uint64_t handle, zes_engine_group_t type, bool on_subdevice, uint32_t subdevice_id) {
     std::unique_lock<std::mutex> lock(this->mutex);
     if (engines.find(handle) == engines.end()) {
@@ -217,8 +233,10 @@ uint32_t Device::getEngineCount(int32_t subdevice_id, zes_engine_group_t type) {
 }
 
 uint32_t Device::getEngineIndex(uint64_t handle) {
-    if (engines.find(handle) != engines.end()) {
-        return engines[handle].getIndex();
+    std::unique_lock<std::mutex> lock(this->mutex);
+    auto iter = engines.find(handle);
+    if (iter != engines.end()) {
+        return iter->second.getIndex();
     }
     return std::numeric_limits<uint32_t>::max();
 }
@@ -228,6 +246,11 @@ void Device::setFabricID(uint32_t fabric_id) {
     this->fabric_id = fabric_id;
 }
 
+uint32_t Device::getFabricID() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    return fabric_id;
+}
+
 void Device::addFabricPortHandle(uint32_t attach_id, uint32_t remote_fabric_id, uint32_t remote_attach_id, zes_fabric_port_handle_t handle) {
     std::unique_lock<std::mutex> lock(this->mutex);
     connected_fabric_port_handles[attach_id][remote_fabric_id][remote_attach_id].push_back(handle);
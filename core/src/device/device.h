@@ -15,6 +15,7 @@
 #include <atomic>
 
 #include "../include/xpum_structs.h"
+#include "device_operation_lock.h"
 #include "engine_info.h"
 #include "infrastructure/device_capability.h"
 #include "infrastructure/exception/base_exception.h"
@@ -29,6 +30,7 @@ namespace xpum {
 class FwDataMgmt;
 class PscMgmt;
 class FwCodeDataMgmt;
+class MeasurementData;
 
 struct RunGSCFirmwareFlashParam;
 struct GetGSCFirmwareFlashResultParam;
@@ -39,6 +41,16 @@ struct GetGSCFirmwareFlashResultParam;
 
 typedef std::function<void(std::shared_ptr<void>, std::shared_ptr<BaseException>)> Callback_t;
 
+/*
+  The result of a device read, in storage of the caller: the data, or the
+  error when the read failed.
+*/
+
+struct MeasurementRead {
+    std::shared_ptr<MeasurementData> data;
+    std::shared_ptr<BaseException> error;
+};
+
 enum FabricThroughputType {
     RECEIVED = 0,
     TRANSMITTED = 1,
@@ -145,6 +157,9 @@ class Device {
 
     static std::function<void(Callback_t)> getDeviceMethod(DeviceCapability& capability, Device* p_device);
 
+    // reads the capability into read through getDeviceMethod
+    void readMeasurement(DeviceCapability capability, MeasurementRead& read) noexcept;
+
     void addEngine(uint64_t engine, zes_engine_group_t type, bool on_subdevice, uint32_t subdevice_id);
 
     uint32_t getEngineCount() noexcept;
@@ -155,6 +170,8 @@ class Device {
 
     void setFabricID(uint32_t fabric_id);
 
+    uint32_t getFabricID();
+
     void addFabricPortHandle(uint32_t attach_id, uint32_t remote_fabric_id, uint32_t remote_attach_id, zes_fabric_port_handle_t handle);
 
     uint64_t getFabricThroughputID(uint32_t attach_id, uint32_t remote_fabric_id, uint32_t remote_attach_id, FabricThroughputType type);
@@ -207,15 +224,9 @@ class Device {
         return pPscMgmt;
     }
 
-    bool try_lock() {
-        if (_operation_lock.test_and_set()) {
-            return false;
-        }
-        return true;
-    }
-
-    void unlock() {
-        _operation_lock.clear();
+    // held shared by the telemetry reads, exclusive by flash, reset and PPR
+    DeviceOperationLock& getOperationLock() {
+        return operation_lock;
     }
 
     int getDeviceModel();
@@ -261,7 +272,7 @@ class Device {
     std::shared_ptr<FwCodeDataMgmt> pFwCodeDataMgmt;
 
    private:
-    std::atomic_flag _operation_lock = ATOMIC_FLAG_INIT;
+    DeviceOperationLock operation_lock;
 };
 
 } // end namespace xpum
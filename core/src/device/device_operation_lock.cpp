@@ -0,0 +1,101 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file device_operation_lock.cpp
+ */
+
+#include "device_operation_lock.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace xpum {
+
+// a read is a few sysman calls, an operation gives up past this
+static const std::chrono::seconds READERS_DRAIN_TIMEOUT(10);
+
+DeviceOperationLock::DeviceOperationLock() : readers(0), writer(false), writer_allows_reads(false), next_ticket(0) {
+    memset(&stats, 0, sizeof(stats));
+}
+
+bool DeviceOperationLock::tryLockShared() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if ((writer && !writer_allows_reads) || !waiting.empty()) {
+        stats.shared_refused++;
+        return false;
+    }
+    readers++;
+    return true;
+}
+
+void DeviceOperationLock::unlockShared() {
+    std::lock_guard<std::mutex> lock(mutex);
+    readers--;
+    if (readers == 0) {
+        cv.notify_all();
+    }
+}
+
+bool DeviceOperationLock::lockExclusive(DeviceOperation operation, std::chrono::milliseconds timeout) {
+    return acquire(operation, Clock::now() + timeout);
+}
+
+bool DeviceOperationLock::tryLockExclusive(DeviceOperation operation) {
+    return acquire(operation, Clock::time_point::min());
+}
+
+bool DeviceOperationLock::acquire(DeviceOperation operation, Clock::time_point queue_deadline) {
+    auto start = Clock::now();
+    std::unique_lock<std::mutex> lock(mutex);
+    if ((writer || !waiting.empty()) && queue_deadline <= start) {
+        stats.exclusive_refused++;
+        return false;
+    }
+
+    // negated so that the highest priority comes first
+    Ticket ticket(-(int)operation, next_ticket++);
+    waiting.insert(ticket);
+    // a single wait, so that no other operation is granted between the
+    // turn of this one and the end of the reads; no read starts meanwhile
+    // since this ticket is waiting
+    bool granted = cv.wait_until(lock, std::max(queue_deadline, start) + READERS_DRAIN_TIMEOUT, [&] {
+        return !writer && (readers == 0 || allowsReads(operation)) && *waiting.begin() == ticket;
+    });
+    waiting.erase(ticket);
+    if (!granted) {
+        stats.exclusive_refused++;
+        cv.notify_all();
+        return false;
+    }
+    writer = true;
+    writer_allows_reads = allowsReads(operation);
+
+    uint64_t wait_us = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    stats.exclusive_count++;
+    stats.exclusive_wait_us += wait_us;
+    stats.exclusive_max_wait_us = std::max(stats.exclusive_max_wait_us, wait_us);
+    return true;
+}
+
+bool DeviceOperationLock::allowsReads(DeviceOperation operation) {
+    return operation == DEVICE_OPERATION_AMC_FIRMWARE_FLASH;
+}
+
+void DeviceOperationLock::unlockExclusive() {
+    std::lock_guard<std::mutex> lock(mutex);
+    writer = false;
+    writer_allows_reads = false;
+    cv.notify_all();
+}
+
+bool DeviceOperationLock::isLockedExclusive() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return writer;
+}
+
+DeviceOperationLockStats DeviceOperationLock::getStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+} // namespace xpum
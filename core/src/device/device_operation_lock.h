@@ -0,0 +1,101 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file device_operation_lock.h
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <utility>
+
+namespace xpum {
+
+// the exclusive operations on a device, a higher one is granted first
+enum DeviceOperation {
+    // goes through the BMC, the device keeps being read meanwhile
+    DEVICE_OPERATION_AMC_FIRMWARE_FLASH = 0,
+    DEVICE_OPERATION_FIRMWARE_FLASH = 1,
+    DEVICE_OPERATION_PPR = 2,
+    DEVICE_OPERATION_RESET = 3,
+};
+
+struct DeviceOperationLockStats {
+    // shared locks refused because of an exclusive operation
+    uint64_t shared_refused;
+    uint64_t exclusive_count;
+    uint64_t exclusive_refused;
+    // time the exclusive operations waited for the lock
+    uint64_t exclusive_wait_us;
+    uint64_t exclusive_max_wait_us;
+};
+
+/*
+  Coordinates the operations on a device: telemetry reads share the device,
+  firmware flash, reset and PPR have it for themselves. The waiting
+  exclusive operations are granted by priority then in order, once the
+  running reads are done; no new read starts while one is waiting, so the
+  monitor pauses the device instead of failing on it. An AMC firmware flash
+  only excludes the other operations, the reads go on while it runs.
+
+  The lock is not owned by a thread, an operation may be unlocked by the
+  thread that finishes it.
+*/
+
+class DeviceOperationLock {
+   public:
+    DeviceOperationLock();
+
+    // false while an exclusive operation other than an AMC firmware flash
+    // runs, or while any waits
+    bool tryLockShared();
+
+    void unlockShared();
+
+    // waits up to timeout for the other exclusive operations, plus the time
+    // given to the running reads to finish
+    bool lockExclusive(DeviceOperation operation, std::chrono::milliseconds timeout);
+
+    // fails at once if another exclusive operation runs or waits, only
+    // waits for the running reads
+    bool tryLockExclusive(DeviceOperation operation);
+
+    void unlockExclusive();
+
+    bool isLockedExclusive();
+
+    DeviceOperationLockStats getStats();
+
+   private:
+    typedef std::chrono::steady_clock Clock;
+
+    // ordered by priority then arrival, the first is granted next
+    typedef std::pair<int, uint64_t> Ticket;
+
+    bool acquire(DeviceOperation operation, Clock::time_point queue_deadline);
+
+    static bool allowsReads(DeviceOperation operation);
+
+    std::mutex mutex;
+
+    std::condition_variable cv;
+
+    uint32_t readers;
+
+    bool writer;
+
+    // the running exclusive operation lets the reads go on
+    bool writer_allows_reads;
+
+    std::set<Ticket> waiting;
+
+    uint64_t next_ticket;
+
+    DeviceOperationLockStats stats;
+};
+
+} // namespace xpum
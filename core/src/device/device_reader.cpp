@@ -0,0 +1,78 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file device_reader.cpp
+ */
+
+#include "device_reader.h"
+
+#include "infrastructure/configuration.h"
+
+namespace xpum {
+
+DeviceReader& DeviceReader::instance() {
+    static DeviceReader reader;
+    return reader;
+}
+
+DeviceReader::DeviceReader() : stop(false) {
+}
+
+DeviceReader::~DeviceReader() {
+    close();
+}
+
+std::future<void> DeviceReader::read(std::shared_ptr<Device> p_device, DeviceCapability capability, MeasurementRead& read) {
+    std::packaged_task<void()> task([p_device, capability, &read]() {
+        p_device->readMeasurement(capability, read);
+    });
+    auto completion = task.get_future();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    if (stop) {
+        lock.unlock();
+        task();
+        return completion;
+    }
+    if (workers.empty()) {
+        for (uint32_t i = 0; i < Configuration::DEVICE_READ_THREADS; i++) {
+            workers.emplace_back(&DeviceReader::run, this);
+        }
+    }
+    queue.push_back(std::move(task));
+    lock.unlock();
+    cv.notify_one();
+    return completion;
+}
+
+void DeviceReader::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        cv.wait(lock, [this] { return stop || !queue.empty(); });
+        if (queue.empty()) {
+            return;
+        }
+        auto task = std::move(queue.front());
+        queue.pop_front();
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+
+void DeviceReader::close() {
+    std::vector<std::thread> stopping;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+        stopping.swap(workers);
+    }
+    cv.notify_all();
+    for (auto& worker : stopping) {
+        worker.join();
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = false;
+}
+
+} // namespace xpum
@@ -0,0 +1,56 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file device_reader.h
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "device/device.h"
+
+namespace xpum {
+
+/*
+  Reads devices on Configuration::DEVICE_READ_THREADS worker threads, so
+  that the slow sysman calls of several devices are in flight together.
+  A read writes its result into the MeasurementRead of the caller, which
+  must live until the returned future is ready.
+*/
+
+class DeviceReader {
+   public:
+    static DeviceReader& instance();
+
+    std::future<void> read(std::shared_ptr<Device> p_device, DeviceCapability capability, MeasurementRead& read);
+
+    // finishes the queued reads and stops the workers, reads are done
+    // in the calling thread until the workers are restarted
+    void close();
+
+   private:
+    DeviceReader();
+
+    ~DeviceReader();
+
+    void run();
+
+    std::mutex mutex;
+
+    std::condition_variable cv;
+
+    std::deque<std::packaged_task<void()>> queue;
+
+    std::vector<std::thread> workers;
+
+    bool stop;
+};
+
+} // namespace xpum
@@ -139,11 +139,18 @@ void GPUDevice::getGPUUtilization(Callback_t callback) noexcept {
 
 void GPUDevice::getEngineUtilization(Callback_t callback) noexcept {
     GPUDeviceStub::instance().getEngineUtilization(zes_device_handle,
-                                                   [callback](std::shared_ptr<void> ret, std::shared_ptr<BaseException> e) {
+                                                   [this, callback](std::shared_ptr<void> ret, std::shared_ptr<BaseException> e) {
+                                                       if (ret != nullptr) {
+                                                           sortEngines(std::static_pointer_cast<EngineCollectionMeasurementData>(ret));
+                                                       }
                                                        callback(ret, e);
                                                    });
 }
 
+void GPUDevice::sortEngines(std::shared_ptr<EngineCollectionMeasurementData> p_data) {
+    p_data->sortEngines([this](uint64_t handle) { return getEngineIndex(handle); });
+}
+
 void GPUDevice::getEngineGroupUtilization(Callback_t callback, zes_engine_group_t engine_group_type) noexcept {
     GPUDeviceStub::instance().getEngineGroupUtilization(
         zes_device_handle,
@@ -283,11 +290,12 @@ xpum_result_t GPUDevice::runFirmwareFlash(RunGSCFirmwareFlashParam &param) noexc
         gscFwFlashPercent.store(0);
         flashFwErrMsg.clear();
         taskGSC = std::async(std::launch::async, [this, img, force] {
+            FlashSlot slot;
             std::string meiPath = getMeiDevicePath();
 
             if(meiPath.empty()){
                 flashFwErrMsg = "Can not find MEI device path";
-                unlock();
+                getOperationLock().unlockExclusive();
                 return xpum_firmware_flash_result_t::XPUM_DEVICE_FIRMWARE_FLASH_ERROR;
             }
 
@@ -311,7 +319,7 @@ xpum_result_t GPUDevice::runFirmwareFlash(RunGSCFirmwareFlashParam &param) noexc
                 flashFwErrMsg = "Cannot initialize device: " + meiPath + ". " + print_device_fw_status(&handle);
                 XPUM_LOG_ERROR("Cannot initialize device: {}. {}", meiPath, print_device_fw_status(&handle));
                 (void)igsc_device_close(&handle);
-                unlock();
+                getOperationLock().unlockExclusive();
                 return xpum_firmware_flash_result_t::XPUM_DEVICE_FIRMWARE_FLASH_ERROR;
             }
 
@@ -330,7 +338,7 @@ xpum_result_t GPUDevice::runFirmwareFlash(RunGSCFirmwareFlashParam &param) noexc
                 }
             }
 
-            ret = igsc_device_fw_update_ex(&handle, (const uint8_t*)img.data(), img.size(),
+            ret = igsc_device_fw_update_ex(&handle, img->data(), img->size(),
                                            progress_func, this, flags);
 
             if (rc6Enabled && this->getDeviceModel() == XPUM_DEVICE_MODEL_PVC) {
@@ -341,7 +349,7 @@ xpum_result_t GPUDevice::runFirmwareFlash(RunGSCFirmwareFlashParam &param) noexc
                 flashFwErrMsg = "Update process failed. " + print_device_fw_status(&handle);
                 XPUM_LOG_ERROR("Update process failed. {}", print_device_fw_status(&handle));
                 (void)igsc_device_close(&handle);
-                unlock();
+                getOperationLock().unlockExclusive();
                 return xpum_firmware_flash_result_t::XPUM_DEVICE_FIRMWARE_FLASH_ERROR;
             }
 
@@ -358,7 +366,7 @@ xpum_result_t GPUDevice::runFirmwareFlash(RunGSCFirmwareFlashParam &param) noexc
             }
 
             (void)igsc_device_close(&handle);
-            unlock();
+            getOperationLock().unlockExclusive();
             return xpum_firmware_flash_result_t::XPUM_DEVICE_FIRMWARE_FLASH_OK;
         });
 
@@ -10,6 +10,7 @@
 #include <mutex>
 
 #include "device/device.h"
+#include "infrastructure/engine_measurement_data.h"
 #include "stdio.h"
 
 namespace xpum {
@@ -57,6 +58,9 @@ class GPUDevice : public Device {
    private:
     void dumpFirmwareFlashLog() noexcept;
 
+    // orders the engines by the indexes given at discovery
+    void sortEngines(std::shared_ptr<EngineCollectionMeasurementData> p_data);
+
    private:
     //FILE* commandExec;
     std::future<xpum_firmware_flash_result_t>  taskGSC;
@@ -30,9 +30,12 @@
 
 #include "api/api_types.h"
 #include "api/device_model.h"
+#include "device/capability_cache.h"
 #include "device/frequency.h"
+#include "device/gpu/ras_sampler.h"
 #include "device/memoryEcc.h"
 #include "device/performancefactor.h"
+#include "device/platform_inventory.h"
 #include "device/scheduler.h"
 #include "device/standby.h"
 #include "gpu_device.h"
@@ -44,7 +47,6 @@
 #include "infrastructure/logger.h"
 #include "infrastructure/measurement_data.h"
 #include "infrastructure/utility.h"
-#include "firmware/system_cmd.h"
 #include "api/psc.h"
 #include "firmware/psc_txcal_blob.h"
 
@@ -78,9 +80,6 @@ void invokeTask(Callback_t callback, F&& f, Args&&... args) {
     }
 }
 
-// used for exclusively runing the RAS APIs to avoid two issues: 1) invalid read/write memory in zesRasGetState; 2) kernel error msg "mei-gsc mei-gscfi.3.auto: id exceeded 256"
-std::mutex ras_m;
-
 template <class F, class... Args>
 bool checkCapability(const char* device_name, const std::string& bdf_address, const char* capability_name, F&& f, Args&&... args) {
     auto detect_func = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
@@ -463,133 +462,6 @@ static std::deque<std::string> getParentPciBridges(const std::string& origin_str
     return res;
 }
 
-static const std::string SYSTEM_SLOT_NAME_MARKER("Designation:");
-static const std::string SYSTEM_SLOT_BUS_ADDRESS_MARKER("Bus Address:");
-static const std::string SYSTEM_SLOT_CURRENT_USAGE_MARKER("Current Usage:");
-static const std::string SYSTEM_INFO_IGNORED_STARTER(" \t");
-static const std::string SYSTEM_INFO_IGNORED_ENDER("\r\n");
-static std::string getValueAtMarker(const std::string& sysInfo, const std::string& marker) {
-    std::string res;
-    std::string spaces;
-    size_t mPos = sysInfo.find(marker);
-    if (mPos != std::string::npos) {
-        const int len = sysInfo.length();
-        int i = mPos + marker.length();
-        while (i < len && SYSTEM_INFO_IGNORED_STARTER.find(sysInfo.at(i)) != std::string::npos) i++;
-        char cc;
-        while (i < len && SYSTEM_INFO_IGNORED_ENDER.find(cc = sysInfo.at(i)) == std::string::npos) {
-            switch (cc) {
-                case ' ':
-                case '\t':
-                    spaces += cc;
-                    break;
-                default:
-                    if (!spaces.empty()) {
-                        res += spaces;
-                        spaces.clear();
-                    }
-                    res += cc;
-                    break;
-            }
-            i++;
-        }
-    }
-    return res;
-}
-
-static const std::string SYSTEM_SLOT_IN_USE("In Use");
-class DMISystemSlot {
-    std::string _name;
-    std::string _busAddress;
-    std::string _currentUsage;
-
-   public:
-    DMISystemSlot(const std::string& slotInfo) {
-        _name = getValueAtMarker(slotInfo, SYSTEM_SLOT_NAME_MARKER);
-        _busAddress = getValueAtMarker(slotInfo, SYSTEM_SLOT_BUS_ADDRESS_MARKER);
-        _currentUsage = getValueAtMarker(slotInfo, SYSTEM_SLOT_CURRENT_USAGE_MARKER);
-    }
-
-    const std::string& name() {
-        return _name;
-    }
-
-    const std::string& busAddress() {
-        return _busAddress;
-    }
-
-    const std::string& currentUsage() {
-        return _currentUsage;
-    }
-
-    bool inUse() {
-        return _currentUsage == SYSTEM_SLOT_IN_USE;
-    }
-};
-
-
-static const std::string SYSTEM_SLOT_MARKER("System Slot Information");
-static std::vector<DMISystemSlot> getSystemSlotBlocks(const std::string& ssInfos) {
-    std::vector<DMISystemSlot> res;
-    size_t curPos = 0;
-    size_t nextPos;
-    while ((nextPos = ssInfos.find(SYSTEM_SLOT_MARKER, curPos)) != std::string::npos) {
-        if (curPos > 0) {
-            res.push_back(DMISystemSlot(ssInfos.substr(curPos, nextPos - curPos)));
-        }
-        curPos = nextPos + SYSTEM_SLOT_MARKER.length();
-    }
-    if (curPos > 0) {
-        res.push_back(DMISystemSlot(ssInfos.substr(curPos)));
-    }
-    return res;
-}
-
-static std::string getCardFullPath(std::string& bdf_address) {
-    char link_path[PATH_MAX];
-    DIR *pdir = NULL;
-    struct dirent *pdirent = NULL;
-    int len = 0;
-    std::string ret = "";
-
-    pdir = opendir("/sys/class/drm");
-    if (pdir == NULL) {
-        return ret;
-    }
-
-    while ((pdirent = readdir(pdir)) != NULL) {
-        if (pdirent->d_name[0] == '.') {
-            continue;
-        }
-        if (strncmp(pdirent->d_name, "card", 4) != 0) {
-            continue;
-        }
-        if (strstr(pdirent->d_name, "-") != NULL) {
-            continue;
-        }
-        len = snprintf(link_path, PATH_MAX, "/sys/class/drm/%s", pdirent->d_name);
-        if (len <= 0 || len >= PATH_MAX) {
-            break;
-        }
-        char full_path[PATH_MAX];
-        ssize_t full_len = ::readlink(link_path, full_path, sizeof(full_path));
-        if (full_len < 0) {
-            full_len = 0;
-        }
-        if (full_len >= PATH_MAX) {
-            full_len = PATH_MAX -1;
-        }
-        full_path[full_len] = '\0';
-
-        if (strstr(full_path, bdf_address.c_str()) != NULL) {
-            ret = full_path;
-            break;
-        }
-    }
-    closedir(pdir);
-    return ret;
-}
-
 
 #define BUF_SIZE 128
 static bool readStrSysFsFile(char *buf, const char *fileName) {
@@ -629,77 +501,15 @@ bool GPUDeviceStub::isOamPlatform(ze_device_handle_t device){
 }
 
 std::string GPUDeviceStub::getOAMSocketId(zes_pci_address_t address) {
-    std::string bdf_address = to_string(address);
-    char link_path[PATH_MAX];
-    DIR *pdir = NULL;
-    struct dirent *pdirent = NULL;
-    int len = 0;
-    std::string ret = "";
-
-    pdir = opendir("/sys/class/drm");
-    if (pdir == NULL) {
-        return ret;
-    }
-
-    while ((pdirent = readdir(pdir)) != NULL) {
-        if (pdirent->d_name[0] == '.') {
-            continue;
-        }
-        
-        if (strstr(pdirent->d_name, "-") != NULL) {
-            continue;
-        }
-
-        if (!strncmp(pdirent->d_name, "card", 4)) {
-            len = snprintf(link_path, PATH_MAX, "/sys/class/drm/%s", pdirent->d_name);
-            if (len <= 0 || len >= PATH_MAX) {
-                break;
-            }
-            char full_path[PATH_MAX];
-            char card_path[PATH_MAX];
-            char socketId_buf[BUF_SIZE];
-
-            ssize_t full_len = ::readlink(link_path, full_path, sizeof(full_path));
-            if (full_len < 0) {
-                full_len = 0;
-            }
-            if (full_len >= PATH_MAX) {
-                full_len = PATH_MAX -1;
-            }
-            full_path[full_len] = '\0';
-            if (strstr(full_path, bdf_address.c_str()) != NULL) {
-                int cardLen = snprintf(card_path, PATH_MAX,"%s/iaf_socket_id",link_path);
-                if (cardLen <= 0 || cardLen >= PATH_MAX) {
-                    closedir(pdir);
-                    return ret;
-                }
-                if (readStrSysFsFile(socketId_buf, card_path) == false) {
-                    closedir(pdir);
-                    return ret;
-                } else {
-                    socketId_buf[strcspn(socketId_buf, "\n")] = '\0';
-                    if(!strncmp(socketId_buf, "0x1f", 4)) {
-                        closedir(pdir);
-                        return ret;
-                    }
-                    closedir(pdir);
-                    return socketId_buf;
-                }
-                break;
-            }
-        }
-    }
-    closedir(pdir);
-    return ret;
+    return PlatformInventory::get()->oamSocketId(to_string(address));
 }
 
 std::string GPUDeviceStub::getPciSlot(zes_pci_address_t address) {
     std::string res;
-    std::string bdf = to_string(address);
-    std::string card_full_path = getCardFullPath(bdf);
-    SystemCommandResult ss_res = execCommand("dmidecode -t 9 2>/dev/null");
+    auto inventory = PlatformInventory::get();
+    std::string card_full_path = inventory->cardFullPath(to_string(address));
 
-    if (card_full_path.size() > 0 && ss_res.exitStatus() == 0) {
+    if (card_full_path.size() > 0) {
         /* 
             Add a temporary workaround for SMC servers because they return
             GPU BDF as bus address of a slot. Here the BDF of a GPU would be 
@@ -712,96 +522,16 @@ std::string GPUDeviceStub::getPciSlot(zes_pci_address_t address) {
             is updated.  
         */
         std::deque<std::string> allBdf = getParentPciBridges(card_full_path);
-        std::vector<DMISystemSlot> systemSlots = getSystemSlotBlocks(ss_res.output());
         for (auto& pBdf : allBdf) {
-            for (auto& sysSlot : systemSlots) {
-                if (sysSlot.inUse() && sysSlot.busAddress() == pBdf) {
-                    res = sysSlot.name();
-                    break;
-                }
-                if (!res.empty()) break;
+            std::string slot = inventory->slotAt(pBdf);
+            if (!slot.empty()) {
+                res = slot;
             }
         }
     }
     return res;
 }
 
-static std::string getI915Version() {
-    std::string ret = "";
-    char buf[BUF_SIZE];
-
-    if (readStrSysFsFile(buf, "/sys/module/i915/version") != true) {
-        return ret;
-    }
-    std::string str(buf);
-    if (str.at(str.length() - 1) == '\n') {
-        str.pop_back();
-    }
-    size_t pos = str.rfind(' ');
-    if (pos == std::string::npos || pos == str.length() - 1) {
-        return ret;
-    }
-    ret = str.substr(pos + 1);
-    return ret;
-}
-
-static std::string getDriverVersion() {
-    std::string version;
-    // Try to get i915 backported version from sysfs first
-    version = getI915Version();
-    if (version.length() > 0) {
-        return version;
-    }
-
-    std::string release;
-    std::string name = "intel-i915-dkms";
-    std::string rpm_cmd = "rpm -qa 2>/dev/null| grep " + name + " 2>/dev/null";
-    SystemCommandResult rpm_res = execCommand(rpm_cmd);
-    if (rpm_res.exitStatus() == 0) {
-        std::string strData = rpm_res.output();
-        auto pos1 = strData.find(name);
-        if (pos1 == std::string::npos) {
-            return version;
-        }
-        pos1 += name.length();
-        pos1 = strData.find_first_of("0123456789",pos1);
-        auto pos2 = strData.find_first_of("-",pos1);
-        version = strData.substr(pos1,pos2-pos1);
-        pos1 = pos2 + 1;
-        pos2 = strData.find_first_of(".",pos1);
-        release = strData.substr(pos1,pos2-pos1);
-        version = version + "-" + release;
-    } else {
-        std::string deb_cmd = "dpkg -l 2>/dev/null| grep " + name + " 2>/dev/null";
-        SystemCommandResult deb_res = execCommand(deb_cmd);
-        if (deb_res.exitStatus() == 0) {
-            std::string strData = deb_res.output();
-            auto pos1 = strData.find(name);
-            if (pos1 == std::string::npos) {
-                return version;
-            }
-            pos1 += name.length();
-            pos1 = strData.find_first_of("0123456789", pos1);
-            auto pos2 = strData.find_first_of(" ", pos1);
-            version = strData.substr(pos1, pos2 - pos1);
-        }
-    }
-    return version;
-}
-
-static std::string getKernelVersion() {
-    std::string version;
-    std::string cmd = "uname -r";
-    SystemCommandResult res = execCommand(cmd);
-    if (res.exitStatus() == 0) {
-        version = res.output();
-        version.erase(std::remove_if(version.begin(), version.end(),
-                                     [](unsigned char x) { return !std::isprint(x); }),
-                      version.end());
-    }
-    return version;
-}
-
 static xpum_device_function_type_t getGPUFunctionType(std::string pci_addr) {
     DIR *dir;
     struct dirent *ent;
@@ -935,6 +665,15 @@ void GPUDeviceStub::addEuActiveStallIdleCapabilities(zes_device_handle_t device,
     }
 }
 
+bool GPUDeviceStub::isDeviceReachable(const zes_device_handle_t& device) {
+    // the state is read from the device, unlike the properties cached at zeInit
+    zes_device_state_t state = {};
+    state.stype = ZES_STRUCTURE_TYPE_DEVICE_STATE;
+    ze_result_t res;
+    XPUM_ZE_HANDLE_LOCK(device, res = zesDeviceGetState(device, &state));
+    return res != ZE_RESULT_ERROR_DEVICE_LOST && res != ZE_RESULT_ERROR_UNINITIALIZED;
+}
+
 void GPUDeviceStub::addEngineCapabilities(zes_device_handle_t device, const ze_device_properties_t& props, std::vector<DeviceCapability>& capabilities) {
     ze_result_t res;
     uint32_t engine_grp_count = 0;
@@ -1111,7 +850,8 @@ std::shared_ptr<std::vector<std::shared_ptr<Device>>> GPUDeviceStub::toDiscover(
     zeDriverGet(&driver_count, nullptr);
     std::vector<ze_driver_handle_t> drivers(driver_count);
     zeDriverGet(&driver_count, drivers.data());
-    std::vector<pci_addr_mei_device> pciAddrMeiDevices = getPCIAddrAndMeiDevices();
+    // slots, MEI devices and versions are looked up once for all the GPUs
+    auto inventory = PlatformInventory::get();
 
     std::mutex devices_mtx;
 
@@ -1155,9 +895,32 @@ std::shared_ptr<std::vector<std::shared_ptr<Device>>> GPUDeviceStub::toDiscover(
             }
 
             if (ze_props.type == ZE_DEVICE_TYPE_GPU) {
-                addCapabilities(device, ze_props, capabilities);
-                addEngineCapabilities(device, ze_props, capabilities);
-                addEuActiveStallIdleCapabilities(device, ze_props, p_driver, capabilities);
+                std::string cap_key = CapabilityCache::key(ze_props, driver_prop);
+                if (CapabilityCache::instance().lookup(cap_key, capabilities)) {
+                    /*
+                      The EU probe opens a metric streamer, which fails while
+                      the monitoring holds one, so a cached EU capability is
+                      kept as is.
+                    */
+                    bool eu_cap = std::find(capabilities.begin(), capabilities.end(), DeviceCapability::METRIC_EU_ACTIVE_STALL_IDLE) != capabilities.end();
+                    ze_driver_handle_t driver = p_driver;
+                    CapabilityCache::instance().revalidateLater(cap_key, [device, ze_props, driver, eu_cap] {
+                        std::vector<DeviceCapability> probed;
+                        addCapabilities(device, ze_props, probed);
+                        addEngineCapabilities(device, ze_props, probed);
+                        if (eu_cap) {
+                            probed.push_back(DeviceCapability::METRIC_EU_ACTIVE_STALL_IDLE);
+                        } else {
+                            addEuActiveStallIdleCapabilities(device, ze_props, driver, probed);
+                        }
+                        return probed;
+                    });
+                } else {
+                    addCapabilities(device, ze_props, capabilities);
+                    addEngineCapabilities(device, ze_props, capabilities);
+                    addEuActiveStallIdleCapabilities(device, ze_props, p_driver, capabilities);
+                    CapabilityCache::instance().store(cap_key, capabilities);
+                }
                 logSupportedMetrics(device, ze_props, capabilities);
                 auto p_gpu = std::make_shared<GPUDevice>(std::to_string(i), zes_device, device, p_driver, capabilities);
                 p_gpu->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_DEVICE_TYPE, std::string("GPU")));
@@ -1165,8 +928,8 @@ std::shared_ptr<std::vector<std::shared_ptr<Device>>> GPUDeviceStub::toDiscover(
                 p_gpu->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_DEVICE_NAME, std::string(ze_props.name)));
                 // p_gpu->addProperty(Property(DeviceProperty::BOARD_NUMBER,std::string(props.boardNumber)));
                 // p_gpu->addProperty(Property(DeviceProperty::BRAND_NAME,std::string(props.brandName)));
-                p_gpu->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_DRIVER_VERSION, getDriverVersion()));
-                p_gpu->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_LINUX_KERNEL_VERSION, getKernelVersion()));
+                p_gpu->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_DRIVER_VERSION, inventory->driverVersion()));
+                p_gpu->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_LINUX_KERNEL_VERSION, inventory->kernelVersion()));
                 p_gpu->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_SERIAL_NUMBER, std::string(props.boardNumber)));
                 p_gpu->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_VENDOR_NAME, std::string(props.vendorName)));
                 p_gpu->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_CORE_CLOCK_RATE_MHZ, std::to_string(ze_props.coreClockRate)));
@@ -1308,7 +1071,7 @@ std::shared_ptr<std::vector<std::shared_ptr<Device>>> GPUDeviceStub::toDiscover(
                 addPCIeProperties(device, p_gpu);
                 
                 if (func_type == DEVICE_FUNCTION_TYPE_PHYSICAL) {
-                    toSetMeiDevicePath(p_gpu, pciAddrMeiDevices);
+                    toSetMeiDevicePath(p_gpu, inventory->meiDevices());
                     std::string sku_type = "";
                     p_gpu->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_SKU_TYPE, sku_type));
                 }
@@ -1345,6 +1108,7 @@ std::shared_ptr<std::vector<std::shared_ptr<Device>>> GPUDeviceStub::toDiscover(
         }
     });
 
+    CapabilityCache::instance().flush();
     return p_devices;
 }
 
@@ -2235,39 +1999,17 @@ void GPUDeviceStub::getRasError(const zes_device_handle_t& device, Callback_t ca
 
 std::shared_ptr<MeasurementData> GPUDeviceStub::toGetRasError(const zes_device_handle_t& device, const zes_ras_error_cat_t& rasCat, const zes_ras_error_type_t& rasType) {
     //rasCat: ZES_RAS_ERROR_CAT_RESET; rasType: ZES_RAS_ERROR_TYPE_CORRECTABLE,ZES_RAS_ERROR_TYPE_UNCORRECTABLE
-    if (device == nullptr) {
+    auto ras_sample = RasSampler::instance().get(device);
+    if (ras_sample == nullptr) {
         throw BaseException("toGetRasError error");
     }
-    uint32_t numRasErrorSets = 0;
-    ze_result_t res;
-    XPUM_ZE_HANDLE_LOCK(device, res = zesDeviceEnumRasErrorSets(device, &numRasErrorSets, nullptr));
-    if (res == ZE_RESULT_SUCCESS && numRasErrorSets > 0) {
-        std::vector<zes_ras_handle_t> phRasErrorSets(numRasErrorSets);
-        XPUM_ZE_HANDLE_LOCK(device, res = zesDeviceEnumRasErrorSets(device, &numRasErrorSets, phRasErrorSets.data()));
-        if (res == ZE_RESULT_SUCCESS) {
-            uint64_t rasCounter = 0;
-            for (auto& rasHandle : phRasErrorSets) {
-                // globally lock for RAS APIs to avoid two issues: 1) invalid read/write memory in zesRasGetState; 2) kernel error msg "mei-gsc mei-gscfi.3.auto: id exceeded 256"
-                std::lock_guard<std::mutex> lock(ras_m);
-                zes_ras_properties_t props = {};
-                props.stype = ZES_STRUCTURE_TYPE_RAS_PROPERTIES;
-                XPUM_ZE_HANDLE_LOCK(rasHandle, res = zesRasGetProperties(rasHandle, &props));
-                if (res == ZE_RESULT_SUCCESS) {
-                    //if (props.supported && props.enabled) {
-                    if (props.type == rasType) {
-                        zes_ras_state_t errorDetails = {};
-                        XPUM_ZE_HANDLE_LOCK(rasHandle, res = zesRasGetState(rasHandle, 0, &errorDetails));
-                        if (res == ZE_RESULT_SUCCESS) {
-                            rasCounter += errorDetails.category[rasCat];
-                        }
-                    }
-                    //}
-                }
-            }
-            return std::make_shared<MeasurementData>(rasCounter);
+    uint64_t rasCounter = 0;
+    for (auto& error_set : ras_sample->error_sets) {
+        if (error_set.props.type == rasType) {
+            rasCounter += error_set.state.category[rasCat];
         }
     }
-    throw BaseException("toGetRasError error");
+    return std::make_shared<MeasurementData>(rasCounter);
 }
 
 void GPUDeviceStub::getRasErrorOnSubdevice(const zes_device_handle_t& device, Callback_t callback) noexcept {
@@ -2280,76 +2022,47 @@ void GPUDeviceStub::getRasErrorOnSubdevice(const zes_device_handle_t& device, Ca
 
 std::shared_ptr<MeasurementData> GPUDeviceStub::toGetRasErrorOnSubdevice(const zes_device_handle_t& device) {
     //rasCat: ZES_RAS_ERROR_CAT_RESET; rasType: ZES_RAS_ERROR_TYPE_CORRECTABLE,ZES_RAS_ERROR_TYPE_UNCORRECTABLE
-    if (device == nullptr) {
+    auto ras_sample = RasSampler::instance().get(device);
+    if (ras_sample == nullptr) {
         throw BaseException("toGetRasErrorOnSubdevice error");
     }
 
-    ////
     bool dataAcquired = false;
     std::shared_ptr<MeasurementData> ret = std::make_shared<MeasurementData>();
-    uint32_t subdeviceId = UINT32_MAX;
     uint64_t rasCounter = 0;
-    uint32_t numRasErrorSets = 0;
-    ze_result_t res;
-    zes_ras_state_t errorDetails = {};
-
-    ////
-    XPUM_ZE_HANDLE_LOCK(device, res = zesDeviceEnumRasErrorSets(device, &numRasErrorSets, nullptr));
-    if (res == ZE_RESULT_SUCCESS && numRasErrorSets > 0) {
-        std::vector<zes_ras_handle_t> phRasErrorSets(numRasErrorSets);
-        XPUM_ZE_HANDLE_LOCK(device, res = zesDeviceEnumRasErrorSets(device, &numRasErrorSets, phRasErrorSets.data()));
-        if (res == ZE_RESULT_SUCCESS) {
-            //uint64_t rasCounter = 0;
-            for (auto& rasHandle : phRasErrorSets) {
-                // globally lock for RAS APIs to avoid two issues: 1) invalid read/write memory in zesRasGetState; 2) kernel error msg "mei-gsc mei-gscfi.3.auto: id exceeded 256"
-                std::lock_guard<std::mutex> lock(ras_m);
-                zes_ras_properties_t props = {};
-                props.stype = ZES_STRUCTURE_TYPE_RAS_PROPERTIES;
-                XPUM_ZE_HANDLE_LOCK(rasHandle, res = zesRasGetProperties(rasHandle, &props));
-                if (res == ZE_RESULT_SUCCESS) {
-                    //if (props.supported && props.enabled) {
-                    if (props.type == ZES_RAS_ERROR_TYPE_UNCORRECTABLE) {
-                        XPUM_ZE_HANDLE_LOCK(rasHandle, res = zesRasGetState(rasHandle, 0, &errorDetails));
-                        if (res == ZE_RESULT_SUCCESS) {
-                            subdeviceId = props.onSubdevice ? props.subdeviceId : UINT32_MAX;
-                            //
-                            rasCounter = errorDetails.category[ZES_RAS_ERROR_CAT_RESET];
-                            props.onSubdevice ? ret->setSubdeviceDataCurrent(subdeviceId, rasCounter) : ret->setCurrent(rasCounter);
-                            //
-                            rasCounter = errorDetails.category[ZES_RAS_ERROR_CAT_PROGRAMMING_ERRORS];
-                            ret->setSubdeviceAdditionalData(subdeviceId, METRIC_RAS_ERROR_CAT_PROGRAMMING_ERRORS, rasCounter);
-                            rasCounter = errorDetails.category[ZES_RAS_ERROR_CAT_DRIVER_ERRORS];
-                            ret->setSubdeviceAdditionalData(subdeviceId, METRIC_RAS_ERROR_CAT_DRIVER_ERRORS, rasCounter);
-                            //
-                            rasCounter = errorDetails.category[ZES_RAS_ERROR_CAT_CACHE_ERRORS];
-                            ret->setSubdeviceAdditionalData(subdeviceId, METRIC_RAS_ERROR_CAT_CACHE_ERRORS_UNCORRECTABLE, rasCounter);
-                            rasCounter = errorDetails.category[ZES_RAS_ERROR_CAT_DISPLAY_ERRORS];
-                            ret->setSubdeviceAdditionalData(subdeviceId, METRIC_RAS_ERROR_CAT_DISPLAY_ERRORS_UNCORRECTABLE, rasCounter);
-                            rasCounter = errorDetails.category[ZES_RAS_ERROR_CAT_NON_COMPUTE_ERRORS];
-                            ret->setSubdeviceAdditionalData(subdeviceId, METRIC_RAS_ERROR_CAT_NON_COMPUTE_ERRORS_UNCORRECTABLE, rasCounter);
-                            dataAcquired = true;
-                        }
-                    } else if (props.type == ZES_RAS_ERROR_TYPE_CORRECTABLE) {
-                        XPUM_ZE_HANDLE_LOCK(rasHandle, res = zesRasGetState(rasHandle, 0, &errorDetails));
-                        if (res == ZE_RESULT_SUCCESS) {
-                            subdeviceId = props.onSubdevice ? props.subdeviceId : UINT32_MAX;
-                            //
-                            rasCounter = errorDetails.category[ZES_RAS_ERROR_CAT_CACHE_ERRORS];
-                            ret->setSubdeviceAdditionalData(subdeviceId, METRIC_RAS_ERROR_CAT_CACHE_ERRORS_CORRECTABLE, rasCounter);
-                            rasCounter = errorDetails.category[ZES_RAS_ERROR_CAT_DISPLAY_ERRORS];
-                            ret->setSubdeviceAdditionalData(subdeviceId, METRIC_RAS_ERROR_CAT_DISPLAY_ERRORS_CORRECTABLE, rasCounter);
-                            rasCounter = errorDetails.category[ZES_RAS_ERROR_CAT_NON_COMPUTE_ERRORS];
-                            ret->setSubdeviceAdditionalData(subdeviceId, METRIC_RAS_ERROR_CAT_NON_COMPUTE_ERRORS_CORRECTABLE, rasCounter);
-                            dataAcquired = true;
-                        }
-                    }
-                    //}
-                }
-            }
-            //return std::make_shared<MeasurementData>(rasCounter);
-        }
-    }
-    if (res == ZE_RESULT_SUCCESS && dataAcquired) {
+    for (auto& error_set : ras_sample->error_sets) {
+        auto& props = error_set.props;
+        auto& errorDetails = error_set.state;
+        uint32_t subdeviceId = props.onSubdevice ? props.subdeviceId : UINT32_MAX;
+        if (props.type == ZES_RAS_ERROR_TYPE_UNCORRECTABLE) {
+            //
+            rasCounter = errorDetails.category[ZES_RAS_ERROR_CAT_RESET];
+            props.onSubdevice ? ret->setSubdeviceDataCurrent(subdeviceId, rasCounter) : ret->setCurrent(rasCounter);
+            //
+            rasCounter = errorDetails.category[ZES_RAS_ERROR_CAT_PROGRAMMING_ERRORS];
+            ret->setSubdeviceAdditionalData(subdeviceId, METRIC_RAS_ERROR_CAT_PROGRAMMING_ERRORS, rasCounter);
+            rasCounter = errorDetails.category[ZES_RAS_ERROR_CAT_DRIVER_ERRORS];
+            ret->setSubdeviceAdditionalData(subdeviceId, METRIC_RAS_ERROR_CAT_DRIVER_ERRORS, rasCounter);
+            //
+            rasCounter = errorDetails.category[ZES_RAS_ERROR_CAT_CACHE_ERRORS];
+            ret->setSubdeviceAdditionalData(subdeviceId, METRIC_RAS_ERROR_CAT_CACHE_ERRORS_UNCORRECTABLE, rasCounter);
+            rasCounter = errorDetails.category[ZES_RAS_ERROR_CAT_DISPLAY_ERRORS];
+            ret->setSubdeviceAdditionalData(subdeviceId, METRIC_RAS_ERROR_CAT_DISPLAY_ERRORS_UNCORRECTABLE, rasCounter);
+            rasCounter = errorDetails.category[ZES_RAS_ERROR_CAT_NON_COMPUTE_ERRORS];
+            ret->setSubdeviceAdditionalData(subdeviceId, METRIC_RAS_ERROR_CAT_NON_COMPUTE_ERRORS_UNCORRECTABLE, rasCounter);
+            dataAcquired = true;
+        } else if (props.type == ZES_RAS_ERROR_TYPE_CORRECTABLE) {
+            //
+            rasCounter = errorDetails.category[ZES_RAS_ERROR_CAT_CACHE_ERRORS];
+            ret->setSubdeviceAdditionalData(subdeviceId, METRIC_RAS_ERROR_CAT_CACHE_ERRORS_CORRECTABLE, rasCounter);
+            rasCounter = errorDetails.category[ZES_RAS_ERROR_CAT_DISPLAY_ERRORS];
+            ret->setSubdeviceAdditionalData(subdeviceId, METRIC_RAS_ERROR_CAT_DISPLAY_ERRORS_CORRECTABLE, rasCounter);
+            rasCounter = errorDetails.category[ZES_RAS_ERROR_CAT_NON_COMPUTE_ERRORS];
+            ret->setSubdeviceAdditionalData(subdeviceId, METRIC_RAS_ERROR_CAT_NON_COMPUTE_ERRORS_CORRECTABLE, rasCounter);
+            dataAcquired = true;
+        }
+    }
+    if (dataAcquired) {
         return ret;
     } else {
         throw BaseException("toGetRasErrorOnSubdevice error");
@@ -2362,50 +2075,25 @@ void GPUDeviceStub::getRasError(const zes_device_handle_t& device, uint64_t erro
         errorCategory[i] = 0;
     }
 
-    if (device == nullptr) {
+    auto ras_sample = RasSampler::instance().get(device);
+    if (ras_sample == nullptr) {
         return;
     }
 
-    //
-    uint32_t numRasErrorSets = 0;
-    ze_result_t res;
-    XPUM_ZE_HANDLE_LOCK(device, res = zesDeviceEnumRasErrorSets(device, &numRasErrorSets, nullptr));
-    if (res == ZE_RESULT_SUCCESS) {
-        std::vector<zes_ras_handle_t> phRasErrorSets(numRasErrorSets);
-        XPUM_ZE_HANDLE_LOCK(device, res = zesDeviceEnumRasErrorSets(device, &numRasErrorSets, phRasErrorSets.data()));
-        if (res == ZE_RESULT_SUCCESS) {
-            for (auto& rasHandle : phRasErrorSets) {
-                // globally lock for RAS APIs to avoid two issues: 1) invalid read/write memory in zesRasGetState; 2) kernel error msg "mei-gsc mei-gscfi.3.auto: id exceeded 256"
-                std::lock_guard<std::mutex> lock(ras_m);
-                zes_ras_properties_t props = {};
-                props.stype = ZES_STRUCTURE_TYPE_RAS_PROPERTIES;
-                XPUM_ZE_HANDLE_LOCK(rasHandle, res = zesRasGetProperties(rasHandle, &props));
-                if (res == ZE_RESULT_SUCCESS) {
-                    if (props.type == ZES_RAS_ERROR_TYPE_CORRECTABLE) {
-                        zes_ras_state_t errorDetails = {};
-                        XPUM_ZE_HANDLE_LOCK(rasHandle, res = zesRasGetState(rasHandle, 0, &errorDetails));
-                        if (res == ZE_RESULT_SUCCESS) {
-                            errorCategory[XPUM_RAS_ERROR_CAT_CACHE_ERRORS_CORRECTABLE] += errorDetails.category[ZES_RAS_ERROR_CAT_CACHE_ERRORS];
-                            errorCategory[XPUM_RAS_ERROR_CAT_DISPLAY_ERRORS_CORRECTABLE] += errorDetails.category[ZES_RAS_ERROR_CAT_DISPLAY_ERRORS];
-                        }
-                    } else if (props.type == ZES_RAS_ERROR_TYPE_UNCORRECTABLE) {
-                        zes_ras_state_t errorDetails = {};
-                        XPUM_ZE_HANDLE_LOCK(rasHandle, res = zesRasGetState(rasHandle, 0, &errorDetails));
-                        if (res == ZE_RESULT_SUCCESS) {
-                            errorCategory[XPUM_RAS_ERROR_CAT_RESET] += errorDetails.category[ZES_RAS_ERROR_CAT_RESET];
-                            errorCategory[XPUM_RAS_ERROR_CAT_PROGRAMMING_ERRORS] += errorDetails.category[ZES_RAS_ERROR_CAT_PROGRAMMING_ERRORS];
-                            errorCategory[XPUM_RAS_ERROR_CAT_DRIVER_ERRORS] += errorDetails.category[ZES_RAS_ERROR_CAT_DRIVER_ERRORS];
-                            //
-                            errorCategory[XPUM_RAS_ERROR_CAT_CACHE_ERRORS_UNCORRECTABLE] += errorDetails.category[ZES_RAS_ERROR_CAT_CACHE_ERRORS];
-                            errorCategory[XPUM_RAS_ERROR_CAT_DISPLAY_ERRORS_UNCORRECTABLE] += errorDetails.category[ZES_RAS_ERROR_CAT_DISPLAY_ERRORS];
-                        }
-                    }
-                }
-            }
-            return;
+    for (auto& error_set : ras_sample->error_sets) {
+        auto& errorDetails = error_set.state;
+        if (error_set.props.type == ZES_RAS_ERROR_TYPE_CORRECTABLE) {
+            errorCategory[XPUM_RAS_ERROR_CAT_CACHE_ERRORS_CORRECTABLE] += errorDetails.category[ZES_RAS_ERROR_CAT_CACHE_ERRORS];
+            errorCategory[XPUM_RAS_ERROR_CAT_DISPLAY_ERRORS_CORRECTABLE] += errorDetails.category[ZES_RAS_ERROR_CAT_DISPLAY_ERRORS];
+        } else if (error_set.props.type == ZES_RAS_ERROR_TYPE_UNCORRECTABLE) {
+            errorCategory[XPUM_RAS_ERROR_CAT_RESET] += errorDetails.category[ZES_RAS_ERROR_CAT_RESET];
+            errorCategory[XPUM_RAS_ERROR_CAT_PROGRAMMING_ERRORS] += errorDetails.category[ZES_RAS_ERROR_CAT_PROGRAMMING_ERRORS];
+            errorCategory[XPUM_RAS_ERROR_CAT_DRIVER_ERRORS] += errorDetails.category[ZES_RAS_ERROR_CAT_DRIVER_ERRORS];
+            //
+            errorCategory[XPUM_RAS_ERROR_CAT_CACHE_ERRORS_UNCORRECTABLE] += errorDetails.category[ZES_RAS_ERROR_CAT_CACHE_ERRORS];
+            errorCategory[XPUM_RAS_ERROR_CAT_DISPLAY_ERRORS_UNCORRECTABLE] += errorDetails.category[ZES_RAS_ERROR_CAT_DISPLAY_ERRORS];
         }
     }
-    //throw BaseException("getRasError error");
 }
 
 void GPUDeviceStub::getRasErrorOnSubdevice(const zes_device_handle_t& device, Callback_t callback, const zes_ras_error_cat_t& rasCat, const zes_ras_error_type_t& rasType) noexcept {
@@ -2418,45 +2106,21 @@ void GPUDeviceStub::getRasErrorOnSubdevice(const zes_device_handle_t& device, Ca
 
 std::shared_ptr<MeasurementData> GPUDeviceStub::toGetRasErrorOnSubdeviceOld(const zes_device_handle_t& device, const zes_ras_error_cat_t& rasCat, const zes_ras_error_type_t& rasType) {
     //rasCat: ZES_RAS_ERROR_CAT_RESET; rasType: ZES_RAS_ERROR_TYPE_CORRECTABLE,ZES_RAS_ERROR_TYPE_UNCORRECTABLE
-    if (device == nullptr) {
+    auto ras_sample = RasSampler::instance().get(device);
+    if (ras_sample == nullptr) {
         throw BaseException("toGetRasErrorOnSubdevice error");
     }
     bool dataAcquired = false;
     std::shared_ptr<MeasurementData> ret = std::make_shared<MeasurementData>();
-
-    ////
-    uint32_t numRasErrorSets = 0;
-    ze_result_t res;
-    XPUM_ZE_HANDLE_LOCK(device, res = zesDeviceEnumRasErrorSets(device, &numRasErrorSets, nullptr));
-    if (res == ZE_RESULT_SUCCESS && numRasErrorSets > 0) {
-        std::vector<zes_ras_handle_t> phRasErrorSets(numRasErrorSets);
-        XPUM_ZE_HANDLE_LOCK(device, res = zesDeviceEnumRasErrorSets(device, &numRasErrorSets, phRasErrorSets.data()));
-        if (res == ZE_RESULT_SUCCESS) {
-            //uint64_t rasCounter = 0;
-            for (auto& rasHandle : phRasErrorSets) {
-                // globally lock for RAS APIs to avoid two issues: 1) invalid read/write memory in zesRasGetState; 2) kernel error msg "mei-gsc mei-gscfi.3.auto: id exceeded 256"
-                std::lock_guard<std::mutex> lock(ras_m);
-                zes_ras_properties_t props = {};
-                props.stype = ZES_STRUCTURE_TYPE_RAS_PROPERTIES;
-                XPUM_ZE_HANDLE_LOCK(rasHandle, res = zesRasGetProperties(rasHandle, &props));
-                if (res == ZE_RESULT_SUCCESS) {
-                    //if (props.supported && props.enabled) {
-                    if (props.type == rasType) {
-                        zes_ras_state_t errorDetails = {};
-                        XPUM_ZE_HANDLE_LOCK(rasHandle, res = zesRasGetState(rasHandle, 0, &errorDetails));
-                        if (res == ZE_RESULT_SUCCESS) {
-                            uint64_t rasCounter = errorDetails.category[rasCat];
-                            props.onSubdevice ? ret->setSubdeviceDataCurrent(props.subdeviceId, rasCounter) : ret->setCurrent(rasCounter);
-                            dataAcquired = true;
-                        }
-                    }
-                    //}
-                }
-            }
-            //return std::make_shared<MeasurementData>(rasCounter);
+    for (auto& error_set : ras_sample->error_sets) {
+        auto& props = error_set.props;
+        if (props.type == rasType) {
+            uint64_t rasCounter = error_set.state.category[rasCat];
+            props.onSubdevice ? ret->setSubdeviceDataCurrent(props.subdeviceId, rasCounter) : ret->setCurrent(rasCounter);
+            dataAcquired = true;
         }
     }
-    if (res == ZE_RESULT_SUCCESS && dataAcquired) {
+    if (dataAcquired) {
         return ret;
     } else {
         throw BaseException("toGetRasErrorOnSubdevice error");
@@ -2571,6 +2235,10 @@ std::shared_ptr<EngineCollectionMeasurementData> GPUDeviceStub::toGetEngineUtili
                 props.pNext = nullptr;
                 XPUM_ZE_HANDLE_LOCK(engine, res = zesEngineGetProperties(engine, &props));
                 if (res == ZE_RESULT_SUCCESS) {
+                    // engine groups are reported by the engine group utilization metrics
+                    if (props.type != ZES_ENGINE_GROUP_COMPUTE_SINGLE && props.type != ZES_ENGINE_GROUP_RENDER_SINGLE && props.type != ZES_ENGINE_GROUP_MEDIA_DECODE_SINGLE && props.type != ZES_ENGINE_GROUP_MEDIA_ENCODE_SINGLE && props.type != ZES_ENGINE_GROUP_COPY_SINGLE && props.type != ZES_ENGINE_GROUP_MEDIA_ENHANCEMENT_SINGLE && props.type != ZES_ENGINE_GROUP_3D_SINGLE) {
+                        continue;
+                    }
                     zes_engine_stats_t snap = {};
                     XPUM_ZE_HANDLE_LOCK(engine, res = zesEngineGetActivity(engine, &snap));
                     if (res == ZE_RESULT_SUCCESS) {
@@ -4746,17 +4414,7 @@ void GPUDeviceStub::readPerfMetricsData(std::shared_ptr<std::map<uint32_t, std::
 }
 
 std::string GPUDeviceStub::getPciSlotByPath(std::vector<std::string> pciPath) {
-    std::string ret;
-    SystemCommandResult res = execCommand("dmidecode -t 9 2>/dev/null");
-    std::vector<DMISystemSlot> slots = getSystemSlotBlocks(res.output());
-    for (auto &slot : slots) {
-        for (auto &node : pciPath) {
-            if (slot.inUse() && slot.busAddress() == node) {
-                return slot.name();
-            }
-        }
-    } 
-    return ret;
+    return PlatformInventory::get()->slotByPath(pciPath);
 }
 
 } // end namespace xpum
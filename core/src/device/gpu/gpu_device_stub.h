@@ -9,6 +9,7 @@
 #include <dirent.h>
 #include <dlfcn.h>
 
+#include <set>
 #include <string>
 
 #include "device/device.h"
@@ -59,6 +60,10 @@ class GPUDeviceStub {
    public:
     void discoverDevices(Callback_t callback);
 
+    // false once Level Zero lost the device, e.g. after its driver was
+    // unbound: the handles come from zeInit and are not enumerated again
+    static bool isDeviceReachable(const zes_device_handle_t& device);
+
     void getPower(const zes_device_handle_t& device, Callback_t callback) noexcept;
 
     void getActuralRequestFrequency(const zes_device_handle_t& device, Callback_t callback) noexcept;
@@ -0,0 +1,144 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file ras_sampler.cpp
+ */
+
+#include "ras_sampler.h"
+
+#include <chrono>
+
+#include "infrastructure/configuration.h"
+#include "infrastructure/handle_lock.h"
+#include "infrastructure/logger.h"
+#include "infrastructure/utility.h"
+
+namespace xpum {
+
+RasSampler& RasSampler::instance() {
+    static RasSampler sampler;
+    return sampler;
+}
+
+RasSampler::~RasSampler() {
+    close();
+}
+
+std::shared_ptr<RasSampler::Lane> RasSampler::lane(const zes_device_handle_t& device) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& lane = lanes[device];
+    if (lane == nullptr) {
+        lane = std::make_shared<Lane>();
+    }
+    if (!worker.joinable() && !stop) {
+        worker = std::thread(&RasSampler::run, this);
+    }
+    return lane;
+}
+
+std::shared_ptr<const RasSample> RasSampler::get(const zes_device_handle_t& device) {
+    if (device == nullptr) {
+        return nullptr;
+    }
+    auto lane = this->lane(device);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (lane->sampled) {
+            return lane->last;
+        }
+    }
+    return sample(device);
+}
+
+std::shared_ptr<const RasSample> RasSampler::sample(const zes_device_handle_t& device) {
+    if (device == nullptr) {
+        return nullptr;
+    }
+    return sample(device, this->lane(device));
+}
+
+std::shared_ptr<const RasSample> RasSampler::sample(const zes_device_handle_t& device, const std::shared_ptr<Lane>& lane) {
+    std::lock_guard<std::mutex> sampling(lane->sampling);
+    auto ras_sample = read(device);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    lane->sampled = true;
+    // a failed sample keeps the previous one
+    if (ras_sample != nullptr) {
+        lane->last = ras_sample;
+    }
+    return ras_sample;
+}
+
+std::shared_ptr<const RasSample> RasSampler::read(const zes_device_handle_t& device) {
+    uint32_t numRasErrorSets = 0;
+    ze_result_t res;
+    XPUM_ZE_HANDLE_LOCK(device, res = zesDeviceEnumRasErrorSets(device, &numRasErrorSets, nullptr));
+    if (res != ZE_RESULT_SUCCESS || numRasErrorSets == 0) {
+        return nullptr;
+    }
+    std::vector<zes_ras_handle_t> phRasErrorSets(numRasErrorSets);
+    XPUM_ZE_HANDLE_LOCK(device, res = zesDeviceEnumRasErrorSets(device, &numRasErrorSets, phRasErrorSets.data()));
+    if (res != ZE_RESULT_SUCCESS) {
+        return nullptr;
+    }
+
+    auto ras_sample = std::make_shared<RasSample>();
+    ras_sample->timestamp = Utility::getCurrentMillisecond();
+    for (auto& rasHandle : phRasErrorSets) {
+        RasErrorSet error_set = {};
+        error_set.props.stype = ZES_STRUCTURE_TYPE_RAS_PROPERTIES;
+        XPUM_ZE_HANDLE_LOCK(rasHandle, res = zesRasGetProperties(rasHandle, &error_set.props));
+        if (res != ZE_RESULT_SUCCESS) {
+            continue;
+        }
+        XPUM_ZE_HANDLE_LOCK(rasHandle, res = zesRasGetState(rasHandle, 0, &error_set.state));
+        if (res != ZE_RESULT_SUCCESS) {
+            continue;
+        }
+        ras_sample->error_sets.push_back(error_set);
+    }
+    return ras_sample;
+}
+
+void RasSampler::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stop) {
+        cv.wait_for(lock, std::chrono::milliseconds(Configuration::RAS_SAMPLING_INTERVAL), [this] { return stop; });
+        if (stop) {
+            break;
+        }
+        // a lane forgotten meanwhile is sampled once more, but not added back
+        std::vector<std::pair<zes_device_handle_t, std::shared_ptr<Lane>>> devices(lanes.begin(), lanes.end());
+        lock.unlock();
+        Utility::parallel_in_batches(devices.size(), devices.size(), [&](int start, int end) {
+            for (int i = start; i < end; i++) {
+                if (sample(devices[i].first, devices[i].second) == nullptr) {
+                    XPUM_LOG_DEBUG("Failed to sample RAS errors of device {}", (void*)devices[i].first);
+                }
+            }
+        });
+        lock.lock();
+    }
+}
+
+void RasSampler::forget(const zes_device_handle_t& device) {
+    std::lock_guard<std::mutex> lock(mutex);
+    lanes.erase(device);
+}
+
+void RasSampler::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    cv.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    lanes.clear();
+    stop = false;
+}
+
+} // namespace xpum
@@ -0,0 +1,95 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file ras_sampler.h
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "level_zero/zes_api.h"
+
+namespace xpum {
+
+struct RasErrorSet {
+    zes_ras_properties_t props;
+    zes_ras_state_t state;
+};
+
+struct RasSample {
+    // milliseconds since the epoch
+    long long timestamp;
+    std::vector<RasErrorSet> error_sets;
+};
+
+/*
+  RAS error states of the devices, sampled in the background every
+  Configuration::RAS_SAMPLING_INTERVAL so that the monitor, the realtime
+  queries and the health checks get the last sample instead of calling
+  zesRasGetState themselves.
+
+  The RAS APIs of a device are called by one thread at a time, to avoid
+  invalid memory accesses in zesRasGetState and the kernel error
+  "mei-gsc mei-gscfi.3.auto: id exceeded 256", but the devices, each with
+  its own MEI interface, are sampled in parallel.
+*/
+
+class RasSampler {
+   public:
+    static RasSampler& instance();
+
+    // the last sample of the device, sampled now when the device was never
+    // sampled; nullptr when the RAS error sets of the device could not be
+    // read so far, which is not retried before the next background sample
+    std::shared_ptr<const RasSample> get(const zes_device_handle_t& device);
+
+    // samples the device now
+    std::shared_ptr<const RasSample> sample(const zes_device_handle_t& device);
+
+    // stops sampling the device, which has been removed
+    void forget(const zes_device_handle_t& device);
+
+    // stops the background sampling and drops the samples
+    void close();
+
+   private:
+    struct Lane {
+        // held while the RAS APIs of the device are called
+        std::mutex sampling;
+
+        std::shared_ptr<const RasSample> last;
+
+        // set by the first sample, also when it failed
+        bool sampled = false;
+    };
+
+    RasSampler() = default;
+
+    ~RasSampler();
+
+    std::shared_ptr<Lane> lane(const zes_device_handle_t& device);
+
+    std::shared_ptr<const RasSample> sample(const zes_device_handle_t& device, const std::shared_ptr<Lane>& lane);
+
+    static std::shared_ptr<const RasSample> read(const zes_device_handle_t& device);
+
+    void run();
+
+    std::mutex mutex;
+
+    std::map<zes_device_handle_t, std::shared_ptr<Lane>> lanes;
+
+    std::thread worker;
+
+    std::condition_variable cv;
+
+    bool stop = false;
+};
+
+} // namespace xpum
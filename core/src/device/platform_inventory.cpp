@@ -0,0 +1,390 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file platform_inventory.cpp
+ */
+
+#include "platform_inventory.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <nlohmann/json.hpp>
+
+#include "firmware/system_cmd.h"
+#include "infrastructure/configuration.h"
+#include "infrastructure/logger.h"
+
+using namespace nlohmann;
+
+namespace xpum {
+
+static const int INVENTORY_CACHE_VERSION = 1;
+
+static const std::string INVENTORY_CACHE_FILE("platform_inventory.json");
+
+static const std::string SYSTEM_SLOT_NAME_MARKER("Designation:");
+static const std::string SYSTEM_SLOT_BUS_ADDRESS_MARKER("Bus Address:");
+static const std::string SYSTEM_SLOT_CURRENT_USAGE_MARKER("Current Usage:");
+static const std::string SYSTEM_INFO_IGNORED_STARTER(" \t");
+static const std::string SYSTEM_INFO_IGNORED_ENDER("\r\n");
+static std::string getValueAtMarker(const std::string& sysInfo, const std::string& marker) {
+    std::string res;
+    std::string spaces;
+    size_t mPos = sysInfo.find(marker);
+    if (mPos != std::string::npos) {
+        const int len = sysInfo.length();
+        int i = mPos + marker.length();
+        while (i < len && SYSTEM_INFO_IGNORED_STARTER.find(sysInfo.at(i)) != std::string::npos) i++;
+        char cc;
+        while (i < len && SYSTEM_INFO_IGNORED_ENDER.find(cc = sysInfo.at(i)) == std::string::npos) {
+            switch (cc) {
+                case ' ':
+                case '\t':
+                    spaces += cc;
+                    break;
+                default:
+                    if (!spaces.empty()) {
+                        res += spaces;
+                        spaces.clear();
+                    }
+                    res += cc;
+                    break;
+            }
+            i++;
+        }
+    }
+    return res;
+}
+
+static const std::string SYSTEM_SLOT_IN_USE("In Use");
+class DMISystemSlot {
+    std::string _name;
+    std::string _busAddress;
+    std::string _currentUsage;
+
+   public:
+    DMISystemSlot(const std::string& slotInfo) {
+        _name = getValueAtMarker(slotInfo, SYSTEM_SLOT_NAME_MARKER);
+        _busAddress = getValueAtMarker(slotInfo, SYSTEM_SLOT_BUS_ADDRESS_MARKER);
+        _currentUsage = getValueAtMarker(slotInfo, SYSTEM_SLOT_CURRENT_USAGE_MARKER);
+    }
+
+    const std::string& name() {
+        return _name;
+    }
+
+    const std::string& busAddress() {
+        return _busAddress;
+    }
+
+    const std::string& currentUsage() {
+        return _currentUsage;
+    }
+
+    bool inUse() {
+        return _currentUsage == SYSTEM_SLOT_IN_USE;
+    }
+};
+
+
+static const std::string SYSTEM_SLOT_MARKER("System Slot Information");
+static std::vector<DMISystemSlot> getSystemSlotBlocks(const std::string& ssInfos) {
+    std::vector<DMISystemSlot> res;
+    size_t curPos = 0;
+    size_t nextPos;
+    while ((nextPos = ssInfos.find(SYSTEM_SLOT_MARKER, curPos)) != std::string::npos) {
+        if (curPos > 0) {
+            res.push_back(DMISystemSlot(ssInfos.substr(curPos, nextPos - curPos)));
+        }
+        curPos = nextPos + SYSTEM_SLOT_MARKER.length();
+    }
+    if (curPos > 0) {
+        res.push_back(DMISystemSlot(ssInfos.substr(curPos)));
+    }
+    return res;
+}
+
+static std::string readFirstLine(const std::string& path) {
+    std::string line;
+    std::ifstream ifs(path);
+    if (ifs.good()) {
+        std::getline(ifs, line);
+    }
+    return line;
+}
+
+static std::string getI915Version() {
+    std::string ret = "";
+    std::string str = readFirstLine("/sys/module/i915/version");
+    size_t pos = str.rfind(' ');
+    if (pos == std::string::npos || pos == str.length() - 1) {
+        return ret;
+    }
+    ret = str.substr(pos + 1);
+    return ret;
+}
+
+static std::string getDriverVersion() {
+    std::string version;
+    // Try to get i915 backported version from sysfs first
+    version = getI915Version();
+    if (version.length() > 0) {
+        return version;
+    }
+
+    std::string release;
+    std::string name = "intel-i915-dkms";
+    std::string rpm_cmd = "rpm -qa 2>/dev/null| grep " + name + " 2>/dev/null";
+    SystemCommandResult rpm_res = execCommand(rpm_cmd);
+    if (rpm_res.exitStatus() == 0) {
+        std::string strData = rpm_res.output();
+        auto pos1 = strData.find(name);
+        if (pos1 == std::string::npos) {
+            return version;
+        }
+        pos1 += name.length();
+        pos1 = strData.find_first_of("0123456789",pos1);
+        auto pos2 = strData.find_first_of("-",pos1);
+        version = strData.substr(pos1,pos2-pos1);
+        pos1 = pos2 + 1;
+        pos2 = strData.find_first_of(".",pos1);
+        release = strData.substr(pos1,pos2-pos1);
+        version = version + "-" + release;
+    } else {
+        std::string deb_cmd = "dpkg -l 2>/dev/null| grep " + name + " 2>/dev/null";
+        SystemCommandResult deb_res = execCommand(deb_cmd);
+        if (deb_res.exitStatus() == 0) {
+            std::string strData = deb_res.output();
+            auto pos1 = strData.find(name);
+            if (pos1 == std::string::npos) {
+                return version;
+            }
+            pos1 += name.length();
+            pos1 = strData.find_first_of("0123456789", pos1);
+            auto pos2 = strData.find_first_of(" ", pos1);
+            version = strData.substr(pos1, pos2 - pos1);
+        }
+    }
+    return version;
+}
+
+static std::string getKernelVersion() {
+    struct utsname name;
+    if (uname(&name) != 0) {
+        return "";
+    }
+    return name.release;
+}
+
+static std::string getBootId() {
+    return readFirstLine("/proc/sys/kernel/random/boot_id");
+}
+
+static std::mutex inventory_mutex;
+
+static std::shared_ptr<const PlatformInventory> current_inventory;
+
+// the last inventory, kept by refresh() for its boot-stable part
+static std::shared_ptr<const PlatformInventory> previous_inventory;
+
+std::shared_ptr<const PlatformInventory> PlatformInventory::get() {
+    std::lock_guard<std::mutex> lock(inventory_mutex);
+    if (current_inventory == nullptr) {
+        auto inventory = std::make_shared<PlatformInventory>();
+        inventory->collect(previous_inventory.get());
+        current_inventory = inventory;
+        previous_inventory = nullptr;
+    }
+    return current_inventory;
+}
+
+void PlatformInventory::refresh() {
+    std::lock_guard<std::mutex> lock(inventory_mutex);
+    if (current_inventory != nullptr) {
+        previous_inventory = current_inventory;
+        current_inventory = nullptr;
+    }
+}
+
+void PlatformInventory::collect(const PlatformInventory* previous) {
+    std::string boot_id = getBootId();
+    bool stable = false;
+    if (previous != nullptr) {
+        slots_valid = previous->slots_valid;
+        slots = previous->slots;
+        driver_version = previous->driver_version;
+        stable = true;
+    } else if (!boot_id.empty()) {
+        stable = load(boot_id);
+    }
+    bool need_slots = !stable || !slots_valid;
+
+    std::future<SystemCommandResult> dmi_task;
+    if (need_slots) {
+        dmi_task = std::async(std::launch::async, [] { return execCommand("dmidecode -t 9 2>/dev/null"); });
+    }
+    std::future<std::string> driver_task;
+    if (!stable) {
+        driver_task = std::async(std::launch::async, getDriverVersion);
+    }
+    auto mei_task = std::async(std::launch::async, getPCIAddrAndMeiDevices);
+
+    kernel_version = getKernelVersion();
+
+    DIR* pdir = opendir("/sys/class/drm");
+    if (pdir != NULL) {
+        struct dirent* pdirent;
+        while ((pdirent = readdir(pdir)) != NULL) {
+            if (strncmp(pdirent->d_name, "card", 4) != 0 || strstr(pdirent->d_name, "-") != NULL) {
+                continue;
+            }
+            std::string link_path = std::string("/sys/class/drm/") + pdirent->d_name;
+            char full_path[PATH_MAX];
+            ssize_t full_len = ::readlink(link_path.c_str(), full_path, sizeof(full_path) - 1);
+            if (full_len < 0) {
+                full_len = 0;
+            }
+            full_path[full_len] = '\0';
+            DrmCard card;
+            card.full_path = full_path;
+            card.oam_socket_id = readFirstLine(link_path + "/iaf_socket_id");
+            if (card.oam_socket_id.compare(0, 4, "0x1f") == 0) {
+                card.oam_socket_id.clear();
+            }
+            cards.push_back(card);
+        }
+        closedir(pdir);
+    }
+
+    mei_devices = mei_task.get();
+    if (driver_task.valid()) {
+        driver_version = driver_task.get();
+    }
+    if (dmi_task.valid()) {
+        SystemCommandResult ss_res = dmi_task.get();
+        slots_valid = ss_res.exitStatus() == 0;
+        slots.clear();
+        if (slots_valid) {
+            for (auto& sysSlot : getSystemSlotBlocks(ss_res.output())) {
+                if (sysSlot.inUse()) {
+                    slots.push_back({sysSlot.busAddress(), sysSlot.name()});
+                }
+            }
+        }
+    }
+    XPUM_LOG_DEBUG("Platform inventory: {} slots, {} DRM cards, {} MEI devices, driver {}",
+                   slots.size(), cards.size(), mei_devices.size(), driver_version);
+
+    if (!boot_id.empty() && (!stable || (need_slots && slots_valid))) {
+        save(boot_id);
+    }
+}
+
+bool PlatformInventory::load(const std::string& boot_id) {
+    if (Configuration::CACHE_DIR.empty()) {
+        return false;
+    }
+    std::ifstream ifs(Configuration::CACHE_DIR + INVENTORY_CACHE_FILE);
+    if (!ifs.good()) {
+        return false;
+    }
+    try {
+        json cache = json::parse(ifs);
+        if (cache["version"].get<int>() != INVENTORY_CACHE_VERSION || cache["boot_id"].get<std::string>() != boot_id) {
+            return false;
+        }
+        driver_version = cache["driver_version"].get<std::string>();
+        slots_valid = cache.contains("slots");
+        if (slots_valid) {
+            for (auto& slot : cache["slots"]) {
+                slots.push_back({slot["bus_address"].get<std::string>(), slot["name"].get<std::string>()});
+            }
+        }
+    } catch (std::exception& e) {
+        XPUM_LOG_WARN("Ignore invalid platform inventory cache: {}", e.what());
+        slots.clear();
+        slots_valid = false;
+        driver_version.clear();
+        return false;
+    }
+    return true;
+}
+
+void PlatformInventory::save(const std::string& boot_id) const {
+    if (Configuration::CACHE_DIR.empty()) {
+        return;
+    }
+    json cache;
+    cache["version"] = INVENTORY_CACHE_VERSION;
+    cache["boot_id"] = boot_id;
+    cache["driver_version"] = driver_version;
+    if (slots_valid) {
+        cache["slots"] = json::array();
+        for (auto& slot : slots) {
+            cache["slots"].push_back({{"bus_address", slot.bus_address}, {"name", slot.name}});
+        }
+    }
+    mkdir(Configuration::CACHE_DIR.c_str(), 0755);
+    // written aside then renamed, a concurrent reader sees the old or the new file
+    std::string file_path = Configuration::CACHE_DIR + INVENTORY_CACHE_FILE;
+    std::string tmp_path = file_path + "." + std::to_string(getpid());
+    std::ofstream ofs(tmp_path);
+    if (!ofs.good()) {
+        XPUM_LOG_DEBUG("Cannot write platform inventory cache to {}", Configuration::CACHE_DIR);
+        return;
+    }
+    ofs << cache.dump();
+    ofs.close();
+    if (ofs.fail() || rename(tmp_path.c_str(), file_path.c_str()) != 0) {
+        unlink(tmp_path.c_str());
+    }
+}
+
+std::string PlatformInventory::slotAt(const std::string& bus_address) const {
+    for (auto& slot : slots) {
+        if (slot.bus_address == bus_address) {
+            return slot.name;
+        }
+    }
+    return "";
+}
+
+std::string PlatformInventory::slotByPath(const std::vector<std::string>& pci_path) const {
+    for (auto& slot : slots) {
+        for (auto& node : pci_path) {
+            if (slot.bus_address == node) {
+                return slot.name;
+            }
+        }
+    }
+    return "";
+}
+
+std::string PlatformInventory::cardFullPath(const std::string& bdf) const {
+    for (auto& card : cards) {
+        if (card.full_path.find(bdf) != std::string::npos) {
+            return card.full_path;
+        }
+    }
+    return "";
+}
+
+std::string PlatformInventory::oamSocketId(const std::string& bdf) const {
+    for (auto& card : cards) {
+        if (card.full_path.find(bdf) != std::string::npos) {
+            return card.oam_socket_id;
+        }
+    }
+    return "";
+}
+
+} // namespace xpum
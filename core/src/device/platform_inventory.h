@@ -0,0 +1,90 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file platform_inventory.h
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "device/skuType.h"
+
+namespace xpum {
+
+/*
+  What device discovery needs to know about the platform beside Level Zero:
+  the SMBIOS system slots, the DRM cards with their OAM socket, the MEI
+  device of each GPU and the driver and kernel versions. It is collected
+  once for all the GPUs, the sources being read in parallel, instead of
+  once per GPU.
+
+  The slots, read from dmidecode, and the driver version, which may come
+  from the package manager, do not change until the next boot. They are
+  saved to Configuration::CACHE_DIR with the boot id, so the following
+  runs on the same boot do not start any subprocess.
+*/
+
+class PlatformInventory {
+   public:
+    static std::shared_ptr<const PlatformInventory> get();
+
+    // makes the next get() read sysfs and MEI devices again
+    static void refresh();
+
+    // first in-use slot at bus_address, empty when there is none
+    std::string slotAt(const std::string& bus_address) const;
+
+    // first in-use slot, in SMBIOS order, at one of the addresses of pci_path
+    std::string slotByPath(const std::vector<std::string>& pci_path) const;
+
+    // sysfs path of the DRM card of the PCI device bdf
+    std::string cardFullPath(const std::string& bdf) const;
+
+    std::string oamSocketId(const std::string& bdf) const;
+
+    const std::vector<pci_addr_mei_device>& meiDevices() const {
+        return mei_devices;
+    }
+
+    const std::string& driverVersion() const {
+        return driver_version;
+    }
+
+    const std::string& kernelVersion() const {
+        return kernel_version;
+    }
+
+   private:
+    struct SystemSlot {
+        std::string bus_address;
+        std::string name;
+    };
+
+    struct DrmCard {
+        std::string full_path;
+        std::string oam_socket_id;
+    };
+
+    void collect(const PlatformInventory* previous);
+
+    bool load(const std::string& boot_id);
+
+    void save(const std::string& boot_id) const;
+
+    bool slots_valid = false;
+
+    std::vector<SystemSlot> slots;
+
+    std::vector<DrmCard> cards;
+
+    std::vector<pci_addr_mei_device> mei_devices;
+
+    std::string driver_version;
+
+    std::string kernel_version;
+};
+
+} // namespace xpum
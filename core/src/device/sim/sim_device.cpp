@@ -0,0 +1,569 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file sim_device.cpp
+ */
+
+#include "sim_device.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#include "infrastructure/configuration.h"
+#include "infrastructure/engine_measurement_data.h"
+#include "infrastructure/fabric_measurement_data.h"
+#include "infrastructure/logger.h"
+#include "infrastructure/measurement_data.h"
+
+namespace xpum {
+
+namespace {
+
+// one period of the simulated load
+const uint64_t LOAD_PERIOD_US = 180000000;
+// the counters are integrated in steps of at most 100 ms
+const uint64_t INTEGRATION_STEP_US = 100000;
+
+const double IDLE_POWER_W = 40;
+const double MAX_POWER_W = 300;
+const double THROTTLE_LOAD = 0.9;
+const uint32_t MIN_FREQUENCY_MHZ = 900;
+const uint32_t MAX_FREQUENCY_MHZ = 1600;
+const uint32_t THROTTLED_FREQUENCY_MHZ = 1300;
+const uint64_t MEMORY_SIZE_BYTE = 64ull << 30;
+// bytes per microsecond
+const double MEMORY_BANDWIDTH = 1.6e6;
+const double FABRIC_PORT_BANDWIDTH = 2.5e4;
+const double PCIE_BANDWIDTH = 3.2e4;
+
+enum EngineKind {
+    ENGINE_KIND_COMPUTE,
+    ENGINE_KIND_RENDER,
+    ENGINE_KIND_MEDIA,
+    ENGINE_KIND_COPY,
+    ENGINE_KIND_FABRIC,
+    ENGINE_KIND_MAX,
+};
+
+// weights of the compute, media, copy heavy and mixed workloads
+const double WORKLOAD_WEIGHTS[4][ENGINE_KIND_MAX] = {
+    {1.0, 0.2, 0.05, 0.3, 0.4},
+    {0.2, 0.1, 0.9, 0.2, 0.1},
+    {0.3, 0.0, 0.0, 0.9, 1.0},
+    {0.6, 0.3, 0.4, 0.5, 0.5},
+};
+
+struct EngineLayout {
+    zes_engine_group_t type;
+    EngineKind kind;
+    uint32_t count;
+};
+
+const EngineLayout TILE_ENGINES[] = {
+    {ZES_ENGINE_GROUP_COMPUTE_SINGLE, ENGINE_KIND_COMPUTE, 4},
+    {ZES_ENGINE_GROUP_RENDER_SINGLE, ENGINE_KIND_RENDER, 1},
+    {ZES_ENGINE_GROUP_MEDIA_DECODE_SINGLE, ENGINE_KIND_MEDIA, 2},
+    {ZES_ENGINE_GROUP_MEDIA_ENCODE_SINGLE, ENGINE_KIND_MEDIA, 2},
+    {ZES_ENGINE_GROUP_MEDIA_ENHANCEMENT_SINGLE, ENGINE_KIND_MEDIA, 2},
+    {ZES_ENGINE_GROUP_COPY_SINGLE, ENGINE_KIND_COPY, 1},
+};
+
+uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+double toUnit(uint64_t value) {
+    return (value >> 11) * (1.0 / 9007199254740992.0);
+}
+
+uint64_t nowMicroseconds() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// handles only need to be unique, they are never passed to Level Zero
+uint64_t engineHandle(uint32_t index, uint32_t tile, uint32_t engine) {
+    return ((uint64_t)(index + 1) << 32) | (tile << 16) | engine;
+}
+
+uint64_t engineGroupAllHandle(uint32_t index, uint32_t tile) {
+    return engineHandle(index, tile, 0xffff);
+}
+
+uint64_t fabricPortHandle(uint32_t index, uint32_t port) {
+    return ((uint64_t)(index + 1) << 32) | (1u << 31) | port;
+}
+
+} // namespace
+
+SimulatedDevice::SimulatedDevice(const std::string& id, uint32_t index, uint32_t tile_count, std::vector<DeviceCapability>& capabilities)
+    : index(index),
+      tile_count(tile_count),
+      profile(index % 4),
+      pcie_read(0),
+      pcie_write(0) {
+    this->id = id;
+    this->zes_device_handle = nullptr;
+    this->ze_device_handle = nullptr;
+    this->ze_driver_handle = nullptr;
+    for (DeviceCapability& cap : capabilities) {
+        this->capabilities.push_back(cap);
+    }
+
+    uint64_t seed = Configuration::SIMULATED_SEED ^ ((uint64_t)index << 20);
+    fault_state = splitmix64(seed);
+    tiles.resize(tile_count);
+    for (auto& tile : tiles) {
+        tile = TileState();
+        tile.phase = toUnit(splitmix64(seed));
+    }
+    for (uint32_t tile = 0; tile < tile_count; ++tile) {
+        uint32_t engine = 0;
+        for (auto& layout : TILE_ENGINES) {
+            for (uint32_t i = 0; i < layout.count; ++i) {
+                EngineState state;
+                state.handle = engineHandle(index, tile, engine++);
+                state.type = layout.type;
+                state.tile = tile;
+                // spread the engines of a group so that they do not report the same activity
+                state.weight = WORKLOAD_WEIGHTS[profile][layout.kind] * (1.0 - 0.1 * i);
+                state.active_time = 0;
+                engine_states.push_back(state);
+                addEngine(state.handle, state.type, tile_count > 1, tile);
+            }
+        }
+    }
+    start_time = timestamp = nowMicroseconds();
+}
+
+SimulatedDevice::~SimulatedDevice() {
+}
+
+void SimulatedDevice::addFabricPort(uint32_t attach_id, uint32_t remote_fabric_id, uint32_t remote_attach_id) {
+    std::lock_guard<std::mutex> lock(state_mutex);
+    FabricPortState port;
+    port.handle = fabricPortHandle(index, fabric_ports.size());
+    port.attach_id = attach_id;
+    port.remote_fabric_id = remote_fabric_id;
+    port.remote_attach_id = remote_attach_id;
+    port.rx_counter = 0;
+    port.tx_counter = 0;
+    fabric_ports.push_back(port);
+    addFabricPortHandle(attach_id, remote_fabric_id, remote_attach_id, (zes_fabric_port_handle_t)(uintptr_t)port.handle);
+}
+
+double SimulatedDevice::loadAt(uint32_t tile, uint64_t time) const {
+    double position = (double)((time - start_time) % LOAD_PERIOD_US) / LOAD_PERIOD_US + tiles[tile].phase;
+    position -= std::floor(position);
+    double triangle = position < 0.5 ? 2 * position : 2 - 2 * position;
+    return 0.05 + 0.9 * triangle;
+}
+
+void SimulatedDevice::advance() {
+    uint64_t now = nowMicroseconds();
+    while (timestamp < now) {
+        uint64_t step = std::min(now - timestamp, INTEGRATION_STEP_US);
+        uint64_t middle = timestamp + step / 2;
+        double load_sum = 0;
+        for (uint32_t t = 0; t < tile_count; ++t) {
+            auto& tile = tiles[t];
+            tile.load = loadAt(t, middle);
+            load_sum += tile.load;
+            tile.energy += (IDLE_POWER_W + (MAX_POWER_W - IDLE_POWER_W) * tile.load) * step;
+            tile.active_time += tile.load * step;
+            if (tile.load > THROTTLE_LOAD) {
+                tile.throttle_time += step;
+            }
+            tile.memory_read += 0.6 * MEMORY_BANDWIDTH * tile.load * step;
+            tile.memory_write += 0.3 * MEMORY_BANDWIDTH * tile.load * step;
+        }
+        for (auto& engine : engine_states) {
+            engine.active_time += std::min(1.0, tiles[engine.tile].load * engine.weight) * step;
+        }
+        for (auto& port : fabric_ports) {
+            double traffic = FABRIC_PORT_BANDWIDTH * WORKLOAD_WEIGHTS[profile][ENGINE_KIND_FABRIC] * tiles[port.attach_id].load * step;
+            port.rx_counter += traffic;
+            port.tx_counter += 0.8 * traffic;
+        }
+        pcie_read += PCIE_BANDWIDTH * load_sum / tile_count * step;
+        pcie_write += 0.5 * PCIE_BANDWIDTH * load_sum / tile_count * step;
+        timestamp += step;
+    }
+}
+
+bool SimulatedDevice::injectFault() {
+    if (Configuration::SIMULATED_FAULT_RATE <= 0) {
+        return false;
+    }
+    uint64_t value = splitmix64(fault_state);
+    if (toUnit(value) >= Configuration::SIMULATED_FAULT_RATE) {
+        return false;
+    }
+    tiles[value % tile_count].ras_correctable++;
+    return true;
+}
+
+uint32_t SimulatedDevice::subdeviceId(uint32_t tile) const {
+    return tile_count > 1 ? tile : UINT32_MAX;
+}
+
+void SimulatedDevice::sample(Callback_t callback, std::function<std::shared_ptr<void>()> read) noexcept {
+    if (Configuration::SIMULATED_LATENCY_US > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(Configuration::SIMULATED_LATENCY_US));
+    }
+    std::shared_ptr<void> ret;
+    std::shared_ptr<BaseException> error;
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        if (injectFault()) {
+            error = std::make_shared<BaseException>("Injected fault on simulated device " + id);
+        } else {
+            try {
+                advance();
+                ret = read();
+            } catch (std::exception& e) {
+                error = std::make_shared<BaseException>(e.what());
+            }
+        }
+    }
+    if (error != nullptr) {
+        XPUM_LOG_DEBUG("Simulated device {}: {}", id, error->what());
+    }
+    callback(ret, error);
+}
+
+void SimulatedDevice::getPower(Callback_t callback) noexcept {
+    sample(callback, [this]() {
+        auto ret = std::make_shared<MeasurementData>();
+        uint64_t energy = 0;
+        for (uint32_t t = 0; t < tile_count; ++t) {
+            energy += tiles[t].energy;
+            if (tile_count > 1) {
+                ret->setSubdeviceRawData(t, Configuration::DEFAULT_MEASUREMENT_DATA_SCALE * tiles[t].energy);
+                ret->setSubdeviceDataRawTimestamp(t, timestamp);
+            }
+        }
+        ret->setRawData(Configuration::DEFAULT_MEASUREMENT_DATA_SCALE * energy);
+        ret->setRawTimestamp(timestamp);
+        ret->setScale(Configuration::DEFAULT_MEASUREMENT_DATA_SCALE);
+        return ret;
+    });
+}
+
+void SimulatedDevice::getEnergy(Callback_t callback) noexcept {
+    sample(callback, [this]() {
+        auto ret = std::make_shared<MeasurementData>();
+        uint64_t energy = 0;
+        for (uint32_t t = 0; t < tile_count; ++t) {
+            energy += tiles[t].energy;
+            if (tile_count > 1) {
+                ret->setSubdeviceDataCurrent(t, tiles[t].energy / 1000);
+            }
+        }
+        ret->setCurrent(energy / 1000);
+        return ret;
+    });
+}
+
+void SimulatedDevice::getActuralRequestFrequency(Callback_t callback) noexcept {
+    sample(callback, [this]() {
+        auto ret = std::make_shared<MeasurementData>();
+        for (uint32_t t = 0; t < tile_count; ++t) {
+            uint64_t actual = tiles[t].load > THROTTLE_LOAD ? THROTTLED_FREQUENCY_MHZ : MIN_FREQUENCY_MHZ + (MAX_FREQUENCY_MHZ - MIN_FREQUENCY_MHZ) * tiles[t].load;
+            if (tile_count > 1) {
+                ret->setSubdeviceDataCurrent(t, actual);
+            } else {
+                ret->setCurrent(actual);
+            }
+            ret->setSubdeviceAdditionalData(subdeviceId(t), MeasurementType::METRIC_REQUEST_FREQUENCY, MAX_FREQUENCY_MHZ);
+        }
+        return ret;
+    });
+}
+
+void SimulatedDevice::getTemperature(Callback_t callback, zes_temp_sensors_t type) noexcept {
+    sample(callback, [this, type]() {
+        auto ret = std::make_shared<MeasurementData>();
+        double base = type == ZES_TEMP_SENSORS_MEMORY ? 30 : 35;
+        double range = type == ZES_TEMP_SENSORS_MEMORY ? 40 : 50;
+        double hottest = 0;
+        for (uint32_t t = 0; t < tile_count; ++t) {
+            double temperature = base + range * tiles[t].load;
+            hottest = std::max(hottest, temperature);
+            if (tile_count > 1) {
+                ret->setSubdeviceDataCurrent(t, temperature * Configuration::DEFAULT_MEASUREMENT_DATA_SCALE);
+            }
+        }
+        ret->setCurrent(hottest * Configuration::DEFAULT_MEASUREMENT_DATA_SCALE);
+        ret->setScale(Configuration::DEFAULT_MEASUREMENT_DATA_SCALE);
+        return ret;
+    });
+}
+
+void SimulatedDevice::getMemoryUsedUtilization(Callback_t callback) noexcept {
+    sample(callback, [this]() {
+        auto ret = std::make_shared<MeasurementData>();
+        for (uint32_t t = 0; t < tile_count; ++t) {
+            uint64_t used = MEMORY_SIZE_BYTE * (0.1 + 0.7 * tiles[t].load);
+            uint64_t utilization = Configuration::DEFAULT_MEASUREMENT_DATA_SCALE * 100 * (double)used / MEMORY_SIZE_BYTE;
+            if (tile_count > 1) {
+                ret->setSubdeviceDataCurrent(t, used);
+            } else {
+                ret->setCurrent(used);
+            }
+            ret->setSubdeviceAdditionalData(subdeviceId(t), MeasurementType::METRIC_MEMORY_UTILIZATION, utilization, Configuration::DEFAULT_MEASUREMENT_DATA_SCALE);
+        }
+        return ret;
+    });
+}
+
+void SimulatedDevice::getMemoryThroughputAndBandwidth(Callback_t callback) noexcept {
+    sample(callback, [this]() {
+        auto ret = std::make_shared<MeasurementData>();
+        uint64_t max_bandwidth = MEMORY_BANDWIDTH * 1000000;
+        for (uint32_t t = 0; t < tile_count; ++t) {
+            auto& tile = tiles[t];
+            uint32_t subdevice_id = subdeviceId(t);
+            if (tile_count > 1) {
+                ret->setSubdeviceDataCurrent(t, tile.memory_read);
+            } else {
+                ret->setCurrent(tile.memory_read);
+            }
+            ret->setSubdeviceAdditionalData(subdevice_id, MeasurementType::METRIC_MEMORY_WRITE, tile.memory_write);
+            ret->setSubdeviceAdditionalData(subdevice_id, MeasurementType::METRIC_MEMORY_READ_THROUGHPUT, tile.memory_read / 1024 * 1000, 1, true, timestamp / 1000);
+            ret->setSubdeviceAdditionalData(subdevice_id, MeasurementType::METRIC_MEMORY_WRITE_THROUGHPUT, tile.memory_write / 1024 * 1000, 1, true, timestamp / 1000);
+            ret->setSubdeviceAdditionalData(subdevice_id, MeasurementType::METRIC_MEMORY_BANDWIDTH, 100 * (tile.memory_read / 1000 + tile.memory_write / 1000) / (max_bandwidth / 1000) * 1000, 1, true, timestamp / 1000);
+        }
+        return ret;
+    });
+}
+
+void SimulatedDevice::getGPUUtilization(Callback_t callback) noexcept {
+    sample(callback, [this]() {
+        auto ret = std::make_shared<MeasurementData>();
+        ret->setNumSubdevices(tile_count > 1 ? tile_count : 0);
+        for (uint32_t t = 0; t < tile_count; ++t) {
+            ExtendedMeasurementData data;
+            data.on_subdevice = tile_count > 1;
+            data.subdevice_id = t;
+            data.type = ZES_ENGINE_GROUP_ALL;
+            data.active_time = tiles[t].active_time;
+            data.timestamp = timestamp;
+            ret->addExtendedData(engineGroupAllHandle(index, t), data);
+        }
+        return ret;
+    });
+}
+
+void SimulatedDevice::getEngineUtilization(Callback_t callback) noexcept {
+    sample(callback, [this]() {
+        auto ret = std::make_shared<EngineCollectionMeasurementData>();
+        ret->setNumSubdevices(tile_count > 1 ? tile_count : 0);
+        for (auto& engine : engine_states) {
+            ret->addRawData(engine.handle, engine.type, tile_count > 1, engine.tile, engine.active_time, timestamp);
+        }
+        ret->sortEngines([this](uint64_t handle) { return getEngineIndex(handle); });
+        return ret;
+    });
+}
+
+bool SimulatedDevice::inEngineGroup(zes_engine_group_t type, zes_engine_group_t engine_group_type) {
+    switch (engine_group_type) {
+        case ZES_ENGINE_GROUP_COMPUTE_ALL:
+            return type == ZES_ENGINE_GROUP_COMPUTE_SINGLE;
+        case ZES_ENGINE_GROUP_RENDER_ALL:
+            return type == ZES_ENGINE_GROUP_RENDER_SINGLE;
+        case ZES_ENGINE_GROUP_MEDIA_ALL:
+            return type == ZES_ENGINE_GROUP_MEDIA_DECODE_SINGLE || type == ZES_ENGINE_GROUP_MEDIA_ENCODE_SINGLE || type == ZES_ENGINE_GROUP_MEDIA_ENHANCEMENT_SINGLE;
+        case ZES_ENGINE_GROUP_COPY_ALL:
+            return type == ZES_ENGINE_GROUP_COPY_SINGLE;
+        case ZES_ENGINE_GROUP_3D_ALL:
+            return type == ZES_ENGINE_GROUP_3D_SINGLE;
+        default:
+            return true;
+    }
+}
+
+void SimulatedDevice::getEngineGroupUtilization(Callback_t callback, zes_engine_group_t engine_group_type) noexcept {
+    sample(callback, [this, engine_group_type]() {
+        auto ret = std::make_shared<MeasurementData>();
+        ret->setNumSubdevices(tile_count > 1 ? tile_count : 0);
+        for (auto& engine : engine_states) {
+            if (!inEngineGroup(engine.type, engine_group_type)) {
+                continue;
+            }
+            ExtendedMeasurementData data;
+            data.on_subdevice = tile_count > 1;
+            data.subdevice_id = engine.tile;
+            data.type = engine.type;
+            data.active_time = engine.active_time;
+            data.timestamp = timestamp;
+            ret->addExtendedData(engine.handle, data);
+        }
+        if (ret->getExtendedDatas()->empty()) {
+            throw BaseException("No simulated engine in engine group type " + std::to_string(engine_group_type));
+        }
+        return ret;
+    });
+}
+
+void SimulatedDevice::getEuActiveStallIdle(Callback_t callback, MeasurementType type) noexcept {
+    callback(nullptr, std::make_shared<BaseException>("EU active/stall/idle is not simulated"));
+}
+
+void SimulatedDevice::getRasError(Callback_t callback, const zes_ras_error_cat_t& rasCat, const zes_ras_error_type_t& rasType) noexcept {
+    zes_ras_error_cat_t cat = rasCat;
+    zes_ras_error_type_t type = rasType;
+    sample(callback, [this, cat, type]() {
+        auto ret = std::make_shared<MeasurementData>();
+        uint64_t count = 0;
+        if (cat == ZES_RAS_ERROR_CAT_NON_COMPUTE_ERRORS && type == ZES_RAS_ERROR_TYPE_CORRECTABLE) {
+            for (auto& tile : tiles) {
+                count += tile.ras_correctable;
+            }
+        }
+        ret->setCurrent(count);
+        return ret;
+    });
+}
+
+void SimulatedDevice::getRasErrorOnSubdevice(Callback_t callback, const zes_ras_error_cat_t& rasCat, const zes_ras_error_type_t& rasType) noexcept {
+    zes_ras_error_cat_t cat = rasCat;
+    zes_ras_error_type_t type = rasType;
+    sample(callback, [this, cat, type]() {
+        auto ret = std::make_shared<MeasurementData>();
+        uint64_t total = 0;
+        for (uint32_t t = 0; t < tile_count; ++t) {
+            uint64_t count = cat == ZES_RAS_ERROR_CAT_NON_COMPUTE_ERRORS && type == ZES_RAS_ERROR_TYPE_CORRECTABLE ? tiles[t].ras_correctable : 0;
+            total += count;
+            if (tile_count > 1) {
+                ret->setSubdeviceDataCurrent(t, count);
+            }
+        }
+        ret->setCurrent(total);
+        return ret;
+    });
+}
+
+void SimulatedDevice::getRasErrorOnSubdevice(Callback_t callback) noexcept {
+    sample(callback, [this]() {
+        auto ret = std::make_shared<MeasurementData>();
+        for (uint32_t t = 0; t < tile_count; ++t) {
+            uint32_t subdevice_id = subdeviceId(t);
+            tile_count > 1 ? ret->setSubdeviceDataCurrent(t, 0) : ret->setCurrent(0);
+            ret->setSubdeviceAdditionalData(subdevice_id, METRIC_RAS_ERROR_CAT_PROGRAMMING_ERRORS, 0);
+            ret->setSubdeviceAdditionalData(subdevice_id, METRIC_RAS_ERROR_CAT_DRIVER_ERRORS, 0);
+            ret->setSubdeviceAdditionalData(subdevice_id, METRIC_RAS_ERROR_CAT_CACHE_ERRORS_UNCORRECTABLE, 0);
+            ret->setSubdeviceAdditionalData(subdevice_id, METRIC_RAS_ERROR_CAT_DISPLAY_ERRORS_UNCORRECTABLE, 0);
+            ret->setSubdeviceAdditionalData(subdevice_id, METRIC_RAS_ERROR_CAT_NON_COMPUTE_ERRORS_UNCORRECTABLE, 0);
+            ret->setSubdeviceAdditionalData(subdevice_id, METRIC_RAS_ERROR_CAT_CACHE_ERRORS_CORRECTABLE, 0);
+            ret->setSubdeviceAdditionalData(subdevice_id, METRIC_RAS_ERROR_CAT_DISPLAY_ERRORS_CORRECTABLE, 0);
+            ret->setSubdeviceAdditionalData(subdevice_id, METRIC_RAS_ERROR_CAT_NON_COMPUTE_ERRORS_CORRECTABLE, tiles[t].ras_correctable);
+        }
+        return ret;
+    });
+}
+
+void SimulatedDevice::getFrequencyThrottle(Callback_t callback) noexcept {
+    sample(callback, [this]() {
+        auto ret = std::make_shared<MeasurementData>();
+        uint64_t throttle_time = 0;
+        for (uint32_t t = 0; t < tile_count; ++t) {
+            throttle_time = std::max(throttle_time, tiles[t].throttle_time);
+            if (tile_count > 1) {
+                ret->setSubdeviceRawData(t, Configuration::DEFAULT_MEASUREMENT_DATA_SCALE * tiles[t].throttle_time);
+                ret->setSubdeviceDataRawTimestamp(t, timestamp);
+            }
+        }
+        if (tile_count == 1) {
+            ret->setRawData(Configuration::DEFAULT_MEASUREMENT_DATA_SCALE * throttle_time);
+            ret->setRawTimestamp(timestamp);
+        }
+        ret->setScale(Configuration::DEFAULT_MEASUREMENT_DATA_SCALE);
+        return ret;
+    });
+}
+
+void SimulatedDevice::getFrequencyThrottleReason(Callback_t callback) noexcept {
+    sample(callback, [this]() {
+        auto ret = std::make_shared<MeasurementData>();
+        zes_freq_throttle_reason_flags_t device_flags = 0;
+        for (uint32_t t = 0; t < tile_count; ++t) {
+            zes_freq_throttle_reason_flags_t flags = tiles[t].load > THROTTLE_LOAD ? ZES_FREQ_THROTTLE_REASON_FLAG_AVE_PWR_CAP : 0;
+            device_flags |= flags;
+            if (tile_count > 1) {
+                ret->setSubdeviceDataCurrent(t, flags);
+            }
+        }
+        ret->setCurrent(device_flags);
+        return ret;
+    });
+}
+
+void SimulatedDevice::getPCIeReadThroughput(Callback_t callback) noexcept {
+    sample(callback, [this]() {
+        auto ret = std::make_shared<MeasurementData>();
+        double load = 0;
+        for (auto& tile : tiles) {
+            load += tile.load / tile_count;
+        }
+        // kB/s
+        ret->setCurrent(PCIE_BANDWIDTH * load * 1000);
+        return ret;
+    });
+}
+
+void SimulatedDevice::getPCIeWriteThroughput(Callback_t callback) noexcept {
+    sample(callback, [this]() {
+        auto ret = std::make_shared<MeasurementData>();
+        double load = 0;
+        for (auto& tile : tiles) {
+            load += tile.load / tile_count;
+        }
+        ret->setCurrent(0.5 * PCIE_BANDWIDTH * load * 1000);
+        return ret;
+    });
+}
+
+void SimulatedDevice::getPCIeRead(Callback_t callback) noexcept {
+    sample(callback, [this]() {
+        auto ret = std::make_shared<MeasurementData>();
+        ret->setCurrent(pcie_read);
+        return ret;
+    });
+}
+
+void SimulatedDevice::getPCIeWrite(Callback_t callback) noexcept {
+    sample(callback, [this]() {
+        auto ret = std::make_shared<MeasurementData>();
+        ret->setCurrent(pcie_write);
+        return ret;
+    });
+}
+
+void SimulatedDevice::getFabricThroughput(Callback_t callback) noexcept {
+    sample(callback, [this]() {
+        if (fabric_ports.empty()) {
+            throw BaseException("fabric port not found");
+        }
+        auto ret = std::make_shared<FabricMeasurementData>();
+        for (auto& port : fabric_ports) {
+            ret->addRawData(port.handle, timestamp, port.rx_counter, port.tx_counter, port.attach_id, port.remote_fabric_id, port.remote_attach_id);
+        }
+        return ret;
+    });
+}
+
+void SimulatedDevice::getPerfMetrics(Callback_t callback) noexcept {
+    callback(nullptr, std::make_shared<BaseException>("perf metrics are not simulated"));
+}
+
+bool SimulatedDevice::isUpgradingFwResultReady(void) noexcept {
+    return true;
+}
+
+} // end namespace xpum
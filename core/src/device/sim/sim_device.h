@@ -0,0 +1,138 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file sim_device.h
+ */
+
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "device/device.h"
+
+namespace xpum {
+
+/*
+  SimulatedDevice answers the telemetry interfaces of Device from a
+  deterministic model instead of Level Zero sysman. Every tile runs a
+  triangle shaped load that repeats every few minutes; its phase is derived
+  from the simulation seed, the device index and the tile, and the device
+  index picks a workload mix (compute, media, copy or mixed) that weights
+  the engines and the fabric ports. Energy, engine activity, memory and
+  fabric traffic are integrated from that load, so the counters are
+  monotonic and identical between runs that sample at the same times.
+
+  Each call sleeps for the configured latency and fails with the configured
+  fault rate, an injected fault is also counted as a correctable RAS error.
+  Configuration, firmware and diagnostic interfaces are not simulated, the
+  Level Zero handles of a simulated device are null.
+*/
+
+class SimulatedDevice : public Device {
+   public:
+    SimulatedDevice(const std::string& id, uint32_t index, uint32_t tile_count, std::vector<DeviceCapability>& capabilities);
+
+    virtual ~SimulatedDevice();
+
+   public:
+    void getPower(Callback_t callback) noexcept override;
+    void getActuralRequestFrequency(Callback_t callback) noexcept override;
+    void getTemperature(Callback_t callback, zes_temp_sensors_t type) noexcept override;
+    void getMemoryUsedUtilization(Callback_t callback) noexcept override;
+    void getMemoryThroughputAndBandwidth(Callback_t callback) noexcept override;
+    void getGPUUtilization(Callback_t callback) noexcept override;
+    void getEngineUtilization(Callback_t callback) noexcept override;
+    void getEngineGroupUtilization(Callback_t callback, zes_engine_group_t engine_group_type) noexcept override;
+    void getEnergy(Callback_t callback) noexcept override;
+    void getEuActiveStallIdle(Callback_t callback, MeasurementType type) noexcept override;
+    void getRasError(Callback_t callback, const zes_ras_error_cat_t& rasCat, const zes_ras_error_type_t& rasType) noexcept override;
+    void getRasErrorOnSubdevice(Callback_t callback, const zes_ras_error_cat_t& rasCat, const zes_ras_error_type_t& rasType) noexcept override;
+    void getRasErrorOnSubdevice(Callback_t callback) noexcept override;
+    void getFrequencyThrottle(Callback_t callback) noexcept override;
+    void getFrequencyThrottleReason(Callback_t callback) noexcept override;
+    void getPCIeReadThroughput(Callback_t callback) noexcept override;
+    void getPCIeWriteThroughput(Callback_t callback) noexcept override;
+    void getPCIeRead(Callback_t callback) noexcept override;
+    void getPCIeWrite(Callback_t callback) noexcept override;
+    void getFabricThroughput(Callback_t callback) noexcept override;
+    void getPerfMetrics(Callback_t callback) noexcept override;
+
+    bool isUpgradingFwResultReady(void) noexcept override;
+
+    uint32_t getTileCount() const {
+        return tile_count;
+    }
+
+    // connects a port of the given tile to a tile of another simulated device
+    void addFabricPort(uint32_t attach_id, uint32_t remote_fabric_id, uint32_t remote_attach_id);
+
+   private:
+    struct TileState {
+        double phase;
+        double load;
+        uint64_t energy;
+        uint64_t active_time;
+        uint64_t throttle_time;
+        uint64_t memory_read;
+        uint64_t memory_write;
+        uint64_t ras_correctable;
+    };
+
+    struct EngineState {
+        uint64_t handle;
+        zes_engine_group_t type;
+        uint32_t tile;
+        double weight;
+        uint64_t active_time;
+    };
+
+    struct FabricPortState {
+        uint64_t handle;
+        uint32_t attach_id;
+        uint32_t remote_fabric_id;
+        uint32_t remote_attach_id;
+        uint64_t rx_counter;
+        uint64_t tx_counter;
+    };
+
+    void sample(Callback_t callback, std::function<std::shared_ptr<void>()> read) noexcept;
+
+    void advance();
+
+    bool injectFault();
+
+    double loadAt(uint32_t tile, uint64_t time) const;
+
+    uint32_t subdeviceId(uint32_t tile) const;
+
+    static bool inEngineGroup(zes_engine_group_t type, zes_engine_group_t engine_group_type);
+
+   private:
+    uint32_t index;
+
+    uint32_t tile_count;
+
+    uint32_t profile;
+
+    uint64_t start_time;
+
+    uint64_t timestamp;
+
+    uint64_t pcie_read;
+
+    uint64_t pcie_write;
+
+    uint64_t fault_state;
+
+    std::vector<TileState> tiles;
+
+    std::vector<EngineState> engine_states;
+
+    std::vector<FabricPortState> fabric_ports;
+
+    std::mutex state_mutex;
+};
+
+} // end namespace xpum
@@ -0,0 +1,121 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file sim_device_stub.cpp
+ */
+
+#include "sim_device_stub.h"
+
+#include <cstdio>
+#include <string>
+
+#include "device/sim/sim_device.h"
+#include "infrastructure/configuration.h"
+#include "infrastructure/device_property.h"
+#include "infrastructure/logger.h"
+
+namespace xpum {
+
+SimulatedDeviceStub::SimulatedDeviceStub() {
+    XPUM_LOG_DEBUG("SimulatedDeviceStub()");
+}
+
+SimulatedDeviceStub& SimulatedDeviceStub::instance() {
+    static SimulatedDeviceStub stub;
+    return stub;
+}
+
+bool SimulatedDeviceStub::isEnabled() {
+    return Configuration::SIMULATED_DEVICE_NUM > 0;
+}
+
+void SimulatedDeviceStub::discoverDevices(Callback_t callback) {
+    try {
+        callback(toDiscover(), nullptr);
+    } catch (std::exception& e) {
+        callback(nullptr, std::make_shared<BaseException>(e.what()));
+    }
+}
+
+static uint32_t simulatedFabricId(uint32_t index) {
+    return index + 1;
+}
+
+std::shared_ptr<std::vector<std::shared_ptr<Device>>> SimulatedDeviceStub::toDiscover() {
+    auto p_devices = std::make_shared<std::vector<std::shared_ptr<Device>>>();
+    uint32_t device_count = Configuration::SIMULATED_DEVICE_NUM;
+    uint32_t tile_count = Configuration::SIMULATED_TILE_NUM;
+    auto enabled_GPU_ids = Configuration::getEnabledGPUIds();
+
+    std::vector<DeviceCapability> capabilities = {
+        DeviceCapability::METRIC_POWER,
+        DeviceCapability::METRIC_FREQUENCY,
+        DeviceCapability::METRIC_TEMPERATURE,
+        DeviceCapability::METRIC_ENERGY,
+        DeviceCapability::METRIC_MEMORY_USED_UTILIZATION,
+        DeviceCapability::METRIC_MEMORY_THROUGHPUT_BANDWIDTH,
+        DeviceCapability::METRIC_COMPUTATION,
+        DeviceCapability::METRIC_ENGINE_GROUP_COMPUTE_ALL_UTILIZATION,
+        DeviceCapability::METRIC_ENGINE_GROUP_MEDIA_ALL_UTILIZATION,
+        DeviceCapability::METRIC_ENGINE_GROUP_COPY_ALL_UTILIZATION,
+        DeviceCapability::METRIC_ENGINE_GROUP_RENDER_ALL_UTILIZATION,
+        DeviceCapability::METRIC_RAS_ERROR,
+        DeviceCapability::METRIC_MEMORY_TEMPERATURE,
+        DeviceCapability::METRIC_FREQUENCY_THROTTLE,
+        DeviceCapability::METRIC_FREQUENCY_THROTTLE_REASON_GPU,
+        DeviceCapability::METRIC_PCIE_READ_THROUGHPUT,
+        DeviceCapability::METRIC_PCIE_WRITE_THROUGHPUT,
+        DeviceCapability::METRIC_PCIE_READ,
+        DeviceCapability::METRIC_PCIE_WRITE,
+        DeviceCapability::METRIC_ENGINE_UTILIZATION,
+    };
+    if (device_count > 1) {
+        capabilities.push_back(DeviceCapability::METRIC_FABRIC_THROUGHPUT);
+    }
+
+    for (uint32_t i = 0; i < device_count; ++i) {
+        if (enabled_GPU_ids != nullptr && enabled_GPU_ids->find(i) == enabled_GPU_ids->end()) {
+            continue;
+        }
+        auto p_sim = std::make_shared<SimulatedDevice>(std::to_string(i), i, tile_count, capabilities);
+        char bdf[16] = {};
+        snprintf(bdf, sizeof(bdf), "0000:%02x:00.0", (i + 1) & 0xff);
+        p_sim->setPciAddress({0, (i + 1) & 0xff, 0, 0});
+        char uuid[37] = {};
+        snprintf(uuid, sizeof(uuid), "53494d55-4c41-5445-4400-%012x", i);
+        p_sim->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_DEVICE_TYPE, std::string("GPU")));
+        p_sim->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_DEVICE_NAME, std::string("Simulated GPU")));
+        p_sim->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_PCI_DEVICE_ID, std::string("0x0")));
+        p_sim->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_PCI_VENDOR_ID, std::string("0x8086")));
+        p_sim->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_VENDOR_NAME, std::string("Intel(R) Corporation")));
+        p_sim->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_UUID, std::string(uuid)));
+        p_sim->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_SERIAL_NUMBER, "SIM" + std::to_string(i)));
+        p_sim->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_PCI_BDF_ADDRESS, std::string(bdf)));
+        p_sim->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_DEVICE_FUNCTION_TYPE, DEVICE_FUNCTION_TYPE_PHYSICAL));
+        p_sim->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_DRIVER_VERSION, std::string("simulated")));
+        p_sim->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_NUMBER_OF_SUBDEVICE, std::to_string(tile_count > 1 ? tile_count : 0)));
+        p_sim->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_NUMBER_OF_TILES, std::to_string(tile_count)));
+        p_sim->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_MEMORY_PHYSICAL_SIZE_BYTE, std::to_string((64ull << 30) * tile_count)));
+        p_sim->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_NUMBER_OF_MEDIA_ENGINES, std::to_string(2 * tile_count)));
+        p_sim->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_NUMBER_OF_MEDIA_ENH_ENGINES, std::to_string(2 * tile_count)));
+
+        if (device_count > 1) {
+            uint32_t next = (i + 1) % device_count;
+            uint32_t previous = (i + device_count - 1) % device_count;
+            p_sim->setFabricID(simulatedFabricId(i));
+            for (uint32_t tile = 0; tile < tile_count; ++tile) {
+                p_sim->addFabricPort(tile, simulatedFabricId(next), tile);
+                // two devices are linked once, a second port would duplicate the link
+                if (previous != next) {
+                    p_sim->addFabricPort(tile, simulatedFabricId(previous), tile);
+                }
+            }
+            p_sim->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_FABRIC_PORT_NUMBER, std::to_string(tile_count * (previous != next ? 2 : 1))));
+        }
+        p_devices->push_back(p_sim);
+    }
+    XPUM_LOG_INFO("Discovered {} simulated devices", p_devices->size());
+    return p_devices;
+}
+
+} // end namespace xpum
@@ -0,0 +1,46 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file sim_device_stub.h
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "device/device.h"
+
+namespace xpum {
+
+/*
+  SimulatedDeviceStub discovers simulated devices in place of GPUDeviceStub,
+  so that the daemon can be load tested on a machine without GPUs. It is
+  enabled by XPUM_SIMULATED_DEVICES=N and tuned with XPUM_SIMULATED_TILES,
+  XPUM_SIMULATED_LATENCY_US, XPUM_SIMULATED_FAULT_RATE (0 to 1) and
+  XPUM_SIMULATED_SEED. Level Zero is not initialized in this mode.
+
+  When there is more than one device, the tiles are linked in a ring: every
+  tile has a fabric port to the same tile of the next and of the previous
+  device.
+*/
+
+class SimulatedDeviceStub {
+   public:
+    static SimulatedDeviceStub& instance();
+
+    static bool isEnabled();
+
+    void discoverDevices(Callback_t callback);
+
+   private:
+    SimulatedDeviceStub();
+
+    SimulatedDeviceStub(const SimulatedDeviceStub&) = delete;
+
+    SimulatedDeviceStub& operator=(const SimulatedDeviceStub&) = delete;
+
+    static std::shared_ptr<std::vector<std::shared_ptr<Device>>> toDiscover();
+};
+
+} // end namespace xpum
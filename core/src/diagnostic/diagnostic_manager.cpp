@@ -19,6 +19,7 @@
 #include <sys/stat.h>
 #include <sys/sysinfo.h>
 #include "helper.h"
+#include "diagnostic_scheduler.h"
 
 namespace xpum {
 
@@ -36,6 +37,7 @@ void DiagnosticManager::init() {
 }
 
 void DiagnosticManager::close() {
+    DiagnosticRuntimeLease::clear();
 }
 
 std::map<std::string, std::map<std::string, int>> DiagnosticManager::thresholds;
@@ -51,13 +53,18 @@ const std::string DiagnosticManager::COMPONENT_TYPE_NOT_SUPPORTED = "Not support
 std::map<uint32_t, int32_t> DiagnosticManager::fabric_id_convert_to_device_id;
 std::map<int32_t, std::set<int32_t>> DiagnosticManager::device_id_link_to_device_ids;
 
+// the device tasks of a group fill the Xe Link maps concurrently
+static std::mutex xe_link_topology_mutex;
+static std::mutex xe_link_datas_mutex;
+
 std::string zeResultErrorCodeStr(ze_result_t ret) {
     std::ostringstream os;
     os << "0x" << std::setfill('0') << std::setw(8) << std::hex << ret;
     return os.str();
 }
 
-xpum_result_t DiagnosticManager::runDiagnosticsCore(xpum_device_id_t deviceId, xpum_diag_level_t level, xpum_diag_task_type_t types[], int count) {
+xpum_result_t DiagnosticManager::runDiagnosticsCore(xpum_device_id_t deviceId, xpum_diag_level_t level, xpum_diag_task_type_t types[], int count,
+                                                    std::shared_ptr<XeLinkThroughputBatch> xe_link_batch) {
     std::unique_lock<std::mutex> lock(this->mutex);
     if (diagnostic_task_infos.find(deviceId) != diagnostic_task_infos.end() && diagnostic_task_infos.at(deviceId)->finished == false) {
         return XPUM_RESULT_DIAGNOSTIC_TASK_NOT_COMPLETE;
@@ -124,25 +131,51 @@ xpum_result_t DiagnosticManager::runDiagnosticsCore(xpum_device_id_t deviceId, x
     std::thread task(level != XPUM_DIAG_LEVEL_MAX ? DiagnosticManager::doDeviceLevelDiagnosticCore : DiagnosticManager::doDeviceMultipleSpecificDiagnosticCore,
                      this->p_device_manager->getDevice(std::to_string(deviceId))->getDeviceZeHandle(),
                      this->p_device_manager->getDevice(std::to_string(deviceId))->getDriverHandle(),
-                     p_task_info, gpu_total_count, devices, std::ref(this->media_codec_perf_datas), std::ref(this->xe_link_throughput_datas));
+                     p_task_info, gpu_total_count, devices, std::ref(this->media_codec_perf_datas), std::ref(this->xe_link_throughput_datas), xe_link_batch);
     task.detach();
     return XPUM_OK;
 }
 
 xpum_result_t DiagnosticManager::runLevelDiagnostics(xpum_device_id_t deviceId, xpum_diag_level_t level) {
-    if (this->p_device_manager->getDevice(std::to_string(deviceId)) == nullptr) {
-        return XPUM_RESULT_DEVICE_NOT_FOUND;
+    return runLevelDiagnosticsByGroup(std::vector<xpum_device_id_t>{deviceId}, level);
+}
+
+xpum_result_t DiagnosticManager::runMultipleSpecificDiagnostics(xpum_device_id_t deviceId, xpum_diag_task_type_t types[], int count) {
+    return runMultipleSpecificDiagnosticsByGroup(std::vector<xpum_device_id_t>{deviceId}, types, count);
+}
+
+xpum_result_t DiagnosticManager::runLevelDiagnosticsByGroup(const std::vector<xpum_device_id_t> &deviceIds, xpum_diag_level_t level) {
+    for (auto deviceId : deviceIds) {
+        if (this->p_device_manager->getDevice(std::to_string(deviceId)) == nullptr) {
+            return XPUM_RESULT_DEVICE_NOT_FOUND;
+        }
     }
 
     if (level < xpum_diag_level_t::XPUM_DIAG_LEVEL_1 || level > xpum_diag_level_t::XPUM_DIAG_LEVEL_3) {
         return XPUM_RESULT_DIAGNOSTIC_INVALID_LEVEL;
     }
-    return runDiagnosticsCore(deviceId, level, nullptr, 0);
+
+    std::set<int32_t> pending(deviceIds.begin(), deviceIds.end());
+    auto xe_link_batch = std::make_shared<XeLinkThroughputBatch>(pending);
+    for (auto deviceId : deviceIds) {
+        xpum_result_t ret = runDiagnosticsCore(deviceId, level, nullptr, 0, xe_link_batch);
+        if (ret != XPUM_OK) {
+            // the started tasks must not wait for the Xe Link test of the others
+            for (auto id : pending) {
+                xe_link_batch->leave(id);
+            }
+            return ret;
+        }
+        pending.erase(deviceId);
+    }
+    return XPUM_OK;
 }
 
-xpum_result_t DiagnosticManager::runMultipleSpecificDiagnostics(xpum_device_id_t deviceId, xpum_diag_task_type_t types[], int count) {
-    if (this->p_device_manager->getDevice(std::to_string(deviceId)) == nullptr) {
-        return XPUM_RESULT_DEVICE_NOT_FOUND;
+xpum_result_t DiagnosticManager::runMultipleSpecificDiagnosticsByGroup(const std::vector<xpum_device_id_t> &deviceIds, xpum_diag_task_type_t types[], int count) {
+    for (auto deviceId : deviceIds) {
+        if (this->p_device_manager->getDevice(std::to_string(deviceId)) == nullptr) {
+            return XPUM_RESULT_DEVICE_NOT_FOUND;
+        }
     }
     if (count <= 0 || count >= xpum_diag_task_type_t::XPUM_DIAG_TASK_TYPE_MAX) {
         return XPUM_RESULT_DIAGNOSTIC_INVALID_TASK_TYPE;
@@ -152,7 +185,20 @@ xpum_result_t DiagnosticManager::runMultipleSpecificDiagnostics(xpum_device_id_t
             return XPUM_RESULT_DIAGNOSTIC_INVALID_TASK_TYPE;
         }
 
-    return runDiagnosticsCore(deviceId, xpum_diag_level_t::XPUM_DIAG_LEVEL_MAX, types, count);
+
+    std::set<int32_t> pending(deviceIds.begin(), deviceIds.end());
+    auto xe_link_batch = std::make_shared<XeLinkThroughputBatch>(pending);
+    for (auto deviceId : deviceIds) {
+        xpum_result_t ret = runDiagnosticsCore(deviceId, xpum_diag_level_t::XPUM_DIAG_LEVEL_MAX, types, count, xe_link_batch);
+        if (ret != XPUM_OK) {
+            for (auto id : pending) {
+                xe_link_batch->leave(id);
+            }
+            return ret;
+        }
+        pending.erase(deviceId);
+    }
+    return XPUM_OK;
 }
 
 bool DiagnosticManager::isDiagnosticsRunning(xpum_device_id_t deviceId) {
@@ -177,6 +223,14 @@ bool DiagnosticManager::isLevelDiagnosticType(xpum_diag_task_type_t type) {
     return false;
 }
 
+static void copyComponentTimes(xpum_diag_component_info_t &dst, const xpum_diag_component_info_t &src) {
+    dst.setupTime = src.setupTime;
+    dst.runTime = src.runTime;
+    dst.cleanupTime = src.cleanupTime;
+    dst.startTime = src.startTime;
+    dst.endTime = src.endTime;
+}
+
 xpum_result_t DiagnosticManager::getDiagnosticsResult(xpum_device_id_t deviceId, xpum_diag_task_info_t *result) {
     if (this->p_device_manager->getDevice(std::to_string(deviceId)) == nullptr) {
         return XPUM_RESULT_DEVICE_NOT_FOUND;
@@ -208,6 +262,7 @@ xpum_result_t DiagnosticManager::getDiagnosticsResult(xpum_device_id_t deviceId,
                 result->result = xpum_diag_task_result_t::XPUM_DIAG_RESULT_FAIL;
             }
             updateMessage(component.message, std::string(diagnostic_task_infos.at(deviceId)->componentList[component.type].message));
+            copyComponentTimes(component, diagnostic_task_infos.at(deviceId)->componentList[component.type]);
         }
     } else {
         int pos = 0;
@@ -228,6 +283,7 @@ xpum_result_t DiagnosticManager::getDiagnosticsResult(xpum_device_id_t deviceId,
                 result->result = xpum_diag_task_result_t::XPUM_DIAG_RESULT_FAIL;
             }
             updateMessage(component.message, std::string(diagnostic_task_infos.at(deviceId)->componentList[index].message));
+            copyComponentTimes(component, diagnostic_task_infos.at(deviceId)->componentList[index]);
             pos += 1;
         }
     }
@@ -326,133 +382,197 @@ void DiagnosticManager::doDeviceDiagnosticExceptionHandle(xpum_diag_task_type_t
     component.finished = true;
 }
 
+void DiagnosticManager::doDeviceDiagnosticComponent(xpum_diag_task_type_t type, const ze_device_handle_t &ze_device, const ze_driver_handle_t &ze_driver,
+                                                    std::shared_ptr<xpum_diag_task_info_t> p_task_info, int gpu_total_count,
+                                                    std::vector<std::shared_ptr<Device>> &devices,
+                                                    std::map<xpum_device_id_t, std::vector<xpum_diag_media_codec_metrics_t>>& media_codec_perf_datas,
+                                                    std::map<xpum_device_id_t, std::vector<xpum_diag_xe_link_throughput_t>>& xe_link_throughput_datas,
+                                                    std::shared_ptr<XeLinkThroughputBatch> xe_link_batch) {
+    zes_device_handle_t zes_device = (zes_device_handle_t)ze_device;
+    switch (type)
+    {
+    case XPUM_DIAG_SOFTWARE_ENV_VARIABLES:
+        XPUM_LOG_INFO("start environment variables diagnostic");
+        try {
+            doDeviceDiagnosticEnvironmentVariables(p_task_info);
+        } catch (BaseException &e) {
+            doDeviceDiagnosticExceptionHandle(XPUM_DIAG_SOFTWARE_ENV_VARIABLES, e.what(), p_task_info);
+        }
+        break;
+    case XPUM_DIAG_SOFTWARE_LIBRARY:
+        XPUM_LOG_INFO("start libraries diagnostic");
+        try {
+            doDeviceDiagnosticLibraries(p_task_info);
+        } catch (BaseException &e) {
+            doDeviceDiagnosticExceptionHandle(XPUM_DIAG_SOFTWARE_LIBRARY, e.what(), p_task_info);
+        }
+        break;
+    case XPUM_DIAG_SOFTWARE_PERMISSION:
+        XPUM_LOG_INFO("start permission diagnostic");
+        try {
+            doDeviceDiagnosticPermission(gpu_total_count, p_task_info);
+        } catch (BaseException &e) {
+            doDeviceDiagnosticExceptionHandle(XPUM_DIAG_SOFTWARE_PERMISSION, e.what(), p_task_info);
+        }
+        break;
+    case XPUM_DIAG_SOFTWARE_EXCLUSIVE:
+        XPUM_LOG_INFO("start exclusive diagnostic");
+        try {
+            doDeviceDiagnosticExclusive(zes_device, p_task_info);
+        } catch (BaseException &e) {
+            doDeviceDiagnosticExceptionHandle(XPUM_DIAG_SOFTWARE_EXCLUSIVE, e.what(), p_task_info);
+        }
+        break;
+    case XPUM_DIAG_LIGHT_COMPUTATION:
+        XPUM_LOG_INFO("start computation check diagnostic");
+        try {
+            doDeviceDiagnosticPeformanceComputation(ze_device, ze_driver, p_task_info, true);
+        } catch (BaseException &e) {
+            doDeviceDiagnosticExceptionHandle(XPUM_DIAG_LIGHT_COMPUTATION, e.what(), p_task_info);
+        }
+        break;
+    case XPUM_DIAG_LIGHT_CODEC:
+        XPUM_LOG_INFO("start media codec check diagnostic");
+        try {
+            doDeviceDiagnosticMediaCodec(zes_device, p_task_info, media_codec_perf_datas, true);
+        } catch (BaseException &e) {
+            doDeviceDiagnosticExceptionHandle(XPUM_DIAG_LIGHT_CODEC, e.what(), p_task_info);
+        }
+        break;
+    case XPUM_DIAG_HARDWARE_SYSMAN:
+        XPUM_LOG_INFO("start hardware sysmam diagnostic");
+        try {
+            doDeviceDiagnosticHardwareSysman(zes_device, p_task_info);
+        } catch (BaseException &e) {
+            doDeviceDiagnosticExceptionHandle(XPUM_DIAG_HARDWARE_SYSMAN, e.what(), p_task_info);
+        }
+        break;
+    case XPUM_DIAG_INTEGRATION_PCIE:
+        XPUM_LOG_INFO("start integration diagnostic");
+        try {
+            doDeviceDiagnosticIntegration(ze_device, ze_driver, p_task_info);
+        } catch (BaseException &e) {
+            doDeviceDiagnosticExceptionHandle(XPUM_DIAG_INTEGRATION_PCIE, e.what(), p_task_info);
+        }
+        break;
+    case XPUM_DIAG_MEDIA_CODEC:
+        XPUM_LOG_INFO("start mediacodec diagnostic");
+        try {
+            doDeviceDiagnosticMediaCodec(zes_device, p_task_info, media_codec_perf_datas, false);
+        } catch (BaseException &e) {
+            doDeviceDiagnosticExceptionHandle(XPUM_DIAG_MEDIA_CODEC, e.what(), p_task_info);
+        }
+        break;
+    case XPUM_DIAG_PERFORMANCE_COMPUTATION:
+        XPUM_LOG_INFO("start computation diagnostic");
+        try {
+            doDeviceDiagnosticPeformanceComputation(ze_device, ze_driver, p_task_info, false);
+        } catch (BaseException &e) {
+            doDeviceDiagnosticExceptionHandle(XPUM_DIAG_PERFORMANCE_COMPUTATION, e.what(), p_task_info);
+        }
+        break;
+    case XPUM_DIAG_PERFORMANCE_POWER:
+        XPUM_LOG_INFO("start power diagnostic");
+        try {
+            doDeviceDiagnosticPeformancePower(ze_device, ze_driver, p_task_info);
+        } catch (BaseException &e) {
+            doDeviceDiagnosticExceptionHandle(XPUM_DIAG_PERFORMANCE_POWER, e.what(), p_task_info);
+        }
+        break;
+    case XPUM_DIAG_PERFORMANCE_MEMORY_BANDWIDTH:
+        XPUM_LOG_INFO("start memory bandwidth diagnostic");
+        try {
+            doDeviceDiagnosticPeformanceMemoryBandwidth(ze_device, ze_driver, p_task_info);
+        } catch (BaseException &e) {
+            doDeviceDiagnosticExceptionHandle(XPUM_DIAG_PERFORMANCE_MEMORY_BANDWIDTH, e.what(), p_task_info);
+        }
+        break;
+    case XPUM_DIAG_PERFORMANCE_MEMORY_ALLOCATION:
+        XPUM_LOG_INFO("start memory allocation diagnostic ");
+        try {
+            doDeviceDiagnosticPeformanceMemoryAllocation(ze_device, ze_driver, p_task_info);
+        } catch (BaseException &e) {
+            doDeviceDiagnosticExceptionHandle(XPUM_DIAG_PERFORMANCE_MEMORY_ALLOCATION, e.what(), p_task_info);
+        }
+        break;
+    case XPUM_DIAG_MEMORY_ERROR:
+        XPUM_LOG_INFO("start memory error diagnostic ");
+        try {
+            doDeviceDiagnosticMemoryError(ze_device, ze_driver, p_task_info);
+        } catch (BaseException &e) {
+            doDeviceDiagnosticExceptionHandle(XPUM_DIAG_MEMORY_ERROR, e.what(), p_task_info);
+        }
+        break;
+    case XPUM_DIAG_XE_LINK_THROUGHPUT:
+        XPUM_LOG_INFO("start xe link throughput diagnostic ");
+        try {
+            doDeviceDiagnosticXeLinkThroughput(ze_device, ze_driver, p_task_info, devices, xe_link_throughput_datas, xe_link_batch);
+        } catch (BaseException &e) {
+            doDeviceDiagnosticExceptionHandle(XPUM_DIAG_XE_LINK_THROUGHPUT, e.what(), p_task_info);
+        }
+        // no-op if the device joined the test
+        xe_link_batch->leave(p_task_info->deviceId);
+        break;
+    default:
+        break;
+    }
+}
+
+bool DiagnosticManager::doDeviceDiagnosticComponents(const std::vector<xpum_diag_task_type_t> &types, const ze_device_handle_t &ze_device, const ze_driver_handle_t &ze_driver,
+                                                     std::shared_ptr<xpum_diag_task_info_t> p_task_info, int gpu_total_count,
+                                                     std::vector<std::shared_ptr<Device>> &devices,
+                                                     std::map<xpum_device_id_t, std::vector<xpum_diag_media_codec_metrics_t>>& media_codec_perf_datas,
+                                                     std::map<xpum_device_id_t, std::vector<xpum_diag_xe_link_throughput_t>>& xe_link_throughput_datas,
+                                                     std::shared_ptr<XeLinkThroughputBatch> xe_link_batch,
+                                                     std::string &error_details) {
+    DiagnosticScheduler scheduler(p_task_info);
+    for (auto type : types) {
+        scheduler.add(type, [type, &ze_device, &ze_driver, p_task_info, gpu_total_count, &devices, &media_codec_perf_datas, &xe_link_throughput_datas, xe_link_batch]() {
+            doDeviceDiagnosticComponent(type, ze_device, ze_driver, p_task_info, gpu_total_count, devices, media_codec_perf_datas, xe_link_throughput_datas, xe_link_batch);
+        });
+    }
+    std::string error;
+    bool done = scheduler.run(error);
+    // an aborted task never reaches the Xe Link test of its group
+    xe_link_batch->leave(p_task_info->deviceId);
+    if (!done) {
+        error_details = "Aborted! " + error;
+        return false;
+    }
+    return true;
+}
+
 void DiagnosticManager::doDeviceLevelDiagnosticCore(const ze_device_handle_t &ze_device, const ze_driver_handle_t &ze_driver,
                                                std::shared_ptr<xpum_diag_task_info_t> p_task_info, int gpu_total_count,
                                                std::vector<std::shared_ptr<Device>> devices, 
                                                std::map<xpum_device_id_t, std::vector<xpum_diag_media_codec_metrics_t>>& media_codec_perf_datas,
-                                               std::map<xpum_device_id_t, std::vector<xpum_diag_xe_link_throughput_t>>& xe_link_throughput_datas) {
-    bool find_error = false;
+                                               std::map<xpum_device_id_t, std::vector<xpum_diag_xe_link_throughput_t>>& xe_link_throughput_datas,
+                                               std::shared_ptr<XeLinkThroughputBatch> xe_link_batch) {
     std::string error_details;
-    try {
-        zes_device_handle_t zes_device = (zes_device_handle_t)ze_device;
-        if (p_task_info->level >= XPUM_DIAG_LEVEL_1) {
-            XPUM_LOG_INFO("start environment variables diagnostic");
-            try {
-                doDeviceDiagnosticEnvironmentVariables(p_task_info);
-            } catch (BaseException &e) {
-                doDeviceDiagnosticExceptionHandle(XPUM_DIAG_SOFTWARE_ENV_VARIABLES, e.what(), p_task_info);
-            }
-            
-            XPUM_LOG_INFO("start libraries diagnostic");
-            try {
-                doDeviceDiagnosticLibraries(p_task_info);
-            } catch (BaseException &e) {
-                doDeviceDiagnosticExceptionHandle(XPUM_DIAG_SOFTWARE_LIBRARY, e.what(), p_task_info);
-            }
-
-            XPUM_LOG_INFO("start permission diagnostic");
-            try {
-                doDeviceDiagnosticPermission(gpu_total_count, p_task_info);
-            } catch (BaseException &e) {
-                doDeviceDiagnosticExceptionHandle(XPUM_DIAG_SOFTWARE_PERMISSION, e.what(), p_task_info);
-            }
-
-            XPUM_LOG_INFO("start exclusive diagnostic");
-            try {
-                doDeviceDiagnosticExclusive(zes_device, p_task_info);
-            } catch (BaseException &e) {
-                doDeviceDiagnosticExceptionHandle(XPUM_DIAG_SOFTWARE_EXCLUSIVE, e.what(), p_task_info);
-            }
-
-            XPUM_LOG_INFO("start computation check diagnostic");
-            try {
-                doDeviceDiagnosticPeformanceComputation(ze_device, ze_driver, p_task_info, true);
-            } catch (BaseException &e) {
-                doDeviceDiagnosticExceptionHandle(XPUM_DIAG_LIGHT_COMPUTATION, e.what(), p_task_info);
-            }
-        }
-
-        /*
-        if (p_task_info->componentList[xpum_diag_task_type_t::XPUM_DIAG_SOFTWARE_EXCLUSIVE].result == xpum_diag_task_result_t::XPUM_DIAG_RESULT_FAIL) {
-            p_task_info->finished = true;
-            p_task_info->endTime = Utility::getCurrentMillisecond();
-            updateMessage(p_task_info->message, std::string("Aborted! Other GPU processes are running"));
-            XPUM_LOG_ERROR("aborted! other GPU processes are running");
-            return;
-        }
-        */
-
-        if (p_task_info->level >= XPUM_DIAG_LEVEL_2) {
-            XPUM_LOG_INFO("start hardware sysmam diagnostic");
-            try {
-                doDeviceDiagnosticHardwareSysman(zes_device, p_task_info);
-            } catch (BaseException &e) {
-                doDeviceDiagnosticExceptionHandle(XPUM_DIAG_HARDWARE_SYSMAN, e.what(), p_task_info);
-            }
-        
-            XPUM_LOG_INFO("start integration diagnostic");
-            try {
-                doDeviceDiagnosticIntegration(ze_device, ze_driver, p_task_info);
-            } catch (BaseException &e) {
-                doDeviceDiagnosticExceptionHandle(XPUM_DIAG_INTEGRATION_PCIE, e.what(), p_task_info);
-            }
-
-            XPUM_LOG_INFO("start mediacodec diagnostic");
-            try {
-                doDeviceDiagnosticMediaCodec(zes_device, p_task_info, media_codec_perf_datas, false);
-            } catch (BaseException &e) {
-                doDeviceDiagnosticExceptionHandle(XPUM_DIAG_MEDIA_CODEC, e.what(), p_task_info);
-            }
-        }
-
-        if (p_task_info->level >= XPUM_DIAG_LEVEL_3) {
-            XPUM_LOG_INFO("start computation diagnostic");
-            try {
-                doDeviceDiagnosticPeformanceComputation(ze_device, ze_driver, p_task_info, false);
-            } catch (BaseException &e) {
-                doDeviceDiagnosticExceptionHandle(XPUM_DIAG_PERFORMANCE_COMPUTATION, e.what(), p_task_info);
-            }
-
-            // Memory bandwidth test might fail if it starts behind power test on some platforms.
-            XPUM_LOG_INFO("start memory bandwidth diagnostic");
-            try {
-                doDeviceDiagnosticPeformanceMemoryBandwidth(ze_device, ze_driver, p_task_info);
-            } catch (BaseException &e) {
-                doDeviceDiagnosticExceptionHandle(XPUM_DIAG_PERFORMANCE_MEMORY_BANDWIDTH, e.what(), p_task_info);
-            }
-            
-            XPUM_LOG_INFO("start power diagnostic");
-            try {
-                doDeviceDiagnosticPeformancePower(ze_device, ze_driver, p_task_info);
-            } catch (BaseException &e) {
-                doDeviceDiagnosticExceptionHandle(XPUM_DIAG_PERFORMANCE_POWER, e.what(), p_task_info);
-            }
-
-            XPUM_LOG_INFO("start memory allocation diagnostic ");
-            try {
-                doDeviceDiagnosticPeformanceMemoryAllocation(ze_device, ze_driver, p_task_info);
-            } catch (BaseException &e) {
-                doDeviceDiagnosticExceptionHandle(XPUM_DIAG_PERFORMANCE_MEMORY_ALLOCATION, e.what(), p_task_info);
-            }
-
-            XPUM_LOG_INFO("start memory error diagnostic ");
-            try {
-                doDeviceDiagnosticMemoryError(ze_device, ze_driver, p_task_info);
-            } catch (BaseException &e) {
-                doDeviceDiagnosticExceptionHandle(XPUM_DIAG_MEMORY_ERROR, e.what(), p_task_info);
-            }
-
-            XPUM_LOG_INFO("start xe link throughput diagnostic ");
-            try {
-                doDeviceDiagnosticXeLinkThroughput(ze_device, ze_driver, p_task_info, devices, xe_link_throughput_datas);
-            } catch (BaseException &e) {
-                doDeviceDiagnosticExceptionHandle(XPUM_DIAG_XE_LINK_THROUGHPUT, e.what(), p_task_info);
-            }
-        }
-    } catch (std::exception &e) {
-        find_error = true;
-        error_details = "Aborted! " + std::string(e.what());
-    }
+    std::vector<xpum_diag_task_type_t> types;
+    if (p_task_info->level >= XPUM_DIAG_LEVEL_1) {
+        types.push_back(XPUM_DIAG_SOFTWARE_ENV_VARIABLES);
+        types.push_back(XPUM_DIAG_SOFTWARE_LIBRARY);
+        types.push_back(XPUM_DIAG_SOFTWARE_PERMISSION);
+        types.push_back(XPUM_DIAG_SOFTWARE_EXCLUSIVE);
+        types.push_back(XPUM_DIAG_LIGHT_COMPUTATION);
+    }
+    if (p_task_info->level >= XPUM_DIAG_LEVEL_2) {
+        types.push_back(XPUM_DIAG_HARDWARE_SYSMAN);
+        types.push_back(XPUM_DIAG_INTEGRATION_PCIE);
+        types.push_back(XPUM_DIAG_MEDIA_CODEC);
+    }
+    if (p_task_info->level >= XPUM_DIAG_LEVEL_3) {
+        types.push_back(XPUM_DIAG_PERFORMANCE_COMPUTATION);
+        // Memory bandwidth test might fail if it starts behind power test on some platforms.
+        types.push_back(XPUM_DIAG_PERFORMANCE_MEMORY_BANDWIDTH);
+        types.push_back(XPUM_DIAG_PERFORMANCE_POWER);
+        types.push_back(XPUM_DIAG_PERFORMANCE_MEMORY_ALLOCATION);
+        types.push_back(XPUM_DIAG_MEMORY_ERROR);
+        types.push_back(XPUM_DIAG_XE_LINK_THROUGHPUT);
+    }
+    bool find_error = !doDeviceDiagnosticComponents(types, ze_device, ze_driver, p_task_info, gpu_total_count, devices,
+                                                    media_codec_perf_datas, xe_link_throughput_datas, xe_link_batch, error_details);
 
     p_task_info->endTime = Utility::getCurrentMillisecond();
     p_task_info->finished = true;
@@ -474,143 +594,15 @@ void DiagnosticManager::doDeviceMultipleSpecificDiagnosticCore(const ze_device_h
                                                std::shared_ptr<xpum_diag_task_info_t> p_task_info, int gpu_total_count,
                                                std::vector<std::shared_ptr<Device>> devices, 
                                                std::map<xpum_device_id_t, std::vector<xpum_diag_media_codec_metrics_t>>& media_codec_perf_datas,
-                                               std::map<xpum_device_id_t, std::vector<xpum_diag_xe_link_throughput_t>>& xe_link_throughput_datas) {
-    bool find_error = false;
+                                               std::map<xpum_device_id_t, std::vector<xpum_diag_xe_link_throughput_t>>& xe_link_throughput_datas,
+                                               std::shared_ptr<XeLinkThroughputBatch> xe_link_batch) {
     std::string error_details;
-
-    try {
-        zes_device_handle_t zes_device = (zes_device_handle_t)ze_device;
-        for (int i = 0; i < p_task_info->targetTypeCount; i++) {
-            switch (p_task_info->targetTypes[i])
-            {
-            case XPUM_DIAG_SOFTWARE_ENV_VARIABLES:
-                XPUM_LOG_INFO("start environment variables diagnostic");
-                try {
-                    doDeviceDiagnosticEnvironmentVariables(p_task_info);
-                } catch (BaseException &e) {
-                    doDeviceDiagnosticExceptionHandle(XPUM_DIAG_SOFTWARE_ENV_VARIABLES, e.what(), p_task_info);
-                }
-                break;
-            case XPUM_DIAG_SOFTWARE_LIBRARY:
-                XPUM_LOG_INFO("start libraries diagnostic");
-                try {
-                    doDeviceDiagnosticLibraries(p_task_info);
-                } catch (BaseException &e) {
-                    doDeviceDiagnosticExceptionHandle(XPUM_DIAG_SOFTWARE_LIBRARY, e.what(), p_task_info);
-                }
-                break;
-            case XPUM_DIAG_SOFTWARE_PERMISSION:
-                XPUM_LOG_INFO("start permission diagnostic");
-                try {
-                    doDeviceDiagnosticPermission(gpu_total_count, p_task_info);
-                } catch (BaseException &e) {
-                    doDeviceDiagnosticExceptionHandle(XPUM_DIAG_SOFTWARE_PERMISSION, e.what(), p_task_info);
-                }
-                break;
-            case XPUM_DIAG_SOFTWARE_EXCLUSIVE:
-                XPUM_LOG_INFO("start exclusive diagnostic");
-                try {
-                    doDeviceDiagnosticExclusive(zes_device, p_task_info);
-                } catch (BaseException &e) {
-                    doDeviceDiagnosticExceptionHandle(XPUM_DIAG_SOFTWARE_EXCLUSIVE, e.what(), p_task_info);
-                }
-                break;
-            case XPUM_DIAG_LIGHT_COMPUTATION:
-                XPUM_LOG_INFO("start computation check diagnostic");
-                try {
-                    doDeviceDiagnosticPeformanceComputation(ze_device, ze_driver, p_task_info, true);
-                } catch (BaseException &e) {
-                    doDeviceDiagnosticExceptionHandle(XPUM_DIAG_LIGHT_COMPUTATION, e.what(), p_task_info);
-                }
-                break;
-            case XPUM_DIAG_LIGHT_CODEC:
-                XPUM_LOG_INFO("start media codec check diagnostic");
-                try {
-                    doDeviceDiagnosticMediaCodec(zes_device, p_task_info, media_codec_perf_datas, true);
-                } catch (BaseException &e) {
-                    doDeviceDiagnosticExceptionHandle(XPUM_DIAG_LIGHT_CODEC, e.what(), p_task_info);
-                }
-                break;
-            case XPUM_DIAG_HARDWARE_SYSMAN:
-                XPUM_LOG_INFO("start hardware sysmam diagnostic");
-                try {
-                    doDeviceDiagnosticHardwareSysman(zes_device, p_task_info);
-                } catch (BaseException &e) {
-                    doDeviceDiagnosticExceptionHandle(XPUM_DIAG_HARDWARE_SYSMAN, e.what(), p_task_info);
-                }
-                break;
-            case XPUM_DIAG_INTEGRATION_PCIE:
-                XPUM_LOG_INFO("start integration diagnostic");
-                try {
-                    doDeviceDiagnosticIntegration(ze_device, ze_driver, p_task_info);
-                } catch (BaseException &e) {
-                    doDeviceDiagnosticExceptionHandle(XPUM_DIAG_INTEGRATION_PCIE, e.what(), p_task_info);
-                }
-                break;
-            case XPUM_DIAG_MEDIA_CODEC:
-                XPUM_LOG_INFO("start mediacodec diagnostic");
-                try {
-                    doDeviceDiagnosticMediaCodec(zes_device, p_task_info, media_codec_perf_datas, false);
-                } catch (BaseException &e) {
-                    doDeviceDiagnosticExceptionHandle(XPUM_DIAG_MEDIA_CODEC, e.what(), p_task_info);
-                }
-                break;
-            case XPUM_DIAG_PERFORMANCE_COMPUTATION:
-                XPUM_LOG_INFO("start computation diagnostic");
-                try {
-                    doDeviceDiagnosticPeformanceComputation(ze_device, ze_driver, p_task_info, false);
-                } catch (BaseException &e) {
-                    doDeviceDiagnosticExceptionHandle(XPUM_DIAG_PERFORMANCE_COMPUTATION, e.what(), p_task_info);
-                }
-                break;
-            case XPUM_DIAG_PERFORMANCE_POWER:
-                XPUM_LOG_INFO("start power diagnostic");
-                try {
-                    doDeviceDiagnosticPeformancePower(ze_device, ze_driver, p_task_info);
-                } catch (BaseException &e) {
-                    doDeviceDiagnosticExceptionHandle(XPUM_DIAG_PERFORMANCE_POWER, e.what(), p_task_info);
-                }
-                break;
-            case XPUM_DIAG_PERFORMANCE_MEMORY_BANDWIDTH:
-                XPUM_LOG_INFO("start memory bandwidth diagnostic");
-                try {
-                    doDeviceDiagnosticPeformanceMemoryBandwidth(ze_device, ze_driver, p_task_info);
-                } catch (BaseException &e) {
-                    doDeviceDiagnosticExceptionHandle(XPUM_DIAG_PERFORMANCE_MEMORY_BANDWIDTH, e.what(), p_task_info);
-                }
-                break;
-            case XPUM_DIAG_PERFORMANCE_MEMORY_ALLOCATION:
-                XPUM_LOG_INFO("start memory allocation diagnostic ");
-                try {
-                    doDeviceDiagnosticPeformanceMemoryAllocation(ze_device, ze_driver, p_task_info);
-                } catch (BaseException &e) {
-                    doDeviceDiagnosticExceptionHandle(XPUM_DIAG_PERFORMANCE_MEMORY_ALLOCATION, e.what(), p_task_info);
-                }
-                break;
-            case XPUM_DIAG_MEMORY_ERROR:
-                XPUM_LOG_INFO("start memory error diagnostic ");
-                try {
-                    doDeviceDiagnosticMemoryError(ze_device, ze_driver, p_task_info);
-                } catch (BaseException &e) {
-                    doDeviceDiagnosticExceptionHandle(XPUM_DIAG_MEMORY_ERROR, e.what(), p_task_info);
-                }
-                break;
-            case XPUM_DIAG_XE_LINK_THROUGHPUT:
-                XPUM_LOG_INFO("start xe link throughput diagnostic ");
-                try {
-                    doDeviceDiagnosticXeLinkThroughput(ze_device, ze_driver, p_task_info, devices, xe_link_throughput_datas);
-                } catch (BaseException &e) {
-                    doDeviceDiagnosticExceptionHandle(XPUM_DIAG_XE_LINK_THROUGHPUT, e.what(), p_task_info);
-                }
-                break;
-            default:
-                break;
-            }
-        }
-    } catch (std::exception &e) {
-        find_error = true;
-        error_details = "Aborted! " + std::string(e.what());
+    std::vector<xpum_diag_task_type_t> types;
+    for (int i = 0; i < p_task_info->targetTypeCount; i++) {
+        types.push_back(p_task_info->targetTypes[i]);
     }
+    bool find_error = !doDeviceDiagnosticComponents(types, ze_device, ze_driver, p_task_info, gpu_total_count, devices,
+                                                    media_codec_perf_datas, xe_link_throughput_datas, xe_link_batch, error_details);
 
     p_task_info->endTime = Utility::getCurrentMillisecond();
     p_task_info->finished = true;
@@ -632,7 +624,6 @@ void DiagnosticManager::doDeviceDiagnosticEnvironmentVariables(std::shared_ptr<x
     std::string details;
     // DIAGNOSTIC_SOFTWARE_ENV
     xpum_diag_component_info_t &component1 = p_task_info->componentList[xpum_diag_task_type_t::XPUM_DIAG_SOFTWARE_ENV_VARIABLES];
-    p_task_info->count += 1;
     updateMessage(component1.message, std::string("Running"));
     std::vector<std::string> check_env_varibles;
     check_env_varibles.push_back(std::string("ZES_ENABLE_SYSMAN"));
@@ -666,7 +657,6 @@ void DiagnosticManager::doDeviceDiagnosticLibraries(std::shared_ptr<xpum_diag_ta
     std::string details;
     // DIAGNOSTIC_SOFTWARE_LIBRARY
     xpum_diag_component_info_t &component2 = p_task_info->componentList[xpum_diag_task_type_t::XPUM_DIAG_SOFTWARE_LIBRARY];
-    p_task_info->count += 1;
     updateMessage(component2.message, std::string("Running"));
     std::vector<std::string> libs;
     libs.push_back("libze_loader.so.1");
@@ -698,7 +688,6 @@ void DiagnosticManager::doDeviceDiagnosticLibraries(std::shared_ptr<xpum_diag_ta
 void DiagnosticManager::doDeviceDiagnosticPermission(int gpu_total_count, std::shared_ptr<xpum_diag_task_info_t> p_task_info) {
     std::string details;
     xpum_diag_component_info_t &component3 = p_task_info->componentList[xpum_diag_task_type_t::XPUM_DIAG_SOFTWARE_PERMISSION];
-    p_task_info->count += 1;
     updateMessage(component3.message, std::string("Running"));
     int device_count = 0;
     DIR *dir;
@@ -747,7 +736,6 @@ void DiagnosticManager::doDeviceDiagnosticExclusive(const zes_device_handle_t &d
     std::string details;
     // DIAGNOSTIC_SOFTWARE_EXCLUSIVE
     xpum_diag_component_info_t &component4 = p_task_info->componentList[xpum_diag_task_type_t::XPUM_DIAG_SOFTWARE_EXCLUSIVE];
-    p_task_info->count += 1;
     updateMessage(component4.message, std::string("Running"));
     uint32_t process_count = 0;
     ze_result_t ret;
@@ -803,7 +791,6 @@ bool DiagnosticManager::countDevEntry(const std::string &entry_name) {
 void DiagnosticManager::doDeviceDiagnosticHardwareSysman(const zes_device_handle_t &zes_device,
                                                          std::shared_ptr<xpum_diag_task_info_t> p_task_info) {
     xpum_diag_component_info_t &component = p_task_info->componentList[xpum_diag_task_type_t::XPUM_DIAG_HARDWARE_SYSMAN];
-    p_task_info->count += 1;
     updateMessage(component.message, std::string("Running"));
     component.result = xpum_diag_task_result_t::XPUM_DIAG_RESULT_UNKNOWN;
     // disable hardware diagnostics due to instability
@@ -905,7 +892,6 @@ void DiagnosticManager::doDeviceDiagnosticMediaCodec(const zes_device_handle_t &
         xpum_diag_task_type_t::XPUM_DIAG_LIGHT_CODEC :
         xpum_diag_task_type_t::XPUM_DIAG_MEDIA_CODEC
     ];
-    p_task_info->count += 1;
     if (Utility::isPVCPlatform(device)) {
         component.result = XPUM_DIAG_RESULT_FAIL;
         component.finished = true;
@@ -1156,7 +1142,6 @@ void DiagnosticManager::doDeviceDiagnosticIntegration(const ze_device_handle_t &
                                                       const ze_driver_handle_t &ze_driver,
                                                       std::shared_ptr<xpum_diag_task_info_t> p_task_info) {
     xpum_diag_component_info_t &component = p_task_info->componentList[xpum_diag_task_type_t::XPUM_DIAG_INTEGRATION_PCIE];
-    p_task_info->count += 1;
     updateMessage(component.message, std::string("Running"));
     component.result = xpum_diag_task_result_t::XPUM_DIAG_RESULT_UNKNOWN;
 
@@ -1366,7 +1351,6 @@ void DiagnosticManager::doDeviceDiagnosticPeformanceMemoryAllocation(const ze_de
                                                                      const ze_driver_handle_t &ze_driver,
                                                                      std::shared_ptr<xpum_diag_task_info_t> p_task_info) {
     xpum_diag_component_info_t &component = p_task_info->componentList[xpum_diag_task_type_t::XPUM_DIAG_PERFORMANCE_MEMORY_ALLOCATION];
-    p_task_info->count += 1;
     updateMessage(component.message, std::string("Running"));
     component.result = xpum_diag_task_result_t::XPUM_DIAG_RESULT_UNKNOWN;
 
@@ -1381,6 +1365,10 @@ void DiagnosticManager::doDeviceDiagnosticPeformanceMemoryAllocation(const ze_de
     std::vector<uint64_t> allocate_sizes = {one_MB, one_GB};
     std::vector<std::string> memory_types = {"DEVICE", "SHARED"};
 
+    DiagnosticRuntimeLease runtime(ze_driver, ze_device);
+    ze_context_handle_t context = runtime->getContext();
+    ze_module_handle_t module_handle = runtime->getModule("test_multiple_memory_allocations.spv", loadBinaryFile);
+
     for (auto &memory_use : memory_uses)
         for (auto &allocate_size : allocate_sizes)
             for (auto &memory_type : memory_types) {
@@ -1391,16 +1379,6 @@ void DiagnosticManager::doDeviceDiagnosticPeformanceMemoryAllocation(const ze_de
                 if (ret != ZE_RESULT_SUCCESS) {
                     throw BaseException("zeDeviceGetProperties()[" + zeResultErrorCodeStr(ret) + "]");
                 }
-                ze_context_desc_t context_desc = {
-                        ZE_STRUCTURE_TYPE_CONTEXT_DESC,
-                        nullptr, 
-                        0
-                };
-                ze_context_handle_t context;
-                XPUM_ZE_HANDLE_LOCK(ze_driver, ret = zeContextCreate(ze_driver, &context_desc, &context));
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeContextCreate()[" + zeResultErrorCodeStr(ret) + "]");
-                }
                 uint64_t target_test_memory_size = device_properties.maxMemAllocSize;
                 struct sysinfo info;
                 if (sysinfo(&info) == 0) {
@@ -1518,20 +1496,6 @@ void DiagnosticManager::doDeviceDiagnosticPeformanceMemoryAllocation(const ze_de
                     test_kernel_names.push_back(kernel_name);
                 }
 
-                const std::vector<uint8_t> binary_file = loadBinaryFile("test_multiple_memory_allocations.spv");
-                ze_module_desc_t module_description = {};
-                module_description.stype = ZE_STRUCTURE_TYPE_MODULE_DESC;
-                module_description.pNext = nullptr;
-                module_description.format = ZE_MODULE_FORMAT_IL_SPIRV;
-                module_description.inputSize = static_cast<uint32_t>(binary_file.size());
-                module_description.pInputModule = binary_file.data();
-                module_description.pBuildFlags = nullptr;
-
-                ze_module_handle_t module_handle = nullptr;
-                XPUM_ZE_HANDLE_LOCK(ze_device, ret = zeModuleCreate(context, ze_device, &module_description, &module_handle, nullptr));
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeModuleCreate()[" + zeResultErrorCodeStr(ret) + "]");
-                }
                 dispatchKernelsForMemoryTest(ze_device, module_handle, input_allocations, output_allocations,
                                              data_out_vector, test_kernel_names, number_of_dispatch, one_case_allocation_count, context);
                 for (auto each_allocation : input_allocations) {
@@ -1546,16 +1510,8 @@ void DiagnosticManager::doDeviceDiagnosticPeformanceMemoryAllocation(const ze_de
                         throw BaseException("zeMemFree()[" + zeResultErrorCodeStr(ret) + "]");
                     }
                 }
-
-                ret = zeModuleDestroy(module_handle);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeModuleDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-                }
-                ret = zeContextDestroy(context);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeContextDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-                }
             }
+    runtime.commit();
     component.result = xpum_diag_task_result_t::XPUM_DIAG_RESULT_PASS;
     updateMessage(component.message, std::string("Pass to check memory allocation."));
     XPUM_LOG_INFO("Pass to check memory allocation.");
@@ -1598,7 +1554,6 @@ void DiagnosticManager::doDeviceDiagnosticMemoryError(const ze_device_handle_t &
                                                                      const ze_driver_handle_t &ze_driver,
                                                                      std::shared_ptr<xpum_diag_task_info_t> p_task_info) {
     xpum_diag_component_info_t &component = p_task_info->componentList[xpum_diag_task_type_t::XPUM_DIAG_MEMORY_ERROR];
-    p_task_info->count += 1;
     updateMessage(component.message, std::string("Running"));
     component.result = xpum_diag_task_result_t::XPUM_DIAG_RESULT_UNKNOWN;
     ze_result_t ret;
@@ -1945,7 +1900,6 @@ void DiagnosticManager::doDeviceDiagnosticPeformanceComputation(const ze_device_
         comp_index = xpum_diag_task_type_t::XPUM_DIAG_PERFORMANCE_COMPUTATION;
     }
     xpum_diag_component_info_t &compute_component = p_task_info->componentList[comp_index];
-    p_task_info->count += 1;
     updateMessage(compute_component.message, std::string("Running"));
     compute_component.result = xpum_diag_task_result_t::XPUM_DIAG_RESULT_UNKNOWN;
 
@@ -1977,10 +1931,12 @@ void DiagnosticManager::doDeviceDiagnosticPeformanceComputation(const ze_device_
         }
     }
 
+    std::vector<DiagnosticPhaseTimes> phase_times(device_handles.size());
     for (std::size_t i = 0; i < device_handles.size(); i++) {
-        compute_threads.push_back(std::thread([&all_gflops, &error_messages, i, &device_handles, &ze_driver, checkOnly]() {
+        compute_threads.push_back(std::thread([&all_gflops, &error_messages, &phase_times, i, &device_handles, &ze_driver, checkOnly]() {
             try {
                 ze_result_t ret;
+                DiagnosticPhaseTimer timer;
                 long double timed;
                 std::size_t flops_per_work_item = 4096;
                 struct ZeWorkGroups workgroup_info;
@@ -2001,29 +1957,9 @@ void DiagnosticManager::doDeviceDiagnosticPeformanceComputation(const ze_device_
                 if (ret != ZE_RESULT_SUCCESS) {
                     throw BaseException("zeDeviceGetComputeProperties()[" + zeResultErrorCodeStr(ret) + "]");
                 }
-                ze_context_handle_t context;
-                ze_context_desc_t context_desc = {
-                        ZE_STRUCTURE_TYPE_CONTEXT_DESC,
-                        nullptr, 
-                        0
-                };
-                XPUM_ZE_HANDLE_LOCK(ze_driver, ret = zeContextCreate(ze_driver, &context_desc, &context));
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeContextCreate()[" + zeResultErrorCodeStr(ret) + "]");
-                }
-                ze_module_handle_t module_handle;
-                ze_module_desc_t module_description = {};
-                std::vector<uint8_t> binary_file = loadBinaryFile("ze_sp_compute.spv");
-                module_description.stype = ZE_STRUCTURE_TYPE_MODULE_DESC;
-                module_description.pNext = nullptr;
-                module_description.format = ZE_MODULE_FORMAT_IL_SPIRV;
-                module_description.inputSize = static_cast<uint32_t>(binary_file.size());
-                module_description.pInputModule = binary_file.data();
-                module_description.pBuildFlags = nullptr;
-                XPUM_ZE_HANDLE_LOCK(device_handles[i], ret = zeModuleCreate(context, device_handles[i], &module_description, &module_handle, nullptr));
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeModuleCreate()[" + zeResultErrorCodeStr(ret) + "]");
-                }
+                DiagnosticRuntimeLease runtime(ze_driver, device_handles[i]);
+                ze_context_handle_t context = runtime->getContext();
+                ze_module_handle_t module_handle = runtime->getModule("ze_sp_compute.spv", loadBinaryFile);
                 uint64_t max_work_items = (uint64_t)device_properties.numSlices *
                                           device_properties.numSubslicesPerSlice *
                                           device_properties.numEUsPerSubslice *
@@ -2064,23 +2000,12 @@ void DiagnosticManager::doDeviceDiagnosticPeformanceComputation(const ze_device_
                 command_list_description.flags = ZE_COMMAND_LIST_FLAG_EXPLICIT_ONLY;
                 command_list_description.commandQueueGroupOrdinal = 0;
 
-                ze_command_queue_handle_t command_queue;
-                ze_command_queue_desc_t command_queue_description{};
-                command_queue_description.stype = ZE_STRUCTURE_TYPE_COMMAND_QUEUE_DESC;
-                command_queue_description.pNext = nullptr;
-                command_queue_description.mode = ZE_COMMAND_QUEUE_MODE_ASYNCHRONOUS;
-                command_queue_description.flags = ZE_COMMAND_QUEUE_FLAG_EXPLICIT_ONLY;
-                command_queue_description.ordinal = 0;
-                command_queue_description.index = 0;
+                ze_command_queue_handle_t command_queue = runtime->getCommandQueue();
 
                 XPUM_ZE_HANDLE_LOCK(device_handles[i], ret = zeCommandListCreate(context, device_handles[i], &command_list_description, &command_list));
                 if (ret != ZE_RESULT_SUCCESS) {
                     throw BaseException("zeCommandListCreate()[" + zeResultErrorCodeStr(ret) + "]");
                 }
-                XPUM_ZE_HANDLE_LOCK(device_handles[i], ret = zeCommandQueueCreate(context, device_handles[i], &command_queue_description, &command_queue));
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeCommandQueueCreate()[" + zeResultErrorCodeStr(ret) + "]");
-                }
                 ret = zeCommandListAppendMemoryCopy(command_list, device_input_value, &input_value, sizeof(float), nullptr, 0, nullptr);
                 if (ret != ZE_RESULT_SUCCESS) {
                     throw BaseException("zeCommandListAppendMemoryCopy()[" + zeResultErrorCodeStr(ret) + "]");
@@ -2108,11 +2033,12 @@ void DiagnosticManager::doDeviceDiagnosticPeformanceComputation(const ze_device_
                 ze_kernel_handle_t compute_sp_v8;
                 ze_kernel_handle_t compute_sp_v16;
 
-                setupFunction(module_handle, compute_sp_v1, "compute_sp_v1", device_input_value, device_output_buffer);
-                setupFunction(module_handle, compute_sp_v2, "compute_sp_v2", device_input_value, device_output_buffer);
-                setupFunction(module_handle, compute_sp_v4, "compute_sp_v4", device_input_value, device_output_buffer);
-                setupFunction(module_handle, compute_sp_v8, "compute_sp_v8", device_input_value, device_output_buffer);
-                setupFunction(module_handle, compute_sp_v16, "compute_sp_v16", device_input_value, device_output_buffer);
+                setupFunction(runtime, module_handle, compute_sp_v1, "compute_sp_v1", device_input_value, device_output_buffer);
+                setupFunction(runtime, module_handle, compute_sp_v2, "compute_sp_v2", device_input_value, device_output_buffer);
+                setupFunction(runtime, module_handle, compute_sp_v4, "compute_sp_v4", device_input_value, device_output_buffer);
+                setupFunction(runtime, module_handle, compute_sp_v8, "compute_sp_v8", device_input_value, device_output_buffer);
+                setupFunction(runtime, module_handle, compute_sp_v16, "compute_sp_v16", device_input_value, device_output_buffer);
+                phase_times[i].setup = timer.lap();
 
                 timed = 0;
                 long double current;
@@ -2152,34 +2078,11 @@ void DiagnosticManager::doDeviceDiagnosticPeformanceComputation(const ze_device_
                 gflops = std::max(gflops, current);
                 XPUM_LOG_INFO("compute sp vector width 16 done");
                 */
-                ret = zeKernelDestroy(compute_sp_v1);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeKernelDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-                }
-                ret = zeKernelDestroy(compute_sp_v2);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeKernelDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-                }
-                ret = zeKernelDestroy(compute_sp_v4);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeKernelDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-                }
-                ret = zeKernelDestroy(compute_sp_v8);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeKernelDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-                }
-                ret = zeKernelDestroy(compute_sp_v16);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeKernelDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-                }
+                phase_times[i].run = timer.lap();
                 ret = zeCommandListDestroy(command_list);
                 if (ret != ZE_RESULT_SUCCESS) {
                     throw BaseException("zeCommandListDestroy()");
                 }
-                ret = zeCommandQueueDestroy(command_queue);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeCommandQueueDestroy()");
-                }
                 ret = zeMemFree(context, device_input_value);
                 if (ret != ZE_RESULT_SUCCESS) {
                     throw BaseException("zeMemFree()[" + zeResultErrorCodeStr(ret) + "]");
@@ -2188,14 +2091,8 @@ void DiagnosticManager::doDeviceDiagnosticPeformanceComputation(const ze_device_
                 if (ret != ZE_RESULT_SUCCESS) {
                     throw BaseException("zeMemFree()[" + zeResultErrorCodeStr(ret) + "]");
                 }
-                ret = zeModuleDestroy(module_handle);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeModuleDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-                }
-                ret = zeContextDestroy(context);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeContextDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-                }
+                phase_times[i].cleanup = timer.lap();
+                runtime.commit();
             } catch (BaseException &e) {
                 XPUM_LOG_DEBUG("Error in computation diagnostic");
                 XPUM_LOG_DEBUG(e.what());
@@ -2212,6 +2109,8 @@ void DiagnosticManager::doDeviceDiagnosticPeformanceComputation(const ze_device_
         compute_threads[i].join();
     }
 
+    updatePhaseTimes(compute_component, phase_times);
+
     long double all_gflops_value = 0;
     for (size_t i = 0; i < all_gflops.size(); i++) {
         if (all_gflops[i] < 0) {
@@ -2258,7 +2157,6 @@ void DiagnosticManager::doDeviceDiagnosticPeformanceComputation(const ze_device_
 void DiagnosticManager::doDeviceDiagnosticPeformancePower(const ze_device_handle_t &ze_device, const ze_driver_handle_t &ze_driver, std::shared_ptr<xpum_diag_task_info_t> p_task_info) {
     std::atomic<bool> computation_done(false);
     xpum_diag_component_info_t &power_component = p_task_info->componentList[xpum_diag_task_type_t::XPUM_DIAG_PERFORMANCE_POWER];
-    p_task_info->count += 1;
     updateMessage(power_component.message, std::string("Running"));
     power_component.result = xpum_diag_task_result_t::XPUM_DIAG_RESULT_UNKNOWN;
 
@@ -2581,7 +2479,19 @@ uint64_t DiagnosticManager::setWorkgroups(ze_device_compute_properties_t &device
     return final_work_items;
 }
 
-void DiagnosticManager::setupFunction(ze_module_handle_t &module_handle, ze_kernel_handle_t &function,
+static void setKernelArguments(ze_kernel_handle_t function, void *input, void *output) {
+    ze_result_t ret;
+    ret = zeKernelSetArgumentValue(function, 0, sizeof(input), &input);
+    if (ret != ZE_RESULT_SUCCESS) {
+        throw BaseException("zeKernelSetArgumentValue()[" + zeResultErrorCodeStr(ret) + "]");
+    }
+    ret = zeKernelSetArgumentValue(function, 1, sizeof(output), &output);
+    if (ret != ZE_RESULT_SUCCESS) {
+        throw BaseException("zeKernelSetArgumentValue()[" + zeResultErrorCodeStr(ret) + "]");
+    }
+}
+
+void DiagnosticManager::setupFunction(ze_module_handle_t &module_handle, ze_kernel_handle_t &function,
                                       const char *name, void *input, void *output) {
     ze_result_t ret;
     ze_kernel_desc_t function_description = {};
@@ -2593,14 +2503,25 @@ void DiagnosticManager::setupFunction(ze_module_handle_t &module_handle, ze_kern
     if (ret != ZE_RESULT_SUCCESS) {
         throw BaseException("zeKernelCreate()[" + zeResultErrorCodeStr(ret) + "]");
     }
-    ret = zeKernelSetArgumentValue(function, 0, sizeof(input), &input);
-    if (ret != ZE_RESULT_SUCCESS) {
-        throw BaseException("zeKernelSetArgumentValue()[" + zeResultErrorCodeStr(ret) + "]");
-    }
-    ret = zeKernelSetArgumentValue(function, 1, sizeof(output), &output);
-    if (ret != ZE_RESULT_SUCCESS) {
-        throw BaseException("zeKernelSetArgumentValue()[" + zeResultErrorCodeStr(ret) + "]");
+    setKernelArguments(function, input, output);
+}
+
+void DiagnosticManager::setupFunction(DiagnosticRuntimeLease &runtime, ze_module_handle_t module_handle, ze_kernel_handle_t &function,
+                                      const char *name, void *input, void *output) {
+    function = runtime->getKernel(module_handle, name);
+    setKernelArguments(function, input, output);
+}
+
+void DiagnosticManager::updatePhaseTimes(xpum_diag_component_info_t &component, const std::vector<DiagnosticPhaseTimes> &phase_times) {
+    component.setupTime = 0;
+    component.runTime = 0;
+    component.cleanupTime = 0;
+    for (auto &times : phase_times) {
+        component.setupTime = std::max(component.setupTime, times.setup);
+        component.runTime = std::max(component.runTime, times.run);
+        component.cleanupTime = std::max(component.cleanupTime, times.cleanup);
     }
+    XPUM_LOG_DEBUG("diagnostic {} setup {} ms, run {} ms, cleanup {} ms", component.type, component.setupTime, component.runTime, component.cleanupTime);
 }
 
 long double DiagnosticManager::runKernel(ze_command_queue_handle_t command_queue, ze_command_list_handle_t command_list,
@@ -2713,7 +2634,6 @@ void DiagnosticManager::doDeviceDiagnosticPeformanceMemoryBandwidth(const ze_dev
                                                                     const ze_driver_handle_t &ze_driver,
                                                                     std::shared_ptr<xpum_diag_task_info_t> p_task_info) {
     xpum_diag_component_info_t &memorybandwidth_component = p_task_info->componentList[xpum_diag_task_type_t::XPUM_DIAG_PERFORMANCE_MEMORY_BANDWIDTH];
-    p_task_info->count += 1;
     updateMessage(memorybandwidth_component.message, std::string("Running"));
     memorybandwidth_component.result = xpum_diag_task_result_t::XPUM_DIAG_RESULT_UNKNOWN;
 
@@ -2744,10 +2664,12 @@ void DiagnosticManager::doDeviceDiagnosticPeformanceMemoryBandwidth(const ze_dev
             error_messages.push_back("");
         }
     }
+    std::vector<DiagnosticPhaseTimes> phase_times(device_handles.size());
     for (std::size_t i = 0; i < device_handles.size(); i++) {
-        memorybandwidth_threads.push_back(std::thread([&all_gbps, &error_messages, i, &device_handles, &ze_driver]() {
+        memorybandwidth_threads.push_back(std::thread([&all_gbps, &error_messages, &phase_times, i, &device_handles, &ze_driver]() {
             try {
                 ze_result_t ret;
+                DiagnosticPhaseTimer timer;
                 long double timed_lo, timed_go, timed, gbps;
                 struct ZeWorkGroups workgroup_info;
                 uint64_t temp_global_size;
@@ -2765,29 +2687,9 @@ void DiagnosticManager::doDeviceDiagnosticPeformanceMemoryBandwidth(const ze_dev
                 if (ret != ZE_RESULT_SUCCESS) {
                     throw BaseException("zeDeviceGetComputeProperties()[" + zeResultErrorCodeStr(ret) + "]");
                 }
-                ze_context_handle_t context;
-                ze_context_desc_t context_desc = {
-                        ZE_STRUCTURE_TYPE_CONTEXT_DESC,
-                        nullptr, 
-                        0
-                };
-                XPUM_ZE_HANDLE_LOCK(ze_driver, ret = zeContextCreate(ze_driver, &context_desc, &context));
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeContextCreate()[" + zeResultErrorCodeStr(ret) + "]");
-                }
-                ze_module_handle_t module_handle;
-                ze_module_desc_t module_description = {};
-                std::vector<uint8_t> binary_file = loadBinaryFile("ze_global_bw.spv");
-                module_description.stype = ZE_STRUCTURE_TYPE_MODULE_DESC;
-                module_description.pNext = nullptr;
-                module_description.format = ZE_MODULE_FORMAT_IL_SPIRV;
-                module_description.inputSize = static_cast<uint32_t>(binary_file.size());
-                module_description.pInputModule = binary_file.data();
-                module_description.pBuildFlags = nullptr;
-                XPUM_ZE_HANDLE_LOCK(device_handles[i], ret = zeModuleCreate(context, device_handles[i], &module_description, &module_handle, nullptr));
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeModuleCreate()[" + zeResultErrorCodeStr(ret) + "]");
-                }
+                DiagnosticRuntimeLease runtime(ze_driver, device_handles[i]);
+                ze_context_handle_t context = runtime->getContext();
+                ze_module_handle_t module_handle = runtime->getModule("ze_global_bw.spv", loadBinaryFile);
                 uint64_t max_items = device_properties.maxMemAllocSize / sizeof(float) / 2;
                 uint64_t num_items = std::min(max_items, (uint64_t)(1 << 29));
                 uint64_t base = (uint64_t)device_compute_properties.maxGroupSizeX * 16 * 16;
@@ -2828,23 +2730,12 @@ void DiagnosticManager::doDeviceDiagnosticPeformanceMemoryBandwidth(const ze_dev
                 command_list_description.flags = ZE_COMMAND_LIST_FLAG_EXPLICIT_ONLY;
                 command_list_description.commandQueueGroupOrdinal = 0;
 
-                ze_command_queue_handle_t command_queue;
-                ze_command_queue_desc_t command_queue_description{};
-                command_queue_description.stype = ZE_STRUCTURE_TYPE_COMMAND_QUEUE_DESC;
-                command_queue_description.pNext = nullptr;
-                command_queue_description.mode = ZE_COMMAND_QUEUE_MODE_ASYNCHRONOUS;
-                command_queue_description.flags = ZE_COMMAND_QUEUE_FLAG_EXPLICIT_ONLY;
-                command_queue_description.ordinal = 0;
-                command_queue_description.index = 0;
+                ze_command_queue_handle_t command_queue = runtime->getCommandQueue();
 
                 XPUM_ZE_HANDLE_LOCK(device_handles[i], ret = zeCommandListCreate(context, device_handles[i], &command_list_description, &command_list));
                 if (ret != ZE_RESULT_SUCCESS) {
                     throw BaseException("zeCommandListCreate()[" + zeResultErrorCodeStr(ret) + "]");
                 }
-                XPUM_ZE_HANDLE_LOCK(device_handles[i], ret = zeCommandQueueCreate(context, device_handles[i], &command_queue_description, &command_queue));
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeCommandQueueCreate()[" + zeResultErrorCodeStr(ret) + "]");
-                }
                 ret = zeCommandListAppendMemoryCopy(command_list, inputBuf, arr.data(), (arr.size() * sizeof(float)), nullptr, 0, nullptr);
                 ret = zeCommandListAppendBarrier(command_list, nullptr, 0, nullptr);
                 if (ret != ZE_RESULT_SUCCESS) {
@@ -2874,16 +2765,17 @@ void DiagnosticManager::doDeviceDiagnosticPeformanceMemoryBandwidth(const ze_dev
                 ze_kernel_handle_t global_offset_v8;
                 ze_kernel_handle_t global_offset_v16;
 
-                setupFunction(module_handle, local_offset_v1, "global_bandwidth_v1_local_offset", inputBuf, outputBuf);
-                setupFunction(module_handle, global_offset_v1, "global_bandwidth_v1_global_offset", inputBuf, outputBuf);
-                setupFunction(module_handle, local_offset_v2, "global_bandwidth_v2_local_offset", inputBuf, outputBuf);
-                setupFunction(module_handle, global_offset_v2, "global_bandwidth_v2_global_offset", inputBuf, outputBuf);
-                setupFunction(module_handle, local_offset_v4, "global_bandwidth_v4_local_offset", inputBuf, outputBuf);
-                setupFunction(module_handle, global_offset_v4, "global_bandwidth_v4_global_offset", inputBuf, outputBuf);
-                setupFunction(module_handle, local_offset_v8, "global_bandwidth_v8_local_offset", inputBuf, outputBuf);
-                setupFunction(module_handle, global_offset_v8, "global_bandwidth_v8_global_offset", inputBuf, outputBuf);
-                setupFunction(module_handle, local_offset_v16, "global_bandwidth_v16_local_offset", inputBuf, outputBuf);
-                setupFunction(module_handle, global_offset_v16, "global_bandwidth_v16_global_offset", inputBuf, outputBuf);
+                setupFunction(runtime, module_handle, local_offset_v1, "global_bandwidth_v1_local_offset", inputBuf, outputBuf);
+                setupFunction(runtime, module_handle, global_offset_v1, "global_bandwidth_v1_global_offset", inputBuf, outputBuf);
+                setupFunction(runtime, module_handle, local_offset_v2, "global_bandwidth_v2_local_offset", inputBuf, outputBuf);
+                setupFunction(runtime, module_handle, global_offset_v2, "global_bandwidth_v2_global_offset", inputBuf, outputBuf);
+                setupFunction(runtime, module_handle, local_offset_v4, "global_bandwidth_v4_local_offset", inputBuf, outputBuf);
+                setupFunction(runtime, module_handle, global_offset_v4, "global_bandwidth_v4_global_offset", inputBuf, outputBuf);
+                setupFunction(runtime, module_handle, local_offset_v8, "global_bandwidth_v8_local_offset", inputBuf, outputBuf);
+                setupFunction(runtime, module_handle, global_offset_v8, "global_bandwidth_v8_global_offset", inputBuf, outputBuf);
+                setupFunction(runtime, module_handle, local_offset_v16, "global_bandwidth_v16_local_offset", inputBuf, outputBuf);
+                setupFunction(runtime, module_handle, global_offset_v16, "global_bandwidth_v16_global_offset", inputBuf, outputBuf);
+                phase_times[i].setup = timer.lap();
 
                 timed = 0;
                 timed_lo = 0;
@@ -2940,54 +2832,11 @@ void DiagnosticManager::doDeviceDiagnosticPeformanceMemoryBandwidth(const ze_dev
                 gbps = calculateGbps(timed, num_items * sizeof(float));
                 all_gbps[i] = std::max(all_gbps[i], gbps);
 
-                ret = zeKernelDestroy(local_offset_v1);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeKernelDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-                }
-                ret = zeKernelDestroy(global_offset_v1);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeKernelDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-                }
-                ret = zeKernelDestroy(local_offset_v2);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeKernelDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-                }
-                ret = zeKernelDestroy(global_offset_v2);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeKernelDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-                }
-                ret = zeKernelDestroy(local_offset_v4);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeKernelDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-                }
-                ret = zeKernelDestroy(global_offset_v4);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeKernelDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-                }
-                ret = zeKernelDestroy(local_offset_v8);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeKernelDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-                }
-                ret = zeKernelDestroy(global_offset_v8);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeKernelDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-                }
-                ret = zeKernelDestroy(local_offset_v16);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeKernelDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-                }
-                ret = zeKernelDestroy(global_offset_v16);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeKernelDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-                }
+                phase_times[i].run = timer.lap();
                 ret = zeCommandListDestroy(command_list);
                 if (ret != ZE_RESULT_SUCCESS) {
                     throw BaseException("zeCommandListDestroy()");
                 }
-                ret = zeCommandQueueDestroy(command_queue);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeCommandQueueDestroy()");
-                }
                 ret = zeMemFree(context, inputBuf);
                 if (ret != ZE_RESULT_SUCCESS) {
                     throw BaseException("zeMemFree()[" + zeResultErrorCodeStr(ret) + "]");
@@ -2996,14 +2845,8 @@ void DiagnosticManager::doDeviceDiagnosticPeformanceMemoryBandwidth(const ze_dev
                 if (ret != ZE_RESULT_SUCCESS) {
                     throw BaseException("zeMemFree()[" + zeResultErrorCodeStr(ret) + "]");
                 }
-                ret = zeModuleDestroy(module_handle);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeModuleDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-                }
-                ret = zeContextDestroy(context);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeContextDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-                }
+                phase_times[i].cleanup = timer.lap();
+                runtime.commit();
             } catch (BaseException &e) {
                 XPUM_LOG_DEBUG("Error in memory bandwidth diagnostic");
                 all_gbps[i] = -1;
@@ -3017,6 +2860,8 @@ void DiagnosticManager::doDeviceDiagnosticPeformanceMemoryBandwidth(const ze_dev
     for (std::size_t i = 0; i < memorybandwidth_threads.size(); i++) {
         memorybandwidth_threads[i].join();
     }
+    updatePhaseTimes(memorybandwidth_component, phase_times);
+
     long double all_gbps_value = 0;
     for (std::size_t i = 0; i < all_gbps.size(); i++) {
         if (all_gbps[i] < 0) {
@@ -3064,7 +2909,11 @@ xpum_result_t DiagnosticManager::getDiagnosticsXeLinkThroughputResult(xpum_devic
     std::unique_lock<std::mutex> lock(this->mutex);
     std::vector<int32_t> related_device_ids;
     related_device_ids.push_back(deviceId);
-    related_device_ids.insert(related_device_ids.end(), device_id_link_to_device_ids[deviceId].begin(), device_id_link_to_device_ids[deviceId].end());
+    {
+        std::unique_lock<std::mutex> topology_lock(xe_link_topology_mutex);
+        related_device_ids.insert(related_device_ids.end(), device_id_link_to_device_ids[deviceId].begin(), device_id_link_to_device_ids[deviceId].end());
+    }
+    std::unique_lock<std::mutex> datas_lock(xe_link_datas_mutex);
     
     bool find = false;
     for (auto id : related_device_ids) {
@@ -3202,85 +3051,166 @@ void DiagnosticManager::getXeLinkPortTransmitCounters(const ze_device_handle_t&
     }
 }
 
-void DiagnosticManager::copyMemoryDataAndCalculateXeLinkThroughput(const ze_driver_handle_t &ze_driver, std::vector<std::tuple<ze_device_handle_t, int32_t, ze_device_handle_t, int32_t>> test_pairs,
+void DiagnosticManager::copyMemoryDataAndCalculateXeLinkThroughput(const ze_driver_handle_t &ze_driver, const std::vector<XeLinkTestPair> &test_pairs,
                                              std::map<xpum_device_id_t, std::vector<xpum_diag_xe_link_throughput_t>>& xe_link_throughput_datas) {
-    for (auto test_pair : test_pairs) {
-        size_t mem_size = 268435456; /* 256 MiB. Consistent with ze_peer.*/
-
-        ze_context_desc_t context_desc = {};
-        context_desc.stype = ZE_STRUCTURE_TYPE_CONTEXT_DESC;
-        ze_context_handle_t context;
-        ze_result_t ret;
-        XPUM_ZE_HANDLE_LOCK(ze_driver, ret = zeContextCreate(ze_driver, &context_desc, &context));
-        if (ret != ZE_RESULT_SUCCESS) {
-            throw BaseException("zeContextCreate()[" + zeResultErrorCodeStr(ret) + "]");
+    {
+        // drop the failures of an earlier test of these links
+        std::unique_lock<std::mutex> lock(xe_link_datas_mutex);
+        for (auto &test_pair : test_pairs) {
+            xe_link_throughput_datas.erase(std::get<1>(test_pair));
+        }
+    }
+    // The transmit counters of the source ports are read before and after the
+    // copies, so two pairs may only run at the same time if they share no
+    // device. Pairs are packed greedily into rounds of device disjoint pairs.
+    std::vector<bool> scheduled(test_pairs.size(), false);
+    std::size_t scheduled_count = 0;
+    while (scheduled_count < test_pairs.size()) {
+        std::set<int32_t> busy_devices;
+        std::vector<std::size_t> round;
+        for (std::size_t i = 0; i < test_pairs.size(); i++) {
+            if (scheduled[i]) {
+                continue;
+            }
+            int32_t src_device_id = std::get<1>(test_pairs[i]);
+            int32_t dst_device_id = std::get<3>(test_pairs[i]);
+            if (busy_devices.count(src_device_id) > 0 || busy_devices.count(dst_device_id) > 0) {
+                continue;
+            }
+            busy_devices.insert(src_device_id);
+            busy_devices.insert(dst_device_id);
+            scheduled[i] = true;
+            scheduled_count++;
+            round.push_back(i);
+        }
+
+        std::vector<std::thread> pair_threads;
+        std::vector<std::string> error_messages(round.size());
+        for (std::size_t i = 0; i < round.size(); i++) {
+            auto &test_pair = test_pairs[round[i]];
+            pair_threads.push_back(std::thread([&ze_driver, &test_pair, &xe_link_throughput_datas, &error_messages, i]() {
+                try {
+                    copyMemoryDataAndCalculateXeLinkThroughput(ze_driver, test_pair, xe_link_throughput_datas, xe_link_datas_mutex);
+                } catch (BaseException &e) {
+                    error_messages[i] = e.what();
+                }
+            }));
+        }
+        for (auto &t : pair_threads) {
+            t.join();
+        }
+        for (auto &error_message : error_messages) {
+            if (!error_message.empty()) {
+                throw BaseException(error_message);
+            }
         }
+    }
+}
 
-        DeviceInstance src_device_instance, dst_device_instance;
-        src_device_instance.device = std::get<0>(test_pair);
-        src_device_instance.driver = ze_driver;
-        dst_device_instance.device = std::get<2>(test_pair);
-        dst_device_instance.driver = ze_driver;
+void DiagnosticManager::copyMemoryDataAndCalculateXeLinkThroughput(const ze_driver_handle_t &ze_driver, const XeLinkTestPair &test_pair,
+                                             std::map<xpum_device_id_t, std::vector<xpum_diag_xe_link_throughput_t>>& xe_link_throughput_datas,
+                                             std::mutex &datas_mutex) {
+    size_t mem_size = 268435456; /* 256 MiB. Consistent with ze_peer.*/
 
-        ze_device_mem_alloc_desc_t device_mem_alloc_desc = {};
-        device_mem_alloc_desc.stype = ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC;
-        device_mem_alloc_desc.ordinal = 0;
-        device_mem_alloc_desc.flags = 0;
+    ze_context_desc_t context_desc = {};
+    context_desc.stype = ZE_STRUCTURE_TYPE_CONTEXT_DESC;
+    ze_context_handle_t context;
+    ze_result_t ret;
+    XPUM_ZE_HANDLE_LOCK(ze_driver, ret = zeContextCreate(ze_driver, &context_desc, &context));
+    if (ret != ZE_RESULT_SUCCESS) {
+        throw BaseException("zeContextCreate()[" + zeResultErrorCodeStr(ret) + "]");
+    }
 
-        src_device_instance.src_region = nullptr;
-        XPUM_ZE_HANDLE_LOCK(src_device_instance.device, ret = zeMemAllocDevice(context, &device_mem_alloc_desc, mem_size, 1, src_device_instance.device, &src_device_instance.src_region));
-        if (ret != ZE_RESULT_SUCCESS) {
-            throw BaseException("zeMemAllocDevice()[" + zeResultErrorCodeStr(ret) + "]");  
-        }
-        dst_device_instance.dst_region = nullptr;
-        XPUM_ZE_HANDLE_LOCK(dst_device_instance.device, ret = zeMemAllocDevice(context, &device_mem_alloc_desc, mem_size, 1, dst_device_instance.device, &dst_device_instance.dst_region));
-        if (ret != ZE_RESULT_SUCCESS) {
-            throw BaseException("zeMemAllocDevice()[" + zeResultErrorCodeStr(ret) + "]");  
-        }
-        ze_command_list_desc_t command_list_description = {};
-        command_list_description.stype = ZE_STRUCTURE_TYPE_COMMAND_LIST_DESC;
-        src_device_instance.cmd_list = nullptr;
-        XPUM_ZE_HANDLE_LOCK(src_device_instance.device, ret = zeCommandListCreate(context, src_device_instance.device, &command_list_description, &src_device_instance.cmd_list));
-        if (ret != ZE_RESULT_SUCCESS) {
-            throw BaseException("zeCommandListCreate()[" + zeResultErrorCodeStr(ret) + "]");  
-        }
+    DeviceInstance src_device_instance, dst_device_instance;
+    src_device_instance.device = std::get<0>(test_pair);
+    src_device_instance.driver = ze_driver;
+    dst_device_instance.device = std::get<2>(test_pair);
+    dst_device_instance.driver = ze_driver;
 
-        ze_command_queue_desc_t command_queue_description = {};
-        command_queue_description.stype = ZE_STRUCTURE_TYPE_COMMAND_QUEUE_DESC;
-        command_queue_description.ordinal = 0;
-        command_queue_description.mode = ZE_COMMAND_QUEUE_MODE_DEFAULT;
-        command_queue_description.flags = 0;
-        command_queue_description.priority = ZE_COMMAND_QUEUE_PRIORITY_NORMAL;
-        src_device_instance.cmd_queue = nullptr;
-        XPUM_ZE_HANDLE_LOCK(src_device_instance.device, ret = zeCommandQueueCreate(context, src_device_instance.device, &command_queue_description, &src_device_instance.cmd_queue));
-        if (ret != ZE_RESULT_SUCCESS) {
-            throw BaseException("zeCommandQueueCreate()[" + zeResultErrorCodeStr(ret) + "]");  
-        }
+    ze_device_mem_alloc_desc_t device_mem_alloc_desc = {};
+    device_mem_alloc_desc.stype = ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC;
+    device_mem_alloc_desc.ordinal = 0;
+    device_mem_alloc_desc.flags = 0;
 
-        // cory core
-        ze_host_mem_alloc_desc_t host_desc = {};
-        host_desc.stype = ZE_STRUCTURE_TYPE_HOST_MEM_ALLOC_DESC;
-        host_desc.flags = 0;
-        host_desc.pNext = nullptr;
-        void *memory = nullptr;
-        XPUM_ZE_HANDLE_LOCK(context, ret = zeMemAllocHost(context, &host_desc, mem_size, 1, &memory));
-        if (ret != ZE_RESULT_SUCCESS) {
-            throw BaseException("zeMemAllocHost()[" + zeResultErrorCodeStr(ret) + "]");  
-        }
-        uint8_t *src = static_cast<uint8_t *>(memory);
-        for (uint32_t i = 0; i < mem_size; i++) {
-            src[i] = i & 0xff;
-        }
+    src_device_instance.src_region = nullptr;
+    XPUM_ZE_HANDLE_LOCK(src_device_instance.device, ret = zeMemAllocDevice(context, &device_mem_alloc_desc, mem_size, 1, src_device_instance.device, &src_device_instance.src_region));
+    if (ret != ZE_RESULT_SUCCESS) {
+        throw BaseException("zeMemAllocDevice()[" + zeResultErrorCodeStr(ret) + "]");  
+    }
+    dst_device_instance.dst_region = nullptr;
+    XPUM_ZE_HANDLE_LOCK(dst_device_instance.device, ret = zeMemAllocDevice(context, &device_mem_alloc_desc, mem_size, 1, dst_device_instance.device, &dst_device_instance.dst_region));
+    if (ret != ZE_RESULT_SUCCESS) {
+        throw BaseException("zeMemAllocDevice()[" + zeResultErrorCodeStr(ret) + "]");  
+    }
+    ze_command_list_desc_t command_list_description = {};
+    command_list_description.stype = ZE_STRUCTURE_TYPE_COMMAND_LIST_DESC;
+    src_device_instance.cmd_list = nullptr;
+    XPUM_ZE_HANDLE_LOCK(src_device_instance.device, ret = zeCommandListCreate(context, src_device_instance.device, &command_list_description, &src_device_instance.cmd_list));
+    if (ret != ZE_RESULT_SUCCESS) {
+        throw BaseException("zeCommandListCreate()[" + zeResultErrorCodeStr(ret) + "]");  
+    }
 
-        ret = zeCommandListAppendMemoryCopy(src_device_instance.cmd_list, src_device_instance.src_region,
-                                            memory, mem_size, nullptr, 0, nullptr);
-        if (ret != ZE_RESULT_SUCCESS) {
-            throw BaseException("zeCommandListAppendMemoryCopy()[" + zeResultErrorCodeStr(ret) + "]");
-        }
-        ret = zeCommandListClose(src_device_instance.cmd_list);
-        if (ret != ZE_RESULT_SUCCESS) {
-            throw BaseException("zeCommandListClose()[" + zeResultErrorCodeStr(ret) + "]");
-        }
+    ze_command_queue_desc_t command_queue_description = {};
+    command_queue_description.stype = ZE_STRUCTURE_TYPE_COMMAND_QUEUE_DESC;
+    command_queue_description.ordinal = 0;
+    command_queue_description.mode = ZE_COMMAND_QUEUE_MODE_DEFAULT;
+    command_queue_description.flags = 0;
+    command_queue_description.priority = ZE_COMMAND_QUEUE_PRIORITY_NORMAL;
+    src_device_instance.cmd_queue = nullptr;
+    XPUM_ZE_HANDLE_LOCK(src_device_instance.device, ret = zeCommandQueueCreate(context, src_device_instance.device, &command_queue_description, &src_device_instance.cmd_queue));
+    if (ret != ZE_RESULT_SUCCESS) {
+        throw BaseException("zeCommandQueueCreate()[" + zeResultErrorCodeStr(ret) + "]");  
+    }
+
+    // cory core
+    ze_host_mem_alloc_desc_t host_desc = {};
+    host_desc.stype = ZE_STRUCTURE_TYPE_HOST_MEM_ALLOC_DESC;
+    host_desc.flags = 0;
+    host_desc.pNext = nullptr;
+    void *memory = nullptr;
+    XPUM_ZE_HANDLE_LOCK(context, ret = zeMemAllocHost(context, &host_desc, mem_size, 1, &memory));
+    if (ret != ZE_RESULT_SUCCESS) {
+        throw BaseException("zeMemAllocHost()[" + zeResultErrorCodeStr(ret) + "]");  
+    }
+    uint8_t *src = static_cast<uint8_t *>(memory);
+    for (uint32_t i = 0; i < mem_size; i++) {
+        src[i] = i & 0xff;
+    }
+
+    ret = zeCommandListAppendMemoryCopy(src_device_instance.cmd_list, src_device_instance.src_region,
+                                        memory, mem_size, nullptr, 0, nullptr);
+    if (ret != ZE_RESULT_SUCCESS) {
+        throw BaseException("zeCommandListAppendMemoryCopy()[" + zeResultErrorCodeStr(ret) + "]");
+    }
+    ret = zeCommandListClose(src_device_instance.cmd_list);
+    if (ret != ZE_RESULT_SUCCESS) {
+        throw BaseException("zeCommandListClose()[" + zeResultErrorCodeStr(ret) + "]");
+    }
+    ret = zeCommandQueueExecuteCommandLists(src_device_instance.cmd_queue, 1, &src_device_instance.cmd_list, nullptr);
+    if (ret != ZE_RESULT_SUCCESS) {
+        throw BaseException("zeCommandQueueExecuteCommandLists()[" + zeResultErrorCodeStr(ret) + "]");
+    }
+    ret = zeCommandQueueSynchronize(src_device_instance.cmd_queue, UINT64_MAX);
+    if (ret != ZE_RESULT_SUCCESS) {
+        throw BaseException("zeCommandQueueSynchronize()[" + zeResultErrorCodeStr(ret) + "]");
+    } 
+    ret = zeCommandListReset(src_device_instance.cmd_list);
+    if (ret != ZE_RESULT_SUCCESS) {
+        throw BaseException("zeCommandListReset()[" + zeResultErrorCodeStr(ret) + "]");
+    }
+    ret = zeCommandListAppendMemoryCopy(src_device_instance.cmd_list, 
+                                            static_cast<void *>(static_cast<uint8_t *>(dst_device_instance.dst_region)),
+                                            static_cast<void *>(static_cast<uint8_t *>(src_device_instance.src_region)),
+                                            mem_size, nullptr, 0, nullptr);
+    if (ret != ZE_RESULT_SUCCESS) {
+        throw BaseException("zeCommandListAppendMemoryCopy()[" + zeResultErrorCodeStr(ret) + "]");
+    }
+    ret = zeCommandListClose(src_device_instance.cmd_list);
+    if (ret != ZE_RESULT_SUCCESS) {
+        throw BaseException("zeCommandListClose()[" + zeResultErrorCodeStr(ret) + "]");
+    }
+    // warm up
+    for (int i = 1; i <= 10; i++) {
         ret = zeCommandQueueExecuteCommandLists(src_device_instance.cmd_queue, 1, &src_device_instance.cmd_list, nullptr);
         if (ret != ZE_RESULT_SUCCESS) {
             throw BaseException("zeCommandQueueExecuteCommandLists()[" + zeResultErrorCodeStr(ret) + "]");
@@ -3288,129 +3218,104 @@ void DiagnosticManager::copyMemoryDataAndCalculateXeLinkThroughput(const ze_driv
         ret = zeCommandQueueSynchronize(src_device_instance.cmd_queue, UINT64_MAX);
         if (ret != ZE_RESULT_SUCCESS) {
             throw BaseException("zeCommandQueueSynchronize()[" + zeResultErrorCodeStr(ret) + "]");
-        } 
-        ret = zeCommandListReset(src_device_instance.cmd_list);
-        if (ret != ZE_RESULT_SUCCESS) {
-            throw BaseException("zeCommandListReset()[" + zeResultErrorCodeStr(ret) + "]");
-        }
-        ret = zeCommandListAppendMemoryCopy(src_device_instance.cmd_list, 
-                                                static_cast<void *>(static_cast<uint8_t *>(dst_device_instance.dst_region)),
-                                                static_cast<void *>(static_cast<uint8_t *>(src_device_instance.src_region)),
-                                                mem_size, nullptr, 0, nullptr);
+        }       
+    }
+    // key: src_device_id, src_tile_id, src_port_id, dst_device_id, dst_tile_id, dst_port_id
+    std::map<std::vector<int32_t>, uint64_t> tx_counters1;
+    double max_speed = -1;
+    getXeLinkPortTransmitCounters(std::get<0>(test_pair), std::get<1>(test_pair), tx_counters1, max_speed);
+    auto start_time = std::chrono::high_resolution_clock::now();
+    // Using a large loops for xpum dump to observe xe link throughput
+    for (int i = 1; i <= 1000; i++) {
+        ret = zeCommandQueueExecuteCommandLists(src_device_instance.cmd_queue, 1, &src_device_instance.cmd_list, nullptr);
         if (ret != ZE_RESULT_SUCCESS) {
-            throw BaseException("zeCommandListAppendMemoryCopy()[" + zeResultErrorCodeStr(ret) + "]");
+            throw BaseException("zeCommandQueueExecuteCommandLists()[" + zeResultErrorCodeStr(ret) + "]");
         }
-        ret = zeCommandListClose(src_device_instance.cmd_list);
+        ret = zeCommandQueueSynchronize(src_device_instance.cmd_queue, UINT64_MAX);
         if (ret != ZE_RESULT_SUCCESS) {
-            throw BaseException("zeCommandListClose()[" + zeResultErrorCodeStr(ret) + "]");
-        }
-        // warm up
-        for (int i = 1; i <= 10; i++) {
-            ret = zeCommandQueueExecuteCommandLists(src_device_instance.cmd_queue, 1, &src_device_instance.cmd_list, nullptr);
-            if (ret != ZE_RESULT_SUCCESS) {
-                throw BaseException("zeCommandQueueExecuteCommandLists()[" + zeResultErrorCodeStr(ret) + "]");
-            }
-            ret = zeCommandQueueSynchronize(src_device_instance.cmd_queue, UINT64_MAX);
-            if (ret != ZE_RESULT_SUCCESS) {
-                throw BaseException("zeCommandQueueSynchronize()[" + zeResultErrorCodeStr(ret) + "]");
-            }       
-        }
-        // key: src_device_id, src_tile_id, src_port_id, dst_device_id, dst_tile_id, dst_port_id
-        std::map<std::vector<int32_t>, uint64_t> tx_counters1;
-        double max_speed = -1;
-        getXeLinkPortTransmitCounters(std::get<0>(test_pair), std::get<1>(test_pair), tx_counters1, max_speed);
-        auto start_time = std::chrono::high_resolution_clock::now();
-        // Using a large loops for xpum dump to observe xe link throughput
-        for (int i = 1; i <= 1000; i++) {
-            ret = zeCommandQueueExecuteCommandLists(src_device_instance.cmd_queue, 1, &src_device_instance.cmd_list, nullptr);
-            if (ret != ZE_RESULT_SUCCESS) {
-                throw BaseException("zeCommandQueueExecuteCommandLists()[" + zeResultErrorCodeStr(ret) + "]");
-            }
-            ret = zeCommandQueueSynchronize(src_device_instance.cmd_queue, UINT64_MAX);
-            if (ret != ZE_RESULT_SUCCESS) {
-                throw BaseException("zeCommandQueueSynchronize()[" + zeResultErrorCodeStr(ret) + "]");
-            }
+            throw BaseException("zeCommandQueueSynchronize()[" + zeResultErrorCodeStr(ret) + "]");
         }
-        auto end_time = std::chrono::high_resolution_clock::now();
-        std::map<std::vector<int32_t>, uint64_t> tx_counters2;
-        getXeLinkPortTransmitCounters(std::get<0>(test_pair), std::get<1>(test_pair), tx_counters2, max_speed);
+    }
+    auto end_time = std::chrono::high_resolution_clock::now();
+    std::map<std::vector<int32_t>, uint64_t> tx_counters2;
+    getXeLinkPortTransmitCounters(std::get<0>(test_pair), std::get<1>(test_pair), tx_counters2, max_speed);
 
-        ret = zeCommandListReset(src_device_instance.cmd_list);
-        if (ret != ZE_RESULT_SUCCESS) {
-            throw BaseException("zeCommandListReset()[" + zeResultErrorCodeStr(ret) + "]");
-        }
-        ret = zeCommandListClose(src_device_instance.cmd_list);
-        if (ret != ZE_RESULT_SUCCESS) {
-            throw BaseException("zeCommandListClose()[" + zeResultErrorCodeStr(ret) + "]");
-        }
-        ret = zeCommandQueueDestroy(src_device_instance.cmd_queue);
-        if (ret != ZE_RESULT_SUCCESS) {
-            throw BaseException("zeCommandQueueDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-        }
-        ret = zeCommandListDestroy(src_device_instance.cmd_list);
-        if (ret != ZE_RESULT_SUCCESS) {
-            throw BaseException("zeCommandListDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-        }
-        ret = zeMemFree(context, src_device_instance.src_region);
-        if (ret != ZE_RESULT_SUCCESS) {
-            throw BaseException("zeMemFree()[" + zeResultErrorCodeStr(ret) + "]");
-        }
-        ret = zeMemFree(context, dst_device_instance.dst_region);
-        if (ret != ZE_RESULT_SUCCESS) {
-            throw BaseException("zeMemFree()[" + zeResultErrorCodeStr(ret) + "]");
-        }
-        ret = zeMemFree(context, memory);
-        if (ret != ZE_RESULT_SUCCESS) {
-            throw BaseException("zeMemFree()[" + zeResultErrorCodeStr(ret) + "]");
-        }
-        ret = zeContextDestroy(context);
-        if (ret != ZE_RESULT_SUCCESS) {
-            throw BaseException("zeContextDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-        }
+    ret = zeCommandListReset(src_device_instance.cmd_list);
+    if (ret != ZE_RESULT_SUCCESS) {
+        throw BaseException("zeCommandListReset()[" + zeResultErrorCodeStr(ret) + "]");
+    }
+    ret = zeCommandListClose(src_device_instance.cmd_list);
+    if (ret != ZE_RESULT_SUCCESS) {
+        throw BaseException("zeCommandListClose()[" + zeResultErrorCodeStr(ret) + "]");
+    }
+    ret = zeCommandQueueDestroy(src_device_instance.cmd_queue);
+    if (ret != ZE_RESULT_SUCCESS) {
+        throw BaseException("zeCommandQueueDestroy()[" + zeResultErrorCodeStr(ret) + "]");
+    }
+    ret = zeCommandListDestroy(src_device_instance.cmd_list);
+    if (ret != ZE_RESULT_SUCCESS) {
+        throw BaseException("zeCommandListDestroy()[" + zeResultErrorCodeStr(ret) + "]");
+    }
+    ret = zeMemFree(context, src_device_instance.src_region);
+    if (ret != ZE_RESULT_SUCCESS) {
+        throw BaseException("zeMemFree()[" + zeResultErrorCodeStr(ret) + "]");
+    }
+    ret = zeMemFree(context, dst_device_instance.dst_region);
+    if (ret != ZE_RESULT_SUCCESS) {
+        throw BaseException("zeMemFree()[" + zeResultErrorCodeStr(ret) + "]");
+    }
+    ret = zeMemFree(context, memory);
+    if (ret != ZE_RESULT_SUCCESS) {
+        throw BaseException("zeMemFree()[" + zeResultErrorCodeStr(ret) + "]");
+    }
+    ret = zeContextDestroy(context);
+    if (ret != ZE_RESULT_SUCCESS) {
+        throw BaseException("zeContextDestroy()[" + zeResultErrorCodeStr(ret) + "]");
+    }
 
-        if (tx_counters1.empty() || tx_counters2.empty())
-            continue;
-        auto total_time_nsec = std::chrono::duration<long double, std::chrono::nanoseconds::period>(end_time - start_time).count();
-
-        for (auto tx_data : tx_counters2) {
-            auto it = tx_counters1.find(tx_data.first);
-            if (it != tx_counters1.end()) {
-                xpum_diag_xe_link_throughput_t xe_link_data_tx = {
-                    std::get<1>(test_pair),
-                    tx_data.first[0], tx_data.first[1], tx_data.first[2],
-                    tx_data.first[3], tx_data.first[4], tx_data.first[5],
-                    round((tx_data.second - it->second) * 1000.0 / total_time_nsec) / 1000,
-                    max_speed,
-                    round(max_speed * DiagnosticManager::XE_LINK_THROUGHPUT_USAGE_PERCENTAGE * 1000.0) / 1000
-                };
-                std::string peer_ports = std::to_string(tx_data.first[0]) + "-"
-                    + std::to_string(tx_data.first[1]) + "-"
-                    + std::to_string(tx_data.first[2]) + " >> "
-                    + std::to_string(tx_data.first[3]) + "-"
-                    + std::to_string(tx_data.first[4]) + "-"
-                    + std::to_string(tx_data.first[5]);
-                if (xe_link_data_tx.dstDeviceId == std::get<3>(test_pair)) {
-                    if (xe_link_data_tx.currentSpeed < xe_link_data_tx.threshold) {
-                        xe_link_throughput_datas[std::get<1>(test_pair)].push_back(xe_link_data_tx);
-                        XPUM_LOG_DEBUG("failed test - fabric port {}, max_speed: {} GBPS, current_speed: {} GBPS, threshold: {} GBPS", peer_ports
-                        , xe_link_data_tx.maxSpeed, xe_link_data_tx.currentSpeed, xe_link_data_tx.threshold);
-                    } else {
-                        XPUM_LOG_DEBUG("passed test - fabric port {}, max_speed: {} GBPS, current_speed: {} GBPS, threshold: {} GBPS", peer_ports
-                        , xe_link_data_tx.maxSpeed, xe_link_data_tx.currentSpeed, xe_link_data_tx.threshold);                    
-                    }
+    if (tx_counters1.empty() || tx_counters2.empty())
+        return;
+    auto total_time_nsec = std::chrono::duration<long double, std::chrono::nanoseconds::period>(end_time - start_time).count();
+
+    for (auto tx_data : tx_counters2) {
+        auto it = tx_counters1.find(tx_data.first);
+        if (it != tx_counters1.end()) {
+            xpum_diag_xe_link_throughput_t xe_link_data_tx = {
+                std::get<1>(test_pair),
+                tx_data.first[0], tx_data.first[1], tx_data.first[2],
+                tx_data.first[3], tx_data.first[4], tx_data.first[5],
+                round((tx_data.second - it->second) * 1000.0 / total_time_nsec) / 1000,
+                max_speed,
+                round(max_speed * DiagnosticManager::XE_LINK_THROUGHPUT_USAGE_PERCENTAGE * 1000.0) / 1000
+            };
+            std::string peer_ports = std::to_string(tx_data.first[0]) + "-"
+                + std::to_string(tx_data.first[1]) + "-"
+                + std::to_string(tx_data.first[2]) + " >> "
+                + std::to_string(tx_data.first[3]) + "-"
+                + std::to_string(tx_data.first[4]) + "-"
+                + std::to_string(tx_data.first[5]);
+            if (xe_link_data_tx.dstDeviceId == std::get<3>(test_pair)) {
+                if (xe_link_data_tx.currentSpeed < xe_link_data_tx.threshold) {
+                    std::unique_lock<std::mutex> lock(datas_mutex);
+                    xe_link_throughput_datas[std::get<1>(test_pair)].push_back(xe_link_data_tx);
+                    XPUM_LOG_DEBUG("failed test - fabric port {}, max_speed: {} GBPS, current_speed: {} GBPS, threshold: {} GBPS", peer_ports
+                    , xe_link_data_tx.maxSpeed, xe_link_data_tx.currentSpeed, xe_link_data_tx.threshold);
+                } else {
+                    XPUM_LOG_DEBUG("passed test - fabric port {}, max_speed: {} GBPS, current_speed: {} GBPS, threshold: {} GBPS", peer_ports
+                    , xe_link_data_tx.maxSpeed, xe_link_data_tx.currentSpeed, xe_link_data_tx.threshold);                    
                 }
             }
         }
-    }  
+    }
 }
 
 void DiagnosticManager::doDeviceDiagnosticXeLinkThroughput(const ze_device_handle_t &ze_device,
                                                     const ze_driver_handle_t &ze_driver,
                                                     std::shared_ptr<xpum_diag_task_info_t> p_task_info,
                                                     std::vector<std::shared_ptr<Device>> devices,
-                                                    std::map<xpum_device_id_t, std::vector<xpum_diag_xe_link_throughput_t>>& xe_link_throughput_datas) {
+                                                    std::map<xpum_device_id_t, std::vector<xpum_diag_xe_link_throughput_t>>& xe_link_throughput_datas,
+                                                    std::shared_ptr<XeLinkThroughputBatch> xe_link_batch) {
     xpum_diag_component_info_t &xe_link_throughput_component = p_task_info->componentList[xpum_diag_task_type_t::XPUM_DIAG_XE_LINK_THROUGHPUT];
-    p_task_info->count += 1;
     int device_id = p_task_info->deviceId;
     ze_result_t ret;
     uint32_t fabric_port_count = 0;
@@ -3450,9 +3355,8 @@ void DiagnosticManager::doDeviceDiagnosticXeLinkThroughput(const ze_device_handl
         updateMessage(xe_link_throughput_component.message, failed_port_status_message);
         return;
     }
-    xe_link_throughput_datas.clear();
-    // src_device_handle, src_device_id, dst_device_hanle, dst_device_id
-    std::vector<std::tuple<ze_device_handle_t, int32_t, ze_device_handle_t, int32_t>> test_pairs;
+    std::vector<XeLinkTestPair> test_pairs;
+    std::unique_lock<std::mutex> topology_lock(xe_link_topology_mutex);
     for (auto device : devices) {
         ze_device_handle_t peer_ze_device = device->getDeviceZeHandle();
         zes_device_handle_t peer_zes_device = device->getDeviceHandle();
@@ -3525,6 +3429,7 @@ void DiagnosticManager::doDeviceDiagnosticXeLinkThroughput(const ze_device_handl
     for (auto fd : fabric_id_convert_to_device_id) {
         XPUM_LOG_DEBUG("GPU {} fabric id: {}", fd.second, fd.first);
     }
+    topology_lock.unlock();
     if (test_pairs.empty()) {
         xe_link_throughput_component.result = XPUM_DIAG_RESULT_FAIL;
         xe_link_throughput_component.finished = true;
@@ -3534,8 +3439,12 @@ void DiagnosticManager::doDeviceDiagnosticXeLinkThroughput(const ze_device_handl
     updateMessage(xe_link_throughput_component.message, std::string("Running"));
     xe_link_throughput_component.result = xpum_diag_task_result_t::XPUM_DIAG_RESULT_UNKNOWN;
 
-    copyMemoryDataAndCalculateXeLinkThroughput(ze_driver, test_pairs, xe_link_throughput_datas);
-    
+    // tested together with the pairs of the other devices under test
+    xe_link_batch->join(device_id, test_pairs, [&ze_driver, &xe_link_throughput_datas](const std::vector<XeLinkTestPair> &batch_pairs) {
+        copyMemoryDataAndCalculateXeLinkThroughput(ze_driver, batch_pairs, xe_link_throughput_datas);
+    });
+
+    std::unique_lock<std::mutex> datas_lock(xe_link_datas_mutex);
     bool find_failed_port = false;
     for (auto data : xe_link_throughput_datas) {
         for (auto item : data.second) {
@@ -3605,29 +3514,9 @@ void DiagnosticManager::stressThreadFunc(int stress_time,
                 if (ret != ZE_RESULT_SUCCESS) {
                     throw BaseException("zeDeviceGetComputeProperties()[" + zeResultErrorCodeStr(ret) + "]");
                 }
-                ze_context_handle_t context;
-                ze_context_desc_t context_desc = {
-                        ZE_STRUCTURE_TYPE_CONTEXT_DESC,
-                        nullptr, 
-                        0
-                };
-                XPUM_ZE_HANDLE_LOCK(ze_driver, ret = zeContextCreate(ze_driver, &context_desc, &context));
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeContextCreate()[" + zeResultErrorCodeStr(ret) + "]");
-                }
-                ze_module_handle_t module_handle;
-                ze_module_desc_t module_description = {};
-                std::vector<uint8_t> binary_file = loadBinaryFile("ze_int_compute.spv");
-                module_description.stype = ZE_STRUCTURE_TYPE_MODULE_DESC;
-                module_description.pNext = nullptr;
-                module_description.format = ZE_MODULE_FORMAT_IL_SPIRV;
-                module_description.inputSize = static_cast<uint32_t>(binary_file.size());
-                module_description.pInputModule = binary_file.data();
-                module_description.pBuildFlags = nullptr;
-                XPUM_ZE_HANDLE_LOCK(device_handles[i], ret = zeModuleCreate(context, device_handles[i], &module_description, &module_handle, nullptr));
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeModuleCreate()[" + zeResultErrorCodeStr(ret) + "]");
-                }
+                DiagnosticRuntimeLease runtime(ze_driver, device_handles[i]);
+                ze_context_handle_t context = runtime->getContext();
+                ze_module_handle_t module_handle = runtime->getModule("ze_int_compute.spv", loadBinaryFile);
                 uint64_t max_work_items = (uint64_t)device_properties.numSlices *
                                           device_properties.numSubslicesPerSlice *
                                           device_properties.numEUsPerSubslice *
@@ -3665,23 +3554,12 @@ void DiagnosticManager::stressThreadFunc(int stress_time,
                 command_list_description.flags = ZE_COMMAND_LIST_FLAG_EXPLICIT_ONLY;
                 command_list_description.commandQueueGroupOrdinal = 0;
 
-                ze_command_queue_handle_t command_queue;
-                ze_command_queue_desc_t command_queue_description{};
-                command_queue_description.stype = ZE_STRUCTURE_TYPE_COMMAND_QUEUE_DESC;
-                command_queue_description.pNext = nullptr;
-                command_queue_description.mode = ZE_COMMAND_QUEUE_MODE_ASYNCHRONOUS;
-                command_queue_description.flags = ZE_COMMAND_QUEUE_FLAG_EXPLICIT_ONLY;
-                command_queue_description.ordinal = 0;
-                command_queue_description.index = 0;
+                ze_command_queue_handle_t command_queue = runtime->getCommandQueue();
 
                 XPUM_ZE_HANDLE_LOCK(device_handles[i], ret = zeCommandListCreate(context, device_handles[i], &command_list_description, &command_list));
                 if (ret != ZE_RESULT_SUCCESS) {
                     throw BaseException("zeCommandListCreate()[" + zeResultErrorCodeStr(ret) + "]");
                 }
-                XPUM_ZE_HANDLE_LOCK(device_handles[i], ret = zeCommandQueueCreate(context, device_handles[i], &command_queue_description, &command_queue));
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeCommandQueueCreate()[" + zeResultErrorCodeStr(ret) + "]");
-                }
                 ret = zeCommandListAppendMemoryCopy(command_list, device_input_value, &input_value, sizeof(int), nullptr, 0, nullptr);
                 if (ret != ZE_RESULT_SUCCESS) {
                     throw BaseException("zeCommandListAppendMemoryCopy()[" + zeResultErrorCodeStr(ret) + "]");
@@ -3704,7 +3582,7 @@ void DiagnosticManager::stressThreadFunc(int stress_time,
                     throw BaseException("zeCommandListReset()[" + zeResultErrorCodeStr(ret) + "]");
                 }
                 ze_kernel_handle_t compute_int_v1;
-                setupFunction(module_handle, compute_int_v1, "compute_int_v1", device_input_value, device_output_buffer);
+                setupFunction(runtime, module_handle, compute_int_v1, "compute_int_v1", device_input_value, device_output_buffer);
 
                 //runKernel stuff
                 ret = zeKernelSetGroupSize(compute_int_v1, workgroup_info.group_size_x, workgroup_info.group_size_y, workgroup_info.group_size_z);
@@ -3751,18 +3629,10 @@ void DiagnosticManager::stressThreadFunc(int stress_time,
                 }
                 //end of runKernel
 
-                ret = zeKernelDestroy(compute_int_v1);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeKernelDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-                }
                 ret = zeCommandListDestroy(command_list);
                 if (ret != ZE_RESULT_SUCCESS) {
                     throw BaseException("zeCommandListDestroy()");
                 }
-                ret = zeCommandQueueDestroy(command_queue);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeCommandQueueDestroy()");
-                }
                 ret = zeMemFree(context, device_input_value);
                 if (ret != ZE_RESULT_SUCCESS) {
                     throw BaseException("zeMemFree()[" + zeResultErrorCodeStr(ret) + "]");
@@ -3771,14 +3641,7 @@ void DiagnosticManager::stressThreadFunc(int stress_time,
                 if (ret != ZE_RESULT_SUCCESS) {
                     throw BaseException("zeMemFree()[" + zeResultErrorCodeStr(ret) + "]");
                 }
-                ret = zeModuleDestroy(module_handle);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeModuleDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-                }
-                ret = zeContextDestroy(context);
-                if (ret != ZE_RESULT_SUCCESS) {
-                    throw BaseException("zeContextDestroy()[" + zeResultErrorCodeStr(ret) + "]");
-                }
+                runtime.commit();
             } catch (BaseException &e) {
                 XPUM_LOG_DEBUG("Error in stress test with BaseException");
                 XPUM_LOG_DEBUG(e.what());
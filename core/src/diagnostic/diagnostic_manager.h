@@ -24,6 +24,8 @@
 #include "data_logic/data_logic_interface.h"
 #include "diagnostic_data_type.h"
 #include "diagnostic_manager_interface.h"
+#include "diagnostic_runtime.h"
+#include "diagnostic_scheduler.h"
 
 namespace xpum {
 
@@ -59,7 +61,12 @@ class DiagnosticManager : public DiagnosticManagerInterface {
 
     xpum_result_t runMultipleSpecificDiagnostics(xpum_device_id_t deviceId, xpum_diag_task_type_t types[], int count) override;
 
-    xpum_result_t runDiagnosticsCore(xpum_device_id_t deviceId, xpum_diag_level_t level, xpum_diag_task_type_t types[], int count);
+    xpum_result_t runLevelDiagnosticsByGroup(const std::vector<xpum_device_id_t> &deviceIds, xpum_diag_level_t level) override;
+
+    xpum_result_t runMultipleSpecificDiagnosticsByGroup(const std::vector<xpum_device_id_t> &deviceIds, xpum_diag_task_type_t types[], int count) override;
+
+    xpum_result_t runDiagnosticsCore(xpum_device_id_t deviceId, xpum_diag_level_t level, xpum_diag_task_type_t types[], int count,
+                                     std::shared_ptr<XeLinkThroughputBatch> xe_link_batch);
 
     bool isDiagnosticsRunning(xpum_device_id_t deviceId) override;
 
@@ -75,13 +82,35 @@ class DiagnosticManager : public DiagnosticManagerInterface {
 
     static bool isLevelDiagnosticType(xpum_diag_task_type_t type);
 
+    static void doDeviceDiagnosticComponent(xpum_diag_task_type_t type,
+                                            const ze_device_handle_t &ze_device,
+                                            const ze_driver_handle_t &ze_driver,
+                                            std::shared_ptr<xpum_diag_task_info_t> p_task_info,
+                                            int gpu_total_count,
+                                            std::vector<std::shared_ptr<Device>> &devices,
+                                            std::map<xpum_device_id_t, std::vector<xpum_diag_media_codec_metrics_t>>& media_codec_perf_datas,
+                                            std::map<xpum_device_id_t, std::vector<xpum_diag_xe_link_throughput_t>>& xe_link_throughput_datas,
+                                            std::shared_ptr<XeLinkThroughputBatch> xe_link_batch);
+
+    static bool doDeviceDiagnosticComponents(const std::vector<xpum_diag_task_type_t> &types,
+                                             const ze_device_handle_t &ze_device,
+                                             const ze_driver_handle_t &ze_driver,
+                                             std::shared_ptr<xpum_diag_task_info_t> p_task_info,
+                                             int gpu_total_count,
+                                             std::vector<std::shared_ptr<Device>> &devices,
+                                             std::map<xpum_device_id_t, std::vector<xpum_diag_media_codec_metrics_t>>& media_codec_perf_datas,
+                                             std::map<xpum_device_id_t, std::vector<xpum_diag_xe_link_throughput_t>>& xe_link_throughput_datas,
+                                             std::shared_ptr<XeLinkThroughputBatch> xe_link_batch,
+                                             std::string &error_details);
+
     static void doDeviceLevelDiagnosticCore(const ze_device_handle_t &ze_device,
                                        const ze_driver_handle_t &ze_driver,
                                        std::shared_ptr<xpum_diag_task_info_t> p_task_info,
                                        int gpu_total_count,
                                        std::vector<std::shared_ptr<Device>> devices,
                                        std::map<xpum_device_id_t, std::vector<xpum_diag_media_codec_metrics_t>>& media_codec_perf_datas,
-                                       std::map<xpum_device_id_t, std::vector<xpum_diag_xe_link_throughput_t>>& xe_link_throughput_datas);
+                                       std::map<xpum_device_id_t, std::vector<xpum_diag_xe_link_throughput_t>>& xe_link_throughput_datas,
+                                       std::shared_ptr<XeLinkThroughputBatch> xe_link_batch);
 
     static void doDeviceMultipleSpecificDiagnosticCore(const ze_device_handle_t &ze_device,
                                        const ze_driver_handle_t &ze_driver,
@@ -89,7 +118,8 @@ class DiagnosticManager : public DiagnosticManagerInterface {
                                        int gpu_total_count,
                                        std::vector<std::shared_ptr<Device>> devices,
                                        std::map<xpum_device_id_t, std::vector<xpum_diag_media_codec_metrics_t>>& media_codec_perf_datas,
-                                       std::map<xpum_device_id_t, std::vector<xpum_diag_xe_link_throughput_t>>& xe_link_throughput_datas);
+                                       std::map<xpum_device_id_t, std::vector<xpum_diag_xe_link_throughput_t>>& xe_link_throughput_datas,
+                                       std::shared_ptr<XeLinkThroughputBatch> xe_link_batch);
 
     static void doDeviceDiagnosticEnvironmentVariables(std::shared_ptr<xpum_diag_task_info_t> p_task_info);
 
@@ -136,7 +166,8 @@ class DiagnosticManager : public DiagnosticManagerInterface {
                                                             const ze_driver_handle_t &ze_driver,
                                                             std::shared_ptr<xpum_diag_task_info_t> p_task_info,
                                                             std::vector<std::shared_ptr<Device>> devices,
-                                                            std::map<xpum_device_id_t, std::vector<xpum_diag_xe_link_throughput_t>>& xe_link_throughput_datas);
+                                                            std::map<xpum_device_id_t, std::vector<xpum_diag_xe_link_throughput_t>>& xe_link_throughput_datas,
+                                                            std::shared_ptr<XeLinkThroughputBatch> xe_link_batch);
 
     static void doDeviceDiagnosticExceptionHandle(xpum_diag_task_type_t type, std::string error, std::shared_ptr<xpum_diag_task_info_t> p_task_info);
 
@@ -185,6 +216,11 @@ class DiagnosticManager : public DiagnosticManagerInterface {
     static void setupFunction(ze_module_handle_t &module_handle, ze_kernel_handle_t &function,
                               const char *name, void *input, void *output);
 
+    static void setupFunction(DiagnosticRuntimeLease &runtime, ze_module_handle_t module_handle, ze_kernel_handle_t &function,
+                              const char *name, void *input, void *output);
+
+    static void updatePhaseTimes(xpum_diag_component_info_t &component, const std::vector<DiagnosticPhaseTimes> &phase_times);
+
     static long double runKernel(ze_command_queue_handle_t command_queue, ze_command_list_handle_t command_list,
                                  ze_kernel_handle_t &function,
                                  struct ZeWorkGroups &workgroup_info, xpum_diag_task_type_t type, bool checkOnly = false);
@@ -202,9 +238,13 @@ class DiagnosticManager : public DiagnosticManagerInterface {
                                  const ze_driver_handle_t &ze_driver,
                                  std::shared_ptr<xpum_diag_task_info_t> p_task_info);
     
-    static void copyMemoryDataAndCalculateXeLinkThroughput(const ze_driver_handle_t &ze_driver, std::vector<std::tuple<ze_device_handle_t, int32_t, ze_device_handle_t, int32_t>> test_pairs,
+    static void copyMemoryDataAndCalculateXeLinkThroughput(const ze_driver_handle_t &ze_driver, const std::vector<XeLinkTestPair> &test_pairs,
                                                         std::map<xpum_device_id_t, std::vector<xpum_diag_xe_link_throughput_t>>& xe_link_throughput_datas);
 
+    static void copyMemoryDataAndCalculateXeLinkThroughput(const ze_driver_handle_t &ze_driver, const XeLinkTestPair &test_pair,
+                                                        std::map<xpum_device_id_t, std::vector<xpum_diag_xe_link_throughput_t>>& xe_link_throughput_datas,
+                                                        std::mutex &datas_mutex);
+
     static void getXeLinkPortTransmitCounters(const ze_device_handle_t& ze_device, int32_t device_id, std::map<std::vector<int32_t>, uint64_t>& tx_counters, double& max_speed);
 
     // zes_fabric_port_id_t.fabricId to xpum deviceId, each device has a unique fabricId
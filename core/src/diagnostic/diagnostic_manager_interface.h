@@ -23,6 +23,10 @@ class DiagnosticManagerInterface : public InitCloseInterface {
 
     virtual xpum_result_t runMultipleSpecificDiagnostics(xpum_device_id_t deviceId, xpum_diag_task_type_t types[], int count) = 0;
 
+    virtual xpum_result_t runLevelDiagnosticsByGroup(const std::vector<xpum_device_id_t> &deviceIds, xpum_diag_level_t level) = 0;
+
+    virtual xpum_result_t runMultipleSpecificDiagnosticsByGroup(const std::vector<xpum_device_id_t> &deviceIds, xpum_diag_task_type_t types[], int count) = 0;
+
     virtual bool isDiagnosticsRunning(xpum_device_id_t deviceId) = 0;
 
     virtual xpum_result_t getDiagnosticsResult(xpum_device_id_t deviceId, xpum_diag_task_info_t *result) = 0;
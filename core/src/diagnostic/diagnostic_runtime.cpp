@@ -0,0 +1,167 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file diagnostic_runtime.cpp
+ */
+
+#include "diagnostic_runtime.h"
+
+#include <mutex>
+
+#include "infrastructure/exception/base_exception.h"
+#include "infrastructure/handle_lock.h"
+#include "infrastructure/logger.h"
+
+namespace xpum {
+
+static std::mutex runtime_cache_mutex;
+
+static std::map<ze_driver_handle_t, ze_context_handle_t> runtime_contexts;
+
+static std::map<ze_device_handle_t, std::unique_ptr<DiagnosticRuntime>> idle_runtimes;
+
+DiagnosticRuntime::DiagnosticRuntime(ze_context_handle_t context, ze_device_handle_t device)
+    : context(context), device(device), command_queue(nullptr) {
+}
+
+DiagnosticRuntime::~DiagnosticRuntime() {
+    ze_result_t ret;
+    for (auto &kernel : kernels) {
+        ret = zeKernelDestroy(kernel.second);
+        if (ret != ZE_RESULT_SUCCESS) {
+            XPUM_LOG_WARN("zeKernelDestroy()[{}]", zeResultErrorCodeStr(ret));
+        }
+    }
+    for (auto &module : modules) {
+        ret = zeModuleDestroy(module.second);
+        if (ret != ZE_RESULT_SUCCESS) {
+            XPUM_LOG_WARN("zeModuleDestroy()[{}]", zeResultErrorCodeStr(ret));
+        }
+    }
+    if (command_queue != nullptr) {
+        ret = zeCommandQueueDestroy(command_queue);
+        if (ret != ZE_RESULT_SUCCESS) {
+            XPUM_LOG_WARN("zeCommandQueueDestroy()[{}]", zeResultErrorCodeStr(ret));
+        }
+    }
+}
+
+ze_command_queue_handle_t DiagnosticRuntime::getCommandQueue() {
+    if (command_queue != nullptr) {
+        return command_queue;
+    }
+    ze_result_t ret;
+    ze_command_queue_desc_t command_queue_description{};
+    command_queue_description.stype = ZE_STRUCTURE_TYPE_COMMAND_QUEUE_DESC;
+    command_queue_description.pNext = nullptr;
+    command_queue_description.mode = ZE_COMMAND_QUEUE_MODE_ASYNCHRONOUS;
+    command_queue_description.flags = ZE_COMMAND_QUEUE_FLAG_EXPLICIT_ONLY;
+    command_queue_description.ordinal = 0;
+    command_queue_description.index = 0;
+    XPUM_ZE_HANDLE_LOCK(device, ret = zeCommandQueueCreate(context, device, &command_queue_description, &command_queue));
+    if (ret != ZE_RESULT_SUCCESS) {
+        command_queue = nullptr;
+        throw BaseException("zeCommandQueueCreate()[" + zeResultErrorCodeStr(ret) + "]");
+    }
+    return command_queue;
+}
+
+ze_module_handle_t DiagnosticRuntime::getModule(const std::string &file_name, BinaryLoader load) {
+    auto it = modules.find(file_name);
+    if (it != modules.end()) {
+        return it->second;
+    }
+    ze_result_t ret;
+    std::vector<uint8_t> binary_file = load(file_name);
+    ze_module_desc_t module_description = {};
+    module_description.stype = ZE_STRUCTURE_TYPE_MODULE_DESC;
+    module_description.pNext = nullptr;
+    module_description.format = ZE_MODULE_FORMAT_IL_SPIRV;
+    module_description.inputSize = static_cast<uint32_t>(binary_file.size());
+    module_description.pInputModule = binary_file.data();
+    module_description.pBuildFlags = nullptr;
+    ze_module_handle_t module_handle = nullptr;
+    XPUM_ZE_HANDLE_LOCK(device, ret = zeModuleCreate(context, device, &module_description, &module_handle, nullptr));
+    if (ret != ZE_RESULT_SUCCESS) {
+        throw BaseException("zeModuleCreate()[" + zeResultErrorCodeStr(ret) + "]");
+    }
+    XPUM_LOG_DEBUG("diagnostic module {} built", file_name);
+    modules[file_name] = module_handle;
+    return module_handle;
+}
+
+ze_kernel_handle_t DiagnosticRuntime::getKernel(ze_module_handle_t module, const std::string &kernel_name) {
+    auto key = std::make_pair(module, kernel_name);
+    auto it = kernels.find(key);
+    if (it != kernels.end()) {
+        return it->second;
+    }
+    ze_result_t ret;
+    ze_kernel_desc_t function_description = {};
+    function_description.stype = ZE_STRUCTURE_TYPE_KERNEL_DESC;
+    function_description.pNext = nullptr;
+    function_description.flags = 0;
+    function_description.pKernelName = kernel_name.c_str();
+    ze_kernel_handle_t function = nullptr;
+    ret = zeKernelCreate(module, &function_description, &function);
+    if (ret != ZE_RESULT_SUCCESS) {
+        throw BaseException("zeKernelCreate()[" + zeResultErrorCodeStr(ret) + "]");
+    }
+    kernels[key] = function;
+    return function;
+}
+
+DiagnosticRuntimeLease::DiagnosticRuntimeLease(ze_driver_handle_t driver, ze_device_handle_t device)
+    : device(device), committed(false) {
+    std::unique_lock<std::mutex> lock(runtime_cache_mutex);
+    auto it = idle_runtimes.find(device);
+    if (it != idle_runtimes.end()) {
+        runtime = std::move(it->second);
+        idle_runtimes.erase(it);
+        return;
+    }
+
+    ze_context_handle_t context = nullptr;
+    auto context_it = runtime_contexts.find(driver);
+    if (context_it != runtime_contexts.end()) {
+        context = context_it->second;
+    } else {
+        ze_result_t ret;
+        ze_context_desc_t context_desc = {
+                ZE_STRUCTURE_TYPE_CONTEXT_DESC,
+                nullptr,
+                0
+        };
+        XPUM_ZE_HANDLE_LOCK(driver, ret = zeContextCreate(driver, &context_desc, &context));
+        if (ret != ZE_RESULT_SUCCESS) {
+            throw BaseException("zeContextCreate()[" + zeResultErrorCodeStr(ret) + "]");
+        }
+        runtime_contexts[driver] = context;
+    }
+    runtime.reset(new DiagnosticRuntime(context, device));
+}
+
+DiagnosticRuntimeLease::~DiagnosticRuntimeLease() {
+    if (!committed || runtime == nullptr) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(runtime_cache_mutex);
+    auto &idle = idle_runtimes[device];
+    if (idle == nullptr) {
+        idle = std::move(runtime);
+    }
+}
+
+void DiagnosticRuntimeLease::clear() {
+    std::unique_lock<std::mutex> lock(runtime_cache_mutex);
+    idle_runtimes.clear();
+    for (auto &context : runtime_contexts) {
+        ze_result_t ret = zeContextDestroy(context.second);
+        if (ret != ZE_RESULT_SUCCESS) {
+            XPUM_LOG_WARN("zeContextDestroy()[{}]", zeResultErrorCodeStr(ret));
+        }
+    }
+    runtime_contexts.clear();
+}
+
+} // end namespace xpum
@@ -0,0 +1,119 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file diagnostic_runtime.h
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "level_zero/ze_api.h"
+
+namespace xpum {
+
+std::string zeResultErrorCodeStr(ze_result_t ret);
+
+/*
+  Level Zero objects of one device or subdevice that are kept across
+  diagnostic and stress runs: a command queue, the modules built from the
+  kernel files and the kernels created from those modules. The context is
+  shared by all devices of a driver.
+*/
+
+class DiagnosticRuntime {
+   public:
+    typedef std::vector<uint8_t> (*BinaryLoader)(const std::string &file_name);
+
+    DiagnosticRuntime(ze_context_handle_t context, ze_device_handle_t device);
+
+    ~DiagnosticRuntime();
+
+    ze_context_handle_t getContext() const {
+        return context;
+    }
+
+    ze_command_queue_handle_t getCommandQueue();
+
+    ze_module_handle_t getModule(const std::string &file_name, BinaryLoader load);
+
+    ze_kernel_handle_t getKernel(ze_module_handle_t module, const std::string &kernel_name);
+
+   private:
+    ze_context_handle_t context;
+
+    ze_device_handle_t device;
+
+    ze_command_queue_handle_t command_queue;
+
+    std::map<std::string, ze_module_handle_t> modules;
+
+    std::map<std::pair<ze_module_handle_t, std::string>, ze_kernel_handle_t> kernels;
+};
+
+/*
+  Hands out the cached runtime of a device for the duration of one run.
+  A cached runtime is used by a single run at a time; a concurrent run on
+  the same device, e.g. a stress run next to a diagnostic, gets a fresh
+  runtime. Only runtimes released with commit() go back to the cache, a
+  failed run may have left its queue in an unknown state.
+*/
+
+class DiagnosticRuntimeLease {
+   public:
+    DiagnosticRuntimeLease(ze_driver_handle_t driver, ze_device_handle_t device);
+
+    ~DiagnosticRuntimeLease();
+
+    DiagnosticRuntime *operator->() const {
+        return runtime.get();
+    }
+
+    void commit() {
+        committed = true;
+    }
+
+    // destroy all cached runtimes and contexts
+    static void clear();
+
+   private:
+    ze_device_handle_t device;
+
+    std::unique_ptr<DiagnosticRuntime> runtime;
+
+    bool committed;
+};
+
+/*
+  Wall clock time of the phases of a diagnostic run, in milliseconds.
+*/
+
+struct DiagnosticPhaseTimes {
+    uint64_t setup = 0;
+    uint64_t run = 0;
+    uint64_t cleanup = 0;
+};
+
+class DiagnosticPhaseTimer {
+   public:
+    DiagnosticPhaseTimer() : last(std::chrono::steady_clock::now()) {}
+
+    // milliseconds since the previous lap
+    uint64_t lap() {
+        auto now = std::chrono::steady_clock::now();
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - last).count();
+        last = now;
+        return elapsed;
+    }
+
+   private:
+    std::chrono::steady_clock::time_point last;
+};
+
+} // end namespace xpum
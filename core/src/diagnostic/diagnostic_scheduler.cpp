@@ -0,0 +1,210 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file diagnostic_scheduler.cpp
+ */
+
+#include "diagnostic_scheduler.h"
+
+#include <exception>
+#include <thread>
+
+#include "infrastructure/exception/base_exception.h"
+#include "infrastructure/logger.h"
+#include "infrastructure/utility.h"
+
+namespace xpum {
+
+// devices whose Xe Links are under test, see XeLinkThroughputBatch
+static std::mutex fabric_mutex;
+static std::condition_variable fabric_cond;
+static std::set<int32_t> fabric_busy_devices;
+
+DiagnosticScheduler::DiagnosticScheduler(std::shared_ptr<xpum_diag_task_info_t> p_task_info)
+    : p_task_info(p_task_info), aborted(false) {
+}
+
+uint32_t DiagnosticScheduler::getResources(xpum_diag_task_type_t type) {
+    switch (type) {
+        case XPUM_DIAG_SOFTWARE_ENV_VARIABLES:
+        case XPUM_DIAG_SOFTWARE_LIBRARY:
+        case XPUM_DIAG_SOFTWARE_PERMISSION:
+        case XPUM_DIAG_HARDWARE_SYSMAN:
+            return DIAG_RESOURCE_NONE;
+        case XPUM_DIAG_LIGHT_COMPUTATION:
+        case XPUM_DIAG_PERFORMANCE_COMPUTATION:
+        case XPUM_DIAG_PERFORMANCE_MEMORY_BANDWIDTH:
+        case XPUM_DIAG_PERFORMANCE_MEMORY_ALLOCATION:
+        case XPUM_DIAG_MEMORY_ERROR:
+            return DIAG_RESOURCE_COMPUTE | DIAG_RESOURCE_MEMORY;
+        case XPUM_DIAG_LIGHT_CODEC:
+        case XPUM_DIAG_MEDIA_CODEC:
+            return DIAG_RESOURCE_MEDIA;
+        case XPUM_DIAG_INTEGRATION_PCIE:
+            return DIAG_RESOURCE_COPY;
+        case XPUM_DIAG_XE_LINK_THROUGHPUT:
+            return DIAG_RESOURCE_FABRIC | DIAG_RESOURCE_COPY | DIAG_RESOURCE_MEMORY;
+        // the exclusive check counts the processes on the device, so it
+        // has to run before our own workloads start; power needs an idle device
+        case XPUM_DIAG_SOFTWARE_EXCLUSIVE:
+        case XPUM_DIAG_PERFORMANCE_POWER:
+        default:
+            return DIAG_RESOURCE_ALL;
+    }
+}
+
+void DiagnosticScheduler::add(xpum_diag_task_type_t type, std::function<void()> run) {
+    Stage stage;
+    stage.type = type;
+    stage.resources = getResources(type);
+    stage.run = run;
+    stage.done = false;
+    for (std::size_t i = 0; i < stages.size(); i++) {
+        if ((stages[i].resources & stage.resources) != 0) {
+            stage.dependencies.push_back(i);
+        }
+    }
+    stages.push_back(stage);
+}
+
+void DiagnosticScheduler::runStage(std::size_t index) {
+    Stage &stage = stages[index];
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this, &stage]() {
+            if (aborted) {
+                return true;
+            }
+            for (auto dependency : stage.dependencies) {
+                if (!stages[dependency].done) {
+                    return false;
+                }
+            }
+            return true;
+        });
+        if (aborted) {
+            stage.done = true;
+            cond.notify_all();
+            return;
+        }
+        p_task_info->count += 1;
+    }
+
+    xpum_diag_component_info_t &component = p_task_info->componentList[stage.type];
+    component.startTime = Utility::getCurrentMillisecond();
+    try {
+        stage.run();
+    } catch (std::exception &e) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!aborted) {
+            aborted = true;
+            error = e.what();
+        }
+    }
+    component.endTime = Utility::getCurrentMillisecond();
+    XPUM_LOG_DEBUG("diagnostic {} of device {} took {} ms", stage.type, p_task_info->deviceId, component.endTime - component.startTime);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    stage.done = true;
+    cond.notify_all();
+}
+
+bool DiagnosticScheduler::run(std::string &error) {
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < stages.size(); i++) {
+        threads.push_back(std::thread(&DiagnosticScheduler::runStage, this, i));
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    if (aborted) {
+        error = this->error;
+        return false;
+    }
+    return true;
+}
+
+XeLinkThroughputBatch::XeLinkThroughputBatch(const std::set<int32_t> &device_ids)
+    : pending(device_ids), started(false), finished(false) {
+}
+
+void XeLinkThroughputBatch::lockDevices(const std::set<int32_t> &device_ids) {
+    std::unique_lock<std::mutex> lock(fabric_mutex);
+    fabric_cond.wait(lock, [&device_ids]() {
+        for (auto device_id : device_ids) {
+            if (fabric_busy_devices.count(device_id) > 0) {
+                return false;
+            }
+        }
+        return true;
+    });
+    fabric_busy_devices.insert(device_ids.begin(), device_ids.end());
+}
+
+void XeLinkThroughputBatch::unlockDevices(const std::set<int32_t> &device_ids) {
+    std::unique_lock<std::mutex> lock(fabric_mutex);
+    for (auto device_id : device_ids) {
+        fabric_busy_devices.erase(device_id);
+    }
+    fabric_cond.notify_all();
+}
+
+void XeLinkThroughputBatch::join(int32_t device_id, const std::vector<XeLinkTestPair> &device_pairs,
+                                 std::function<void(const std::vector<XeLinkTestPair> &)> test) {
+    std::unique_lock<std::mutex> lock(mutex);
+    pending.erase(device_id);
+    for (auto &pair : device_pairs) {
+        // the peers of a device under test join with the same pairs
+        bool found = false;
+        for (auto &p : pairs) {
+            if (std::get<1>(p) == std::get<1>(pair) && std::get<3>(p) == std::get<3>(pair)) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            pairs.push_back(pair);
+        }
+    }
+    cond.notify_all();
+    cond.wait(lock, [this]() { return pending.empty(); });
+
+    if (!started) {
+        started = true;
+        std::vector<XeLinkTestPair> test_pairs = pairs;
+        lock.unlock();
+
+        std::set<int32_t> device_ids;
+        for (auto &pair : test_pairs) {
+            device_ids.insert(std::get<1>(pair));
+            device_ids.insert(std::get<3>(pair));
+        }
+        std::string test_error;
+        lockDevices(device_ids);
+        try {
+            test(test_pairs);
+        } catch (std::exception &e) {
+            test_error = e.what();
+        }
+        unlockDevices(device_ids);
+
+        lock.lock();
+        error = test_error;
+        finished = true;
+        cond.notify_all();
+    } else {
+        cond.wait(lock, [this]() { return finished; });
+    }
+    if (!error.empty()) {
+        throw BaseException(error);
+    }
+}
+
+void XeLinkThroughputBatch::leave(int32_t device_id) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (pending.erase(device_id) > 0) {
+        cond.notify_all();
+    }
+}
+
+} // end namespace xpum
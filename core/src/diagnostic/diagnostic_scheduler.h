@@ -0,0 +1,132 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file diagnostic_scheduler.h
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "level_zero/ze_api.h"
+#include "xpum_structs.h"
+
+namespace xpum {
+
+/*
+  Parts of the node a diagnostic component keeps busy while it runs. Two
+  components of a device that share a resource would disturb each other's
+  measurements, so they never overlap.
+*/
+
+enum DiagnosticResource : uint32_t {
+    DIAG_RESOURCE_NONE = 0,
+    DIAG_RESOURCE_COMPUTE = 1 << 0,
+    DIAG_RESOURCE_MEMORY = 1 << 1,
+    DIAG_RESOURCE_MEDIA = 1 << 2,
+    DIAG_RESOURCE_COPY = 1 << 3,
+    DIAG_RESOURCE_FABRIC = 1 << 4,
+    DIAG_RESOURCE_ALL = 0xffffffff
+};
+
+/*
+  Runs the components of one diagnostic task as a dependency graph. A
+  component depends on every component added before it that uses one of
+  its resources, so components that conflict keep the order they were
+  added in and all others run concurrently. Across devices the Xe Link
+  test is coordinated by XeLinkThroughputBatch below.
+
+  The first std::exception thrown by a component aborts the components
+  that have not started yet, like the sequential loop did.
+*/
+
+class DiagnosticScheduler {
+   public:
+    DiagnosticScheduler(std::shared_ptr<xpum_diag_task_info_t> p_task_info);
+
+    void add(xpum_diag_task_type_t type, std::function<void()> run);
+
+    // returns false and sets error if a component aborted the task
+    bool run(std::string &error);
+
+    static uint32_t getResources(xpum_diag_task_type_t type);
+
+   private:
+    struct Stage {
+        xpum_diag_task_type_t type;
+        uint32_t resources;
+        std::function<void()> run;
+        std::vector<std::size_t> dependencies;
+        bool done;
+    };
+
+    void runStage(std::size_t index);
+
+    std::shared_ptr<xpum_diag_task_info_t> p_task_info;
+
+    std::vector<Stage> stages;
+
+    std::mutex mutex;
+
+    std::condition_variable cond;
+
+    bool aborted;
+
+    std::string error;
+};
+
+// src_device_handle, src_device_id, dst_device_handle, dst_device_id
+typedef std::tuple<ze_device_handle_t, int32_t, ze_device_handle_t, int32_t> XeLinkTestPair;
+
+/*
+  Xe Link throughput test shared by the device tasks of one diagnostic run.
+  Every device under test joins with the pairs between itself and its
+  peers. Once all of them have joined or left, one of them tests the union
+  of the pairs, which is what lets device disjoint pairs run in the same
+  round, and the others wait for it.
+
+  The test holds the fabric of every device in its pairs, so runs sharing
+  no device still test their links concurrently.
+*/
+
+class XeLinkThroughputBatch {
+   public:
+    XeLinkThroughputBatch(const std::set<int32_t> &device_ids);
+
+    // blocks until the pairs of every device under test were tested,
+    // throws BaseException if the test failed
+    void join(int32_t device_id, const std::vector<XeLinkTestPair> &pairs,
+              std::function<void(const std::vector<XeLinkTestPair> &)> test);
+
+    // a device that will not join, e.g. its task aborted or it has no Xe Link
+    void leave(int32_t device_id);
+
+   private:
+    static void lockDevices(const std::set<int32_t> &device_ids);
+
+    static void unlockDevices(const std::set<int32_t> &device_ids);
+
+    std::set<int32_t> pending;
+
+    std::vector<XeLinkTestPair> pairs;
+
+    std::mutex mutex;
+
+    std::condition_variable cond;
+
+    bool started;
+
+    bool finished;
+
+    std::string error;
+};
+
+} // end namespace xpum
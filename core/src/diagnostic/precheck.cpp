@@ -12,6 +12,10 @@
 #include <fstream>
 #include <iostream>
 #include <algorithm>
+#include <array>
+#include <deque>
+#include <limits>
+#include <mutex>
 #include <unistd.h>
 #include <fcntl.h>
 #include <dirent.h>
@@ -158,8 +162,8 @@ namespace xpum {
         }
     }
 
-    static void updateErrorLogLine(std::string line, ErrorPattern error_pattern) {
-        std::regex regTime("T\\d{2}:\\d{2}:\\d{2}.*\\+\\d{2}:?\\d{2}");
+    static void updateErrorLogLine(std::string line, const ErrorPattern& error_pattern) {
+        static const std::regex regTime("T\\d{2}:\\d{2}:\\d{2}.*\\+\\d{2}:?\\d{2}");
         std::smatch match;
         std::string time;
         if(std::regex_search(line, match, regTime)) {
@@ -213,15 +217,133 @@ namespace xpum {
         }
     }
 
-    static void scanErrorLogLinesByFile(std::string print_log_cmd, std::unordered_map<std::string, std::vector<ErrorPattern>>& key_to_error_patterns) {
-        // detect current boot line
+    static const int KEYWORD_NOT_FOUND = std::numeric_limits<int>::max();
+
+    /**
+     * Case insensitive matcher of the targeted words. The words are compiled
+     * once into an Aho-Corasick automaton whose failure links are folded into
+     * the transition table, so a line is scanned in a single pass with one
+     * table lookup per character.
+     */
+    class KeywordMatcher {
+       public:
+        explicit KeywordMatcher(const std::vector<std::string>& keywords) {
+            newNode();
+            for (std::size_t k = 0; k < keywords.size(); k++) {
+                int state = 0;
+                for (char c : keywords[k]) {
+                    unsigned char ch = (unsigned char)::tolower((unsigned char)c) & 0x7f;
+                    if (transitions[state][ch] == 0) {
+                        int next = newNode();
+                        transitions[state][ch] = next;
+                    }
+                    state = transitions[state][ch];
+                }
+                outputs[state] = std::min(outputs[state], (int)k);
+            }
+            // breadth first, so the failure state of a node is complete before its children
+            std::vector<int> failures(transitions.size(), 0);
+            std::deque<int> queue;
+            for (int ch = 0; ch < 128; ch++) {
+                if (transitions[0][ch] != 0) {
+                    queue.push_back(transitions[0][ch]);
+                }
+            }
+            while (!queue.empty()) {
+                int state = queue.front();
+                queue.pop_front();
+                outputs[state] = std::min(outputs[state], outputs[failures[state]]);
+                for (int ch = 0; ch < 128; ch++) {
+                    int next = transitions[state][ch];
+                    if (next != 0) {
+                        failures[next] = transitions[failures[state]][ch];
+                        queue.push_back(next);
+                    } else {
+                        transitions[state][ch] = transitions[failures[state]][ch];
+                    }
+                }
+            }
+        }
+
+        // Returns the index of the first keyword of the list found in line, -1 if none
+        int find(const std::string& line) const {
+            int state = 0;
+            int found = KEYWORD_NOT_FOUND;
+            for (char c : line) {
+                unsigned char ch = (unsigned char)c;
+                if (ch >= 128) {
+                    state = 0;
+                    continue;
+                }
+                state = transitions[state][::tolower(ch)];
+                found = std::min(found, outputs[state]);
+            }
+            return found == KEYWORD_NOT_FOUND ? -1 : found;
+        }
+
+       private:
+        int newNode() {
+            transitions.emplace_back();
+            transitions.back().fill(0);
+            outputs.push_back(KEYWORD_NOT_FOUND);
+            return transitions.size() - 1;
+        }
+
+        std::vector<std::array<int, 128>> transitions;
+        std::vector<int> outputs;
+    };
+
+    struct CompiledErrorPattern {
+        ErrorPattern error_pattern;
+        std::regex re;
+    };
+
+    static std::regex compileErrorPattern(std::string pattern) {
+        // the patterns are only searched, leading and trailing ".*" just cost backtracking
+        while (pattern.compare(0, 2, ".*") == 0) {
+            pattern = pattern.substr(2);
+        }
+        while (pattern.size() >= 2 && pattern.compare(pattern.size() - 2, 2, ".*") == 0) {
+            pattern = pattern.substr(0, pattern.size() - 2);
+        }
+        return std::regex(pattern, std::regex_constants::icase | std::regex_constants::optimize);
+    }
+
+    /**
+     * State of the incremental kernel log scan. The lines already scanned in
+     * the current boot are not matched again: journalctl resumes after the
+     * saved cursor, dmesg and log files skip the lines seen before as long as
+     * the last seen line is still at the same position. The matched lines are
+     * kept and replayed since every precheck starts from clean components.
+     */
+    struct LogScanState {
+        std::string boot_id;
+        std::string print_log_cmd;
+        std::string cursor;
+        uint64_t line_count = 0;
+        std::string last_line;
+        std::vector<std::pair<std::string, ErrorPattern>> matches;
+    };
+
+    static std::mutex log_scan_mutex;
+
+    static LogScanState log_scan_state;
+
+    static std::string readBootId() {
+        std::ifstream ifs("/proc/sys/kernel/random/boot_id");
+        std::string boot_id;
+        std::getline(ifs, boot_id);
+        return boot_id;
+    }
+
+    static std::string detectCurrentBootLine(const std::string& print_log_cmd) {
         std::string currentBootLine;
         std::string detect_cmd = print_log_cmd + " | grep -i \"Command line: \" | grep -i boot | tail -n 1";
         FILE* f = popen(detect_cmd.c_str(), "r");
         if (f == nullptr) {
             XPUM_LOG_ERROR("Failed to detect current boot line with command: {}", detect_cmd);
-            return;
-        } 
+            return currentBootLine;
+        }
         char c_line[1024];
         while (fgets(c_line, 1024, f) != NULL) {
             size_t len = strnlen(c_line, 1024);
@@ -231,20 +353,76 @@ namespace xpum {
             currentBootLine = std::string(c_line);
         }
         pclose(f);
+        return currentBootLine;
+    }
+
+    static void scanErrorLogLinesByFile(xpum_precheck_log_source logSource, std::string print_log_cmd,
+                                        const std::vector<std::vector<CompiledErrorPattern>>& key_to_error_patterns) {
+        static const KeywordMatcher keyword_matcher(targeted_words);
+        std::unique_lock<std::mutex> lock(log_scan_mutex);
+        LogScanState& state = log_scan_state;
+
+        std::string boot_id = readBootId();
+        if (state.boot_id != boot_id || state.print_log_cmd != print_log_cmd) {
+            state = LogScanState();
+            state.boot_id = boot_id;
+            state.print_log_cmd = print_log_cmd;
+        }
+        bool use_cursor = logSource == XPUM_PRECHECK_LOG_SOURCE_JOURNALCTL;
+        bool incremental = use_cursor ? !state.cursor.empty() : state.line_count > 0;
+
+        std::string cmd = print_log_cmd;
+        if (use_cursor) {
+            cmd += " --show-cursor";
+            if (incremental) {
+                cmd += " --after-cursor \"" + state.cursor + "\"";
+            }
+        }
+
+        // the boot line is behind the saved position when scanning incrementally
+        std::string currentBootLine;
+        if (!incremental) {
+            currentBootLine = detectCurrentBootLine(print_log_cmd);
+        }
 
         bool findCurrentBootLine = false;
-        f = popen(print_log_cmd.c_str(), "r");
+        FILE* f = popen(cmd.c_str(), "r");
         if (f == nullptr) {
-            XPUM_LOG_ERROR("Failed to check log with command: {}", print_log_cmd);
+            XPUM_LOG_ERROR("Failed to check log with command: {}", cmd);
             return;
         }
-        std::smatch match;
+        char c_line[1024];
+        uint64_t line_count = 0;
+        std::string last_line;
+        std::vector<std::pair<std::string, ErrorPattern>> matches;
         while (fgets(c_line, 1024, f) != NULL) {
             size_t len = strnlen(c_line, 1024);
             if (len > 0 && c_line[len-1] == '\n') {
                 c_line[--len] = '\0';
             }
             std::string line(c_line);
+            if (use_cursor && line.compare(0, 11, "-- cursor: ") == 0) {
+                state.cursor = line.substr(11);
+                continue;
+            }
+            line_count++;
+            last_line = line;
+            if (!use_cursor && incremental) {
+                if (line_count < state.line_count) {
+                    continue;
+                }
+                if (line_count == state.line_count) {
+                    if (line != state.last_line) {
+                        // the log was rotated or the ring buffer wrapped, scan it again from scratch
+                        pclose(f);
+                        state = LogScanState();
+                        lock.unlock();
+                        scanErrorLogLinesByFile(logSource, print_log_cmd, key_to_error_patterns);
+                        return;
+                    }
+                    continue;
+                }
+            }
             // if currentBootLine is empty, scan all content in the log file.
             if (!currentBootLine.empty()) {
                 if (findCurrentBootLine == false && line == currentBootLine) {
@@ -257,37 +435,56 @@ namespace xpum {
                 }
             }
             XPUM_LOG_DEBUG("precheck scans log line: {}", line);
-            std::string target_found;
-            for (auto tw : targeted_words)
-                if (findCaseInsensitive(line, tw, 0) != std::string::npos) {
-                    target_found = tw;
-                    break;
-                }
-            if (target_found.empty())
+            int key = keyword_matcher.find(line);
+            if (key < 0)
                 continue;
-            for (auto error_pattern : key_to_error_patterns[target_found]) {
-                std::regex re(error_pattern.pattern, std::regex_constants::icase);
-                if(std::regex_search(line, match, re)) {
+            for (auto& compiled : key_to_error_patterns[key]) {
+                auto& error_pattern = compiled.error_pattern;
+                if (std::regex_search(line, compiled.re)) {
                     if (error_pattern.filter.size() > 0 && line.find(error_pattern.filter) != std::string::npos)
                         continue;
-                    updateErrorLogLine(line, error_pattern);
+                    matches.emplace_back(line, error_pattern);
                 }
             }
         }
         pclose(f);
+
+        if (!use_cursor) {
+            if (incremental && line_count < state.line_count) {
+                // the log became shorter than what was seen before
+                state = LogScanState();
+                lock.unlock();
+                scanErrorLogLinesByFile(logSource, print_log_cmd, key_to_error_patterns);
+                return;
+            }
+            state.line_count = line_count;
+            state.last_line = last_line;
+        }
+        state.matches.insert(state.matches.end(), matches.begin(), matches.end());
+        XPUM_LOG_DEBUG("precheck scanned {} log lines, {} matched lines in current boot", line_count, state.matches.size());
+        for (auto& match : state.matches) {
+            updateErrorLogLine(match.first, match.second);
+        }
     }
 
-    static void scanErrorLogLines(xpum_precheck_log_source logSource, std::vector<ErrorPattern> error_patterns, std::string since_time) {
-        std::unordered_map<std::string, std::vector<ErrorPattern>> key_to_error_patterns;
-        for (auto& key : targeted_words) {
-            std::vector<ErrorPattern> patterns;
-            for (auto& ep : error_patterns) {
-                if (findCaseInsensitive(ep.pattern, key, 0) != std::string::npos) {
-                    patterns.push_back(ep);
+    // the error patterns of each targeted word, compiled on the first scan
+    static const std::vector<std::vector<CompiledErrorPattern>>& compiledErrorPatterns() {
+        static const std::vector<std::vector<CompiledErrorPattern>> key_to_error_patterns = [] {
+            std::vector<std::vector<CompiledErrorPattern>> compiled(targeted_words.size());
+            for (std::size_t key = 0; key < targeted_words.size(); key++) {
+                for (auto& ep : error_patterns) {
+                    if (findCaseInsensitive(ep.pattern, targeted_words[key], 0) != std::string::npos) {
+                        compiled[key].push_back({ep, compileErrorPattern(ep.pattern)});
+                    }
                 }
             }
-            key_to_error_patterns[key] = patterns;
-        }
+            return compiled;
+        }();
+        return key_to_error_patterns;
+    }
+
+    static void scanErrorLogLines(xpum_precheck_log_source logSource, std::string since_time) {
+        auto& key_to_error_patterns = compiledErrorPatterns();
 
         std::string print_log_cmd;
         if (logSource == XPUM_PRECHECK_LOG_SOURCE_DMESG) {
@@ -300,7 +497,14 @@ namespace xpum {
             print_log_cmd = "cat " + PrecheckManager::KERNEL_MESSAGES_FILE;
         }
         XPUM_LOG_INFO("precheck log command: {}", print_log_cmd);
-        scanErrorLogLinesByFile(print_log_cmd, key_to_error_patterns);
+        scanErrorLogLinesByFile(logSource, print_log_cmd, key_to_error_patterns);
+    }
+
+    void PrecheckManager::scanLogFile(const std::string& file_path) {
+        std::string kernel_messages_file = PrecheckManager::KERNEL_MESSAGES_FILE;
+        PrecheckManager::KERNEL_MESSAGES_FILE = file_path;
+        scanErrorLogLines(XPUM_PRECHECK_LOG_SOURCE_FILE, "");
+        PrecheckManager::KERNEL_MESSAGES_FILE = kernel_messages_file;
     }
 
     static void doPreCheckDriver() {
@@ -719,7 +923,7 @@ namespace xpum {
             checkMemoryMRCStatus(gpu_bdfs); 
         }
 
-        scanErrorLogLines(logSource, error_patterns, sinceTime);
+        scanErrorLogLines(logSource, sinceTime);
     }
 
     xpum_result_t PrecheckManager::precheck(xpum_precheck_component_info_t resultList[], int *count, xpum_precheck_options options) {
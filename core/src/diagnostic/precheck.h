@@ -74,6 +74,9 @@ class PrecheckManager {
 
     static xpum_result_t getPrecheckErrorList(xpum_precheck_error_t resultList[], int *count);
 
+    // scans a kernel log file for the error patterns as precheck does with the "file" log source
+    static void scanLogFile(const std::string& file_path);
+
     static int cpu_temperature_threshold;
 
     static std::string KERNEL_MESSAGES_SOURCE;
@@ -7,11 +7,11 @@
 #include "dump_task.h"
 
 #include <algorithm>
+#include <cmath>
+#include <ctime>
 #include <fstream>
-#include <iomanip>
 #include <iostream>
 #include <map>
-#include <sstream>
 
 #include "api/internal_api.h"
 #include "api/internal_dump_raw_data.h"
@@ -46,63 +46,105 @@ DumpRawDataTask::~DumpRawDataTask() {
     std::cout << "~DumpRawDataTask() called" << std::endl;
 }
 
-void DumpRawDataTask::writeToFile(std::string text) {
-    std::ofstream outfile;
-    outfile.open(dumpFilePath.c_str(), std::ios::out | std::ios::app);
-    outfile << text << std::endl;
+void DumpRawDataTask::writeToFile(const std::string& text) {
+    if (stopped || !outfile.is_open()) {
+        return;
+    }
+    outfile.write(text.data(), text.size());
     outfile.flush();
-    outfile.close();
 }
 
 void DumpRawDataTask::writeHeader() {
-    std::ofstream outfile;
-    outfile.open(dumpFilePath.c_str(), std::ios::out | std::ios::app);
+    std::string text;
     for (std::size_t i = 0; i < columnList.size(); i++) {
-        auto dc = columnList[i];
-        outfile << dc.header;
+        text += columnList[i].header;
         if (i < columnList.size() - 1) {
-            outfile << ", ";
+            text += ", ";
         }
     }
-    outfile << std::endl;
-    outfile.flush();
-    outfile.close();
+    text += '\n';
+    writeToFile(text);
 }
 
-std::string keepTwoDecimalPrecision(double value) {
-    std::ostringstream os;
-    os << std::fixed;
-    os << std::setprecision(2);
-    os << value;
-    return os.str();
+static void appendUint(std::string& out, uint64_t value) {
+    char buf[20];
+    char* p = buf + sizeof(buf);
+    do {
+        *--p = '0' + value % 10;
+        value /= 10;
+    } while (value > 0);
+    out.append(p, buf + sizeof(buf) - p);
 }
 
-std::string getScaledValue(uint64_t value, uint32_t scale) {
+// same output as printing value / scale with std::fixed and precision 2
+static void appendScaledValue(std::string& out, uint64_t value, uint64_t scale) {
     if (scale == 1) {
-        return std::to_string(value);
-    } else {
-        double v = value / (double)scale;
-        return keepTwoDecimalPrecision(v);
+        appendUint(out, value);
+        return;
+    }
+    double v = value / (double)scale;
+    uint64_t cents = (uint64_t)std::llround(v * 100);
+    appendUint(out, cents / 100);
+    out += '.';
+    out += (char)('0' + cents / 10 % 10);
+    out += (char)('0' + cents % 10);
+}
+
+static void appendLocalTime(std::string& out, uint64_t t) {
+    time_t seconds = (long)t / 1000;
+    tm tm_buf;
+    if (localtime_r(&seconds, &tm_buf) == nullptr) {
+        return;
+    }
+    char buf[16];
+    size_t len = strftime(buf, sizeof(buf), "%T", &tm_buf);
+    out.append(buf, len);
+    int milli_seconds = t % 1000;
+    out += '.';
+    out += (char)('0' + milli_seconds / 100);
+    out += (char)('0' + milli_seconds / 10 % 10);
+    out += (char)('0' + milli_seconds % 10);
+}
+
+static void appendThrottleReason(std::string& out, uint64_t value) {
+    static const std::pair<uint64_t, const char*> reasons[] = {
+        {xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_AVE_PWR_CAP, "AVE_PWR_CAP"},
+        {xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_BURST_PWR_CAP, "BURST_PWR_CAP"},
+        {xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_CURRENT_LIMIT, "CURRENT_LIMIT"},
+        {xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_THERMAL_LIMIT, "THERMAL_LIMIT"},
+        {xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_PSU_ALERT, "PSU_ALERT"},
+        {xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_SW_RANGE, "SW_RANGE"},
+        {xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_HW_RANGE, "HW_RANGE"},
+    };
+    bool throttled = false;
+    for (auto& reason : reasons) {
+        if (value & reason.first) {
+            if (throttled) {
+                out += " | ";
+            }
+            out += reason.second;
+            throttled = true;
+        }
+    }
+    if (!throttled) {
+        out += "Not Throttled";
     }
 }
 
 void DumpRawDataTask::buildColumns() {
-    auto p_this = shared_from_this();
+    columnList.clear();
+    engineSlots.clear();
+    fabricSlots.clear();
 
     // timestamp column
-    columnList.push_back({"Timestamp",
-                          []() { return Utility::getCurrentLocalTimeString(); }});
+    columnList.push_back({"Timestamp", DUMP_COLUMN_TIMESTAMP});
 
     // device id column
-    auto deviceId = p_this->deviceId;
-    columnList.push_back({"DeviceId",
-                          [deviceId]() { return std::to_string(deviceId); }});
+    columnList.push_back({"DeviceId", DUMP_COLUMN_DEVICE_ID});
 
     // tile id column
-    auto tileId = p_this->tileId;
     if (tileId != -1) {
-        columnList.push_back({"TileId",
-                              [tileId]() { return std::to_string(tileId); }});
+        columnList.push_back({"TileId", DUMP_COLUMN_TILE_ID});
     }
 
     // get engine count
@@ -128,6 +170,7 @@ void DumpRawDataTask::buildColumns() {
         std::sort(curEngineCountList.begin(), curEngineCountList.end(),
             [] (const xpum::EngineCount& a, const xpum::EngineCount& b) {return a.tileId < b.tileId;});
     }
+    engineSlotsByTile = needAggFromTiles;
 
     // get fabric count
     auto fabricCountList = getDeviceAndTileFabricCount(deviceId);
@@ -154,292 +197,230 @@ void DumpRawDataTask::buildColumns() {
     // other columns
     for (std::size_t i = 0; i < dumpTypeList.size(); i++) {
         int dumpTypeIdx = dumpTypeList[i];
-        auto config = dumpTypeOptions[dumpTypeIdx];
+        auto& config = dumpTypeOptions[dumpTypeIdx];
         if (config.optionType == xpum::dump::DUMP_OPTION_STATS) {
-            int columnIdx = columnList.size();
-            columnList.push_back({std::string(config.name),
-                                  [config, p_this, columnIdx]() {
-                                      DumpColumn& dc = p_this->columnList.at(columnIdx);
-                                      auto statsType = config.metricsType;
-                                      auto& m = p_this->rawDataMap;
-                                      auto it = m.find(statsType);
-                                      std::string value;
-                                      if (it != m.end()) {
-                                          auto data = it->second;
-                                          if (dc.lastTimestamp != data.timestamp) {
-                                              value = getScaledValue(data.value, data.scale * config.scale);
-                                          }
-                                          dc.lastTimestamp = data.timestamp;
-                                      }
-                                      return value;
-                                  }});
+            columnList.push_back({config.name, DUMP_COLUMN_STATS, (uint32_t)config.metricsType, (uint32_t)config.scale});
         } else if (config.optionType == xpum::dump::DUMP_OPTION_ENGINE) {
-            if (curEngineCountList.empty())
-                continue;
-            for (auto ec : curEngineCountList) {
-            for(auto ecByType : ec.engineCountList){
-                auto engineType = ecByType.engineType;
-                auto tileId = ec.tileId;
-                if (engineType != config.engineType)
-                    continue;
-
-                std::string tileInfo = "";
-                if(needAggFromTiles) {
-                    tileInfo = std::to_string(ec.tileId) + "/";
-                }
-                for (int engineIdx = 0; engineIdx < ecByType.count; engineIdx++) {
-                    std::string header = engineNameMap[config.engineType] + " " + tileInfo + std::to_string(engineIdx) + " (%)";
-                    columnList.push_back({header,
-                                          [engineType, needAggFromTiles, tileId, engineIdx, p_this, config]() {
-                                              auto& m = p_this->engineUtilRawDataMap;
-                                              auto it = m.find(engineType);
-                                              std::string value;
-                                              if (it == m.end()) {
-                                                  return value;
-                                              }
-                                              auto& mm = it->second;
-                                              auto it2 = mm.find(engineIdx);
-                                              if (it2 == mm.end()) {
-                                                  return value;
-                                              }
-                                              auto& dataList = it2->second;
-                                              if (!needAggFromTiles && dataList.size() > 0){
-                                                  auto& data = dataList[0];
-                                                  return getScaledValue(data.value, data.scale * config.scale);
-                                              } else if (needAggFromTiles && dataList.size() > 0){
-                                                  auto it = std::find_if(dataList.begin(), dataList.end(),
-                                                                        [tileId] (const xpum::xpum_device_engine_metric_t& d) {return tileId == d.tileId;});
-                                                  if(it == dataList.end()){
-                                                    return value;
-                                                  }
-                                                  auto& data = (*it);
-                                                  return getScaledValue(data.value, data.scale * config.scale);
-                                              } else {
-                                                  return value;
-                                              }
-                                          }});
+            for (auto& ec : curEngineCountList) {
+                for (auto& ecByType : ec.engineCountList) {
+                    if (ecByType.engineType != config.engineType)
+                        continue;
+
+                    std::string tileInfo = "";
+                    if (needAggFromTiles) {
+                        tileInfo = std::to_string(ec.tileId) + "/";
+                    }
+                    int32_t slotTileId = needAggFromTiles ? ec.tileId : -1;
+                    for (int engineIdx = 0; engineIdx < ecByType.count; engineIdx++) {
+                        std::string header = engineNameMap[config.engineType] + " " + tileInfo + std::to_string(engineIdx) + " (%)";
+                        auto key = std::make_tuple((int)ecByType.engineType, slotTileId, (uint64_t)engineIdx);
+                        auto it = engineSlots.find(key);
+                        if (it == engineSlots.end()) {
+                            it = engineSlots.emplace(key, (uint32_t)engineSlots.size()).first;
+                        }
+                        columnList.push_back({header, DUMP_COLUMN_ENGINE, it->second, (uint32_t)config.scale});
+                    }
                 }
             }
-            }
         } else if (config.optionType == xpum::dump::DUMP_OPTION_FABRIC && pFabricCountList) {
             for (auto& fc : *pFabricCountList) {
-                std::stringstream ss;
-                std::string key;
-                std::string header;
+                std::string local = std::to_string(deviceId) + "/" + std::to_string(fc.tile_id);
+                std::string remote = std::to_string(fc.remote_device_id) + "/" + std::to_string(fc.remote_tile_id);
                 // tx
-                ss << deviceId << "/" << fc.tile_id;
-                ss << "->" << fc.remote_device_id << "/" << fc.remote_tile_id;
-                key = ss.str();
-                header = "XL " + key + " (kB/s)";
-                columnList.push_back({header,
-                                      [config, key, p_this]() {
-                                          auto& m = p_this->fabricRawDataMap;
-                                          auto it = m.find(key);
-                                          std::string value;
-                                          if (it == m.end()) {
-                                              return value;
-                                          }
-                                          auto& data = it->second;
-                                          return getScaledValue(data.value, data.scale * config.scale * 1000); // kB
-                                      }});
+                auto key = std::make_tuple((int)XPUM_FABRIC_THROUGHPUT_TYPE_TRANSMITTED, fc.tile_id, fc.remote_device_id, fc.remote_tile_id);
+                auto it = fabricSlots.emplace(key, (uint32_t)fabricSlots.size()).first;
+                columnList.push_back({"XL " + local + "->" + remote + " (kB/s)", DUMP_COLUMN_FABRIC, it->second, (uint32_t)config.scale * 1000}); // kB
                 // rx
-                ss.str("");
-                ss << fc.remote_device_id << "/" << fc.remote_tile_id;
-                ss << "->";
-                ss << deviceId << "/" << fc.tile_id;
-                key = ss.str();
-                header = "XL " + key + " (kB/s)";
-                columnList.push_back({header,
-                                      [config, key, p_this]() {
-                                          auto& m = p_this->fabricRawDataMap;
-                                          auto it = m.find(key);
-                                          std::string value;
-                                          if (it == m.end()) {
-                                              return value;
-                                          }
-                                          auto& data = it->second;
-                                          return getScaledValue(data.value, data.scale * config.scale * 1000); // kB
-                                      }});
+                key = std::make_tuple((int)XPUM_FABRIC_THROUGHPUT_TYPE_RECEIVED, fc.tile_id, fc.remote_device_id, fc.remote_tile_id);
+                it = fabricSlots.emplace(key, (uint32_t)fabricSlots.size()).first;
+                columnList.push_back({"XL " + remote + "->" + local + " (kB/s)", DUMP_COLUMN_FABRIC, it->second, (uint32_t)config.scale * 1000}); // kB
             }
         } else if (config.optionType == xpum::dump::DUMP_OPTION_THROTTLE_REASON) {
-            int columnIdx = columnList.size();
-            columnList.push_back({std::string(config.name),
-                                  [config, p_this, columnIdx]() {
-                                        DumpColumn& dc = p_this->columnList.at(columnIdx);
-                                        auto statsType = config.metricsType;
-                                        auto& m = p_this->rawDataMap;
-                                        auto it = m.find(statsType);
-                                        std::string value;
-                                        if (it != m.end()) {
-                                            auto data = it->second;
-                                            if (dc.lastTimestamp != data.timestamp) {
-                                                std::string ss;
-                                            if (data.value & xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_AVE_PWR_CAP) {
-                                                ss += "AVE_PWR_CAP | ";
-                                            }
-                                            if (data.value & xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_BURST_PWR_CAP) {
-                                                ss += "BURST_PWR_CAP | ";
-                                            }
-                                            if (data.value & xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_CURRENT_LIMIT) {
-                                                ss += "CURRENT_LIMIT | ";
-                                            }
-                                            if (data.value & xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_THERMAL_LIMIT) {
-                                                ss += "THERMAL_LIMIT | ";
-                                            }
-                                            if (data.value & xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_PSU_ALERT) {
-                                                ss += "PSU_ALERT | ";
-                                            }
-                                            if (data.value & xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_SW_RANGE) {
-                                                ss += "SW_RANGE | ";
-                                            }
-                                            if (data.value & xpum::dump::ZES_FREQ_THROTTLE_REASON_FLAG_HW_RANGE) {
-                                                ss += "HW_RANGE | ";
-                                            }
-                                            if (ss.size() == 0) {
-                                                ss += "Not Throttled | ";
-                                            }
-                                            return ss.substr(0, ss.size() - 3);
-                                          }
-                                          dc.lastTimestamp = data.timestamp;
-                                      }
-                                      return value;
-                                  }});
+            columnList.push_back({config.name, DUMP_COLUMN_THROTTLE_REASON, (uint32_t)config.metricsType});
         }
     }
+
+    statsSamples.assign(XPUM_STATS_MAX, DumpSample());
+    engineSamples.assign(engineSlots.size(), DumpSample());
+    fabricSamples.assign(fabricSlots.size(), DumpSample());
+    tileSamples.assign(XPUM_STATS_MAX, DumpSample());
+    tileSampleCount.assign(XPUM_STATS_MAX, 0);
 }
 
 void DumpRawDataTask::updateData() {
-    auto p_this = shared_from_this();
-    auto p_data_logic = p_this->p_data_logic;
-
     // get raw data
     int metricsCount = 0;
-    p_data_logic->getLatestMetrics(p_this->deviceId, nullptr, &metricsCount);
-    std::vector<xpum_device_metrics_t> deviceMetricsList(metricsCount);
-    p_data_logic->getLatestMetrics(p_this->deviceId, deviceMetricsList.data(), &metricsCount);
+    p_data_logic->getLatestMetrics(deviceId, nullptr, &metricsCount);
+    metricsBuffer.resize(metricsCount);
+    p_data_logic->getLatestMetrics(deviceId, metricsBuffer.data(), &metricsCount);
+    metricsBuffer.resize(metricsCount);
 
-    rawDataMap.clear();
-
-    std::map<xpum_stats_type_t, xpum_device_metric_data_t> rawDeviceDataMap;
-    std::map<xpum_device_tile_id_t, std::map<xpum_stats_type_t, xpum_device_metric_data_t>> rawTileDataMap;
-    std::map<xpum_stats_type_t, xpum_device_metric_data_t> aggregatedDeviceDataMap;
-
-    std::set<xpum_stats_type_enum> tiltMetricTypes;
-    std::set<xpum_stats_type_enum> deviceMetricTypes;
-    std::set<xpum_stats_type_enum> aggregatedMetricTypes;
+    for (auto& sample : statsSamples) {
+        sample.valid = false;
+    }
 
-    for (auto deviceMetrics : deviceMetricsList) {
-        if ((deviceMetrics.isTileData)) {
+    if (tileId != -1) {
+        for (auto& deviceMetrics : metricsBuffer) {
+            if (!deviceMetrics.isTileData || deviceMetrics.tileId != tileId) {
+                continue;
+            }
             for (int i = 0; i < deviceMetrics.count; i++) {
-                auto data = deviceMetrics.dataList[i];
-                rawTileDataMap[deviceMetrics.tileId][data.metricsType] = data;
-                tiltMetricTypes.insert(data.metricsType);
+                auto& data = deviceMetrics.dataList[i];
+                statsSamples[data.metricsType] = {true, data.value, data.scale, data.timestamp};
+            }
+        }
+    } else {
+        int32_t maxTileId = -1;
+        for (auto& deviceMetrics : metricsBuffer) {
+            if (deviceMetrics.isTileData) {
+                maxTileId = std::max(maxTileId, deviceMetrics.tileId);
+                continue;
             }
-        } else {
             for (int i = 0; i < deviceMetrics.count; i++) {
-                auto data = deviceMetrics.dataList[i];
-                rawDeviceDataMap[data.metricsType] = data;
-                deviceMetricTypes.insert(data.metricsType);
+                auto& data = deviceMetrics.dataList[i];
+                statsSamples[data.metricsType] = {true, data.value, data.scale, data.timestamp};
             }
         }
-    }
-
-    std::set_difference(tiltMetricTypes.begin(), tiltMetricTypes.end(),
-                        deviceMetricTypes.begin(), deviceMetricTypes.end(), std::inserter(aggregatedMetricTypes, aggregatedMetricTypes.begin()));
 
-    for (auto metric : aggregatedMetricTypes) {
-        int tileCount = 0;
-        for (auto tileMetrics : rawTileDataMap) {
-            auto tileAllMetrics = tileMetrics.second;
-            if (tileAllMetrics.count(metric)) {
-                if (tileCount == 0) {
-                    aggregatedDeviceDataMap[metric] = tileAllMetrics[metric];
-                } else {
-                    if(sumMetricsList.find(metric) != sumMetricsList.end()){
-                        if(aggregatedDeviceDataMap[metric].scale == 0){
-                            aggregatedDeviceDataMap[metric] = tileAllMetrics[metric];
+        // metrics only reported by tiles are aggregated to the device, in tile order
+        std::fill(tileSampleCount.begin(), tileSampleCount.end(), 0);
+        for (int32_t t = 0; t <= maxTileId; t++) {
+            for (auto& deviceMetrics : metricsBuffer) {
+                if (!deviceMetrics.isTileData || deviceMetrics.tileId != t) {
+                    continue;
+                }
+                for (int i = 0; i < deviceMetrics.count; i++) {
+                    auto& data = deviceMetrics.dataList[i];
+                    auto metric = data.metricsType;
+                    if (statsSamples[metric].valid) {
+                        continue;
+                    }
+                    auto& agg = tileSamples[metric];
+                    int& tileCount = tileSampleCount[metric];
+                    if (tileCount == 0) {
+                        agg = {true, data.value, data.scale, data.timestamp};
+                    } else if (sumMetricsList.find(metric) != sumMetricsList.end()) {
+                        if (agg.scale == 0) {
+                            agg = {true, data.value, data.scale, data.timestamp};
                         } else {
-                            aggregatedDeviceDataMap[metric].value +=
-                            (tileAllMetrics[metric].value * tileAllMetrics[metric].scale / aggregatedDeviceDataMap[metric].scale);
+                            agg.value += data.value * data.scale / agg.scale;
                         }
                     } else {
-                        if(aggregatedDeviceDataMap[metric].scale == 0){
-                            if(tileAllMetrics[metric].scale != 0){
-                                aggregatedDeviceDataMap[metric] = tileAllMetrics[metric];
-                                auto doubleNumber = aggregatedDeviceDataMap[metric].value/ (double) (1 + tileCount);
-                                aggregatedDeviceDataMap[metric].value = round(doubleNumber * 100) / 100;
+                        if (agg.scale == 0) {
+                            if (data.scale != 0) {
+                                agg = {true, data.value, data.scale, data.timestamp};
+                                agg.value = round(agg.value / (double)(1 + tileCount) * 100) / 100;
                             }
                         } else {
-                            auto doubleNumber = (aggregatedDeviceDataMap[metric].value * aggregatedDeviceDataMap[metric].scale * tileCount +
-                            tileAllMetrics[metric].value * tileAllMetrics[metric].scale / (double) (1 + tileCount)) / aggregatedDeviceDataMap[metric].scale;
-                            aggregatedDeviceDataMap[metric].value = round(doubleNumber * 100) / 100;
+                            auto doubleNumber = (agg.value * (double)agg.scale * tileCount + data.value * (double)data.scale) / (1 + tileCount) / agg.scale;
+                            agg.value = round(doubleNumber * 100) / 100;
                         }
                     }
+                    tileCount += 1;
                 }
-                tileCount += 1;
             }
         }
-    }
-
-    if(p_this->tileId == -1){
-        rawDataMap.insert(rawDeviceDataMap.begin(), rawDeviceDataMap.end());
-        rawDataMap.insert(aggregatedDeviceDataMap.begin(), aggregatedDeviceDataMap.end());
-    } else {
-        if(rawTileDataMap.count(p_this->tileId)){
-            rawDataMap.insert(rawTileDataMap[p_this->tileId].begin(), rawTileDataMap[p_this->tileId].end());
+        for (std::size_t metric = 0; metric < statsSamples.size(); metric++) {
+            if (!statsSamples[metric].valid && tileSampleCount[metric] > 0) {
+                statsSamples[metric] = tileSamples[metric];
+            }
         }
     }
 
     // get engine raw data
-    engineUtilRawDataMap.clear();
-
-    uint32_t engineUtilRawDataSize = 0;
-
-    p_data_logic->getEngineUtilizations(p_this->deviceId, nullptr, &engineUtilRawDataSize);
-    std::vector<xpum_device_engine_metric_t> engineUtilRawDataList(engineUtilRawDataSize);
-    p_data_logic->getEngineUtilizations(p_this->deviceId, engineUtilRawDataList.data(), &engineUtilRawDataSize);
-    for (auto engineUtilRawData : engineUtilRawDataList) {
-        if ((p_this->tileId == -1) || (engineUtilRawData.isTileData && (p_this->tileId == engineUtilRawData.tileId))) {
-            auto engineType = engineUtilRawData.type;
-            auto it = engineUtilRawDataMap.find(engineType);
-            if (it == engineUtilRawDataMap.end()) {
-                engineUtilRawDataMap[engineType] = std::map<int, std::vector<xpum_device_engine_metric_t>>();
+    for (auto& sample : engineSamples) {
+        sample.valid = false;
+    }
+    if (!engineSlots.empty()) {
+        uint32_t engineUtilRawDataSize = 0;
+        p_data_logic->getEngineUtilizations(deviceId, nullptr, &engineUtilRawDataSize);
+        engineBuffer.resize(engineUtilRawDataSize);
+        p_data_logic->getEngineUtilizations(deviceId, engineBuffer.data(), &engineUtilRawDataSize);
+        engineBuffer.resize(engineUtilRawDataSize);
+        for (auto& data : engineBuffer) {
+            if ((tileId != -1) && !(data.isTileData && (tileId == data.tileId))) {
+                continue;
             }
-
-            auto it1 = engineUtilRawDataMap[engineType].find(engineUtilRawData.index);
-            if (it1 == engineUtilRawDataMap[engineType].end()){
-                engineUtilRawDataMap[engineType][engineUtilRawData.index] = std::vector<xpum_device_engine_metric_t>();
+            auto it = engineSlots.find(std::make_tuple((int)data.type, engineSlotsByTile ? data.tileId : -1, data.index));
+            if (it == engineSlots.end() || engineSamples[it->second].valid) {
+                continue;
             }
-            engineUtilRawDataMap[engineType][engineUtilRawData.index].push_back(engineUtilRawData);
+            engineSamples[it->second] = {true, data.value, data.scale, 0};
         }
     }
 
     // get fabric raw data
-    fabricRawDataMap.clear();
-
-    uint32_t fabricRawDataSize = 0;
-    p_data_logic->getFabricThroughput(p_this->deviceId, nullptr, &fabricRawDataSize);
-    std::vector<xpum_device_fabric_throughput_metric_t> fabricRawDataList(fabricRawDataSize);
-    p_data_logic->getFabricThroughput(p_this->deviceId, fabricRawDataList.data(), &fabricRawDataSize);
-
-    for (auto fabricRawData : fabricRawDataList) {
-        std::stringstream ss;
-        if (fabricRawData.type == XPUM_FABRIC_THROUGHPUT_TYPE_TRANSMITTED) {
-            ss << p_this->deviceId << "/" << fabricRawData.tile_id;
-            ss << "->";
-            ss << fabricRawData.remote_device_id << "/" << fabricRawData.remote_device_tile_id;
-        } else if (fabricRawData.type == XPUM_FABRIC_THROUGHPUT_TYPE_RECEIVED) {
-            ss << fabricRawData.remote_device_id << "/" << fabricRawData.remote_device_tile_id;
-            ss << "->";
-            ss << p_this->deviceId << "/" << fabricRawData.tile_id;
-        } else {
-            continue;
+    for (auto& sample : fabricSamples) {
+        sample.valid = false;
+    }
+    if (!fabricSlots.empty()) {
+        uint32_t fabricRawDataSize = 0;
+        p_data_logic->getFabricThroughput(deviceId, nullptr, &fabricRawDataSize);
+        fabricBuffer.resize(fabricRawDataSize);
+        p_data_logic->getFabricThroughput(deviceId, fabricBuffer.data(), &fabricRawDataSize);
+        fabricBuffer.resize(fabricRawDataSize);
+        for (auto& data : fabricBuffer) {
+            auto it = fabricSlots.find(std::make_tuple((int)data.type, data.tile_id, data.remote_device_id, data.remote_device_tile_id));
+            if (it != fabricSlots.end()) {
+                fabricSamples[it->second] = {true, data.value, data.scale, 0};
+            }
         }
-        std::string key = ss.str();
-        fabricRawDataMap[key] = fabricRawData;
     }
 }
 
+void DumpRawDataTask::writeRow() {
+    row.clear();
+    for (std::size_t i = 0; i < columnList.size(); i++) {
+        auto& dc = columnList[i];
+        if (i > 0) {
+            row += ',';
+        }
+        std::size_t len = row.size();
+        switch (dc.type) {
+            case DUMP_COLUMN_TIMESTAMP:
+                appendLocalTime(row, Utility::getCurrentMillisecond());
+                break;
+            case DUMP_COLUMN_DEVICE_ID:
+                appendUint(row, deviceId);
+                break;
+            case DUMP_COLUMN_TILE_ID:
+                appendUint(row, tileId);
+                break;
+            case DUMP_COLUMN_STATS: {
+                auto& sample = statsSamples[dc.slot];
+                // a value is only written once, until the next sample arrives
+                if (sample.valid && dc.lastTimestamp != sample.timestamp) {
+                    appendScaledValue(row, sample.value, (uint64_t)sample.scale * dc.scale);
+                }
+                if (sample.valid) {
+                    dc.lastTimestamp = sample.timestamp;
+                }
+                break;
+            }
+            case DUMP_COLUMN_ENGINE:
+            case DUMP_COLUMN_FABRIC: {
+                auto& sample = dc.type == DUMP_COLUMN_ENGINE ? engineSamples[dc.slot] : fabricSamples[dc.slot];
+                if (sample.valid) {
+                    appendScaledValue(row, sample.value, (uint64_t)sample.scale * dc.scale);
+                }
+                break;
+            }
+            case DUMP_COLUMN_THROTTLE_REASON: {
+                auto& sample = statsSamples[dc.slot];
+                if (sample.valid) {
+                    appendThrottleReason(row, sample.value);
+                }
+                break;
+            }
+        }
+        if (row.size() == len) {
+            row += "N/A";
+        }
+    }
+    row += '\n';
+    writeToFile(row);
+}
+
 void DumpRawDataTask::start() {
     // build columns
     buildColumns();
@@ -449,27 +430,20 @@ void DumpRawDataTask::start() {
     begin = time(nullptr) * 1000;
 
     // write to file with header
-    writeHeader();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        outfile.open(dumpFilePath.c_str(), std::ios::out | std::ios::app);
+        writeHeader();
+    }
 
     auto p_this = shared_from_this();
     lambda = [p_this]() {
-        // update data
-        p_this->updateData();
-
-        std::stringstream ss;
-
-        for (std::size_t i = 0; i < p_this->columnList.size(); i++) {
-            auto& dc = p_this->columnList[i];
-            auto value = dc.getValue();
-            if (value.empty())
-                value = "N/A";
-            ss << value;
-            if (i < p_this->columnList.size() - 1) {
-                ss << ",";
-            }
+        std::lock_guard<std::mutex> lock(p_this->mutex);
+        if (p_this->stopped) {
+            return;
         }
-
-        p_this->writeToFile(ss.str());
+        p_this->updateData();
+        p_this->writeRow();
     };
     // schedule task
     pThreadPoolTask = pThreadPool->scheduleAtFixedRate(0, Configuration::TELEMETRY_DATA_MONITOR_FREQUENCE, -1, lambda);
@@ -480,11 +454,21 @@ void DumpRawDataTask::stop() {
         pThreadPoolTask->cancel();
         pThreadPoolTask.reset();
     }
+    // a tick already running finishes its row before the file is closed
+    std::lock_guard<std::mutex> lock(mutex);
+    stopped = true;
+    if (outfile.is_open()) {
+        outfile.close();
+    }
 }
 
 void DumpRawDataTask::reschedule() {
-    // stop task first
-    stop();
+    // cancel task first, the dump file stays open and a tick of the
+    // cancelled task still running is serialized with the new ones
+    if (pThreadPoolTask != nullptr) {
+        pThreadPoolTask->cancel();
+        pThreadPoolTask.reset();
+    }
     // reschedule the task to refresh the dump interval
     pThreadPoolTask = pThreadPool->scheduleAtFixedRate(0, Configuration::TELEMETRY_DATA_MONITOR_FREQUENCE, -1, lambda);
 }
@@ -10,7 +10,9 @@
 #include <map>
 #include <set>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "data_logic/data_logic_interface.h"
@@ -19,18 +21,45 @@
 
 namespace xpum {
 
-typedef std::function<std::string()> getValueFunc;
+enum DumpColumnType {
+    DUMP_COLUMN_TIMESTAMP,
+    DUMP_COLUMN_DEVICE_ID,
+    DUMP_COLUMN_TILE_ID,
+    DUMP_COLUMN_STATS,
+    DUMP_COLUMN_ENGINE,
+    DUMP_COLUMN_FABRIC,
+    DUMP_COLUMN_THROTTLE_REASON,
+};
+
+/*
+  A column of the dump file, compiled once by buildColumns(). slot is the
+  index of the sample the column reads in the array matching its type and
+  scale is applied on top of the scale of the sample.
+*/
 
 struct DumpColumn {
     std::string header;
-    getValueFunc getValue;
+    DumpColumnType type;
+    uint32_t slot;
+    uint32_t scale;
     uint64_t lastTimestamp = 0;
 
     DumpColumn(
         std::string header,
-        getValueFunc getValue)
+        DumpColumnType type,
+        uint32_t slot = 0,
+        uint32_t scale = 1)
         : header(header),
-          getValue(getValue) {}
+          type(type),
+          slot(slot),
+          scale(scale) {}
+};
+
+struct DumpSample {
+    bool valid = false;
+    uint64_t value = 0;
+    uint32_t scale = 1;
+    uint64_t timestamp = 0;
 };
 
 class DumpRawDataTask : public std::enable_shared_from_this<DumpRawDataTask> {
@@ -52,9 +81,30 @@ class DumpRawDataTask : public std::enable_shared_from_this<DumpRawDataTask> {
 
     std::vector<DumpColumn> columnList;
 
-    std::map<xpum_stats_type_t, xpum_device_metric_data_t> rawDataMap;
-    std::map<xpum_engine_type_t, std::map<int, std::vector<xpum_device_engine_metric_t>>> engineUtilRawDataMap;
-    std::map<std::string, xpum_device_fabric_throughput_metric_t> fabricRawDataMap;
+    // latest samples, refreshed in place on every tick
+    std::vector<DumpSample> statsSamples;
+    std::vector<DumpSample> engineSamples;
+    std::vector<DumpSample> fabricSamples;
+
+    // (engine type, tile id, engine index) -> engine sample slot
+    std::map<std::tuple<int, int32_t, uint64_t>, uint32_t> engineSlots;
+    // (throughput type, tile id, remote device id, remote tile id) -> fabric sample slot
+    std::map<std::tuple<int, uint32_t, uint32_t, uint32_t>, uint32_t> fabricSlots;
+    bool engineSlotsByTile = false;
+
+    // buffers reused between ticks
+    std::vector<xpum_device_metrics_t> metricsBuffer;
+    std::vector<xpum_device_engine_metric_t> engineBuffer;
+    std::vector<xpum_device_fabric_throughput_metric_t> fabricBuffer;
+    std::vector<DumpSample> tileSamples;
+    std::vector<int> tileSampleCount;
+    std::string row;
+
+    // held by the ticks and by stop(), so a tick of a cancelled or
+    // rescheduled task never runs along another one or after stop()
+    std::mutex mutex;
+    bool stopped = false;
+    std::ofstream outfile;
 
     std::set<xpum_stats_type_t> sumMetricsList{ XPUM_STATS_MEMORY_READ,
                                                         XPUM_STATS_MEMORY_WRITE,
@@ -92,12 +142,15 @@ class DumpRawDataTask : public std::enable_shared_from_this<DumpRawDataTask> {
 
     void fillTaskInfoBuffer(xpum_dump_raw_data_task_t *taskInfo);
 
-    void writeToFile(std::string text);
+    // the mutex must be held, nothing is written once the task is stopped
+    void writeToFile(const std::string& text);
 
     void writeHeader();
 
     void buildColumns();
 
     void updateData();
+
+    void writeRow();
 };
 } // namespace xpum
\ No newline at end of file
@@ -0,0 +1,196 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file event_bus.cpp
+ */
+
+#include "event_bus.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "infrastructure/logger.h"
+
+namespace xpum {
+
+static bool matchThreshold(EventThresholdType threshold_type, uint64_t threshold, uint64_t value, uint64_t scale) {
+    if (value == std::numeric_limits<uint64_t>::max()) {
+        return false;
+    }
+    value = scale > 1 ? value / scale : value;
+    if (threshold_type == EVENT_THRESHOLD_GREATER) {
+        return value > threshold;
+    }
+    return value < threshold;
+}
+
+bool EventFilter::match(const MeasurementEvent& event) const {
+    if (!types.empty() && types.find(event.type) == types.end()) {
+        return false;
+    }
+    if (!device_ids.empty() && device_ids.find(event.device_id) == device_ids.end()) {
+        return false;
+    }
+    if (threshold_type == EVENT_THRESHOLD_NONE) {
+        return true;
+    }
+
+    auto p_data = event.p_data;
+    uint64_t scale = p_data->getScale();
+    if (p_data->hasDataOnDevice() && matchThreshold(threshold_type, threshold, p_data->getCurrent(), scale)) {
+        return true;
+    }
+    for (auto& sub : *p_data->getSubdeviceDatas()) {
+        if (matchThreshold(threshold_type, threshold, sub.second.current, scale)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+EventBus::EventBus(uint32_t queue_capacity, uint32_t batch_size)
+    : queue_capacity(queue_capacity > 0 ? queue_capacity : 1),
+      batch_size(batch_size > 0 ? batch_size : 1),
+      next_subscription_id(0),
+      subscriber_count(0),
+      stop(true),
+      dispatching(false),
+      dispatching_id(0) {
+    XPUM_LOG_TRACE("EventBus()");
+}
+
+EventBus::~EventBus() {
+    close();
+    XPUM_LOG_TRACE("~EventBus()");
+}
+
+void EventBus::init() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!stop) {
+        return;
+    }
+    stop = false;
+    dispatcher = std::thread(&EventBus::dispatch, this);
+}
+
+void EventBus::close() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (stop) {
+        return;
+    }
+    stop = true;
+    cv.notify_all();
+    lock.unlock();
+
+    if (dispatcher.joinable()) {
+        dispatcher.join();
+    }
+}
+
+uint32_t EventBus::subscribe(const EventFilter& filter, EventCallback_t callback) {
+    auto p_subscription = std::make_shared<Subscription>();
+    p_subscription->filter = filter;
+    p_subscription->callback = callback;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    p_subscription->id = next_subscription_id++;
+    subscriptions[p_subscription->id] = p_subscription;
+    subscriber_count = subscriptions.size();
+    return p_subscription->id;
+}
+
+void EventBus::unsubscribe(uint32_t subscription_id) {
+    std::unique_lock<std::mutex> lock(mutex);
+    subscriptions.erase(subscription_id);
+    subscriber_count = subscriptions.size();
+    // the callback may be running with a batch taken before the erase
+    if (std::this_thread::get_id() != dispatcher.get_id()) {
+        dispatch_done.wait(lock, [this, subscription_id] { return !dispatching || dispatching_id != subscription_id; });
+    }
+}
+
+void EventBus::publish(MeasurementType type,
+                       Timestamp_t time,
+                       const std::map<std::string, std::shared_ptr<MeasurementData>>& datas) noexcept {
+    if (subscriber_count == 0 || stop) {
+        return;
+    }
+
+    bool notify = false;
+    std::unique_lock<std::mutex> lock(mutex);
+    for (auto& data : datas) {
+        if (data.second == nullptr) {
+            continue;
+        }
+        MeasurementEvent event{type, time, data.first, data.second};
+        for (auto& subscription : subscriptions) {
+            auto& p_subscription = subscription.second;
+            if (!p_subscription->filter.match(event)) {
+                continue;
+            }
+            if (p_subscription->queue.size() >= queue_capacity) {
+                p_subscription->queue.pop_front();
+                p_subscription->dropped++;
+            }
+            p_subscription->queue.push_back(event);
+            notify = true;
+        }
+    }
+    lock.unlock();
+
+    if (notify) {
+        cv.notify_one();
+    }
+}
+
+void EventBus::dispatch() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stop) {
+        std::vector<std::shared_ptr<Subscription>> ready;
+        for (auto& subscription : subscriptions) {
+            if (!subscription.second->queue.empty()) {
+                ready.push_back(subscription.second);
+            }
+        }
+        if (ready.empty()) {
+            cv.wait(lock);
+            continue;
+        }
+
+        for (auto& p_subscription : ready) {
+            // unsubscribed while the previous callbacks ran
+            if (subscriptions.find(p_subscription->id) == subscriptions.end()) {
+                continue;
+            }
+            std::vector<MeasurementEvent> batch;
+            uint32_t n = std::min<size_t>(batch_size, p_subscription->queue.size());
+            batch.reserve(n);
+            for (uint32_t i = 0; i < n; i++) {
+                batch.push_back(std::move(p_subscription->queue.front()));
+                p_subscription->queue.pop_front();
+            }
+            uint64_t dropped = p_subscription->dropped;
+            p_subscription->dropped = 0;
+            dispatching = true;
+            dispatching_id = p_subscription->id;
+            lock.unlock();
+
+            try {
+                p_subscription->callback(batch, dropped);
+            } catch (std::exception& e) {
+                XPUM_LOG_WARN("event subscriber {} failed: {}", p_subscription->id, e.what());
+            } catch (...) {
+                XPUM_LOG_WARN("event subscriber {} failed: unexpected exception", p_subscription->id);
+            }
+
+            lock.lock();
+            dispatching = false;
+            dispatch_done.notify_all();
+            if (stop) {
+                break;
+            }
+        }
+    }
+}
+
+} // end namespace xpum
@@ -0,0 +1,139 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file event_bus.h
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "infrastructure/const.h"
+#include "infrastructure/init_close_interface.h"
+#include "infrastructure/measurement_data.h"
+#include "infrastructure/measurement_type.h"
+
+namespace xpum {
+
+enum EventThresholdType {
+    EVENT_THRESHOLD_NONE = 0,
+    EVENT_THRESHOLD_GREATER,
+    EVENT_THRESHOLD_LESS,
+};
+
+/*
+  A measurement sample of one device as it was stored into the data logic.
+*/
+
+struct MeasurementEvent {
+    MeasurementType type;
+    Timestamp_t time;
+    std::string device_id;
+    std::shared_ptr<MeasurementData> p_data;
+};
+
+/*
+  Selects the events a subscriber is interested in. Empty device_ids or
+  types mean "all". The threshold is applied on current / scale of the
+  device level value or of any subdevice value.
+*/
+
+struct EventFilter {
+    std::set<std::string> device_ids;
+    std::set<MeasurementType> types;
+    EventThresholdType threshold_type = EVENT_THRESHOLD_NONE;
+    uint64_t threshold = 0;
+
+    bool match(const MeasurementEvent& event) const;
+};
+
+/*
+  Called on the dispatcher thread with a batch of events. dropped is the
+  number of events discarded for this subscriber since the previous batch
+  because its queue was full.
+*/
+
+typedef std::function<void(std::vector<MeasurementEvent>& events, uint64_t dropped)> EventCallback_t;
+
+/*
+  EventBus pushes measurement updates to subscribers instead of letting
+  them poll the data logic. Publishing never blocks the sampling threads:
+  each subscriber owns a bounded queue and the oldest events are dropped when
+  the subscriber cannot keep up. Callbacks run on a single dispatcher
+  thread, so a subscriber never receives a new batch before its previous
+  callback returned.
+*/
+
+class EventBus : public InitCloseInterface {
+   public:
+    EventBus(uint32_t queue_capacity, uint32_t batch_size);
+
+    virtual ~EventBus();
+
+    void init() override;
+
+    void close() override;
+
+    uint32_t subscribe(const EventFilter& filter, EventCallback_t callback);
+
+    // once it returns the callback of the subscription is not running and is
+    // not called anymore, unless it is called from that callback
+    void unsubscribe(uint32_t subscription_id);
+
+    void publish(MeasurementType type,
+                 Timestamp_t time,
+                 const std::map<std::string, std::shared_ptr<MeasurementData>>& datas) noexcept;
+
+    bool hasSubscribers() const noexcept {
+        return subscriber_count > 0;
+    }
+
+   private:
+    struct Subscription {
+        uint32_t id;
+        EventFilter filter;
+        EventCallback_t callback;
+        std::deque<MeasurementEvent> queue;
+        uint64_t dropped = 0;
+    };
+
+    void dispatch();
+
+   private:
+    uint32_t queue_capacity;
+
+    uint32_t batch_size;
+
+    uint32_t next_subscription_id;
+
+    std::map<uint32_t, std::shared_ptr<Subscription>> subscriptions;
+
+    std::atomic<uint32_t> subscriber_count;
+
+    std::atomic<bool> stop;
+
+    std::thread dispatcher;
+
+    std::mutex mutex;
+
+    std::condition_variable cv;
+
+    // the subscription whose callback is running, if dispatching
+    bool dispatching;
+
+    uint32_t dispatching_id;
+
+    std::condition_variable dispatch_done;
+};
+
+} // end namespace xpum
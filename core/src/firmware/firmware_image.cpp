@@ -0,0 +1,51 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file firmware_image.cpp
+ */
+
+#include "firmware_image.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "infrastructure/logger.h"
+
+namespace xpum {
+
+FirmwareImagePtr FirmwareImage::open(const std::string& file_path) {
+    std::shared_ptr<FirmwareImage> image(new FirmwareImage());
+    int fd = ::open(file_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return image;
+    }
+    struct stat s;
+    if (fstat(fd, &s) != 0 || !S_ISREG(s.st_mode) || s.st_size == 0) {
+        close(fd);
+        return image;
+    }
+    std::vector<uint8_t> content(s.st_size);
+    std::size_t offset = 0;
+    while (offset < content.size()) {
+        ssize_t len = read(fd, content.data() + offset, content.size() - offset);
+        if (len < 0 && errno == EINTR) {
+            continue;
+        }
+        if (len <= 0) {
+            break;
+        }
+        offset += len;
+    }
+    close(fd);
+    if (offset != content.size()) {
+        // truncated while being read
+        XPUM_LOG_ERROR("Failed to read firmware image {}", file_path);
+        return image;
+    }
+    image->content.swap(content);
+    return image;
+}
+
+} // namespace xpum
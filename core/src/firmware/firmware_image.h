@@ -0,0 +1,56 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file firmware_image.h
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace xpum {
+
+/*
+  A firmware image file read into memory once. The content is shared by all
+  the devices flashed with the image and by their flash tasks, which keep a
+  FirmwareImagePtr instead of a copy, so flashing a whole node costs one
+  image worth of memory whatever the number of devices. The file is read
+  rather than mapped, so a file truncated or rewritten during the flash does
+  not affect it.
+
+  An image that is not a regular file or cannot be read is empty.
+*/
+
+class FirmwareImage {
+   public:
+    static std::shared_ptr<const FirmwareImage> open(const std::string& file_path);
+
+    const uint8_t* data() const {
+        return content.data();
+    }
+
+    std::size_t size() const {
+        return content.size();
+    }
+
+    bool empty() const {
+        return content.empty();
+    }
+
+   private:
+    FirmwareImage() = default;
+
+    FirmwareImage(const FirmwareImage&) = delete;
+
+    FirmwareImage& operator=(const FirmwareImage&) = delete;
+
+    std::vector<uint8_t> content;
+};
+
+typedef std::shared_ptr<const FirmwareImage> FirmwareImagePtr;
+
+} // namespace xpum
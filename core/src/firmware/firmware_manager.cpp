@@ -180,8 +180,8 @@ xpum_result_t FirmwareManager::runAMCFirmwareFlash(const char* filePath, AmcCred
 
     std::vector<std::shared_ptr<Device>> allDevices;
     Core::instance().getDeviceManager()->getDeviceList(allDevices);
-    // lock all devices
-    bool locked = Core::instance().getDeviceManager()->tryLockDevices(allDevices);
+    // lock all devices against the other operations, the telemetry goes on
+    bool locked = Core::instance().getDeviceManager()->lockDevices(allDevices, DEVICE_OPERATION_AMC_FIRMWARE_FLASH);
     if (!locked) {
         flashFwErrMsg = "Device is busy";
         return xpum_result_t::XPUM_UPDATE_FIRMWARE_TASK_RUNNING;
@@ -228,10 +228,10 @@ std::string FirmwareManager::getAmcWarnMsg() {
     return getRedfishAmcWarn();
 }
 
-static bool isGscFwImage(std::vector<char>& buffer) {
+static bool isGscFwImage(const FirmwareImage& image) {
     uint8_t type;
     int ret;
-    ret = igsc_image_get_type((const uint8_t*)buffer.data(), buffer.size(), &type);
+    ret = igsc_image_get_type(image.data(), image.size(), &type);
     if (ret != IGSC_SUCCESS)
     {
         return false;
@@ -239,7 +239,7 @@ static bool isGscFwImage(std::vector<char>& buffer) {
     return type == IGSC_IMAGE_TYPE_GFX_FW;
 }
 
-xpum_result_t FirmwareManager::atsmHwConfigCompatibleCheck(std::string meiPath, std::vector<char>& buffer) {
+xpum_result_t FirmwareManager::atsmHwConfigCompatibleCheck(std::string meiPath, const FirmwareImage& image) {
     struct igsc_hw_config img_hw_config, dev_hw_config;
     int ret;
 
@@ -254,7 +254,7 @@ xpum_result_t FirmwareManager::atsmHwConfigCompatibleCheck(std::string meiPath,
     }
 
     // image hw config
-    ret = igsc_image_hw_config((const uint8_t*)buffer.data(), buffer.size(), &img_hw_config);
+    ret = igsc_image_hw_config(image.data(), image.size(), &img_hw_config);
     if (ret != IGSC_SUCCESS) {
         flashFwErrMsg = "Fail to parse image hardware config. " + print_device_fw_status(&handle);
         (void)igsc_device_close(&handle);
@@ -275,7 +275,7 @@ xpum_result_t FirmwareManager::atsmHwConfigCompatibleCheck(std::string meiPath,
     return ret == IGSC_SUCCESS ? XPUM_OK : XPUM_UPDATE_FIRMWARE_FW_IMAGE_NOT_COMPATIBLE_WITH_DEVICE;
 }
 
-xpum_result_t FirmwareManager::isPVCFwImageAndDeviceCompatible(std::string meiPath, std::vector<char>& buffer) {
+xpum_result_t FirmwareManager::isPVCFwImageAndDeviceCompatible(std::string meiPath, const FirmwareImage& image) {
     struct igsc_fw_version img_fw_version, dev_fw_version;
     int ret;
 
@@ -290,7 +290,7 @@ xpum_result_t FirmwareManager::isPVCFwImageAndDeviceCompatible(std::string meiPa
     }
 
     // image fw version
-    ret = igsc_image_fw_version((const uint8_t*)buffer.data(), buffer.size(), &img_fw_version);
+    ret = igsc_image_fw_version(image.data(), image.size(), &img_fw_version);
     if (ret != IGSC_SUCCESS) {
         flashFwErrMsg = "Fail to parse image firmware version. " + print_device_fw_status(&handle);
         (void)igsc_device_close(&handle);
@@ -314,45 +314,11 @@ xpum_result_t FirmwareManager::isPVCFwImageAndDeviceCompatible(std::string meiPa
     }
 }
 
-std::vector<char> readImageContent(const char* filePath) {
-    struct stat s;
-    if (stat(filePath, &s) != 0 || !(s.st_mode & S_IFREG))
-        return std::vector<char>();
-    std::ifstream is(std::string(filePath), std::ifstream::binary);
-    if (!is) {
-        return std::vector<char>();
-    }
-    // get length of file:
-    is.seekg(0, is.end);
-    int length = is.tellg();
-    is.seekg(0, is.beg);
-
-    std::vector<char> buffer(length);
-
-    is.read(buffer.data(), length);
-    is.close();
-    return buffer;
-}
-
-static void progress_percentage_func(uint32_t done, uint32_t total, void* ctx) {
-    uint32_t percent = (done * 100) / total;
-    FirmwareManager *pFM = (FirmwareManager*) ctx;
-    pFM->gscFwFlashPercent.store(percent);
-}
-
-static void data_progress_percentage_func(uint32_t done, uint32_t total, void* ctx) {
-    uint32_t percent = (done * 100) / total;
-    FirmwareManager *pFM = (FirmwareManager*) ctx;
-    pFM->gscFwDataFlashPercent.store(percent);
-}
-
-
 xpum_result_t FirmwareManager::runGscOnlyFwFlash(const char* filePath, bool force) {
-    // read image file
-    auto img = readImageContent(filePath);
+    auto img = FirmwareImage::open(filePath);
 
     // validate the image file
-    if (!isGscFwImage(img)) {
+    if (!isGscFwImage(*img)) {
         return XPUM_UPDATE_FIRMWARE_INVALID_FW_IMAGE;
     }
 
@@ -366,15 +332,15 @@ xpum_result_t FirmwareManager::runGscOnlyFwFlash(const char* filePath, bool forc
         return xpum_result_t::XPUM_UPDATE_FIRMWARE_TASK_RUNNING;
     }
     flashFwErrMsg.clear();
-    gscFwFlashPercent.store(0);
-    gscFwFlashTotalPercent.store(0);
-    taskGSC = std::async(std::launch::async, [this, img, devices, force] {
-        for (auto &device : devices) {
+    auto scheduler = std::make_shared<FlashScheduler>(devices.size());
+    gscFwFlashScheduler = scheduler;
+    taskGSC = std::async(std::launch::async, [this, img, devices, force, scheduler] {
+        bool ok = scheduler->run([&](std::size_t index, void* progress, std::string& errMsg) {
+            auto& device = devices[index];
             XPUM_LOG_INFO("Start update GSC fw on device {}", 
                 device.meiDevicePath);
             struct igsc_device_handle handle;
             struct igsc_fw_version device_fw_version;
-            igsc_progress_func_t progress_func = progress_percentage_func;
             int ret = 0;
             struct igsc_fw_update_flags flags = {0};
             flags.force_update = force;
@@ -384,19 +350,19 @@ xpum_result_t FirmwareManager::runGscOnlyFwFlash(const char* filePath, bool forc
                 device.meiDevicePath.c_str()); 
 
             if (ret) {
-                flashFwErrMsg = "Cannot initialize device: " + device.meiDevicePath;
+                errMsg = "Cannot initialize device: " + device.meiDevicePath;
                 XPUM_LOG_ERROR("Cannot initialize device: {}", device.meiDevicePath);
                 (void)igsc_device_close(&handle);
-                return XPUM_DEVICE_FIRMWARE_FLASH_ERROR;
+                return false;
             }
 
-            ret = igsc_device_fw_update_ex(&handle, (const uint8_t*)img.data(), 
-                img.size(), progress_func, this, flags);
+            ret = igsc_device_fw_update_ex(&handle, img->data(), 
+                img->size(), FlashScheduler::progress, progress, flags);
             if (ret) {
-                flashFwErrMsg = "Update process failed. " + print_device_fw_status(&handle);
-                XPUM_LOG_ERROR("Update process failed. {}", print_device_fw_status(&handle));
+                errMsg = "Update process failed on device " + device.meiDevicePath + ". " + print_device_fw_status(&handle);
+                XPUM_LOG_ERROR("Update process failed on device {}. {}", device.meiDevicePath, print_device_fw_status(&handle));
                 (void)igsc_device_close(&handle);
-                return XPUM_DEVICE_FIRMWARE_FLASH_ERROR;
+                return false;
             }
 
             // get new fw version
@@ -410,15 +376,12 @@ xpum_result_t FirmwareManager::runGscOnlyFwFlash(const char* filePath, bool forc
             }
 
             (void)igsc_device_close(&handle);
-            uint32_t totalPercent = this->gscFwFlashPercent.load() +
-                                this->gscFwFlashTotalPercent.load();
-            {
-                std::lock_guard<std::mutex> lock(this->mtxPct);
-                this->gscFwFlashPercent.store(0);
-                this->gscFwFlashTotalPercent.store(totalPercent);
-            }
+            return true;
+        });
+        if (!ok) {
+            flashFwErrMsg = scheduler->errMsg();
+            return XPUM_DEVICE_FIRMWARE_FLASH_ERROR;
         }
-        
         return XPUM_DEVICE_FIRMWARE_FLASH_OK;
     });
 
@@ -428,18 +391,12 @@ xpum_result_t FirmwareManager::runGscOnlyFwFlash(const char* filePath, bool forc
 void FirmwareManager::getGscOnlyFwFlashResult(xpum_firmware_flash_task_result_t* result) {
     result->percentage = 0;
     result->type = XPUM_DEVICE_FIRMWARE_GFX;
-    auto devices = getPCIAddrAndMeiDevices();
-    std::size_t deviceNum = devices.size();
-    if (deviceNum == 0) {
+    std::lock_guard<std::mutex> lck(mtx);
+    if (gscFwFlashScheduler == nullptr) {
         result->result = XPUM_DEVICE_FIRMWARE_FLASH_ERROR;
         return;
     }
-    {
-        std::lock_guard<std::mutex> lock(mtxPct);
-        result->percentage = (gscFwFlashTotalPercent.load() + 
-            gscFwFlashPercent.load()) / deviceNum;
-    }
-    std::lock_guard<std::mutex> lck(mtx);
+    result->percentage = gscFwFlashScheduler->percent();
     if (taskGSC.valid() && taskGSC.wait_for(0ms) != std::future_status::ready) {
         result->result = XPUM_DEVICE_FIRMWARE_FLASH_ONGOING;
     } else {
@@ -453,11 +410,11 @@ xpum_result_t FirmwareManager::runGSCFirmwareFlash(xpum_device_id_t deviceId, co
     }
 
     flashFwErrMsg.clear();
-    // read image file
-    auto buffer = readImageContent(filePath);
+    // read the image file once, the content is shared by the flash tasks of all devices
+    auto img = FirmwareImage::open(filePath);
 
     // validate the image file
-    if (!isGscFwImage(buffer)) {
+    if (!isGscFwImage(*img)) {
         return XPUM_UPDATE_FIRMWARE_INVALID_FW_IMAGE;
     }
 
@@ -489,12 +446,12 @@ xpum_result_t FirmwareManager::runGSCFirmwareFlash(xpum_device_id_t deviceId, co
         // validate the image is compatible with the device
         if (device->getDeviceModel() == XPUM_DEVICE_MODEL_ATS_M_1 || device->getDeviceModel() == XPUM_DEVICE_MODEL_ATS_M_3 || device->getDeviceModel() == XPUM_DEVICE_MODEL_ATS_M_1C) {
             if (!force) {
-                auto res = atsmHwConfigCompatibleCheck(device->getMeiDevicePath(), buffer);
+                auto res = atsmHwConfigCompatibleCheck(device->getMeiDevicePath(), *img);
                 if (res != XPUM_OK)
                     return res;
             }
         } else {
-            auto res = isPVCFwImageAndDeviceCompatible(device->getMeiDevicePath(), buffer);
+            auto res = isPVCFwImageAndDeviceCompatible(device->getMeiDevicePath(), *img);
             if (res != XPUM_OK) {
                 return res;
             }
@@ -503,7 +460,7 @@ xpum_result_t FirmwareManager::runGSCFirmwareFlash(xpum_device_id_t deviceId, co
 
     xpum_result_t res = XPUM_GENERIC_ERROR;
 
-    bool locked = Core::instance().getDeviceManager()->tryLockDevices(deviceList);
+    bool locked = Core::instance().getDeviceManager()->lockDevices(deviceList, DEVICE_OPERATION_FIRMWARE_FLASH);
     if (!locked)
         return xpum_result_t::XPUM_UPDATE_FIRMWARE_TASK_RUNNING;
     // check is updating fw
@@ -519,7 +476,7 @@ xpum_result_t FirmwareManager::runGSCFirmwareFlash(xpum_device_id_t deviceId, co
     for (auto pd : deviceList) {
         if (!stop) {
             RunGSCFirmwareFlashParam param;
-            param.img = buffer;
+            param.img = img;
             param.force = force;
             res = pd->runFirmwareFlash(param);
             if (res != XPUM_OK) {
@@ -647,11 +604,10 @@ xpum_result_t FirmwareManager::runGscOnlyFwDataFlash(const char* filePath) {
     if (devices.size() == 0) {
         return XPUM_RESULT_DEVICE_NOT_FOUND;
     }
-    // read image file
-    auto buffer = readImageContent(filePath);
+    auto img = FirmwareImage::open(filePath);
     int ret = 0;
     uint8_t type = 0;
-    ret = igsc_image_get_type((const uint8_t*)buffer.data(), buffer.size(), 
+    ret = igsc_image_get_type(img->data(), img->size(), 
         &type);
     if (ret != IGSC_SUCCESS || type != IGSC_IMAGE_TYPE_FW_DATA) {
         return XPUM_UPDATE_FIRMWARE_INVALID_FW_IMAGE;
@@ -662,57 +618,56 @@ xpum_result_t FirmwareManager::runGscOnlyFwDataFlash(const char* filePath) {
         return xpum_result_t::XPUM_UPDATE_FIRMWARE_TASK_RUNNING;
     }
     flashFwErrMsg.clear();
-    gscFwDataFlashPercent.store(0);
-    gscFwDataFlashTotalPercent.store(0);
+    auto scheduler = std::make_shared<FlashScheduler>(devices.size());
+    gscFwDataFlashScheduler = scheduler;
+    std::string imagePath = filePath;
     taskGSCData = std::async(std::launch::async, 
-        [this, buffer, filePath, devices] {
-        for (auto &device : devices) {
-             XPUM_LOG_INFO("Start update GSC FW-DATA on device {}", 
+        [this, img, imagePath, devices, scheduler] {
+        bool ok = scheduler->run([&](std::size_t index, void* progress, std::string& errMsg) {
+            auto& device = devices[index];
+            XPUM_LOG_INFO("Start update GSC FW-DATA on device {}", 
                 device.meiDevicePath);
 
             struct igsc_device_handle handle;
             int ret = 0;
 
             struct igsc_fwdata_image* oimg = NULL;
-            igsc_progress_func_t progress_func = data_progress_percentage_func;
 
             memset(&handle, 0, sizeof(handle));
 
             ret = igsc_device_init_by_device(&handle, device.meiDevicePath.c_str());
             if (ret != IGSC_SUCCESS) {
-                flashFwErrMsg = "Cannot initialize device: " + device.meiDevicePath;
+                errMsg = "Cannot initialize device: " + device.meiDevicePath;
                 XPUM_LOG_ERROR("Cannot initialize device: {}", device.meiDevicePath);
                 igsc_device_close(&handle);
-                return XPUM_DEVICE_FIRMWARE_FLASH_ERROR;
+                return false;
             }
 
-            ret = igsc_image_fwdata_init(&oimg, (const uint8_t*)buffer.data(), buffer.size());
+            ret = igsc_image_fwdata_init(&oimg, img->data(), img->size());
             if (ret == IGSC_ERROR_BAD_IMAGE) {
-                flashFwErrMsg = "Invalid image format: " + std::string(filePath);
-                XPUM_LOG_ERROR("Invalid image format: {}", std::string(filePath));
+                errMsg = "Invalid image format: " + imagePath;
+                XPUM_LOG_ERROR("Invalid image format: {}", imagePath);
                 igsc_image_fwdata_release(oimg);
                 igsc_device_close(&handle);
-                return XPUM_DEVICE_FIRMWARE_FLASH_ERROR;
+                return false;
             }
 
-            ret = igsc_device_fwdata_image_update(&handle, oimg, progress_func, this);
+            ret = igsc_device_fwdata_image_update(&handle, oimg, FlashScheduler::progress, progress);
 
             if (ret) {
-                flashFwErrMsg = "GFX_DATA update failed. " + print_device_fw_status(&handle);
+                errMsg = "GFX_DATA update failed on device " + device.meiDevicePath + ". " + print_device_fw_status(&handle);
                 XPUM_LOG_ERROR("GFX_DATA update failed on device {}. {}", device.meiDevicePath, print_device_fw_status(&handle));
                 igsc_image_fwdata_release(oimg);
                 igsc_device_close(&handle);
-                return XPUM_DEVICE_FIRMWARE_FLASH_ERROR;
+                return false;
             }
             igsc_image_fwdata_release(oimg);
             igsc_device_close(&handle);
-            uint32_t totalPercent = this->gscFwDataFlashPercent.load() +
-                                    this->gscFwDataFlashTotalPercent.load();
-            {
-                std::lock_guard<std::mutex> lock(this->mtxPct);
-                this->gscFwDataFlashPercent.store(0);
-                this->gscFwDataFlashTotalPercent.store(totalPercent);
-            }
+            return true;
+        });
+        if (!ok) {
+            flashFwErrMsg = scheduler->errMsg();
+            return XPUM_DEVICE_FIRMWARE_FLASH_ERROR;
         }
         return XPUM_DEVICE_FIRMWARE_FLASH_OK;
     });
@@ -722,19 +677,12 @@ xpum_result_t FirmwareManager::runGscOnlyFwDataFlash(const char* filePath) {
 void FirmwareManager::getGscOnlyFwDataFlashResult(xpum_firmware_flash_task_result_t* result) {
     result->percentage = 0;
     result->type = XPUM_DEVICE_FIRMWARE_GFX_DATA;
-    auto devices = getPCIAddrAndMeiDevices();
-    std::size_t deviceNum = devices.size();
-    if (deviceNum == 0) {
+    std::lock_guard<std::mutex> lck(mtx);
+    if (gscFwDataFlashScheduler == nullptr) {
         result->result = XPUM_DEVICE_FIRMWARE_FLASH_ERROR;
         return;
     }
-    {
-        std::lock_guard<std::mutex> lock(mtxPct);
-        result->percentage = (gscFwDataFlashTotalPercent.load() + 
-            gscFwDataFlashPercent.load()) / deviceNum;
-    }
-
-    std::lock_guard<std::mutex> lck(mtx);
+    result->percentage = gscFwDataFlashScheduler->percent();
     if (taskGSCData.valid() && taskGSCData.wait_for(0ms) != std::future_status::ready) {
         result->result = XPUM_DEVICE_FIRMWARE_FLASH_ONGOING;
     } else {
@@ -774,7 +722,7 @@ xpum_result_t FirmwareManager::runFwDataFlash(xpum_device_id_t deviceId, const c
     xpum_result_t res = XPUM_GENERIC_ERROR;
 
     // check device is busy or not
-    bool locked = Core::instance().getDeviceManager()->tryLockDevices(deviceList);
+    bool locked = Core::instance().getDeviceManager()->lockDevices(deviceList, DEVICE_OPERATION_FIRMWARE_FLASH);
     if (!locked)
         return xpum_result_t::XPUM_UPDATE_FIRMWARE_TASK_RUNNING;
     // check is updating fw
@@ -785,12 +733,14 @@ xpum_result_t FirmwareManager::runFwDataFlash(xpum_device_id_t deviceId, const c
         }
     }
     // try to update
+    auto img = FirmwareImage::open(filePath);
     bool stop = false;
     std::vector<std::shared_ptr<Device>> toUnlock;
     for (auto pd : deviceList) {
         if (!stop) {
             FlashFwDataParam param;
             param.filePath = filePath;
+            param.img = img;
             res = pd->getFwDataMgmt()->flashFwData(param);
             if (res != XPUM_OK) {
                 flashFwErrMsg = param.errMsg;
@@ -941,13 +891,15 @@ xpum_result_t FirmwareManager::runPscFwFlash(xpum_device_id_t deviceId, const ch
         deviceList.push_back(pDevice);
     }
     xpum_result_t ret;
+    auto img = FirmwareImage::open(filePath);
     for (auto device : deviceList) {
-        bool locked = device->try_lock();
+        bool locked = device->getOperationLock().tryLockExclusive(DEVICE_OPERATION_FIRMWARE_FLASH);
         if (!locked)
             return xpum_result_t::XPUM_UPDATE_FIRMWARE_TASK_RUNNING;
         flashFwErrMsg.clear();
         FlashPscFwParam param;
         param.filePath = filePath;
+        param.img = img;
         param.force = force;
         auto pPscMgmt = device->getPscMgmt();
         if (!pPscMgmt) {
@@ -13,6 +13,8 @@
 
 #include "xpum_structs.h"
 #include "amc/amc_manager.h"
+#include "firmware_image.h"
+#include "flash_scheduler.h"
 
 namespace xpum {
 
@@ -37,7 +39,7 @@ enum GfxFwStatus {
 }
 
 struct RunGSCFirmwareFlashParam {
-    std::vector<char> img;
+    FirmwareImagePtr img;
     bool force;
     std::string errMsg;
 };
@@ -60,9 +62,9 @@ class FirmwareManager {
 
     bool initAmcManager();
 
-    xpum_result_t atsmHwConfigCompatibleCheck(std::string meiPath, std::vector<char>& buffer);
+    xpum_result_t atsmHwConfigCompatibleCheck(std::string meiPath, const FirmwareImage& image);
 
-    xpum_result_t isPVCFwImageAndDeviceCompatible(std::string meiPath, std::vector<char>& buffer);
+    xpum_result_t isPVCFwImageAndDeviceCompatible(std::string meiPath, const FirmwareImage& image);
 
     xpum_result_t runGscOnlyFwFlash(const char* filePath, bool force);
     void getGscOnlyFwFlashResult(xpum_firmware_flash_task_result_t* result);
@@ -72,6 +74,10 @@ class FirmwareManager {
     std::string amcFwErrMsg;
     std::string flashFwErrMsg;
 
+    // progress of the igsc only updates, guarded by mtx
+    std::shared_ptr<FlashScheduler> gscFwFlashScheduler;
+    std::shared_ptr<FlashScheduler> gscFwDataFlashScheduler;
+
 
    public:
     void init();
@@ -113,15 +119,7 @@ class FirmwareManager {
     xpum_result_t getAMCSerialNumbersByRiserSlot(uint8_t riser, uint8_t slot, std::string &serialNumber);
 
     void credentialCheckIfFail(AmcCredential credential, std::string& errMsg);
-
-    std::mutex mtxPct;
-    std::atomic<int> gscFwFlashPercent;
-    std::atomic<int> gscFwFlashTotalPercent;
-    std::atomic<int> gscFwDataFlashPercent;
-    std::atomic<int> gscFwDataFlashTotalPercent;
 };
 
-std::vector<char> readImageContent(const char* filePath);
-
 static const std::string igscPath{"igsc"};
 } // namespace xpum
\ No newline at end of file
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file flash_scheduler.cpp
+ */
+
+#include "flash_scheduler.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "infrastructure/configuration.h"
+
+namespace xpum {
+
+static std::mutex slot_mutex;
+
+static std::condition_variable slot_cv;
+
+static uint32_t slots_in_use = 0;
+
+FlashSlot::FlashSlot() {
+    std::unique_lock<std::mutex> lock(slot_mutex);
+    slot_cv.wait(lock, [] { return slots_in_use < std::max(1u, Configuration::FIRMWARE_FLASH_CONCURRENCY); });
+    slots_in_use++;
+}
+
+FlashSlot::~FlashSlot() {
+    {
+        std::lock_guard<std::mutex> lock(slot_mutex);
+        slots_in_use--;
+    }
+    slot_cv.notify_one();
+}
+
+FlashScheduler::FlashScheduler(std::size_t job_count) : err_msgs(job_count) {
+    for (std::size_t i = 0; i < job_count; i++) {
+        percents.emplace_back(new std::atomic<uint32_t>(0));
+    }
+}
+
+bool FlashScheduler::run(Job job) {
+    std::atomic<std::size_t> next(0);
+    std::atomic<bool> failed(false);
+    auto worker = [&] {
+        std::size_t index;
+        while (!failed.load() && (index = next++) < percents.size()) {
+            FlashSlot slot;
+            if (!job(index, percents[index].get(), err_msgs[index])) {
+                failed.store(true);
+            }
+        }
+    };
+    std::size_t worker_count = std::min<std::size_t>(percents.size(), std::max(1u, Configuration::FIRMWARE_FLASH_CONCURRENCY));
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < worker_count; i++) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : workers) {
+        t.join();
+    }
+    return !failed.load();
+}
+
+uint32_t FlashScheduler::percent() const {
+    if (percents.empty()) {
+        return 0;
+    }
+    uint32_t total = 0;
+    for (auto& p : percents) {
+        total += p->load();
+    }
+    return total / percents.size();
+}
+
+std::string FlashScheduler::errMsg() const {
+    std::string msg;
+    for (auto& err_msg : err_msgs) {
+        if (err_msg.empty()) {
+            continue;
+        }
+        if (!msg.empty()) {
+            msg += " ";
+        }
+        msg += err_msg;
+    }
+    return msg;
+}
+
+void FlashScheduler::progress(uint32_t done, uint32_t total, void* ctx) {
+    uint32_t percent = total > 0 ? (uint64_t)done * 100 / total : 0;
+    ((std::atomic<uint32_t>*)ctx)->store(std::min(percent, 100u));
+}
+
+} // namespace xpum
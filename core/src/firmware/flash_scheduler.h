@@ -0,0 +1,72 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file flash_scheduler.h
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace xpum {
+
+/*
+  Bounds the number of firmware updates talking to devices at the same time
+  to Configuration::FIRMWARE_FLASH_CONCURRENCY, whatever the firmware type
+  and whether the update was started for one device or for all of them. A
+  flash task holds a slot from the first igsc call on the device to the
+  last one.
+*/
+
+class FlashSlot {
+   public:
+    FlashSlot();
+
+    ~FlashSlot();
+
+   private:
+    FlashSlot(const FlashSlot&) = delete;
+
+    FlashSlot& operator=(const FlashSlot&) = delete;
+};
+
+/*
+  Flashes a list of devices in parallel, each job in a slot, and keeps the
+  progress of every device. When a job fails the jobs not started yet are
+  skipped, as they were when the devices were flashed one after another.
+*/
+
+class FlashScheduler {
+   public:
+    /*
+      Flashes device index, progress is passed as context of
+      FlashScheduler::progress to igsc. On failure the job returns false
+      and describes the error in err_msg.
+    */
+    typedef std::function<bool(std::size_t index, void* progress, std::string& err_msg)> Job;
+
+    explicit FlashScheduler(std::size_t job_count);
+
+    // runs the jobs and returns when all of them ended, true if all succeeded
+    bool run(Job job);
+
+    // average progress of the jobs in percent
+    uint32_t percent() const;
+
+    // error messages of the failed jobs
+    std::string errMsg() const;
+
+    static void progress(uint32_t done, uint32_t total, void* ctx);
+
+   private:
+    std::vector<std::unique_ptr<std::atomic<uint32_t>>> percents;
+
+    std::vector<std::string> err_msgs;
+};
+
+} // namespace xpum
@@ -116,10 +116,10 @@ bool removeDir(const char* dirPath){
     return success;
 }
 
-static bool validateImageFormat(std::vector<char>& buffer){
+static bool validateImageFormat(const FirmwareImage& image){
     uint8_t type;
     int ret;
-    ret = igsc_image_get_type((const uint8_t*)buffer.data(), buffer.size(), &type);
+    ret = igsc_image_get_type(image.data(), image.size(), &type);
     if (ret != IGSC_SUCCESS)
     {
         return false;
@@ -127,10 +127,10 @@ static bool validateImageFormat(std::vector<char>& buffer){
     return type == IGSC_IMAGE_TYPE_FW_DATA;
 }
 
-static bool isGscFwImage(std::vector<char>& buffer) {
+static bool isGscFwImage(const FirmwareImage& image) {
     uint8_t type;
     int ret;
-    ret = igsc_image_get_type((const uint8_t*)buffer.data(), buffer.size(), &type);
+    ret = igsc_image_get_type(image.data(), image.size(), &type);
     if (ret != IGSC_SUCCESS)
     {
         return false;
@@ -154,19 +154,19 @@ xpum_result_t FwCodeDataMgmt::flashFwCodeData(FlashFwCodeDataParam &param) {
             return XPUM_GENERIC_ERROR;
         }
         // read code image file
-        auto codeImageBuffer = readImageContent(codeImagePath.c_str());
+        auto codeImg = FirmwareImage::open(codeImagePath);
         // validate the code image file
-        if (!isGscFwImage(codeImageBuffer)) {
+        if (!isGscFwImage(*codeImg)) {
             return XPUM_UPDATE_FIRMWARE_INVALID_FW_IMAGE;
         }
 
         // read data image file
-        auto dataImg = readImageContent(dataImagePath.c_str());
-        if (!validateImageFormat(dataImg)) {
+        auto dataImg = FirmwareImage::open(dataImagePath);
+        if (!validateImageFormat(*dataImg)) {
             return XPUM_UPDATE_FIRMWARE_INVALID_FW_IMAGE;
         }
 
-        auto res = isFwDataImageAndDeviceCompatible(dataImg, devicePath);
+        auto res = isFwDataImageAndDeviceCompatible(*dataImg, devicePath);
         if (res == XPUM_OK) {
             XPUM_LOG_DEBUG("isNeedUpdateData");
             isNeedUpdateData = true;
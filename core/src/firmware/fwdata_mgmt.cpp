@@ -23,10 +23,10 @@ using namespace std::chrono_literals;
 
 static std::string print_fwdata_version(const struct igsc_fwdata_version *fwdata_version);
 
-static bool validateImageFormat(std::vector<char>& buffer){
+static bool validateImageFormat(const FirmwareImage& image){
     uint8_t type;
     int ret;
-    ret = igsc_image_get_type((const uint8_t*)buffer.data(), buffer.size(), &type);
+    ret = igsc_image_get_type(image.data(), image.size(), &type);
     if (ret != IGSC_SUCCESS)
     {
         return false;
@@ -34,12 +34,12 @@ static bool validateImageFormat(std::vector<char>& buffer){
     return type == IGSC_IMAGE_TYPE_FW_DATA;
 }
 
-xpum_result_t isFwDataImageAndDeviceCompatible(std::vector<char>& buffer, std::string devicePath) {
+xpum_result_t isFwDataImageAndDeviceCompatible(const FirmwareImage& image, std::string devicePath) {
     struct igsc_fwdata_image* oimg = NULL;
     int ret;
     // image
     struct igsc_fwdata_version img_version;
-    ret = igsc_image_fwdata_init(&oimg, (const uint8_t*)buffer.data(), buffer.size());
+    ret = igsc_image_fwdata_init(&oimg, image.data(), image.size());
     if (ret != IGSC_SUCCESS) {
         igsc_image_fwdata_release(oimg);
         return XPUM_UPDATE_FIRMWARE_INVALID_FW_IMAGE;
@@ -126,12 +126,12 @@ xpum_result_t FwDataMgmt::flashFwData(FlashFwDataParam &param) {
         // task already running
         return xpum_result_t::XPUM_UPDATE_FIRMWARE_TASK_RUNNING;
     } else {
-        auto buffer = readImageContent(filePath.c_str());
+        auto img = param.img;
 
-        if (!validateImageFormat(buffer)) {
+        if (!validateImageFormat(*img)) {
             return XPUM_UPDATE_FIRMWARE_INVALID_FW_IMAGE;
         }
-        auto res = isFwDataImageAndDeviceCompatible(buffer, devicePath);
+        auto res = isFwDataImageAndDeviceCompatible(*img, devicePath);
         if (res != XPUM_OK) {
             return res;
         }
@@ -139,7 +139,8 @@ xpum_result_t FwDataMgmt::flashFwData(FlashFwDataParam &param) {
         // init fw-data update progress
         percent.store(0);
 
-        taskFwData = std::async(std::launch::async, [this, buffer, filePath] {
+        taskFwData = std::async(std::launch::async, [this, img, filePath] {
+            FlashSlot slot;
             XPUM_LOG_INFO("Start update GSC FW-DATA on device {}", devicePath);
 
             struct igsc_device_handle handle;
@@ -156,17 +157,17 @@ xpum_result_t FwDataMgmt::flashFwData(FlashFwDataParam &param) {
                 flashFwErrMsg = "Cannot initialize device: " + devicePath;
                 XPUM_LOG_ERROR("Cannot initialize device: {}", devicePath);
                 igsc_device_close(&handle);
-                pDevice->unlock();
+                pDevice->getOperationLock().unlockExclusive();
                 return xpum_firmware_flash_result_t::XPUM_DEVICE_FIRMWARE_FLASH_ERROR;
             }
 
-            ret = igsc_image_fwdata_init(&oimg, (const uint8_t*)buffer.data(), buffer.size());
+            ret = igsc_image_fwdata_init(&oimg, img->data(), img->size());
             if (ret == IGSC_ERROR_BAD_IMAGE) {
                 flashFwErrMsg = "Invalid image format: " + filePath;
                 XPUM_LOG_ERROR("Invalid image format: {}", filePath);
                 igsc_image_fwdata_release(oimg);
                 igsc_device_close(&handle);
-                pDevice->unlock();
+                pDevice->getOperationLock().unlockExclusive();
                 return xpum_firmware_flash_result_t::XPUM_DEVICE_FIRMWARE_FLASH_ERROR;
             }
 
@@ -177,7 +178,7 @@ xpum_result_t FwDataMgmt::flashFwData(FlashFwDataParam &param) {
                 XPUM_LOG_ERROR("GFX_DATA update failed on device {}. {}", devicePath, print_device_fw_status(&handle));
                 igsc_image_fwdata_release(oimg);
                 igsc_device_close(&handle);
-                pDevice->unlock();
+                pDevice->getOperationLock().unlockExclusive();
                 return xpum_firmware_flash_result_t::XPUM_DEVICE_FIRMWARE_FLASH_ERROR;
             }
 
@@ -192,7 +193,7 @@ xpum_result_t FwDataMgmt::flashFwData(FlashFwDataParam &param) {
 
             igsc_image_fwdata_release(oimg);
             igsc_device_close(&handle);
-            pDevice->unlock();
+            pDevice->getOperationLock().unlockExclusive();
             return xpum_firmware_flash_result_t::XPUM_DEVICE_FIRMWARE_FLASH_OK;
         });
 
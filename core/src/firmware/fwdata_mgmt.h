@@ -12,11 +12,13 @@
 #include <atomic>
 
 #include "device/device.h"
+#include "firmware_image.h"
 
 namespace xpum {
 
 struct FlashFwDataParam {
     std::string filePath;
+    FirmwareImagePtr img;
     std::string errMsg;
 };
 
@@ -51,6 +53,6 @@ class FwDataMgmt {
     std::string flashFwErrMsg;
 };
 
-xpum_result_t isFwDataImageAndDeviceCompatible(std::vector<char>& buffer, std::string devicePath);
+xpum_result_t isFwDataImageAndDeviceCompatible(const FirmwareImage& image, std::string devicePath);
 
 } // namespace xpum
@@ -48,42 +48,46 @@ static void progress_percentage_func(uint32_t done, uint32_t total, void* ctx) {
 xpum_result_t PscMgmt::flashPscFw(FlashPscFwParam &param) {
     auto deviceModel = pDevice->getDeviceModel();
     if (deviceModel != XPUM_DEVICE_MODEL_PVC) {
-        pDevice->unlock();
+        pDevice->getOperationLock().unlockExclusive();
         return XPUM_UPDATE_FIRMWARE_UNSUPPORTED_PSC;
     }
     if (!libIgsc.ok()) {
-        pDevice->unlock();
+        pDevice->getOperationLock().unlockExclusive();
         return XPUM_UPDATE_FIRMWARE_UNSUPPORTED_PSC_IGSC;
     }
     std::lock_guard<std::mutex> lck(mtx);
     std::string filePath = param.filePath;
     if (task.valid()) {
         // task already running
-        pDevice->unlock();
+        pDevice->getOperationLock().unlockExclusive();
         return xpum_result_t::XPUM_UPDATE_FIRMWARE_TASK_RUNNING;
     } else {
-        auto buffer = readImageContent(filePath.c_str());
+        auto img = param.img;
 
         // validate psc image
-        std::vector<uint8_t> _buffer(buffer.begin(), buffer.end());
+        std::vector<uint8_t> _buffer(img->data(), img->data() + img->size());
         auto _res = getPSCData(_buffer);
         if (_res.size() == 0) {
             return XPUM_UPDATE_FIRMWARE_INVALID_FW_IMAGE;
         }
 
+        // the calibration blob of the device follows the image, the shared image is used as is otherwise
+        std::shared_ptr<std::vector<uint8_t>> calibrated;
         if (!param.force) {
             auto meiDeviceName = getMeiDeviceNameFromPath(devicePath);
             auto txCalBlobBuffer = getTxCalBlobByMeiDevice(meiDeviceName);
             if (txCalBlobBuffer.size() > 0) {
                 XPUM_LOG_INFO("Xe Link Calibration Blob found");
-                buffer.insert(buffer.end(), txCalBlobBuffer.begin(), txCalBlobBuffer.end());
+                calibrated = std::make_shared<std::vector<uint8_t>>(std::move(_buffer));
+                calibrated->insert(calibrated->end(), txCalBlobBuffer.begin(), txCalBlobBuffer.end());
             }
         }
 
         // init fw-data update progress
         percent.store(0);
 
-        task = std::async(std::launch::async, [this, buffer, filePath] {
+        task = std::async(std::launch::async, [this, img, calibrated, filePath] {
+            FlashSlot slot;
             XPUM_LOG_INFO("Start update GSC_PSCBIN on device {}", devicePath);
 
             struct igsc_device_handle handle {};
@@ -96,18 +100,23 @@ xpum_result_t PscMgmt::flashPscFw(FlashPscFwParam &param) {
                 flashFwErrMsg = "Cannot initialize device: " + devicePath;
                 XPUM_LOG_ERROR("Cannot initialize device: {}", devicePath);
                 igsc_device_close(&handle);
-                pDevice->unlock();
+                pDevice->getOperationLock().unlockExclusive();
                 return xpum_firmware_flash_result_t::XPUM_DEVICE_FIRMWARE_FLASH_ERROR;
             }
 
-            ret = igsc_iaf_psc_update(&handle, (const uint8_t*)buffer.data(), buffer.size(),
-                                      progress_func, this);
+            if (calibrated) {
+                ret = igsc_iaf_psc_update(&handle, calibrated->data(), calibrated->size(),
+                                          progress_func, this);
+            } else {
+                ret = igsc_iaf_psc_update(&handle, img->data(), img->size(),
+                                          progress_func, this);
+            }
 
             if (ret) {
                 flashFwErrMsg = "GSC_PSCBIN update failed. " + print_device_fw_status(&handle);
                 XPUM_LOG_ERROR("GSC_PSCBIN update failed on device {}. {}", devicePath, print_device_fw_status(&handle));
                 igsc_device_close(&handle);
-                pDevice->unlock();
+                pDevice->getOperationLock().unlockExclusive();
                 return xpum_firmware_flash_result_t::XPUM_DEVICE_FIRMWARE_FLASH_ERROR;
             }
 
@@ -130,7 +139,7 @@ xpum_result_t PscMgmt::flashPscFw(FlashPscFwParam &param) {
             auto txCalDate = getTxCalDateByMeiDevice(meiDeviceName);
             pDevice->addProperty(Property(XPUM_DEVICE_PROPERTY_INTERNAL_XELINK_CALIBRATION_DATE, txCalDate));
 
-            pDevice->unlock();
+            pDevice->getOperationLock().unlockExclusive();
             return xpum_firmware_flash_result_t::XPUM_DEVICE_FIRMWARE_FLASH_OK;
         });
 
@@ -12,11 +12,13 @@
 #include <string>
 
 #include "device/device.h"
+#include "firmware_image.h"
 
 namespace xpum {
 
 struct FlashPscFwParam {
     std::string filePath;
+    FirmwareImagePtr img;
     bool force;
     std::string errMsg;
 };
@@ -0,0 +1,358 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file igsc_sim.cpp
+ */
+
+/*
+  Stand-in for the igsc library to exercise the GSC firmware flash paths on
+  a machine without Intel GPUs. Build it with -DXPUM_BUILD_IGSC_SIM=ON and
+  preload it in front of the real library:
+
+    LD_PRELOAD=libigsc_sim.so xpumd
+
+  It enumerates IGSC_SIM_DEVICES devices (8 by default) named /dev/meiN on
+  PCI bus N+1, like the simulated GPUs of XPUM_SIMULATED_DEVICES. An update
+  takes IGSC_SIM_FLASH_MS milliseconds (3000 by default) and reports its
+  progress in 1% steps; the devices listed in IGSC_SIM_FAIL_DEVICES, e.g.
+  "2,5", fail halfway.
+
+  Only images made for the stand-in are accepted: the file starts with
+  "IGSCSIM", then 'G' for a GFX firmware image or 'D' for a FW-DATA image,
+  then a little endian uint16 version, e.g.
+
+    printf 'IGSCSIMG\x10\x27' > gfx.bin && head -c 64M /dev/zero >> gfx.bin
+
+  Only the functions used to flash GFX and FW-DATA firmware are replaced;
+  PSC, OPROM, ECC and IFR calls still go to the real library.
+*/
+
+#include <igsc_lib.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct igsc_lib_ctx {
+    uint32_t index;
+    uint32_t last_status;
+};
+
+struct igsc_device_iterator {
+    uint32_t next;
+};
+
+struct igsc_fwdata_image {
+    uint16_t version;
+};
+
+namespace {
+
+const char sim_magic[] = "IGSCSIM";
+
+const std::size_t sim_header_size = sizeof(sim_magic) - 1 + 1 + 2;
+
+struct SimDevice {
+    uint16_t fw_build = 1;
+    uint16_t fwdata_version = 1;
+};
+
+struct SimState {
+    uint32_t flash_ms = 3000;
+    std::set<uint32_t> failing;
+    std::vector<SimDevice> devices;
+    std::mutex mutex;
+
+    SimState() {
+        uint32_t count = 8;
+        if (const char* env = std::getenv("IGSC_SIM_DEVICES")) {
+            count = std::strtoul(env, nullptr, 10);
+        }
+        if (const char* env = std::getenv("IGSC_SIM_FLASH_MS")) {
+            flash_ms = std::strtoul(env, nullptr, 10);
+        }
+        if (const char* env = std::getenv("IGSC_SIM_FAIL_DEVICES")) {
+            std::stringstream ss(env);
+            std::string index;
+            while (std::getline(ss, index, ',')) {
+                failing.insert(std::strtoul(index.c_str(), nullptr, 10));
+            }
+        }
+        devices.resize(count);
+    }
+};
+
+SimState& state() {
+    static SimState sim_state;
+    return sim_state;
+}
+
+bool parseImage(const uint8_t* buffer, uint32_t buffer_len, uint8_t& type, uint16_t& version) {
+    if (buffer == nullptr || buffer_len < sim_header_size || std::memcmp(buffer, sim_magic, sizeof(sim_magic) - 1) != 0) {
+        return false;
+    }
+    char kind = buffer[sizeof(sim_magic) - 1];
+    if (kind == 'G') {
+        type = IGSC_IMAGE_TYPE_GFX_FW;
+    } else if (kind == 'D') {
+        type = IGSC_IMAGE_TYPE_FW_DATA;
+    } else {
+        return false;
+    }
+    version = buffer[sim_header_size - 2] | (buffer[sim_header_size - 1] << 8);
+    return true;
+}
+
+void fillDeviceInfo(uint32_t index, struct igsc_device_info* info) {
+    std::memset(info, 0, sizeof(*info));
+    snprintf(info->name, sizeof(info->name), "/dev/mei%u", index);
+    info->bus = (index + 1) & 0xff;
+    info->vendor_id = 0x8086;
+}
+
+bool validHandle(struct igsc_device_handle* handle) {
+    return handle != nullptr && handle->ctx != nullptr && handle->ctx->index < state().devices.size();
+}
+
+// sends the image in 1% steps, returns false if the device is set to fail
+bool transfer(struct igsc_device_handle* handle, uint32_t total, igsc_progress_func_t progress_f, void* ctx) {
+    SimState& sim = state();
+    bool fail = sim.failing.count(handle->ctx->index) > 0;
+    for (uint32_t step = 1; step <= 100; step++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(sim.flash_ms / 100));
+        if (fail && step == 50) {
+            handle->ctx->last_status = 1;
+            return false;
+        }
+        if (progress_f != nullptr) {
+            progress_f((uint64_t)total * step / 100, total, ctx);
+        }
+    }
+    handle->ctx->last_status = 0;
+    return true;
+}
+
+} // namespace
+
+extern "C" {
+
+int igsc_device_iterator_create(struct igsc_device_iterator** iter) {
+    if (iter == nullptr) {
+        return IGSC_ERROR_INVALID_PARAMETER;
+    }
+    *iter = new igsc_device_iterator{0};
+    return IGSC_SUCCESS;
+}
+
+int igsc_device_iterator_next(struct igsc_device_iterator* iter, struct igsc_device_info* info) {
+    if (iter == nullptr || info == nullptr) {
+        return IGSC_ERROR_INVALID_PARAMETER;
+    }
+    if (iter->next >= state().devices.size()) {
+        return IGSC_ERROR_DEVICE_NOT_FOUND;
+    }
+    fillDeviceInfo(iter->next++, info);
+    return IGSC_SUCCESS;
+}
+
+void igsc_device_iterator_destroy(struct igsc_device_iterator* iter) {
+    delete iter;
+}
+
+int igsc_device_init_by_device(struct igsc_device_handle* handle, const char* device_path) {
+    uint32_t index;
+    if (handle == nullptr || device_path == nullptr) {
+        return IGSC_ERROR_INVALID_PARAMETER;
+    }
+    if (sscanf(device_path, "/dev/mei%u", &index) != 1 || index >= state().devices.size()) {
+        return IGSC_ERROR_DEVICE_NOT_FOUND;
+    }
+    handle->ctx = new igsc_lib_ctx{index, 0};
+    return IGSC_SUCCESS;
+}
+
+int igsc_device_init_by_device_info(struct igsc_device_handle* handle, const struct igsc_device_info* dev_info) {
+    if (dev_info == nullptr) {
+        return IGSC_ERROR_INVALID_PARAMETER;
+    }
+    return igsc_device_init_by_device(handle, dev_info->name);
+}
+
+int igsc_device_get_device_info(struct igsc_device_handle* handle, struct igsc_device_info* dev_info) {
+    if (!validHandle(handle) || dev_info == nullptr) {
+        return IGSC_ERROR_INVALID_PARAMETER;
+    }
+    fillDeviceInfo(handle->ctx->index, dev_info);
+    return IGSC_SUCCESS;
+}
+
+int igsc_device_close(struct igsc_device_handle* handle) {
+    if (handle == nullptr) {
+        return IGSC_ERROR_INVALID_PARAMETER;
+    }
+    delete handle->ctx;
+    handle->ctx = nullptr;
+    return IGSC_SUCCESS;
+}
+
+uint32_t igsc_get_last_firmware_status(struct igsc_device_handle* handle) {
+    return validHandle(handle) ? handle->ctx->last_status : 0;
+}
+
+const char* igsc_translate_firmware_status(uint32_t firmware_status) {
+    return firmware_status == 0 ? "Success" : "Simulated update failure";
+}
+
+int igsc_image_get_type(const uint8_t* buffer, const uint32_t buffer_len, uint8_t* type) {
+    uint16_t version;
+    if (type == nullptr) {
+        return IGSC_ERROR_INVALID_PARAMETER;
+    }
+    return parseImage(buffer, buffer_len, *type, version) ? IGSC_SUCCESS : IGSC_ERROR_BAD_IMAGE;
+}
+
+int igsc_image_fw_version(const uint8_t* buffer, uint32_t buffer_len, struct igsc_fw_version* version) {
+    uint8_t type;
+    uint16_t build;
+    if (version == nullptr || !parseImage(buffer, buffer_len, type, build) || type != IGSC_IMAGE_TYPE_GFX_FW) {
+        return IGSC_ERROR_BAD_IMAGE;
+    }
+    std::memcpy(version->project, "SIM0", sizeof(version->project));
+    version->hotfix = 0;
+    version->build = build;
+    return IGSC_SUCCESS;
+}
+
+int igsc_device_fw_version(struct igsc_device_handle* handle, struct igsc_fw_version* version) {
+    if (!validHandle(handle) || version == nullptr) {
+        return IGSC_ERROR_INVALID_PARAMETER;
+    }
+    std::lock_guard<std::mutex> lock(state().mutex);
+    std::memcpy(version->project, "SIM0", sizeof(version->project));
+    version->hotfix = 0;
+    version->build = state().devices[handle->ctx->index].fw_build;
+    return IGSC_SUCCESS;
+}
+
+int igsc_image_hw_config(const uint8_t* buffer, uint32_t buffer_len, struct igsc_hw_config* hw_config) {
+    uint8_t type;
+    uint16_t version;
+    if (hw_config == nullptr || !parseImage(buffer, buffer_len, type, version)) {
+        return IGSC_ERROR_BAD_IMAGE;
+    }
+    std::memset(hw_config, 0, sizeof(*hw_config));
+    return IGSC_SUCCESS;
+}
+
+int igsc_device_hw_config(struct igsc_device_handle* handle, struct igsc_hw_config* hw_config) {
+    if (!validHandle(handle) || hw_config == nullptr) {
+        return IGSC_ERROR_INVALID_PARAMETER;
+    }
+    std::memset(hw_config, 0, sizeof(*hw_config));
+    return IGSC_SUCCESS;
+}
+
+int igsc_hw_config_compatible(const struct igsc_hw_config* image_hw_config, const struct igsc_hw_config* device_hw_config) {
+    if (image_hw_config == nullptr || device_hw_config == nullptr) {
+        return IGSC_ERROR_INVALID_PARAMETER;
+    }
+    return IGSC_SUCCESS;
+}
+
+int igsc_device_fw_update_ex(struct igsc_device_handle* handle, const uint8_t* buffer, const uint32_t buffer_len,
+                             igsc_progress_func_t progress_f, void* ctx, struct igsc_fw_update_flags flags) {
+    uint8_t type;
+    uint16_t build;
+    (void)flags;
+    if (!validHandle(handle)) {
+        return IGSC_ERROR_INVALID_PARAMETER;
+    }
+    if (!parseImage(buffer, buffer_len, type, build) || type != IGSC_IMAGE_TYPE_GFX_FW) {
+        return IGSC_ERROR_BAD_IMAGE;
+    }
+    if (!transfer(handle, buffer_len, progress_f, ctx)) {
+        return IGSC_ERROR_PROTOCOL;
+    }
+    std::lock_guard<std::mutex> lock(state().mutex);
+    state().devices[handle->ctx->index].fw_build = build;
+    return IGSC_SUCCESS;
+}
+
+int igsc_image_fwdata_init(struct igsc_fwdata_image** img, const uint8_t* buffer, uint32_t buffer_len) {
+    uint8_t type;
+    uint16_t version;
+    if (img == nullptr) {
+        return IGSC_ERROR_INVALID_PARAMETER;
+    }
+    if (!parseImage(buffer, buffer_len, type, version) || type != IGSC_IMAGE_TYPE_FW_DATA) {
+        return IGSC_ERROR_BAD_IMAGE;
+    }
+    if (*img == nullptr) {
+        *img = new igsc_fwdata_image;
+    }
+    (*img)->version = version;
+    return IGSC_SUCCESS;
+}
+
+int igsc_image_fwdata_release(struct igsc_fwdata_image* img) {
+    delete img;
+    return IGSC_SUCCESS;
+}
+
+int igsc_image_fwdata_version(struct igsc_fwdata_image* img, struct igsc_fwdata_version* version) {
+    if (img == nullptr || version == nullptr) {
+        return IGSC_ERROR_INVALID_PARAMETER;
+    }
+    std::memset(version, 0, sizeof(*version));
+    version->major_version = img->version;
+    return IGSC_SUCCESS;
+}
+
+int igsc_image_fwdata_match_device(struct igsc_fwdata_image* img, struct igsc_device_info* device) {
+    if (img == nullptr || device == nullptr) {
+        return IGSC_ERROR_INVALID_PARAMETER;
+    }
+    return IGSC_SUCCESS;
+}
+
+int igsc_device_fwdata_version(struct igsc_device_handle* handle, struct igsc_fwdata_version* version) {
+    if (!validHandle(handle) || version == nullptr) {
+        return IGSC_ERROR_INVALID_PARAMETER;
+    }
+    std::lock_guard<std::mutex> lock(state().mutex);
+    std::memset(version, 0, sizeof(*version));
+    version->major_version = state().devices[handle->ctx->index].fwdata_version;
+    return IGSC_SUCCESS;
+}
+
+uint8_t igsc_fwdata_version_compare(struct igsc_fwdata_version* image_ver, struct igsc_fwdata_version* device_ver) {
+    if (image_ver == nullptr || device_ver == nullptr) {
+        return IGSC_VERSION_ERROR;
+    }
+    if (image_ver->major_version > device_ver->major_version) {
+        return IGSC_VERSION_NEWER;
+    }
+    return image_ver->major_version == device_ver->major_version ? IGSC_VERSION_EQUAL : IGSC_VERSION_OLDER;
+}
+
+int igsc_device_fwdata_image_update(struct igsc_device_handle* handle, struct igsc_fwdata_image* img,
+                                    igsc_progress_func_t progress_f, void* ctx) {
+    if (!validHandle(handle) || img == nullptr) {
+        return IGSC_ERROR_INVALID_PARAMETER;
+    }
+    if (!transfer(handle, 100, progress_f, ctx)) {
+        return IGSC_ERROR_PROTOCOL;
+    }
+    std::lock_guard<std::mutex> lock(state().mutex);
+    state().devices[handle->ctx->index].fwdata_version = img->version;
+    return IGSC_SUCCESS;
+}
+
+} // extern "C"
@@ -6,10 +6,13 @@
 
 #include "group_manager.h"
 
+#include <algorithm>
+#include <limits>
 #include <vector>
 
 #include "infrastructure/device_property.h"
 #include "infrastructure/logger.h"
+#include "infrastructure/utility.h"
 #include "topology/pci_database.h"
 #include "topology/topology.h"
 
@@ -17,7 +20,7 @@ namespace xpum {
 
 GroupManager::GroupManager(std::shared_ptr<DeviceManagerInterface>& p_device_manager,
                            std::shared_ptr<DataLogicInterface>& p_data_logic)
-    : p_devicemanager(p_device_manager), p_datalogic(p_data_logic), groupSequence(1), internalSequence(1) {
+    : p_devicemanager(p_device_manager), p_datalogic(p_data_logic), groupSequence(1), internalSequence(1), subscriptionId(0) {
     XPUM_LOG_TRACE("GroupManager()");
 }
 
@@ -172,6 +175,49 @@ xpum_result_t GroupManager::getAllGroupIds(xpum_group_id_t groupIds[], int* coun
     return XPUM_OK;
 }
 
+xpum_result_t GroupManager::getGroupStatistics(xpum_group_id_t groupId, xpum_group_stats_data_t dataList[], uint32_t* count) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    std::shared_ptr<GroupUnit> pGroupInfo = getGroupById(groupId);
+    if (pGroupInfo == nullptr) {
+        XPUM_LOG_DEBUG("GroupManager::getGroupStatistics-invalid group {}", groupId);
+        return XPUM_RESULT_GROUP_NOT_FOUND;
+    }
+
+    std::vector<xpum_group_stats_data_t> datas;
+    pGroupInfo->getAggregates(datas, Utility::getCurrentMillisecond());
+    if (dataList == nullptr) {
+        *count = datas.size();
+        return XPUM_OK;
+    } else if (*count < datas.size()) {
+        *count = datas.size();
+        return XPUM_BUFFER_TOO_SMALL;
+    }
+
+    std::copy(datas.begin(), datas.end(), dataList);
+    *count = datas.size();
+    return XPUM_OK;
+}
+
+void GroupManager::onMeasurementEvents(std::vector<MeasurementEvent>& events) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    for (auto& event : events) {
+        if (!Utility::isMetric(event.type) || Utility::isCounterMetric(event.type) || !event.p_data->hasDataOnDevice()) {
+            continue;
+        }
+        uint64_t value = event.p_data->getCurrent();
+        if (value == std::numeric_limits<uint64_t>::max()) {
+            continue;
+        }
+        xpum_device_id_t deviceId = std::stoi(event.device_id);
+        for (auto& group : groupMap) {
+            if (group.second != nullptr && group.second->hasDevice(deviceId)) {
+                group.second->updateAggregate(event.type, deviceId, value, event.p_data->getScale(), event.time);
+            }
+        }
+    }
+}
+
 std::shared_ptr<GroupUnit> GroupManager::getGroupById(xpum_group_id_t groupId) {
     std::shared_ptr<GroupUnit> pGroupInfo;
     GroupMap::iterator groupIterator = groupMap.find(groupId);
@@ -355,8 +401,50 @@ void GroupManager::init() {
     is updated.  
     */
     copySlotNameForBuildinGroups();
+
+    /*
+    Group aggregates are maintained from the samples pushed by the data
+    logic, so that a group query does not walk the devices of the group.
+    */
+    p_event_bus = p_datalogic->getEventBus();
+    if (p_event_bus != nullptr) {
+        std::weak_ptr<GroupManager> this_weak_ptr = shared_from_this();
+        // only the gauge metrics are aggregated
+        EventFilter filter;
+        std::vector<MeasurementType> metric_types;
+        Utility::getMetricsTypes(metric_types);
+        for (auto type : metric_types) {
+            if (!Utility::isCounterMetric(type)) {
+                filter.types.insert(type);
+            }
+        }
+        subscriptionId = p_event_bus->subscribe(filter, [this_weak_ptr](std::vector<MeasurementEvent>& events, uint64_t dropped) {
+            auto p_this = this_weak_ptr.lock();
+            if (p_this == nullptr) {
+                return;
+            }
+            p_this->onMeasurementEvents(events);
+        });
+    }
+}
+
+void GroupManager::removeDevices(const std::vector<std::string>& removed) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    for (auto& id : removed) {
+        xpum_device_id_t deviceId = std::stoi(id);
+        // the device does not come back until a restart, so it leaves all its groups
+        for (auto& group : groupMap) {
+            if (group.second->hasDevice(deviceId)) {
+                group.second->removeDevice(p_devicemanager, group.first, deviceId);
+            }
+        }
+    }
 }
 
 void GroupManager::close() {
+    if (p_event_bus != nullptr) {
+        p_event_bus->unsubscribe(subscriptionId);
+        p_event_bus = nullptr;
+    }
 }
 } // end namespace xpum
@@ -43,6 +43,10 @@ class GroupManager : public GroupManagerInterface,
 
     xpum_result_t getAllGroupIds(xpum_group_id_t groupIds[], int *count) override;
 
+    xpum_result_t getGroupStatistics(xpum_group_id_t groupId, xpum_group_stats_data_t dataList[], uint32_t *count) override;
+
+    void removeDevices(const std::vector<std::string> &removed) override;
+
     void init() override;
 
     void close() override;
@@ -60,6 +64,8 @@ class GroupManager : public GroupManagerInterface,
     void createBuildInGroup(bool bBuildInDevice, int vendorId, int deviceId, std::string devID, std::string bdfAddress);
     void copySlotNameForBuildinGroups();
 
+    void onMeasurementEvents(std::vector<MeasurementEvent> &events);
+
    private:
     std::shared_ptr<DeviceManagerInterface> p_devicemanager;
     std::shared_ptr<DataLogicInterface> p_datalogic;
@@ -68,5 +74,7 @@ class GroupManager : public GroupManagerInterface,
     std::atomic_int internalSequence;
     typedef std::map<xpum_group_id_t, std::shared_ptr<GroupUnit>> GroupMap;
     GroupMap groupMap;
+    std::shared_ptr<EventBus> p_event_bus;
+    uint32_t subscriptionId;
 };
 } // end namespace xpum
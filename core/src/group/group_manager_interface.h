@@ -6,6 +6,9 @@
 
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include "../include/xpum_structs.h"
 #include "infrastructure/init_close_interface.h"
 
@@ -26,5 +29,10 @@ class GroupManagerInterface : public InitCloseInterface {
     virtual xpum_result_t getGroupInfo(xpum_group_id_t groupId, xpum_group_info_t *pGroupInfo) = 0;
 
     virtual xpum_result_t getAllGroupIds(xpum_group_id_t groupIds[XPUM_MAX_NUM_GROUPS], int *count) = 0;
+
+    virtual xpum_result_t getGroupStatistics(xpum_group_id_t groupId, xpum_group_stats_data_t dataList[], uint32_t *count) = 0;
+
+    // the ids of the devices removed by a hot-plug
+    virtual void removeDevices(const std::vector<std::string> &removed) = 0;
 };
 } // end namespace xpum
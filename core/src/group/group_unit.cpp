@@ -6,10 +6,125 @@
 
 #include "group_unit.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "infrastructure/configuration.h"
 #include "infrastructure/logger.h"
+#include "infrastructure/utility.h"
 
 namespace xpum {
 
+// Relative width of a percentile sketch bucket, the estimate error is about half of it
+static const double SKETCH_GAMMA = 1.02;
+
+// A device value is evicted when it is older than this number of intervals of its metric
+static const int AGGREGATE_STALE_INTERVALS = 3;
+
+void GroupMetricAggregate::update(xpum_device_id_t deviceId, uint64_t value, uint64_t scale, Timestamp_t time) {
+    if (scale == 0) {
+        scale = 1;
+    }
+    if (this->scale == 0) {
+        this->scale = scale;
+    } else if (scale != this->scale) {
+        value = (uint64_t)std::llround((double)value * this->scale / scale);
+    }
+    auto it = latest.find(deviceId);
+    if (it != latest.end()) {
+        removeValue(it->second.value);
+        it->second.value = value;
+        it->second.time = time;
+    } else {
+        latest[deviceId] = Sample{value, time};
+    }
+    values.insert(value);
+    buckets[bucketOf(value)]++;
+    sum += value;
+    timestamp = std::max(timestamp, time);
+}
+
+void GroupMetricAggregate::remove(xpum_device_id_t deviceId) {
+    auto it = latest.find(deviceId);
+    if (it == latest.end()) {
+        return;
+    }
+    removeValue(it->second.value);
+    latest.erase(it);
+}
+
+void GroupMetricAggregate::evict(Timestamp_t time) {
+    for (auto it = latest.begin(); it != latest.end();) {
+        if (it->second.time < time) {
+            removeValue(it->second.value);
+            it = latest.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool GroupMetricAggregate::empty() const {
+    return latest.empty();
+}
+
+void GroupMetricAggregate::removeValue(uint64_t value) {
+    auto it = values.find(value);
+    if (it != values.end()) {
+        values.erase(it);
+    }
+    auto bucket = buckets.find(bucketOf(value));
+    if (bucket != buckets.end() && --bucket->second == 0) {
+        buckets.erase(bucket);
+    }
+    sum -= value;
+}
+
+int32_t GroupMetricAggregate::bucketOf(uint64_t value) {
+    if (value == 0) {
+        return 0;
+    }
+    return 1 + (int32_t)std::ceil(std::log((double)value) / std::log(SKETCH_GAMMA));
+}
+
+uint64_t GroupMetricAggregate::bucketValue(int32_t bucket) {
+    if (bucket == 0) {
+        return 0;
+    }
+    return (uint64_t)std::llround(2 * std::pow(SKETCH_GAMMA, bucket - 1) / (SKETCH_GAMMA + 1));
+}
+
+uint64_t GroupMetricAggregate::percentile(uint32_t percent) const {
+    uint64_t rank = (latest.size() * percent + 99) / 100;
+    uint64_t seen = 0;
+    for (auto& bucket : buckets) {
+        seen += bucket.second;
+        if (seen >= rank) {
+            // the extreme buckets are bounded by the exact min and max
+            return std::min(std::max(bucketValue(bucket.first), *values.begin()), *values.rbegin());
+        }
+    }
+    return *values.rbegin();
+}
+
+void GroupMetricAggregate::getStats(xpum_group_stats_data_t& data) const {
+    data.deviceCount = latest.size();
+    data.timestamp = timestamp;
+    data.scale = scale;
+    if (latest.empty()) {
+        data.sum = data.avg = data.min = data.max = 0;
+        data.p50 = data.p90 = data.p99 = 0;
+        return;
+    }
+    data.sum = sum;
+    data.avg = sum / latest.size();
+    data.min = *values.begin();
+    data.max = *values.rbegin();
+    data.p50 = percentile(50);
+    data.p90 = percentile(90);
+    data.p99 = percentile(99);
+}
+
 GroupUnit::GroupUnit(std::string groupname, xpum_group_id_t groupId)
     : topoLevel(0) {
     XPUM_LOG_TRACE("GroupUnit");
@@ -64,6 +179,9 @@ xpum_result_t GroupUnit::removeDevice(const std::shared_ptr<DeviceManagerInterfa
     for (unsigned int i = 0; i < deviceList.size(); i++) {
         if (deviceList[i] == deviceId) {
             deviceList.erase(deviceList.begin() + i);
+            for (auto& aggregate : aggregates) {
+                aggregate.second.remove(deviceId);
+            }
             return XPUM_OK;
         }
     }
@@ -103,4 +221,27 @@ bool GroupUnit::deviceInGroup(std::vector<zes_pci_address_t>& pcieTop) {
     return false;
 }
 
+bool GroupUnit::hasDevice(xpum_device_id_t deviceId) {
+    return std::find(deviceList.begin(), deviceList.end(), deviceId) != deviceList.end();
+}
+
+void GroupUnit::updateAggregate(MeasurementType type, xpum_device_id_t deviceId, uint64_t value, uint64_t scale, Timestamp_t time) {
+    aggregates[type].update(deviceId, value, scale, time);
+}
+
+void GroupUnit::getAggregates(std::vector<xpum_group_stats_data_t>& datas, Timestamp_t now) {
+    for (auto& aggregate : aggregates) {
+        MeasurementType type = aggregate.first;
+        int interval = Configuration::getMetricInterval(Utility::capabilityFromMeasurementType(type));
+        aggregate.second.evict(now - (Timestamp_t)AGGREGATE_STALE_INTERVALS * interval);
+        if (aggregate.second.empty()) {
+            continue;
+        }
+        xpum_group_stats_data_t data;
+        data.metricsType = Utility::xpumStatsTypeFromMeasurementType(type);
+        aggregate.second.getStats(data);
+        datas.push_back(data);
+    }
+}
+
 } // end namespace xpum
@@ -5,14 +5,68 @@
  */
 
 #pragma once
+#include <map>
+#include <set>
 #include <string>
 #include <vector>
 
 #include "../include/xpum_structs.h"
 #include "control/device_manager_interface.h"
+#include "infrastructure/const.h"
+#include "infrastructure/measurement_type.h"
 
 namespace xpum {
 
+/*
+  Aggregate of one metric over the devices of a group. Only the latest
+  device level value of every device is kept: an update replaces the
+  previous contribution of that device, so sum, mean, min and max are
+  maintained incrementally and reading them does not depend on the number
+  of devices. Percentiles come from a log-bucket sketch with about 1%
+  relative error.
+
+  The scale of the aggregate is the one of its first sample, the values
+  of the devices are converted to it. A device that stops reporting is
+  evicted by evict() once its value is too old.
+*/
+
+class GroupMetricAggregate {
+   public:
+    void update(xpum_device_id_t deviceId, uint64_t value, uint64_t scale, Timestamp_t time);
+
+    void remove(xpum_device_id_t deviceId);
+
+    // removes the values of the devices sampled before time
+    void evict(Timestamp_t time);
+
+    bool empty() const;
+
+    void getStats(xpum_group_stats_data_t& data) const;
+
+   private:
+    static int32_t bucketOf(uint64_t value);
+
+    static uint64_t bucketValue(int32_t bucket);
+
+    uint64_t percentile(uint32_t percent) const;
+
+    void removeValue(uint64_t value);
+
+   private:
+    struct Sample {
+        uint64_t value;
+        Timestamp_t time;
+    };
+
+    std::map<xpum_device_id_t, Sample> latest;
+    std::multiset<uint64_t> values;
+    std::map<int32_t, uint32_t> buckets;
+    uint64_t sum = 0;
+    // 0 until the first sample
+    uint64_t scale = 0;
+    Timestamp_t timestamp = 0;
+};
+
 class GroupUnit : public std::enable_shared_from_this<GroupUnit> {
    public:
     GroupUnit(std::string groupname, xpum_group_id_t groupId);
@@ -32,11 +86,20 @@ class GroupUnit : public std::enable_shared_from_this<GroupUnit> {
     void setPcieTopo(std::vector<zes_pci_address_t>& pcieTop);
     bool deviceInGroup(std::vector<zes_pci_address_t>& pcieTop);
 
+    bool hasDevice(xpum_device_id_t deviceId);
+
+    void updateAggregate(MeasurementType type, xpum_device_id_t deviceId, uint64_t value, uint64_t scale, Timestamp_t time);
+
+    // the values not refreshed for a few intervals of their metric are
+    // evicted first
+    void getAggregates(std::vector<xpum_group_stats_data_t>& datas, Timestamp_t now);
+
    private:
     xpum_group_id_t id;
     std::string name;
     std::vector<xpum_device_id_t> deviceList;
     std::vector<zes_pci_address_t> pcieTopology;
     std::size_t topoLevel;
+    std::map<MeasurementType, GroupMetricAggregate> aggregates;
 };
 } // end namespace xpum
@@ -6,9 +6,11 @@
 
 #include "configuration.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <cstdlib>
+#include <mutex>
 #include <sstream>
 #include <regex>
 #include <unistd.h>
@@ -38,10 +40,26 @@ bool Configuration::INITIALIZE_PCIE_MANAGER = false;
 uint32_t Configuration::DEFAULT_MEASUREMENT_DATA_SCALE = 100;
 uint32_t Configuration::MAX_STATISTICS_SESSION_NUM = 2;
 bool Configuration::INITIALIZE_PERF_METRIC = false;
+uint32_t Configuration::EVENT_BUS_QUEUE_CAPACITY = 1024;
+uint32_t Configuration::EVENT_BUS_BATCH_SIZE = 64;
+uint32_t Configuration::SIMULATED_DEVICE_NUM = 0;
+uint32_t Configuration::SIMULATED_TILE_NUM = 2;
+uint32_t Configuration::SIMULATED_LATENCY_US = 0;
+double Configuration::SIMULATED_FAULT_RATE = 0;
+uint64_t Configuration::SIMULATED_SEED = 0;
+uint32_t Configuration::FIRMWARE_FLASH_CONCURRENCY = 4;
+int Configuration::RAS_SAMPLING_INTERVAL = 5000;
+uint32_t Configuration::DEVICE_READ_THREADS = 8;
+int Configuration::DEVICE_OPERATION_TIMEOUT = 0;
+int Configuration::DEVICE_HOTPLUG_SETTLE_TIME = 1000;
+std::string Configuration::CACHE_DIR;
 
 std::set<MeasurementType> Configuration::enabled_metrics;
 std::shared_ptr<std::set<int>> Configuration::enabled_gpu_ids;
 std::vector<PerfMetric_t> Configuration::perf_metrics;
+std::map<DeviceCapability, int> Configuration::metric_intervals;
+// set through xpumSetAgentConfig while the monitor tasks read them
+static std::mutex metric_intervals_mutex;
 std::string Configuration::XPUM_MODE;
 
 void Configuration::initEnabledMetrics() {
@@ -211,4 +229,248 @@ void Configuration::initPerfMetrics() {
     conf_file.close();
 }
 
+/*
+  XPUM_SIMULATED_DEVICES=N replaces the Level Zero devices with N simulated
+  ones, see device/sim/sim_device_stub.h. The other variables tune the
+  simulation and are ignored when no simulated device is requested.
+*/
+
+void Configuration::initSimulatedDevices() {
+    char* env = std::getenv("XPUM_SIMULATED_DEVICES");
+    if (env == NULL) {
+        return;
+    }
+    try {
+        SIMULATED_DEVICE_NUM = std::stoul(env);
+        env = std::getenv("XPUM_SIMULATED_TILES");
+        if (env != NULL) {
+            SIMULATED_TILE_NUM = std::max(1ul, std::stoul(env));
+        }
+        env = std::getenv("XPUM_SIMULATED_LATENCY_US");
+        if (env != NULL) {
+            SIMULATED_LATENCY_US = std::stoul(env);
+        }
+        env = std::getenv("XPUM_SIMULATED_FAULT_RATE");
+        if (env != NULL) {
+            SIMULATED_FAULT_RATE = std::min(1.0, std::max(0.0, std::stod(env)));
+        }
+        env = std::getenv("XPUM_SIMULATED_SEED");
+        if (env != NULL) {
+            SIMULATED_SEED = std::stoull(env);
+        }
+    } catch (std::exception& e) {
+        XPUM_LOG_ERROR("Invalid simulated device configuration: {}", e.what());
+        SIMULATED_DEVICE_NUM = 0;
+        return;
+    }
+    if (SIMULATED_DEVICE_NUM > 0) {
+        XPUM_LOG_INFO("Simulating {} devices with {} tiles, latency {} us, fault rate {}, seed {}",
+                      SIMULATED_DEVICE_NUM, SIMULATED_TILE_NUM, SIMULATED_LATENCY_US, SIMULATED_FAULT_RATE, SIMULATED_SEED);
+    }
+}
+
+void Configuration::initFirmwareFlashConcurrency() {
+    char* env = std::getenv("XPUM_FW_FLASH_CONCURRENCY");
+    if (env == NULL) {
+        return;
+    }
+    try {
+        FIRMWARE_FLASH_CONCURRENCY = std::max(1ul, std::stoul(env));
+    } catch (std::exception&) {
+        XPUM_LOG_ERROR("Invalid firmware flash concurrency: {}", env);
+    }
+}
+
+/*
+  RAS error counters change rarely and reading them goes through the MEI
+  interface of the device, they are sampled every XPUM_RAS_SAMPLING_INTERVAL
+  milliseconds rather than at the telemetry frequency.
+*/
+
+void Configuration::initRasSamplingInterval() {
+    char* env = std::getenv("XPUM_RAS_SAMPLING_INTERVAL");
+    if (env == NULL) {
+        return;
+    }
+    try {
+        RAS_SAMPLING_INTERVAL = std::max(100, std::stoi(env));
+    } catch (std::exception&) {
+        XPUM_LOG_ERROR("Invalid RAS sampling interval: {}", env);
+    }
+}
+
+/*
+  Number of threads reading the devices for the monitor, at most
+  XPUM_DEVICE_READ_THREADS reads are in flight at a time.
+*/
+
+void Configuration::initDeviceReadThreads() {
+    char* env = std::getenv("XPUM_DEVICE_READ_THREADS");
+    if (env == NULL) {
+        return;
+    }
+    try {
+        DEVICE_READ_THREADS = std::max(1ul, std::stoul(env));
+    } catch (std::exception&) {
+        XPUM_LOG_ERROR("Invalid device read threads: {}", env);
+    }
+}
+
+/*
+  Milliseconds a firmware flash, reset or PPR waits in the queue of the
+  device for the one running, XPUM_DEVICE_OPERATION_TIMEOUT. By default it
+  fails at once with the device busy.
+*/
+
+void Configuration::initDeviceOperationTimeout() {
+    char* env = std::getenv("XPUM_DEVICE_OPERATION_TIMEOUT");
+    if (env == NULL) {
+        return;
+    }
+    try {
+        DEVICE_OPERATION_TIMEOUT = std::max(0, std::stoi(env));
+    } catch (std::exception&) {
+        XPUM_LOG_ERROR("Invalid device operation timeout: {}", env);
+    }
+}
+
+/*
+  Milliseconds without udev event on the GPUs before the devices gone are
+  removed, XPUM_DEVICE_HOTPLUG_SETTLE_TIME, so that a reset or a VF change
+  is handled once. -1 turns the hot-plug handling off.
+*/
+
+void Configuration::initDeviceHotplugSettleTime() {
+    char* env = std::getenv("XPUM_DEVICE_HOTPLUG_SETTLE_TIME");
+    if (env == NULL) {
+        return;
+    }
+    try {
+        DEVICE_HOTPLUG_SETTLE_TIME = std::max(-1, std::stoi(env));
+    } catch (std::exception&) {
+        XPUM_LOG_ERROR("Invalid device hot-plug settle time: {}", env);
+    }
+}
+
+// names of the metrics in the help of --enable_metrics, by stats type
+static const char* metric_names[] = {
+    "GPU_UTILIZATION", "EU_ACTIVE", "EU_STALL", "EU_IDLE", "POWER", "ENERGY",
+    "GPU_FREQUENCY", "GPU_CORE_TEMPERATURE", "MEMORY_USED", "MEMORY_UTILIZATION",
+    "MEMORY_BANDWIDTH", "MEMORY_READ", "MEMORY_WRITE", "MEMORY_READ_THROUGHPUT",
+    "MEMORY_WRITE_THROUGHPUT", "ENGINE_GROUP_COMPUTE_ALL_UTILIZATION",
+    "ENGINE_GROUP_MEDIA_ALL_UTILIZATION", "ENGINE_GROUP_COPY_ALL_UTILIZATION",
+    "ENGINE_GROUP_RENDER_ALL_UTILIZATION", "ENGINE_GROUP_3D_ALL_UTILIZATION",
+    "RAS_ERROR_CAT_RESET", "RAS_ERROR_CAT_PROGRAMMING_ERRORS", "RAS_ERROR_CAT_DRIVER_ERRORS",
+    "RAS_ERROR_CAT_CACHE_ERRORS_CORRECTABLE", "RAS_ERROR_CAT_CACHE_ERRORS_UNCORRECTABLE",
+    "RAS_ERROR_CAT_DISPLAY_ERRORS_CORRECTABLE", "RAS_ERROR_CAT_DISPLAY_ERRORS_UNCORRECTABLE",
+    "RAS_ERROR_CAT_NON_COMPUTE_ERRORS_CORRECTABLE", "RAS_ERROR_CAT_NON_COMPUTE_ERRORS_UNCORRECTABLE",
+    "GPU_REQUEST_FREQUENCY", "MEMORY_TEMPERATURE", "FREQUENCY_THROTTLE", "PCIE_READ_THROUGHPUT",
+    "PCIE_WRITE_THROUGHPUT", "PCIE_READ", "PCIE_WRITE", "ENGINE_UTILIZATION", "FABRIC_THROUGHPUT",
+    "FREQUENCY_THROTTLE_REASON_GPU", "MEDIA_ENGINE_FREQUENCY"};
+
+static_assert(sizeof(metric_names) / sizeof(metric_names[0]) == XPUM_STATS_MAX, "a metric has no name");
+
+// a metric name or index, or a range of indexes "a-b"; throws on a bad one
+static std::vector<xpum_stats_type_t> parseMetricTypes(std::string metrics) {
+    std::transform(metrics.begin(), metrics.end(), metrics.begin(), ::toupper);
+    for (int i = 0; i < XPUM_STATS_MAX; i++) {
+        if (metrics == metric_names[i]) {
+            return {(xpum_stats_type_t)i};
+        }
+    }
+    int first, last;
+    auto pos = metrics.find('-');
+    if (pos != 0 && pos != std::string::npos) {
+        first = std::stoi(metrics.substr(0, pos));
+        last = std::stoi(metrics.substr(pos + 1));
+    } else {
+        first = last = std::stoi(metrics);
+    }
+    if (first < 0 || last >= XPUM_STATS_MAX || first > last) {
+        throw std::out_of_range(metrics);
+    }
+    std::vector<xpum_stats_type_t> types;
+    for (int i = first; i <= last; i++) {
+        types.push_back((xpum_stats_type_t)i);
+    }
+    return types;
+}
+
+/*
+  Intervals of the metrics that are not collected at the telemetry
+  frequency, in XPUM_METRIC_INTERVALS as a list of metrics and interval in
+  milliseconds. The metrics are given like to --enable_metrics, by name,
+  index or range of indexes, for example
+  "POWER:100,RAS_ERROR_CAT_RESET:1000,23-28:1000". The metrics collected
+  together share the interval of the last one given.
+*/
+
+void Configuration::initMetricIntervals() {
+    char* env = std::getenv("XPUM_METRIC_INTERVALS");
+    if (env == NULL) {
+        return;
+    }
+    std::stringstream env_ss(env);
+    while (env_ss.good()) {
+        std::string item;
+        getline(env_ss, item, ',');
+        auto pos = item.find(':');
+        if (pos == std::string::npos) {
+            continue;
+        }
+        try {
+            auto types = parseMetricTypes(item.substr(0, pos));
+            int interval = std::stoi(item.substr(pos + 1));
+            if (interval < 0) {
+                XPUM_LOG_ERROR("Invalid metric interval: {}", item);
+                continue;
+            }
+            for (auto type : types) {
+                auto m_type = Utility::measurementTypeFromXpumStatsType(type);
+                if ((int)m_type < 0 || (int)m_type >= MeasurementType::METRIC_MAX) {
+                    continue;
+                }
+                setMetricInterval(Utility::capabilityFromMeasurementType(m_type), interval);
+            }
+        } catch (std::exception&) {
+            XPUM_LOG_ERROR("Invalid metric interval: {}", item);
+        }
+    }
+}
+
+int Configuration::getMetricInterval(DeviceCapability capability) {
+    std::lock_guard<std::mutex> lock(metric_intervals_mutex);
+    auto it = metric_intervals.find(capability);
+    if (it == metric_intervals.end()) {
+        return TELEMETRY_DATA_MONITOR_FREQUENCE;
+    }
+    return it->second;
+}
+
+void Configuration::setMetricInterval(DeviceCapability capability, int interval) {
+    std::lock_guard<std::mutex> lock(metric_intervals_mutex);
+    if (interval <= 0) {
+        metric_intervals.erase(capability);
+    } else {
+        metric_intervals[capability] = interval;
+    }
+}
+
+/*
+  Directory of the files kept between runs, /var/cache/<mode>/ unless
+  XPUM_CACHE_DIR is set. An empty XPUM_CACHE_DIR disables them.
+*/
+
+void Configuration::initCacheDir() {
+    char* env = std::getenv("XPUM_CACHE_DIR");
+    if (env == NULL) {
+        CACHE_DIR = "/var/cache/" + XPUM_MODE + "/";
+        return;
+    }
+    CACHE_DIR = env;
+    if (!CACHE_DIR.empty() && CACHE_DIR.back() != '/') {
+        CACHE_DIR += "/";
+    }
+}
+
 } // end namespace xpum
@@ -5,12 +5,14 @@
  */
 
 #pragma once
+#include <map>
 #include <set>
 #include <vector>
 #include <string>
 #include <unistd.h>
 #include <limits.h>
 
+#include "infrastructure/device_capability.h"
 #include "infrastructure/logger.h"
 #include "measurement_type.h"
 
@@ -41,7 +43,20 @@ class Configuration {
     static uint32_t DEFAULT_MEASUREMENT_DATA_SCALE;
     static uint32_t MAX_STATISTICS_SESSION_NUM;
     static bool INITIALIZE_PERF_METRIC;
+    static uint32_t EVENT_BUS_QUEUE_CAPACITY;
+    static uint32_t EVENT_BUS_BATCH_SIZE;
     static std::string XPUM_MODE;
+    static uint32_t SIMULATED_DEVICE_NUM;
+    static uint32_t SIMULATED_TILE_NUM;
+    static uint32_t SIMULATED_LATENCY_US;
+    static double SIMULATED_FAULT_RATE;
+    static uint64_t SIMULATED_SEED;
+    static uint32_t FIRMWARE_FLASH_CONCURRENCY;
+    static int RAS_SAMPLING_INTERVAL;
+    static uint32_t DEVICE_READ_THREADS;
+    static int DEVICE_OPERATION_TIMEOUT;
+    static int DEVICE_HOTPLUG_SETTLE_TIME;
+    static std::string CACHE_DIR;
 
    public:
     static void init() {
@@ -64,11 +79,27 @@ class Configuration {
         initEnabledMetrics();
         initEnabledGPUIds();
         initPerfMetrics();
+        initSimulatedDevices();
+        initFirmwareFlashConcurrency();
+        initRasSamplingInterval();
+        initDeviceReadThreads();
+        initDeviceOperationTimeout();
+        initDeviceHotplugSettleTime();
+        initMetricIntervals();
+        initCacheDir();
     }
 
     static void initEnabledMetrics();
     static void initEnabledGPUIds();
     static void initPerfMetrics();
+    static void initSimulatedDevices();
+    static void initFirmwareFlashConcurrency();
+    static void initRasSamplingInterval();
+    static void initDeviceReadThreads();
+    static void initDeviceOperationTimeout();
+    static void initDeviceHotplugSettleTime();
+    static void initMetricIntervals();
+    static void initCacheDir();
 
     static std::set<MeasurementType>& getEnabledMetrics() {
         return enabled_metrics;
@@ -86,7 +117,14 @@ class Configuration {
         return XPUM_MODE;
     }
 
+    // the interval of the capability, TELEMETRY_DATA_MONITOR_FREQUENCE unless set
+    static int getMetricInterval(DeviceCapability capability);
+
+    // an interval of 0 puts the capability back to TELEMETRY_DATA_MONITOR_FREQUENCE
+    static void setMetricInterval(DeviceCapability capability, int interval);
+
    private:
+    static std::map<DeviceCapability, int> metric_intervals;
     static std::set<MeasurementType> enabled_metrics;
     static std::vector<PerfMetric_t> perf_metrics;
     static std::shared_ptr<std::set<int>> enabled_gpu_ids;
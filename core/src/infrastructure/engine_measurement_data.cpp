@@ -6,6 +6,8 @@
 
 #include "engine_measurement_data.h"
 
+#include <algorithm>
+
 namespace xpum {
 
 void EngineCollectionMeasurementData::addRawData(uint64_t handle,
@@ -14,15 +16,45 @@ void EngineCollectionMeasurementData::addRawData(uint64_t handle,
                                                  uint32_t subdevice_id,
                                                  uint64_t raw_active_time,
                                                  uint64_t raw_timestamp) {
-    (*p_engine_datas)[handle].type = type;
-    (*p_engine_datas)[handle].raw_active_time = raw_active_time;
-    (*p_engine_datas)[handle].raw_timestamp = raw_timestamp;
+    EngineRawData_t data;
+    data.handle = handle;
+    data.type = type;
+    data.on_subdevice = on_subdevice;
+    data.subdevice_id = subdevice_id;
+    data.raw_active_time = raw_active_time;
+    data.raw_timestamp = raw_timestamp;
+    p_engine_datas->push_back(data);
     addMetricCollectionMeasurementData(handle, on_subdevice, subdevice_id);
 }
 
+void EngineCollectionMeasurementData::sortEngines(const std::function<uint32_t(uint64_t)>& engine_index) {
+    // the index is the one given to the engine at discovery, so it does not
+    // move when another engine fails to be read
+    for (auto& data : *p_engine_datas) {
+        data.index = engine_index(data.handle);
+    }
+    p_engine_datas->erase(std::remove_if(p_engine_datas->begin(), p_engine_datas->end(), [](const EngineRawData_t& data) {
+                              return data.index == std::numeric_limits<uint32_t>::max();
+                          }),
+                          p_engine_datas->end());
+    std::sort(p_engine_datas->begin(), p_engine_datas->end(), engineBefore);
+}
+
+bool EngineCollectionMeasurementData::engineBefore(const EngineRawData_t& a, const EngineRawData_t& b) {
+    if (a.subdevice_id != b.subdevice_id) {
+        return a.subdevice_id < b.subdevice_id;
+    }
+    if (a.type != b.type) {
+        return a.type < b.type;
+    }
+    return a.index < b.index;
+}
+
 zes_engine_group_t EngineCollectionMeasurementData::getEngineType(uint64_t handle) {
-    if (p_engine_datas->find(handle) != p_engine_datas->end()) {
-        return (*p_engine_datas)[handle].type;
+    for (auto& data : *p_engine_datas) {
+        if (data.handle == handle) {
+            return data.type;
+        }
     }
     return ZES_ENGINE_GROUP_FORCE_UINT32;
 }
@@ -6,38 +6,63 @@
 
 #pragma once
 
+#include <functional>
+#include <vector>
+
 #include "measurement_data.h"
 #include "metric_collection_measurement_data.h"
 
 namespace xpum {
 
 struct EngineRawData_t {
+    uint64_t handle;
     zes_engine_group_t type;
+    bool on_subdevice;
+    uint32_t subdevice_id;
+    uint32_t index;
     uint64_t raw_active_time;
     uint64_t raw_timestamp;
+    uint64_t utilization;
     EngineRawData_t() {
+        handle = 0;
         type = ZES_ENGINE_GROUP_FORCE_UINT32;
+        on_subdevice = false;
+        subdevice_id = std::numeric_limits<uint32_t>::max();
+        index = 0;
         raw_active_time = std::numeric_limits<uint64_t>::max();
         raw_timestamp = 0;
+        utilization = std::numeric_limits<uint64_t>::max();
     };
 };
 
+/*
+  Engine activity of one device. The engines are kept in a flat array
+  ordered by (tile, engine type, index), which is the order the engine APIs
+  return, so the utilization can be computed and read back in a single pass
+  over contiguous entries. Call sortEngines() once all raw data is added,
+  with the lookup of the engine indexes given at discovery; the engines
+  without an index are dropped.
+*/
+
 class EngineCollectionMeasurementData : public MetricCollectionMeasurementData {
    public:
     EngineCollectionMeasurementData() {
-        p_engine_datas = std::make_shared<std::map<uint64_t, EngineRawData_t>>();
+        p_engine_datas = std::make_shared<std::vector<EngineRawData_t>>();
     }
     ~EngineCollectionMeasurementData() {
         p_engine_datas->clear();
     }
     void addRawData(uint64_t handle, zes_engine_group_t type, bool on_subdevice, uint32_t subdevice_id, uint64_t raw_active_time, uint64_t raw_timestamp);
-    const std::shared_ptr<std::map<uint64_t, EngineRawData_t>> getEngineRawDatas() {
+    void sortEngines(const std::function<uint32_t(uint64_t)>& engine_index);
+    const std::shared_ptr<std::vector<EngineRawData_t>> getEngineRawDatas() {
         return p_engine_datas;
     }
     zes_engine_group_t getEngineType(uint64_t handle);
+    // the (tile, engine type, index) order of the engines
+    static bool engineBefore(const EngineRawData_t& a, const EngineRawData_t& b);
 
    private:
-    std::shared_ptr<std::map<uint64_t, EngineRawData_t>> p_engine_datas;
+    std::shared_ptr<std::vector<EngineRawData_t>> p_engine_datas;
 };
 
 } //namespace xpum
\ No newline at end of file
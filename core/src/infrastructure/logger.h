@@ -6,15 +6,51 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
 #include "spdlog/cfg/env.h"
 #include "spdlog/spdlog.h"
 
 #define XPUM_LOG_INFO(...) spdlog::info(__VA_ARGS__)
 #define XPUM_LOG_WARN(...) spdlog::warn(__VA_ARGS__)
 #define XPUM_LOG_ERROR(...) spdlog::error(__VA_ARGS__)
+#define XPUM_LOG_FATAL(...) spdlog::critical(__VA_ARGS__)
+
+// TRACE and DEBUG logs are compiled out when building with XPUM_LOG_NO_DEBUG,
+// the arguments are still used so that no variable becomes unused
+#ifdef XPUM_LOG_NO_DEBUG
+#define XPUM_LOG_DEBUG(...)             \
+    do {                                \
+        if (false) {                    \
+            spdlog::debug(__VA_ARGS__); \
+        }                               \
+    } while (0)
+#define XPUM_LOG_TRACE(...)             \
+    do {                                \
+        if (false) {                    \
+            spdlog::trace(__VA_ARGS__); \
+        }                               \
+    } while (0)
+#else
 #define XPUM_LOG_DEBUG(...) spdlog::debug(__VA_ARGS__)
 #define XPUM_LOG_TRACE(...) spdlog::trace(__VA_ARGS__)
-#define XPUM_LOG_FATAL(...) spdlog::critical(__VA_ARGS__)
+#endif
+
+/*
+  Rate limited logs for hot paths, e.g.
+  XPUM_LOG_RATE_LIMITED(XPUM_LOG_ERROR, 1, 5, "Failed to execute scheduled threadpool task: {}", e.what());
+  logs at most 5 messages in a burst and then 1 message per second from
+  this call site. The arguments are not evaluated for suppressed messages.
+*/
+#define XPUM_LOG_RATE_LIMITED(LOG_MACRO, PER_SECOND, BURST, ...)                         \
+    do {                                                                                 \
+        static xpum::LogRateLimiter xpum_log_rate_limiter_((PER_SECOND), (BURST));      \
+        if (xpum_log_rate_limiter_.allow()) {                                            \
+            LOG_MACRO(__VA_ARGS__);                                                      \
+        }                               \
+    } while (0)
 
 namespace xpum {
 
@@ -24,4 +60,38 @@ class Logger {
         spdlog::cfg::load_env_levels();
     }
 };
+
+/*
+  Token bucket of one log call site, implemented as a generic cell rate
+  algorithm on a single atomic so that sampling threads never block on it.
+*/
+class LogRateLimiter {
+   public:
+    LogRateLimiter(uint32_t per_second, uint32_t burst)
+        : interval(per_second > 0 ? 1000000000LL / per_second : 1000000000LL),
+          tolerance(interval * (burst > 0 ? burst - 1 : 0)),
+          theoretical_arrival(0) {
+    }
+
+    bool allow() noexcept {
+        int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now().time_since_epoch())
+                          .count();
+        int64_t tat = theoretical_arrival.load(std::memory_order_relaxed);
+        while (true) {
+            int64_t start = tat > now ? tat : now;
+            if (start - now > tolerance) {
+                return false;
+            }
+            if (theoretical_arrival.compare_exchange_weak(tat, start + interval, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+
+   private:
+    const int64_t interval;
+    const int64_t tolerance;
+    std::atomic<int64_t> theoretical_arrival;
+};
 } // end namespace xpum
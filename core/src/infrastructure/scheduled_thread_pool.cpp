@@ -47,9 +47,10 @@ void ScheduledThreadPool::init(uint32_t& size) {
                 try {
                     task->run();
                 } catch (std::exception& e) {
-                    XPUM_LOG_ERROR("Failed to execute scheduled threadpool task: {}", e.what());
+                    // a periodic task failing fails at every run
+                    XPUM_LOG_RATE_LIMITED(XPUM_LOG_ERROR, 1, 10, "Failed to execute scheduled threadpool task: {}", e.what());
                 } catch (...) {
-                    XPUM_LOG_ERROR("Failed to execute scheduled threadpool task: unexpected exception");
+                    XPUM_LOG_RATE_LIMITED(XPUM_LOG_ERROR, 1, 10, "Failed to execute scheduled threadpool task: unexpected exception");
                 }
 
                 if (task->next()) {
@@ -89,13 +90,14 @@ bool ScheduledThreadPoolTask::after(std::shared_ptr<ScheduledThreadPoolTask> oth
 
 bool ScheduledThreadPoolTask::next() {
     if (this->remaining_exe_time == 0) return false;
-    this->scheduled_time += std::chrono::milliseconds{this->interval};
+    uint32_t interval = this->interval.load();
+    this->scheduled_time += std::chrono::milliseconds{interval};
     auto now = std::chrono::steady_clock::now();
     if (now > this->scheduled_time) {
         // the scheduled time is too far before now, advance it to a near time
         auto gap_to_now = std::chrono::duration_cast<std::chrono::milliseconds>(now - this->scheduled_time);
-        auto gaps = gap_to_now.count() / this->interval;
-        auto advanced_ms = std::chrono::milliseconds{this->interval * gaps};
+        auto gaps = gap_to_now.count() / interval;
+        auto advanced_ms = std::chrono::milliseconds{interval * gaps};
         this->scheduled_time += advanced_ms;
     }
     return true;
@@ -129,6 +131,10 @@ int ScheduledThreadPoolTask::getExeTime(){
     return exe_time;
 }
 
+void ScheduledThreadPoolTask::setInterval(uint32_t interval) {
+    this->interval.store(interval);
+}
+
 /// SchedulingQueue
 
 void SchedulingQueue::enqueue(std::shared_ptr<ScheduledThreadPoolTask> newTask) {
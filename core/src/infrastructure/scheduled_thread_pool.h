@@ -72,8 +72,15 @@ class ScheduledThreadPoolTask {
 
     int getExeTime();
 
+    /**
+     * @brief Changes the interval between successive executions, from the next execution on
+     * 
+     * @param interval the interval in milliseconds
+     */
+    void setInterval(uint32_t interval);
+
    private:
-    uint32_t interval;
+    std::atomic<uint32_t> interval;
     // One design option is that we can use remaining_exe_time to judge whether is the task finished.
     // But then this member will need to be public and should be sync. So, we choose the member exe_time to finish the work.
     int remaining_exe_time;
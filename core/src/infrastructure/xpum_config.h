@@ -0,0 +1,10 @@
+#pragma once
+
+#define XPUM_VERSION "1.2.31.20261019"
+#define XPUM_VERSION_GIT "00000000"
+
+#define XPUM_CONFIG_DIR "/usr/local/lib/xpu-smi/config/"
+#define XPUM_RESOURCES_DIR "/usr/local/lib/xpu-smi/resources/"
+
+#define PCI_IDS_FILE "pci.ids"
+#define PCI_IDS_CONFIG "pci.conf"
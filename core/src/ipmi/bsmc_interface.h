@@ -138,6 +138,7 @@ typedef struct
 typedef struct {
     int (*init)();
     int (*cmd)(bsmc_req *req, bsmc_res *res);
+    int (*cmd_batch)(bsmc_req *reqs, bsmc_res *res, int *errors, int count);
     int (*validate_res)(bsmc_res res, uint16_t res_size);
     void (*oem_req_init)(bsmc_req *req, void *addr, uint8_t cmd);
 } bsmc_hal_t;
@@ -44,9 +44,12 @@ UINT32 gFwReqSize;
 #include "tool.h"
 #include "amc/ipmi_amc_manager.h"
 
+#include <algorithm>
+#include <chrono>
 #include <vector>
 #include <string>
 #include <sstream>
+#include <thread>
 #include "ipmi.h"
 
 namespace xpum {
@@ -56,7 +59,7 @@ static void* amcManager;
 static percent_callback_func_t percentCallback;
 
 static int fw_update_device_count;
-static int fw_update_device_index;
+static int fw_update_skipped_count;
 
 void setPercentCallbackAndContext(percent_callback_func_t callback, void *pAmcManager) {
     percentCallback = callback;
@@ -67,7 +70,9 @@ void setPercentCallbackAndContext(percent_callback_func_t callback, void *pAmcMa
 
 #define MODULE_LIST_PATH "/proc/modules"
 
-#define UPDATE_WAIT_TIME_US 10
+#define UPDATE_WAIT_TIME_MS 10
+#define UPDATE_WAIT_MAX_TIME_MS 160
+#define SYNC_RETRIES 30 /* Retry for 3 seconds */
 #define BSMC_READY_TIMEOUT_S 5
 
 #define FW_UPDATE_TYPE_STR(n) ( \
@@ -75,13 +80,6 @@ void setPercentCallbackAndContext(percent_callback_func_t callback, void *pAmcMa
 
 #define CHECK_FW_VERSION 0 // 0 - will not check the firmware version whereas 1 will check firmware version //
 
-extern unsigned char gNetfn;
-extern unsigned char gCmd;
-extern uint8_t gData[267];
-extern uint8_t gUpdateType;
-extern unsigned short gSize;
-extern uint8_t gReqData[300];
-
 struct firmware_versions {
     fw_get_info_res bsmc;
     fw_get_info_res csmc_bootloader;
@@ -148,9 +146,6 @@ static int fw_get_info(ipmi_address_t *addr, fw_get_info_res *fw_info,
 
     bsmc_hal->oem_req_init(&req, addr, chip_info_cmd);
 
-    gNetfn = IPMI_INTEL_OEM_NETFN;
-    gCmd = chip_info_cmd;
-
     if (bsmc_hal->cmd(&req, &res))
         return NRV_IPMI_ERROR;
 
@@ -188,10 +183,6 @@ static int fw_update_start(ipmi_address_t *addr, uint8_t fw_update_type) {
     req.data_len = sizeof(fw_update_start_req);
     req.fw_update_start.fw_update_type = fw_update_type;
 
-    gNetfn = IPMI_INTEL_OEM_NETFN;
-    gCmd = IPMI_FW_UPDATE_START_CMD;
-    gUpdateType = fw_update_type;
-
     if (bsmc_hal->cmd(&req, &res))
         return NRV_IPMI_ERROR;
 
@@ -203,7 +194,7 @@ static int fw_update_start(ipmi_address_t *addr, uint8_t fw_update_type) {
 
 static int fw_update_sync(ipmi_address_t *addr, uint32_t *offset, uint32_t *size,
                           uint8_t *status) {
-    int retries = 30; /* Retry for 3 seconds*/
+    int retries = SYNC_RETRIES;
     bsmc_req req;
     bsmc_res res;
 
@@ -211,8 +202,6 @@ static int fw_update_sync(ipmi_address_t *addr, uint32_t *offset, uint32_t *size
 
     /* BSMC needs some time for flash preparation with disabled interrupts */
 retry:
-    gNetfn = IPMI_INTEL_OEM_NETFN;
-    gCmd = IPMI_FW_UPDATE_SYNC_CMD;
     if (bsmc_hal->cmd(&req, &res) ||
 #if !(__linux__) && (_MSC_VER < 1910)
         bsmc_hal->validate_res(res, SIZE_FW_UPDATE_SYNC_RES)) {
@@ -237,131 +226,252 @@ retry:
     return NRV_SUCCESS;
 }
 
-static int fw_update_transfer(ipmi_address_t *addr, unsigned short max_data_len,
-                              const uint8_t *data, size_t data_size, uint8_t *status) {
-    XPUM_LOG_INFO("Start transfer");
+/*
+ * State of the image transfer to one card. The BMC drives the transfer:
+ * each sync tells which part of the image it wants next, which is then
+ * sent in SEND_DATA chunks. The chunks carry no offset, so a card has one
+ * request in flight at a time; the cards being independent, a round sends
+ * the next request of every card together.
+ */
+typedef struct {
+    nrv_card *card;
+    int err;
+    bool done;
+    /* offset and size are those of the last sync */
+    bool synced;
+    uint8_t status;
+    uint32_t offset;
+    uint32_t size;
+    /* image bytes the card has taken */
+    uint32_t received;
+    int sync_retries;
+    bool i2c_addr_retried;
+    int wait_time_ms;
+    std::chrono::steady_clock::time_point wait_until;
+} fw_transfer;
+
+/*
+ * Asks the card how much of an IPMI_TRANSFER_SIZE_BIG request reaches it,
+ * so that the chunks are as large as the path to the card lets through.
+ * Cards without the command get IPMI_TRANSFER_SIZE_BIG chunks.
+ */
+static uint16_t fw_detect_transfer_size(ipmi_address_t *addr) {
     bsmc_req req;
     bsmc_res res;
-    int err;
-    uint32_t offset = 0;
-    uint32_t size = 0;
 
-#if !(__linux__) && (_MSC_VER < 1910)
-    UINT32 Index;
-#endif
+    bsmc_hal->oem_req_init(&req, addr, IPMI_TRANSFER_SIZE_DETECT);
+    req.data_len = IPMI_TRANSFER_SIZE_BIG;
+    memset(req.data, 0, req.data_len);
 
-    bsmc_hal->oem_req_init(&req, addr, IPMI_FW_UPDATE_SEND_DATA_CMD);
+    if (bsmc_hal->cmd(&req, &res) || res.completion_code != IPMI_CC_SUCCESS ||
+        res.data_len < sizeof(transfer_size_detect_res))
+        return IPMI_TRANSFER_SIZE_BIG;
 
-    while (true) {
-        /* Check FW update status */
-        err = fw_update_sync(addr, &offset, &size, status);
-        if (err) {
+    if (res.size_detect_res.received_bytes < IPMI_TRANSFER_SIZE_SMALL)
+        return IPMI_TRANSFER_SIZE_SMALL;
+    if (res.size_detect_res.received_bytes > IPMI_TRANSFER_SIZE_BIG)
+        return IPMI_TRANSFER_SIZE_BIG;
+    return res.size_detect_res.received_bytes;
+}
+
+static void fw_transfer_wait(fw_transfer *t, int wait_time_ms) {
+    t->wait_until = std::chrono::steady_clock::now() + std::chrono::milliseconds(wait_time_ms);
+}
+
+static void fw_transfer_finish(fw_transfer *t, int err) {
+    t->err = err;
+    t->done = true;
+}
+
+static void fw_transfer_req_init(fw_transfer *t, const uint8_t *data, size_t data_size, bsmc_req *req) {
+    if (!t->synced) {
+        bsmc_hal->oem_req_init(req, &t->card->ipmi_address, IPMI_FW_UPDATE_SYNC_CMD);
+        return;
+    }
+
+    bsmc_hal->oem_req_init(req, &t->card->ipmi_address, IPMI_FW_UPDATE_SEND_DATA_CMD);
+    if (t->status == IPMI_FW_UPDATE_GET_FILE_SIZE) {
+        req->data_len = std::min<uint32_t>(t->size, sizeof(data_size));
+        memcpy(req->data, &data_size, req->data_len);
+    } else {
+        req->data_len = std::min<uint32_t>(t->size, t->card->max_transfer_len);
+        memcpy(req->data, &data[t->offset], req->data_len);
+    }
+}
+
+static void fw_transfer_sync_res(fw_transfer *t, bsmc_res *res, int err, size_t data_size) {
+    if (err || bsmc_hal->validate_res(*res, sizeof(fw_update_sync_res))) {
+        /* BSMC needs some time for flash preparation with disabled interrupts */
+        if (t->sync_retries) {
+            t->sync_retries--;
+            fw_transfer_wait(t, WAIT_100_MS);
+        } else if (!t->i2c_addr_retried) {
             XPUM_LOG_INFO("Retry with slave addr 0xce");
-            // retry with new I2C addr
-            addr->i2c_addr = CARD_FIRST_I2C_ADDR;
-            err = fw_update_sync(addr, &offset, &size, status);
-            if (err){
-                XPUM_LOG_ERROR("Fail to fw_update_sync, err {}", err);
-                goto exit;
-            }
+            t->card->ipmi_address.i2c_addr = CARD_FIRST_I2C_ADDR;
+            t->i2c_addr_retried = true;
+            t->sync_retries = SYNC_RETRIES;
+        } else {
+            XPUM_LOG_ERROR("Fail to fw_update_sync, err {}", NRV_IPMI_ERROR);
+            fw_transfer_finish(t, NRV_IPMI_ERROR);
         }
+        return;
+    }
+    t->sync_retries = SYNC_RETRIES;
+    t->status = res->fw_update_sync.status;
 
-        if (*status == IPMI_FW_UPDATE_WAIT) {
-            do_sleep(UPDATE_WAIT_TIME_US);
-            continue;
-        } else if (*status == IPMI_FW_UPDATE_GET_FILE_SIZE) {
-            req.data_len = size;
-            memcpy(req.data, &data_size, size);
-            gNetfn = IPMI_INTEL_OEM_NETFN;
-            gCmd = IPMI_FW_UPDATE_SEND_DATA_CMD;
-            err = bsmc_hal->cmd(&req, &res);
-            if (err){
-                XPUM_LOG_ERROR("Fail to do command IPMI_FW_UPDATE_GET_FILE_SIZE, err {}", err);
-                goto exit;
-            }
-            continue;
-        } else if (*status != IPMI_FW_UPDATE_READ) {
-            XPUM_LOG_ERROR("go to exit, status {}", *status);
-            switch (*status) {
-                case IPMI_FW_UPDATE_FAIL:
-                    err = NRV_IPMI_ERROR_FW_UPDATE_FAIL;
-                    break;
-                case IPMI_FW_UPDATE_SIGNATURE_FAIL:
-                    err = NRV_IPMI_ERROR_FW_UPDATE_SIGNATURE_FAIL;
-                    break;
-                case IPMI_FW_UPDATE_IMAGE_TO_LARGE_FAIL:
-                    err = NRV_IPMI_ERROR_FW_UPDATE_IMAGE_TO_LARGE_FAIL;
-                    break;
-                case IPMI_FW_UPDATE_NO_IMAGE_SIZE_FAIL:
-                    err = NRV_IPMI_ERROR_FW_UPDATE_NO_IMAGE_SIZE_FAIL;
-                    break;
-                case IPMI_FW_UPDATE_PACKET_TO_LARGE_FAIL:
-                    err = NRV_IPMI_ERROR_FW_UPDATE_PACKET_TO_LARGE_FAIL;
-                    break;
-                case IPMI_FW_UPDATE_TO_MANY_RETRIES_FAIL:
-                    err = NRV_IPMI_ERROR_FW_UPDATE_TO_MANY_RETRIES_FAIL;
-                    break;
-                case IPMI_FW_UPDATE_WRITE_TO_FLASH_FAIL:
-                    err = NRV_IPMI_ERROR_FW_UPDATE_WRITE_TO_FLASH_FAIL;
-                    break;
-            }
-            goto exit;
+    if (t->status == IPMI_FW_UPDATE_WAIT) {
+        fw_transfer_wait(t, t->wait_time_ms);
+        t->wait_time_ms = std::min(t->wait_time_ms * 2, UPDATE_WAIT_MAX_TIME_MS);
+        return;
+    }
+    t->wait_time_ms = UPDATE_WAIT_TIME_MS;
+
+    if (t->status == IPMI_FW_UPDATE_GET_FILE_SIZE) {
+        t->size = res->fw_update_sync.size;
+        t->synced = true;
+        return;
+    }
+    if (t->status != IPMI_FW_UPDATE_READ) {
+        if (t->status != IPMI_FW_UPDATE_COMPLETE)
+            XPUM_LOG_ERROR("go to exit, status {}", t->status);
+        switch (t->status) {
+            case IPMI_FW_UPDATE_FAIL:
+                err = NRV_IPMI_ERROR_FW_UPDATE_FAIL;
+                break;
+            case IPMI_FW_UPDATE_SIGNATURE_FAIL:
+                err = NRV_IPMI_ERROR_FW_UPDATE_SIGNATURE_FAIL;
+                break;
+            case IPMI_FW_UPDATE_IMAGE_TO_LARGE_FAIL:
+                err = NRV_IPMI_ERROR_FW_UPDATE_IMAGE_TO_LARGE_FAIL;
+                break;
+            case IPMI_FW_UPDATE_NO_IMAGE_SIZE_FAIL:
+                err = NRV_IPMI_ERROR_FW_UPDATE_NO_IMAGE_SIZE_FAIL;
+                break;
+            case IPMI_FW_UPDATE_PACKET_TO_LARGE_FAIL:
+                err = NRV_IPMI_ERROR_FW_UPDATE_PACKET_TO_LARGE_FAIL;
+                break;
+            case IPMI_FW_UPDATE_TO_MANY_RETRIES_FAIL:
+                err = NRV_IPMI_ERROR_FW_UPDATE_TO_MANY_RETRIES_FAIL;
+                break;
+            case IPMI_FW_UPDATE_WRITE_TO_FLASH_FAIL:
+                err = NRV_IPMI_ERROR_FW_UPDATE_WRITE_TO_FLASH_FAIL;
+                break;
         }
+        fw_transfer_finish(t, err);
+        return;
+    }
 
-        if ((offset + size) > data_size) {
-            XPUM_LOG_ERROR("Unexpected end of firmware image");
-            err = NRV_INVALID_FIRMWARE_IMAGE;
-            goto exit;
+    t->offset = res->fw_update_sync.offset;
+    t->size = res->fw_update_sync.size;
+    if ((t->offset + t->size) > data_size) {
+        XPUM_LOG_ERROR("Unexpected end of firmware image");
+        fw_transfer_finish(t, NRV_INVALID_FIRMWARE_IMAGE);
+        return;
+    }
+    t->received = t->offset;
+    t->synced = t->size > 0;
+}
+
+static void fw_transfer_send_res(fw_transfer *t, bsmc_req *req, bsmc_res *res, int err) {
+    if (t->status == IPMI_FW_UPDATE_GET_FILE_SIZE) {
+        if (err) {
+            XPUM_LOG_ERROR("Fail to do command IPMI_FW_UPDATE_GET_FILE_SIZE, err {}", err);
+            fw_transfer_finish(t, err);
+            return;
         }
+        t->synced = false;
+        return;
+    }
 
-        while (size > 0) {
-#ifdef _WIN32
-            req.data_len = getMin(size, max_data_len);
-#else
-            req.data_len = min(size, max_data_len);
-#endif
-            memcpy(req.data, &data[offset], req.data_len);
+    if (err || bsmc_hal->validate_res(*res, COMPLETION_CODE_SIZE)) {
+        /* the BMC tells again which part of the image it waits for */
+        if (t->card->max_transfer_len > IPMI_TRANSFER_SIZE_SMALL) {
+            XPUM_LOG_WARN("Fail to transfer with big data size, try with small data size");
+            t->card->max_transfer_len = IPMI_TRANSFER_SIZE_SMALL;
+            t->synced = false;
+            return;
+        }
+        XPUM_LOG_ERROR("Error during send data, err {}", err);
+        fw_transfer_finish(t, NRV_FIRMWARE_UPDATE_ERROR);
+        return;
+    }
 
-#if !(__linux__) && (_MSC_VER < 1910)
-            gFwReqSize = (UINT32)req.data_len;
-            for (Index = 0; Index < gFwReqSize; Index++) {
-                gFwReqData[Index] = req.data[Index];
-            }
-#endif
+    t->offset += req->data_len;
+    t->size -= req->data_len;
+    t->received = t->offset;
+    if (t->size == 0)
+        t->synced = false;
+}
 
-            gNetfn = IPMI_INTEL_OEM_NETFN;
-            gCmd = IPMI_FW_UPDATE_SEND_DATA_CMD;
-            gSize = req.data_len;
-            for (int index = 0; index < gSize; index++)
-                gReqData[index] = req.data[index];
+static void fw_transfer_progress(fw_transfer *transfers, int count, size_t data_size,
+                                 std::chrono::steady_clock::time_point begin) {
+    if (!percentCallback || !data_size)
+        return;
+
+    uint64_t received = 0;
+    for (int i = 0; i < count; i++)
+        received += transfers[i].done ? data_size : transfers[i].received;
+
+    int total = fw_update_skipped_count + count;
+    if (total < fw_update_device_count)
+        total = fw_update_device_count;
+    uint32_t percent = (fw_update_skipped_count * 100 + received * 100 / data_size) / total;
+
+    auto elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                          std::chrono::steady_clock::now() - begin)
+                          .count();
+    uint32_t bytes_per_second = elapsed_us > 0 ? received * 1000000 / elapsed_us : 0;
+    percentCallback(percent, bytes_per_second, amcManager);
+}
 
-            err = bsmc_hal->cmd(&req, &res);
-            if (err) {
-                XPUM_LOG_ERROR("Error during send data, err {}", err);
-                err = NRV_FIRMWARE_UPDATE_ERROR;
-                goto exit;
-            }
+/*
+ * Transfers the image to the cards, started with fw_update_start. Each
+ * round sends the next request of every card that is not waiting for the
+ * BMC, a card in IPMI_FW_UPDATE_WAIT is synced again after a backoff
+ * starting at UPDATE_WAIT_TIME_MS.
+ */
+static void fw_update_transfer(fw_transfer *transfers, int count, const uint8_t *data, size_t data_size) {
+    XPUM_LOG_INFO("Start transfer");
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<bsmc_req> reqs(count);
+    std::vector<bsmc_res> res(count);
+    std::vector<int> errors(count);
+    std::vector<fw_transfer *> active;
 
-            if (bsmc_hal->validate_res(res, COMPLETION_CODE_SIZE)) {
-                XPUM_LOG_ERROR("Error validate ipmi response");
-                err = NRV_FIRMWARE_UPDATE_ERROR;
-                goto exit;
+    while (true) {
+        auto now = std::chrono::steady_clock::now();
+        auto wake_up = std::chrono::steady_clock::time_point::max();
+        active.clear();
+        for (int i = 0; i < count; i++) {
+            fw_transfer *t = &transfers[i];
+            if (t->done)
+                continue;
+            if (t->wait_until > now) {
+                wake_up = std::min(wake_up, t->wait_until);
+                continue;
             }
+            fw_transfer_req_init(t, data, data_size, &reqs[active.size()]);
+            active.push_back(t);
+        }
 
-            size -= req.data_len;
-            offset += req.data_len;
+        if (active.empty()) {
+            if (wake_up == std::chrono::steady_clock::time_point::max())
+                break;
+            std::this_thread::sleep_until(wake_up);
+            continue;
         }
 
-        if (percentCallback) {
-            int percent = (fw_update_device_index * 100 + (offset * 100) / data_size) / fw_update_device_count;
-            percentCallback(percent, amcManager);
+        bsmc_hal->cmd_batch(reqs.data(), res.data(), errors.data(), active.size());
+
+        for (size_t k = 0; k < active.size(); k++) {
+            if (reqs[k].cmd == IPMI_FW_UPDATE_SYNC_CMD)
+                fw_transfer_sync_res(active[k], &res[k], errors[k], data_size);
+            else
+                fw_transfer_send_res(active[k], &reqs[k], &res[k], errors[k]);
         }
 
-        //log_progress_next();
+        fw_transfer_progress(transfers, count, data_size, begin);
     }
-
-exit:
-    return err;
 }
 
 static int pci_reset_devices(pci_address_t *address, int pci_address_count) {
@@ -389,8 +499,6 @@ static int discover_pci_address_list(nrv_list *cards, pci_address_t *pci_address
         card = &cards->card[i];
         if (!card->pci_address_valid) {
             bsmc_hal->oem_req_init(&req, &card->ipmi_address, IPMI_CARD_GET_INFO_CMD);
-            gNetfn = IPMI_INTEL_OEM_NETFN;
-            gCmd = IPMI_CARD_GET_INFO_CMD;
             if (bsmc_hal->cmd(&req, &res))
                 err = NRV_IPMI_ERROR;
 
@@ -434,31 +542,8 @@ static int check_image(const char *file) {
     return NRV_SUCCESS;
 }
 
-static int fw_update(nrv_card *card, const uint8_t *data, size_t data_size, fw_get_info_res *version,
-                     uint8_t fw_update_type) {
-    uint8_t chip_status = 0;
-    int err;
-
-    XPUM_LOG_INFO("Initializing {} firmware update",
-                  FW_UPDATE_TYPE_STR(fw_update_type));
-    XPUM_LOG_INFO("Actual {} firmware version {}.{}.{}.{}", FW_UPDATE_TYPE_STR(fw_update_type),
-                  std::to_string(version->major), std::to_string(version->minor), std::to_string(version->patch), std::to_string(version->build));
-
-    if (fw_update_start(&card->ipmi_address, fw_update_type)) {
-        XPUM_LOG_ERROR("{} firmware update initialization failed",
-                       FW_UPDATE_TYPE_STR(fw_update_type));
-        return NRV_FIRMWARE_UPDATE_ERROR;
-    }
-
-    XPUM_LOG_INFO("Updating {} on card {}", FW_UPDATE_TYPE_STR(fw_update_type), card->id);
-
-    err = fw_update_transfer(&card->ipmi_address, card->max_transfer_len, data, data_size, &chip_status);
-    if (err) {
-        XPUM_LOG_WARN("Fail to transfer with big data size, try with small data size");
-        err = fw_update_transfer(&card->ipmi_address, IPMI_TRANSFER_SIZE_SMALL, data, data_size, &chip_status);
-        if (err)
-            return err;
-    }
+static int fw_update_check_status(uint8_t chip_status, uint8_t fw_update_type) {
+    int err = NRV_SUCCESS;
 
     switch (chip_status) {
         case IPMI_FW_UPDATE_COMPLETE:
@@ -510,6 +595,47 @@ static int fw_update(nrv_card *card, const uint8_t *data, size_t data_size, fw_g
     return err;
 }
 
+int fw_update_cards(nrv_card **cards, int count, const uint8_t *data, size_t data_size,
+                    uint8_t fw_update_type) {
+    std::vector<fw_transfer> transfers;
+    int err = NRV_SUCCESS;
+
+    XPUM_LOG_INFO("Initializing {} firmware update",
+                  FW_UPDATE_TYPE_STR(fw_update_type));
+
+    for (int i = 0; i < count; i++) {
+        nrv_card *card = cards[i];
+        card->max_transfer_len = fw_detect_transfer_size(&card->ipmi_address);
+
+        if (fw_update_start(&card->ipmi_address, fw_update_type)) {
+            XPUM_LOG_ERROR("{} firmware update initialization failed on card {}",
+                           FW_UPDATE_TYPE_STR(fw_update_type), card->id);
+            if (!err)
+                err = NRV_FIRMWARE_UPDATE_ERROR;
+            continue;
+        }
+
+        XPUM_LOG_INFO("Updating {} on card {} in chunks of {} bytes", FW_UPDATE_TYPE_STR(fw_update_type),
+                      card->id, card->max_transfer_len);
+
+        fw_transfer t{};
+        t.card = card;
+        t.sync_retries = SYNC_RETRIES;
+        t.wait_time_ms = UPDATE_WAIT_TIME_MS;
+        transfers.push_back(t);
+    }
+
+    fw_update_transfer(transfers.data(), transfers.size(), data, data_size);
+
+    for (auto &t : transfers) {
+        int card_err = t.err ? t.err : fw_update_check_status(t.status, fw_update_type);
+        if (card_err && !err)
+            err = card_err;
+    }
+
+    return err;
+}
+
 static int wait_for_bsmc(ipmi_address_t *addr, fw_get_info_res prev_ver) {
     int retries = BSMC_READY_TIMEOUT_S;
     fw_get_info_res curr_ver;
@@ -587,10 +713,11 @@ static int cmd_firmware_update(const char* file, nrv_list cards, uint8_t *bsmc_d
     pci_address_t pci_address[MAX_CARD_NO];
     int pci_address_count = 0;
     bool reset_failed = false;
-    fw_update_device_index = 0;
+    std::vector<nrv_card *> update_cards;
+    fw_update_skipped_count = 0;
     fw_update_device_count = cards.count;
     if (percentCallback) {
-        percentCallback(0, amcManager);
+        percentCallback(0, 0, amcManager);
     }
 
 #if __linux__
@@ -617,27 +744,31 @@ static int cmd_firmware_update(const char* file, nrv_list cards, uint8_t *bsmc_d
         //if ( cards.count > 0 ) { //only one card now
         nrv_card *card = &cards.card[i];
 
-        fw_update_device_index = i;
-
         err = get_fw_version(&card->ipmi_address, &prev_ver[i]);
         if (err)
             goto exit;
 
         if(parse_success && fw_match(&cur_fw_version, &prev_ver[i])){
+            fw_update_skipped_count++;
             if (percentCallback) {
-                int percent = (fw_update_device_index + 1) * 100  / fw_update_device_count;
-                percentCallback(percent, amcManager);
+                int percent = fw_update_skipped_count * 100  / fw_update_device_count;
+                percentCallback(percent, 0, amcManager);
             }
             continue;
         }
-        card->max_transfer_len = IPMI_TRANSFER_SIZE_BIG;
 
-        if (bsmc_data) {
-            err = fw_update(card, bsmc_data, bsmc_size, &prev_ver[i].bsmc,
-                            FW_UPDATE_TYPE_BSMC);
-            if (err)
-                goto exit;
-        }
+        XPUM_LOG_INFO("Actual {} firmware version on card {}: {}.{}.{}.{}", FW_UPDATE_TYPE_STR(FW_UPDATE_TYPE_BSMC), card->id,
+                      std::to_string(prev_ver[i].bsmc.major), std::to_string(prev_ver[i].bsmc.minor),
+                      std::to_string(prev_ver[i].bsmc.patch), std::to_string(prev_ver[i].bsmc.build));
+        update_cards.push_back(card);
+    }
+
+    /* the cards are independent, their images are transferred together */
+    if (bsmc_data && !update_cards.empty()) {
+        err = fw_update_cards(update_cards.data(), update_cards.size(), bsmc_data, bsmc_size,
+                              FW_UPDATE_TYPE_BSMC);
+        if (err)
+            goto exit;
     }
 
 #if 0
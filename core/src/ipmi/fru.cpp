@@ -14,13 +14,6 @@
 
 namespace xpum {
 
-extern unsigned char gNetfn;
-extern unsigned char gCmd;
-extern uint8_t gDeviceId;
-extern uint8_t gOffsetLsb;
-extern uint8_t gOffsetMsb;
-extern uint8_t gReadCount;
-
 int get_fru_data_size(ipmi_address_t *ipmi_address) {
     bsmc_req req;
     bsmc_res res;
@@ -29,8 +22,6 @@ int get_fru_data_size(ipmi_address_t *ipmi_address) {
     req.cmd = IPMI_FRU_GET_INFO;
     req.fru_area_info.device_id = 0;
     req.data_len = sizeof(fru_get_area_info_req_t);
-    gNetfn = IPMI_STORAGE_NETFN;
-    gCmd = IPMI_FRU_GET_INFO;
 
     if (bsmc_hal->cmd(&req, &res)) {
         return -1;
@@ -53,9 +44,6 @@ int get_fru_data(ipmi_address_t *ipmi_address, uint16_t fru_size, uint8_t *out_d
 	req.fru_read.device_id = 0;
 	req.fru_read.read_count = 0x1e;
 
-	gNetfn = IPMI_STORAGE_NETFN;
-	gCmd = IPMI_FRU_READ_DATA;
-
 	/* Read FRU data from 0 offset */
 	for (uint16_t offset = 0; offset < fru_size; offset += res.fru_read.bytes_read) {
 		req.fru_read.offset_lsb = 0xff & offset;
@@ -64,11 +52,6 @@ int get_fru_data(ipmi_address_t *ipmi_address, uint16_t fru_size, uint8_t *out_d
 		if (offset + req.fru_read.read_count > fru_size)
 			req.fru_read.read_count = fru_size - offset;
 
-        gDeviceId = 0;
-		gOffsetLsb = req.fru_read.offset_lsb;
-		gOffsetMsb = req.fru_read.offset_msb;
-		gReadCount = req.fru_read.read_count;
-
 		if (bsmc_hal->cmd(&req, &res))
 			return NRV_IPMI_ERROR;
 
@@ -37,9 +37,6 @@ static bsmc_interface_t iface;
 //extern nnp_hal scr_hal;
 extern bsmc_hal_t *bsmc_hal;
 
-extern unsigned char gNetfn;
-extern unsigned char gCmd;
-
 /*
 nnp_hal *ops_table[NUM_BOARD_PRODUCTS] = {
     &lcr_hal,
@@ -73,9 +70,7 @@ static int get_device_id(nrv_card *card, unsigned char *data) {
     bsmc_res res{};
 
     bsmc_hal->oem_req_init(&req, &card->ipmi_address, IPMI_CARD_GET_INFO_CMD);
-
-    gNetfn = IPMI_GET_DEVID_OEM_NETFN;
-    gCmd = IPMI_CARD_GET_INFO_CMD;
+    req.netfn = IPMI_GET_DEVID_OEM_NETFN;
 
     if (bsmc_hal->cmd(&req, &res))
         return NRV_IPMI_ERROR;
@@ -85,17 +80,7 @@ static int get_device_id(nrv_card *card, unsigned char *data) {
     return NRV_SUCCESS;
 }
 
-static int card_detect(nrv_card *card) {
-    bsmc_req req{};
-    bsmc_res res{};
-    bsmc_hal->oem_req_init(&req, &card->ipmi_address, IPMI_CARD_GET_INFO_CMD);
-
-    gNetfn = IPMI_INTEL_OEM_NETFN;
-    gCmd = IPMI_CARD_GET_INFO_CMD;
-
-    if (bsmc_hal->cmd(&req, &res))
-        return NRV_IPMI_ERROR;
-
+static int card_detect(nrv_card *card, bsmc_res &res) {
     if (bsmc_hal->validate_res(res, CARD_GET_INFO_RES_MIN_SIZE))
         return NRV_IPMI_ERROR;
 
@@ -177,6 +162,8 @@ static int init_card_list() {
 
     uint8_t slaveAddrs[]{CARD_FIRST_I2C_ADDR_OLD, CARD_FIRST_I2C_ADDR};
 
+    // every address is probed in one batch, most of them have no card
+    std::vector<nrv_card> slots;
     for (auto i2c_addr : slaveAddrs) {
         for (uint8_t slot = 0; slot < slot_count; slot++) {
             card.ipmi_address = (ipmi_address_t){
@@ -184,19 +171,31 @@ static int init_card_list() {
                 .slot = slot,
                 .i2c_addr = i2c_addr,
             };
-
-            err = card_detect(&card);
-            if (err)
-                continue;
-            // get sdr list
-            get_sdr_list(card);
-            g_list.card[g_list.count] = card;
-            g_list.card[g_list.count].id = g_list.count;
-
-            g_list.count++;
+            slots.push_back(card);
         }
     }
 
+    std::vector<bsmc_req> reqs(slots.size());
+    std::vector<bsmc_res> res(slots.size());
+    std::vector<int> errors(slots.size());
+    for (size_t i = 0; i < slots.size(); i++)
+        bsmc_hal->oem_req_init(&reqs[i], &slots[i].ipmi_address, IPMI_CARD_GET_INFO_CMD);
+    bsmc_hal->cmd_batch(reqs.data(), res.data(), errors.data(), slots.size());
+
+    for (size_t i = 0; i < slots.size(); i++) {
+        if (errors[i])
+            continue;
+        err = card_detect(&slots[i], res[i]);
+        if (err)
+            continue;
+        // get sdr list
+        get_sdr_list(slots[i]);
+        g_list.card[g_list.count] = slots[i];
+        g_list.card[g_list.count].id = g_list.count;
+
+        g_list.count++;
+    }
+
     if (g_list.count)
         return NRV_SUCCESS;
 
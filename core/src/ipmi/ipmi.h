@@ -36,7 +36,8 @@ namespace xpum {
 #define NRV_IPMI_ERROR_FW_UPDATE_WRITE_TO_FLASH_FAIL 21
 #define NRV_COMMAND_NOT_EXIST 127
 
-typedef void (*percent_callback_func_t)(uint32_t percent, void *pAmcManager);
+// bytes_per_second is the image transfer rate since the start of the transfer
+typedef void (*percent_callback_func_t)(uint32_t percent, uint32_t bytes_per_second, void *pAmcManager);
 
 int cmd_firmware(const char *file, unsigned int versions[4]);
 
@@ -0,0 +1,221 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file ipmi_channel.cpp
+ */
+
+#ifdef __linux__
+#include "ipmi_channel.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <climits>
+
+#include "infrastructure/logger.h"
+#include "ipmi.h"
+
+namespace xpum {
+
+#define RESPONSE_TIMEOUT_SEC 50
+
+class KernelIpmiDevice : public IpmiDevice {
+   public:
+    explicit KernelIpmiDevice(int dev) : dev(dev) {
+    }
+
+    ~KernelIpmiDevice() {
+        close(dev);
+    }
+
+    int fd() override {
+        return dev;
+    }
+
+    int send(struct ipmi_req* req) override {
+        return ioctl(dev, IPMICTL_SEND_COMMAND, req);
+    }
+
+    int receive(struct ipmi_recv* recv) override {
+        /*
+         * IPMICTL_RECEIVE_MSG_TRUNC grab message from queue when response
+         * length is too small. It helps to avoid plugging message queue.
+         */
+        return ioctl(dev, IPMICTL_RECEIVE_MSG_TRUNC, recv);
+    }
+
+   private:
+    int dev;
+};
+
+IpmiChannel::IpmiChannel(std::unique_ptr<IpmiDevice> device)
+    : device(std::move(device)), reading(false), next_msgid(0) {
+}
+
+std::shared_ptr<IpmiChannel> IpmiChannel::open(const char* path) {
+    int dev = ::open(path, O_RDWR | O_CLOEXEC);
+    if (dev < 0) {
+        return nullptr;
+    }
+    return std::make_shared<IpmiChannel>(std::unique_ptr<IpmiDevice>(new KernelIpmiDevice(dev)));
+}
+
+void IpmiChannel::transact(IpmiTransfer& transfer) {
+    std::vector<IpmiTransfer> transfers{transfer};
+    transactAll(transfers, 1);
+    transfer = transfers[0];
+}
+
+void IpmiChannel::transactAll(std::vector<IpmiTransfer>& transfers, std::size_t window) {
+    std::vector<Pending> pendings(transfers.size());
+    std::vector<std::size_t> in_flight;
+    std::size_t next = 0;
+    window = std::max(window, (std::size_t)1);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (next < transfers.size() || !in_flight.empty()) {
+        while (next < transfers.size() && in_flight.size() < window) {
+            pendings[next].transfer = &transfers[next];
+            pendings[next].done = false;
+            lock.unlock();
+            submit(pendings[next]);
+            lock.lock();
+            in_flight.push_back(next++);
+        }
+        waitAny(lock, pendings, in_flight);
+        in_flight.erase(std::remove_if(in_flight.begin(), in_flight.end(),
+                                       [&](std::size_t i) { return pendings[i].done; }),
+                        in_flight.end());
+    }
+}
+
+void IpmiChannel::submit(Pending& pending) {
+    IpmiTransfer* transfer = pending.transfer;
+    struct ipmi_req req;
+    struct ipmi_system_interface_addr req_addr;
+
+    req_addr.addr_type = IPMI_SYSTEM_INTERFACE_ADDR_TYPE;
+    req_addr.channel = IPMI_BMC_CHANNEL;
+    req_addr.lun = 0;
+
+    req.addr = (unsigned char*)&req_addr;
+    req.addr_len = sizeof(req_addr);
+    req.msg.netfn = transfer->netfn;
+    req.msg.cmd = transfer->cmd;
+    req.msg.data = transfer->data;
+    req.msg.data_len = transfer->data_len;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.msgid = req.msgid = next_msgid++;
+        pending.deadline = Clock::now() + std::chrono::seconds(RESPONSE_TIMEOUT_SEC);
+        // registered first, the response may be read before send returns
+        waiters[pending.msgid] = &pending;
+    }
+    int err = device->send(&req);
+    if (err) {
+        XPUM_LOG_WARN(
+            "Ioctl IPMICTL_SEND_COMMAND return error:{}, "
+            "errno: {}({})\n",
+            err, errno, strerror(errno));
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!pending.done) {
+            complete(pending, NRV_IPMI_ERROR);
+        }
+    }
+}
+
+void IpmiChannel::complete(Pending& pending, int result) {
+    waiters.erase(pending.msgid);
+    pending.transfer->result = result;
+    pending.done = true;
+}
+
+void IpmiChannel::waitAny(std::unique_lock<std::mutex>& lock, std::vector<Pending>& pendings, const std::vector<std::size_t>& in_flight) {
+    while (true) {
+        Clock::time_point deadline = Clock::time_point::max();
+        for (auto i : in_flight) {
+            if (pendings[i].done) {
+                return;
+            }
+            deadline = std::min(deadline, pendings[i].deadline);
+        }
+        auto now = Clock::now();
+        if (now >= deadline) {
+            for (auto i : in_flight) {
+                if (pendings[i].deadline <= now) {
+                    XPUM_LOG_WARN("No response to IPMI request netfn: {:#x}, cmd: {:#x}", pendings[i].transfer->netfn, pendings[i].transfer->cmd);
+                    complete(pendings[i], NRV_IPMI_ERROR);
+                }
+            }
+            continue;
+        }
+        if (reading) {
+            cv.wait_until(lock, deadline);
+            continue;
+        }
+
+        reading = true;
+        lock.unlock();
+        struct pollfd pfd;
+        pfd.fd = device->fd();
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        auto timeout = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count() + 1;
+        int ret = poll(&pfd, 1, (int)std::min(timeout, (decltype(timeout))INT_MAX));
+        if (ret > 0) {
+            receiveAll();
+        } else if (ret < 0 && errno != EINTR) {
+            XPUM_LOG_WARN("Poll on IPMI device return error, errno: {}({})", errno, strerror(errno));
+        }
+        lock.lock();
+        reading = false;
+        cv.notify_all();
+    }
+}
+
+void IpmiChannel::receiveAll() {
+    unsigned char buf[IPMI_MAX_MSG_LENGTH];
+    struct ipmi_recv recv;
+    struct ipmi_addr recv_addr;
+
+    while (true) {
+        recv.addr = (unsigned char*)&recv_addr;
+        recv.addr_len = sizeof(recv_addr);
+        recv.msg.data = buf;
+        recv.msg.data_len = sizeof(buf);
+        int err = device->receive(&recv);
+        if (err) {
+            if (errno != EAGAIN) {
+                XPUM_LOG_WARN(
+                    "Ioctl call IPMICTL_RECEIVE_MSG return error: {}, "
+                    "errno: {}({})\n",
+                    err, errno, strerror(errno));
+            }
+            return;
+        }
+        if (recv.recv_type != IPMI_RESPONSE_RECV_TYPE) {
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = waiters.find(recv.msgid);
+        if (it == waiters.end()) {
+            XPUM_LOG_DEBUG("Drop IPMI response {} of a timed out request", recv.msgid);
+            continue;
+        }
+        IpmiTransfer* transfer = it->second->transfer;
+        unsigned short len = std::min(recv.msg.data_len, transfer->response_len);
+        memcpy(transfer->response, buf, len);
+        transfer->response_len = len;
+        complete(*it->second, NRV_SUCCESS);
+    }
+}
+
+} // namespace xpum
+#endif
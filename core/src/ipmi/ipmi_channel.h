@@ -0,0 +1,106 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file ipmi_channel.h
+ */
+
+#pragma once
+
+#ifdef __linux__
+#include <linux/ipmi.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace xpum {
+
+/*
+  The device the IPMI messages go through, /dev/ipmi0 or a fake one. The
+  calls have the semantics of the IPMICTL_SEND_COMMAND and
+  IPMICTL_RECEIVE_MSG_TRUNC ioctls: receive() fails with EAGAIN when no
+  message is queued, and fd() polls readable when one is.
+*/
+
+class IpmiDevice {
+   public:
+    virtual ~IpmiDevice() {
+    }
+
+    virtual int fd() = 0;
+
+    virtual int send(struct ipmi_req* req) = 0;
+
+    virtual int receive(struct ipmi_recv* recv) = 0;
+};
+
+struct IpmiTransfer {
+    unsigned char netfn;
+    unsigned char cmd;
+    unsigned char* data;
+    unsigned short data_len;
+    unsigned char* response;
+    // size of response, then length of the response received
+    unsigned short response_len;
+    // NRV_SUCCESS or NRV_IPMI_ERROR
+    int result;
+};
+
+/*
+  Sends requests to the BMC and dispatches the responses to their waiters
+  by message id, so that several requests can be in flight at a time, sent
+  by one thread or by several. The responses are waited for with poll():
+  one of the waiting threads reads the device and hands the responses it
+  gets to the others.
+*/
+
+class IpmiChannel {
+   public:
+    explicit IpmiChannel(std::unique_ptr<IpmiDevice> device);
+
+    // nullptr, with errno set, when the device cannot be opened
+    static std::shared_ptr<IpmiChannel> open(const char* path);
+
+    void transact(IpmiTransfer& transfer);
+
+    // keeps up to window transfers in flight until all are done
+    void transactAll(std::vector<IpmiTransfer>& transfers, std::size_t window);
+
+   private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Pending {
+        IpmiTransfer* transfer;
+        long msgid;
+        Clock::time_point deadline;
+        bool done;
+    };
+
+    void submit(Pending& pending);
+
+    void waitAny(std::unique_lock<std::mutex>& lock, std::vector<Pending>& pendings, const std::vector<std::size_t>& in_flight);
+
+    void receiveAll();
+
+    void complete(Pending& pending, int result);
+
+    std::unique_ptr<IpmiDevice> device;
+
+    std::mutex mutex;
+
+    std::condition_variable cv;
+
+    // a thread is polling the device
+    bool reading;
+
+    long next_msgid;
+
+    std::map<long, Pending*> waiters;
+};
+
+} // namespace xpum
+#endif
@@ -13,3 +13,14 @@
 #include <stdint.h>
 
 #include "bsmc_interface.h"
+
+#ifdef __linux__
+#include <memory>
+
+namespace xpum {
+class IpmiChannel;
+
+/* Replaces the channel to /dev/ipmi0, e.g. by one to a fake device */
+void ipmi_set_channel(std::shared_ptr<IpmiChannel> channel);
+} // namespace xpum
+#endif
@@ -14,52 +14,31 @@
 
 namespace xpum {
 
-extern unsigned char gNetfn;
-extern unsigned char gCmd;
-extern uint8_t gSensorIndex;
-
 int get_sdr_count(ipmi_address_t *ipmi_address, int &count) {
     bsmc_req req;
     bsmc_res res;
     bsmc_hal->oem_req_init(&req, ipmi_address, 0x20);
     req.data[0] = 1;
     req.data_len = 1;
-    gNetfn = 0x4;
-    gCmd = 0x20;
+    req.netfn = 0x4;
     if (bsmc_hal->cmd(&req, &res))
         return NRV_IPMI_ERROR;
     count = res.data[0];
     return NRV_SUCCESS;
 }
 
-int cmd_get_sensor_reading(ipmi_address_t *ipmi_address, uint8_t sensor_number, ipmi_buf *buf) {
-    bsmc_req req;
-    bsmc_res res;
-    bsmc_hal->oem_req_init(&req, ipmi_address, 0x2d);
-    req.data[0] = sensor_number;
-    req.data_len = 1;
-    gNetfn = 0x4;
-    gCmd = 0x2d;
-    // std::cout << "Sensor Reading:" << std::endl;
-    // std::cout << "request data: " << std::endl;
-    // for (int i = 0; i < req.data_len; i++) {
-    //     std::cout << "0x" << std::hex << (int)req.data[i] << " ";
-    // }
-    // std::cout << std::endl;
-    if (bsmc_hal->cmd(&req, &res))
-        return NRV_IPMI_ERROR;
-    // std::cout << "completion code: ";
-    // std::cout << std::dec << (int)res.completion_code << std::endl;
-    if (res.completion_code)
+static void get_sensor_reading_req_init(bsmc_req *req, ipmi_address_t *ipmi_address, uint8_t sensor_number) {
+    bsmc_hal->oem_req_init(req, ipmi_address, 0x2d);
+    req->data[0] = sensor_number;
+    req->data_len = 1;
+    req->netfn = 0x4;
+}
+
+static int get_sensor_reading_res(bsmc_res *res, ipmi_buf *buf) {
+    if (res->completion_code)
         return NRV_IPMI_ERROR;
-    memcpy(buf->data, res.data, res.data_len - 1);
-    buf->data_len = res.data_len - 1;
-    // std::cout << std::dec << "response data_len: " << res.data_len << std::endl;
-    // std::cout << "response data: " << std::endl;
-    // for (int i = 0; i < res.data_len; i++) {
-    //     std::cout << "0x" << std::hex << (int)res.data[i] << " ";
-    // }
-    // std::cout << std::endl;
+    memcpy(buf->data, res->data, res->data_len - 1);
+    buf->data_len = res->data_len - 1;
     return NRV_SUCCESS;
 }
 
@@ -69,8 +48,7 @@ int get_sdr(ipmi_address_t *ipmi_address,
     bsmc_req req;
     bsmc_res res;
     bsmc_hal->oem_req_init(&req, ipmi_address, 0x21); // 0x21 is get device sdr
-    gNetfn = 0x4;
-    gCmd = 0x21;
+    req.netfn = 0x4;
 
     req.data[0] = 0x0;  // reservation id LS Byte
     req.data[1] = 0x0;  // reservation id MS Byte
@@ -156,12 +134,31 @@ int get_sdr_list(nrv_card& card){
     return NRV_SUCCESS;
 }
 
-void get_sensor_reading(nrv_card& card, std::vector<xpum_sensor_reading_t>& reading_list){
-    int sdr_count = card.sdr_list.size();
-    ipmi_address_t *ipmi_address = &card.ipmi_address;
+void get_sensor_reading(nrv_list& cards, std::vector<xpum_sensor_reading_t>& reading_list){
+    std::vector<nrv_card *> sdr_cards;
+    std::vector<ipmi_buf *> sdrs;
+    for (int i = 0; i < cards.count; i++) {
+        for (auto& sdr_buf : cards.card[i].sdr_list) {
+            sdr_cards.push_back(&cards.card[i]);
+            sdrs.push_back(&sdr_buf);
+        }
+    }
+    int sdr_count = sdrs.size();
+    if (!sdr_count)
+        return;
+
+    // the sensors of all the cards are read in one batch, not one by one
+    std::vector<bsmc_req> reqs(sdr_count);
+    std::vector<bsmc_res> reading_res(sdr_count);
+    std::vector<int> errors(sdr_count);
+    for (int i = 0; i < sdr_count; i++) {
+        struct sdr_record_common_sensor * record = (struct sdr_record_common_sensor *)(sdrs[i]->data+7);
+        get_sensor_reading_req_init(&reqs[i], &sdr_cards[i]->ipmi_address, record->keys.sensor_num);
+    }
+    bsmc_hal->cmd_batch(reqs.data(), reading_res.data(), errors.data(), sdr_count);
 
     for (int i = 0; i < sdr_count; i++) {
-        ipmi_buf sdr_buf = card.sdr_list[i];
+        ipmi_buf& sdr_buf = *sdrs[i];
         ipmi_buf reading_buf;
         memset(&reading_buf, 0, sizeof(ipmi_buf));
 
@@ -169,15 +166,14 @@ void get_sensor_reading(nrv_card& card, std::vector<xpum_sensor_reading_t>& read
 
         struct sdr_record_common_sensor * record = (struct sdr_record_common_sensor *)(sdr_buf.data+7);
 
-        int err = cmd_get_sensor_reading(ipmi_address, record->keys.sensor_num, &reading_buf);
-        if (err)
+        if (errors[i] || get_sensor_reading_res(&reading_res[i], &reading_buf))
             continue;
 
         xpum_sensor_reading_t sensor_reading_data;
 
         memset(&sensor_reading_data, 0, sizeof(sensor_reading_data));
 
-        sensor_reading_data.amcIndex = card.id;
+        sensor_reading_data.amcIndex = sdr_cards[i]->id;
 
         auto sr = ipmi_sdr_read_sensor_value(record, header->type, 3, &reading_buf);
 
@@ -231,9 +227,7 @@ std::vector<xpum_sensor_reading_t> read_sensor() {
     if (err)
         goto exit;
 
-    for (int i = 0; i < cards.count; i++) {
-        get_sensor_reading(cards.card[i], res);
-    }
+    get_sensor_reading(cards, res);
 
 exit:
     // free(cbuf_header.buf);
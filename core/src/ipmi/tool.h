@@ -89,5 +89,7 @@ int cmd_version(int argc, char **argv);
 int cmd_modes(int argc, char **argv);
 void do_sleep(int sleep_time_in_ms);
 void clean_data();
+int fw_update_cards(nrv_card **cards, int count, const uint8_t *data, size_t data_size,
+                    uint8_t fw_update_type);
 
 } // namespace xpum
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "monitor_manager.h"
 
 #include <algorithm>
+#include <map>
 #include <set>
 
 #include "core/core.h"
@@ -37,7 +38,7 @@ void MonitorManager::init() {
 
     std::unique_lock<std::mutex> lock(this->mutex);
 
-    createMonitorTasks(MeasurementType::METRIC_MAX);
+    createMonitorTasks(MeasurementType::METRIC_MAX, true);
 
     for (uint64_t session = 0; session < Configuration::MAX_STATISTICS_SESSION_NUM; session++) {
         std::vector<std::shared_ptr<Device>> devices;
@@ -66,19 +67,63 @@ void MonitorManager::close() {
     }
 }
 
-void MonitorManager::createMonitorTasks(MeasurementType target_type) {
+void MonitorManager::createMonitorTasks(MeasurementType target_type, bool coalesce) {
     auto metric_types = Configuration::getEnabledMetrics();
     std::set<DeviceCapability> created_caps;
+    std::map<int, std::vector<DeviceCapability>> intervals;
     for (auto& type : metric_types) {
         if (target_type != MeasurementType::METRIC_MAX && type != target_type) {
             continue;
         }
         DeviceCapability capability = Utility::capabilityFromMeasurementType(type);
         if (created_caps.find(capability) == created_caps.end()) {
-            tasks.emplace_back(std::make_shared<MonitorTask>(capability, Configuration::TELEMETRY_DATA_MONITOR_FREQUENCE, p_device_manager, p_data_logic, MonitorTaskType::GPU_METRICS));
+            if (coalesce) {
+                intervals[Configuration::getMetricInterval(capability)].push_back(capability);
+            } else {
+                tasks.emplace_back(std::make_shared<MonitorTask>(std::vector<DeviceCapability>{capability}, Configuration::TELEMETRY_DATA_MONITOR_FREQUENCE, p_device_manager, p_data_logic, MonitorTaskType::GPU_METRICS));
+            }
             created_caps.emplace(capability);
         }
     }
+    for (auto& interval : intervals) {
+        tasks.emplace_back(std::make_shared<MonitorTask>(interval.second, interval.first, p_device_manager, p_data_logic, MonitorTaskType::GPU_METRICS));
+    }
+}
+
+void MonitorManager::rescheduleMonitorTasks() {
+    std::map<int, std::vector<DeviceCapability>> intervals;
+    for (auto& p_task : tasks) {
+        for (auto capability : p_task->getCapabilities()) {
+            intervals[Configuration::getMetricInterval(capability)].push_back(capability);
+        }
+    }
+
+    // the tasks keep running, only their capabilities and intervals change
+    std::vector<std::shared_ptr<MonitorTask>> unused;
+    for (auto& p_task : tasks) {
+        auto it = intervals.find(p_task->getFreq());
+        if (it != intervals.end()) {
+            p_task->setCapabilities(it->second);
+            intervals.erase(it);
+        } else {
+            unused.push_back(p_task);
+        }
+    }
+    for (auto& interval : intervals) {
+        if (!unused.empty()) {
+            unused.back()->setCapabilities(interval.second);
+            unused.back()->setFreq(interval.first);
+            unused.pop_back();
+        } else {
+            auto p_task = std::make_shared<MonitorTask>(interval.second, interval.first, p_device_manager, p_data_logic, MonitorTaskType::GPU_METRICS);
+            tasks.push_back(p_task);
+            p_task->start(this->p_scheduled_thread_pool);
+        }
+    }
+    for (auto& p_task : unused) {
+        p_task->stop();
+        tasks.erase(std::find(tasks.begin(), tasks.end(), p_task));
+    }
 }
 
 void MonitorManager::resetMetricTasksFrequency() {
@@ -89,14 +134,18 @@ void MonitorManager::resetMetricTasksFrequency() {
     }
     
     std::unique_lock<std::mutex> lock(this->mutex);
-    for (auto& p_task : tasks) {
-        p_task->stop();
-    }
-    tasks.clear();
-    createMonitorTasks(MeasurementType::METRIC_MAX);
-    for (auto& p_task : tasks) {
-        p_task->start(this->p_scheduled_thread_pool);
+    rescheduleMonitorTasks();
+}
+
+void MonitorManager::setMetricInterval(MeasurementType type, int interval) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    Configuration::setMetricInterval(Utility::capabilityFromMeasurementType(type), interval);
+    char* env = std::getenv("XPUM_DISABLE_PERIODIC_METRIC_MONITOR");
+    std::string xpum_disable_periodic_metric_monitor{env != NULL ? env : ""};
+    if (xpum_disable_periodic_metric_monitor == "1") {
+        return;
     }
+    rescheduleMonitorTasks();
 }
 
 bool MonitorManager::initOneTimeMetricMonitorTasks(MeasurementType type) {
@@ -106,7 +155,7 @@ bool MonitorManager::initOneTimeMetricMonitorTasks(MeasurementType type) {
         XPUM_LOG_TRACE("Init One-Time Monitor Tasks");
         std::unique_lock<std::mutex> lock(this->mutex);
 
-        createMonitorTasks(type);
+        createMonitorTasks(type, false);
 
         for (uint64_t session = 0; session < Configuration::MAX_STATISTICS_SESSION_NUM; session++) {
             std::vector<std::shared_ptr<Device>> devices;
@@ -25,12 +25,18 @@ class MonitorManager : public MonitorManagerInterface {
 
     void close() override;
 
-    void resetMetricTasksFrequency();
+    void resetMetricTasksFrequency() override;
 
-    bool initOneTimeMetricMonitorTasks(MeasurementType type);
+    void setMetricInterval(MeasurementType type, int interval) override;
+
+    bool initOneTimeMetricMonitorTasks(MeasurementType type) override;
 
    private:
-    void createMonitorTasks(MeasurementType target_type);
+    // one task per interval when coalesce, else one per capability
+    void createMonitorTasks(MeasurementType target_type, bool coalesce);
+
+    // moves the capabilities whose interval changed to the task of their new interval
+    void rescheduleMonitorTasks();
 
    private:
     std::shared_ptr<DeviceManagerInterface> p_device_manager;
@@ -17,6 +17,8 @@ class MonitorManagerInterface : public InitCloseInterface {
    public:
     virtual ~MonitorManagerInterface(){};
     virtual void resetMetricTasksFrequency() = 0;
+    // an interval of 0 collects the metric at the telemetry frequency again
+    virtual void setMetricInterval(MeasurementType type, int interval) = 0;
     virtual bool initOneTimeMetricMonitorTasks(MeasurementType type) = 0;
 };
 
@@ -7,11 +7,13 @@
 #include "monitor_task.h"
 
 #include <chrono>
+#include <future>
 #include <mutex>
 #include <set>
 #include <thread>
 
 #include "control/device_manager.h"
+#include "device/device_reader.h"
 #include "infrastructure/configuration.h"
 #include "infrastructure/logger.h"
 #include "infrastructure/utility.h"
@@ -19,36 +21,22 @@
 namespace xpum {
 
 MonitorTask::MonitorTask(
-    DeviceCapability capability, int freq,
-    std::shared_ptr<DeviceManagerInterface>& p_device_manager,
-    std::shared_ptr<DataLogicInterface>& p_data_logic)
-    : capability(capability),
-      freq(freq),
-      p_device_manager(p_device_manager),
-      p_data_logic(p_data_logic),
-      type(MonitorTaskType::DEFAULT_TELEMETRY),
-      p_scheduled_task(nullptr),
-      exe_counter(0) {
-    XPUM_LOG_TRACE("MonitorTask(), capability: {}", capability);
-}
-
-MonitorTask::MonitorTask(
-    DeviceCapability capability, int freq,
+    const std::vector<DeviceCapability>& capabilities, int freq,
     std::shared_ptr<DeviceManagerInterface>& p_device_manager,
     std::shared_ptr<DataLogicInterface>& p_data_logic,
     MonitorTaskType type)
-    : capability(capability),
+    : capabilities(capabilities),
       freq(freq),
       p_device_manager(p_device_manager),
       p_data_logic(p_data_logic),
       type(type),
       p_scheduled_task(nullptr),
       exe_counter(0) {
-    XPUM_LOG_TRACE("MonitorTask(), capability: {}", capability);
+    XPUM_LOG_TRACE("MonitorTask(), {} capabilities every {} ms", capabilities.size(), freq);
 }
 
 MonitorTask::~MonitorTask() {
-    XPUM_LOG_TRACE("~MonitorTask(), capability: {}", capability);
+    XPUM_LOG_TRACE("~MonitorTask(), {} ms", freq.load());
 }
 
 void MonitorTask::start(std::shared_ptr<ScheduledThreadPool>& threadPool) {
@@ -62,18 +50,19 @@ void MonitorTask::start(std::shared_ptr<ScheduledThreadPool>& threadPool) {
     if (xpum_disable_periodic_metric_monitor == "1") {
         delay = 0;
         interval = Configuration::TELEMETRY_DATA_MONITOR_FREQUENCE / 2;
-        if (this->getCapability() == DeviceCapability::METRIC_RAS_ERROR ||
-        this->getCapability() == DeviceCapability::METRIC_MEMORY_USED_UTILIZATION ||
-        this->getCapability() == DeviceCapability::METRIC_FREQUENCY ||
-        this->getCapability() == DeviceCapability::METRIC_TEMPERATURE ||
-        this->getCapability() == DeviceCapability::METRIC_ENERGY ||
-        this->getCapability() == DeviceCapability::METRIC_FREQUENCY_THROTTLE_REASON_GPU) {
-            execution_times = 1;
-        } else {
-            // Currently known types that need to be executed twice as follows
-            // METRIC_ENGINE_UTILIZATION, METRIC_FABRIC_THROUGHPUT and METRIC_POWER
-            // later will move more types from executed twice to executed once
-            execution_times = 2;
+        // Currently known types that need to be executed twice are
+        // METRIC_ENGINE_UTILIZATION, METRIC_FABRIC_THROUGHPUT and METRIC_POWER
+        // later will move more types from executed twice to executed once
+        execution_times = 1;
+        for (auto capability : getCapabilities()) {
+            if (capability != DeviceCapability::METRIC_RAS_ERROR &&
+            capability != DeviceCapability::METRIC_MEMORY_USED_UTILIZATION &&
+            capability != DeviceCapability::METRIC_FREQUENCY &&
+            capability != DeviceCapability::METRIC_TEMPERATURE &&
+            capability != DeviceCapability::METRIC_ENERGY &&
+            capability != DeviceCapability::METRIC_FREQUENCY_THROTTLE_REASON_GPU) {
+                execution_times = 2;
+            }
         }
     }
 
@@ -83,64 +72,108 @@ void MonitorTask::start(std::shared_ptr<ScheduledThreadPool>& threadPool) {
     p_scheduled_task = threadPool->scheduleAtFixedRate(delay, interval, execution_times, [this_weak_ptr]() {
         auto p_this = this_weak_ptr.lock();
         if (p_this == nullptr) {
-            XPUM_LOG_WARN("this_weak_ptr is nullptr for monitor data");
+            XPUM_LOG_RATE_LIMITED(XPUM_LOG_WARN, 1, 10, "this_weak_ptr is nullptr for monitor data");
             return;
         }
 
-        long long now = Utility::getCurrentMillisecond();
+        // one pass over the devices for all the capabilities, with the same timestamp
+        p_this->collect(p_this->getCapabilities(), Utility::getCurrentMillisecond());
+        p_this->exe_counter++;
+    });
 
-        std::vector<std::shared_ptr<Device>> devices;
-        p_this->p_device_manager->getDeviceList(p_this->capability, devices);
-        if (devices.size() == 0) {
-            XPUM_LOG_TRACE("no device supports capability: {}", p_this->capability);
-            p_this->exe_counter++;
-            return;
-        }
+    XPUM_LOG_TRACE("Monitor task started every {} ms", interval);
+}
 
-        auto datas = std::make_shared<std::map<std::string, std::shared_ptr<MeasurementData>>>();
+void MonitorTask::collect(const std::vector<DeviceCapability>& capabilities, long long now) {
+    std::vector<std::shared_ptr<Device>> all_devices;
+    p_device_manager->getDeviceList(all_devices);
 
-        bool use_multithreading = false;
-        if(p_this->getCapability() == DeviceCapability::METRIC_MEMORY_USED_UTILIZATION){
-            use_multithreading = true;
+    // the devices under a flash, reset or PPR are left out until it is done
+    std::vector<std::shared_ptr<Device>> devices;
+    for (auto& p_device : all_devices) {
+        if (p_device->getOperationLock().tryLockShared()) {
+            devices.push_back(p_device);
+        } else {
+            XPUM_LOG_TRACE("device {} is busy, monitoring paused", p_device->getId());
+        }
+    }
+    auto unlockDevices = [&devices]() {
+        for (auto& p_device : devices) {
+            p_device->getOperationLock().unlockShared();
         }
+    };
 
-        Utility::parallel_in_batches(devices.size(), devices.size(), [&](int start, int end){
-        for (int i = start; i < end; ++i) {
-            auto& p_device = devices[i];
-            DeviceCapability capability = p_this->capability;
-            auto method = Device::getDeviceMethod(capability, p_device.get());
-            method([p_device, this_weak_ptr, datas, capability](
-                       std::shared_ptr<void> ret, std::shared_ptr<BaseException> e) {
-                auto p_this = this_weak_ptr.lock();
-                if (p_this == nullptr) {
-                    return;
-                }
-                std::lock_guard<std::mutex> lock(p_this->callback_mutex);
-                if (e == nullptr && ret != nullptr) {
-                    std::string id = p_device->getId();
-                    auto p_mdata = std::static_pointer_cast<MeasurementData>(ret);
-                    (*datas)[id] = p_mdata;
-                    if (p_mdata->getErrors().empty()) {
-                        // everything is ok, no error messages reported in executing the underlying task, clear the log reported flag
-                        p_this->monitor_task_log_status[p_device->getId()] = false;
-                    } else {
-                        // errors happened in executing the underlying task though partial data has been collected successfully, log the error if it has not been logged before
-                        if (!p_this->monitor_task_log_status[p_device->getId()]) {
-                            XPUM_LOG_WARN("partial monitoring failure: {}", p_mdata->getErrors());
-                            p_this->monitor_task_log_status[p_device->getId()] = true;
-                        }
-                    }
-                } else if (e != nullptr) {
-                    // errors happened in executing the underlying task, log the error if it has not been logged before
-                    if (!p_this->monitor_task_log_status[p_device->getId()]) {
-                        XPUM_LOG_WARN("monitoring failure: {}", e->what());
-                        p_this->monitor_task_log_status[p_device->getId()] = true;
+    // one read per device and capability, all in flight together
+    struct Read {
+        std::shared_ptr<Device> p_device;
+        DeviceCapability capability;
+        MeasurementRead result;
+    };
+    std::vector<Read> reads;
+    std::vector<DeviceCapability> supported;
+    for (auto capability : capabilities) {
+        bool found = false;
+        for (auto& p_device : devices) {
+            if (p_device->hasCapability(capability)) {
+                reads.push_back(Read{p_device, capability, MeasurementRead()});
+                found = true;
+            }
+        }
+        if (!found) {
+            XPUM_LOG_TRACE("no device supports capability: {}", capability);
+            continue;
+        }
+        supported.push_back(capability);
+    }
+    if (supported.empty()) {
+        unlockDevices();
+        return;
+    }
+
+    std::vector<std::future<void>> completions;
+    for (auto& read : reads) {
+        completions.push_back(DeviceReader::instance().read(read.p_device, read.capability, read.result));
+    }
+    for (auto& completion : completions) {
+        completion.wait();
+    }
+    unlockDevices();
+
+    std::map<DeviceCapability, std::shared_ptr<std::map<std::string, std::shared_ptr<MeasurementData>>>> capability_datas;
+    for (auto capability : supported) {
+        capability_datas[capability] = std::make_shared<std::map<std::string, std::shared_ptr<MeasurementData>>>();
+    }
+    {
+        std::lock_guard<std::mutex> lock(callback_mutex);
+        for (auto& read : reads) {
+            std::string id = read.p_device->getId();
+            std::string log_key = id + "/" + std::to_string((int)read.capability);
+            if (read.result.error == nullptr) {
+                auto& p_mdata = read.result.data;
+                (*capability_datas[read.capability])[id] = p_mdata;
+                if (p_mdata->getErrors().empty()) {
+                    // everything is ok, no error messages reported in executing the underlying task, clear the log reported flag
+                    monitor_task_log_status[log_key] = false;
+                } else {
+                    // errors happened in executing the underlying task though partial data has been collected successfully, log the error if it has not been logged before
+                    if (!monitor_task_log_status[log_key]) {
+                        XPUM_LOG_WARN("partial monitoring failure: {}", p_mdata->getErrors());
+                        monitor_task_log_status[log_key] = true;
                     }
                 }
-            });
+            } else {
+                // errors happened in executing the underlying task, log the error if it has not been logged before
+                if (!monitor_task_log_status[log_key]) {
+                    XPUM_LOG_WARN("monitoring failure: {}", read.result.error->what());
+                    monitor_task_log_status[log_key] = true;
+                }
+            }
         }
-        }, use_multithreading);
+    }
 
+    MeasurementBatch batch;
+    for (auto capability : supported) {
+        auto& datas = capability_datas[capability];
         bool hasSubdeviceAdditionalData = false;
         std::set<MeasurementType> subdeviceAdditionalDataTypes;
         // deviceId, subdeviceId, addtionalType, addtionalData
@@ -154,11 +187,10 @@ void MonitorTask::start(std::shared_ptr<ScheduledThreadPool>& threadPool) {
                 data.second->clearSubdeviceAdditionalData();
             }
         }
-        MeasurementType measurmentType = Utility::measurementTypeFromCapability(p_this->capability);
-        XPUM_LOG_TRACE("Monitor passes data {} to datalogic", p_this->capability);
-        p_this->p_data_logic->storeMeasurementData(measurmentType, now, datas);
+        batch.emplace_back(Utility::measurementTypeFromCapability(capability), datas);
         if (hasSubdeviceAdditionalData) {
             for (auto& type : subdeviceAdditionalDataTypes) {
+                auto additionalDatas = std::make_shared<std::map<std::string, std::shared_ptr<MeasurementData>>>();
                 for (auto& data : (*datas)) {
                     auto mData = std::make_shared<MeasurementData>();
                     for (auto& sData : subdeviceAdditionalCurrentDatasAll[data.first]) {
@@ -180,16 +212,14 @@ void MonitorTask::start(std::shared_ptr<ScheduledThreadPool>& threadPool) {
                             }
                         }
                     }
-                    (*datas)[data.first] = mData;
+                    (*additionalDatas)[data.first] = mData;
                 }
-                XPUM_LOG_TRACE("Monitor passes data {} to datalogic", p_this->capability);
-                p_this->p_data_logic->storeMeasurementData(type, now, datas);
+                batch.emplace_back(type, additionalDatas);
             }
         }
-        p_this->exe_counter++;
-    });
-
-    XPUM_LOG_TRACE("Monitor task started for {}", this->capability);
+    }
+    XPUM_LOG_TRACE("Monitor passes data of {} types to datalogic", batch.size());
+    p_data_logic->storeMeasurementBatch(now, batch);
 }
 
 void MonitorTask::stop() {
@@ -204,8 +234,26 @@ bool MonitorTask::finished(){
     return exe_counter.load() == p_scheduled_task->getExeTime();
 }
 
-DeviceCapability MonitorTask::getCapability() {
-    return capability;
+std::vector<DeviceCapability> MonitorTask::getCapabilities() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return capabilities;
+}
+
+void MonitorTask::setCapabilities(const std::vector<DeviceCapability>& capabilities) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->capabilities = capabilities;
+}
+
+int MonitorTask::getFreq() {
+    return freq;
+}
+
+void MonitorTask::setFreq(int freq) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->freq = freq;
+    if (p_scheduled_task != nullptr) {
+        p_scheduled_task->setInterval(freq);
+    }
 }
 
 MonitorTaskType MonitorTask::getType() {
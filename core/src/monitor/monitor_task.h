@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "control/device_manager_interface.h"
 #include "data_logic/data_logic_interface.h"
 #include "infrastructure/device_capability.h"
@@ -19,16 +21,17 @@ enum MonitorTaskType {
     TASK_TYPE_FORCE_UINT32 = 0x7fffffff
 };
 
+/*
+  Collects the capabilities sharing an interval, with one timestamp per
+  run: the device list is taken once and the reads of all the devices
+  and capabilities go to the DeviceReader together. The capabilities and
+  the interval can be changed while running.
+*/
+
 class MonitorTask : public std::enable_shared_from_this<MonitorTask> {
    public:
     MonitorTask(
-        DeviceCapability capability,
-        int freq,
-        std::shared_ptr<DeviceManagerInterface>& p_device_manager,
-        std::shared_ptr<DataLogicInterface>& p_data_logic);
-
-    MonitorTask(
-        DeviceCapability capability,
+        const std::vector<DeviceCapability>& capabilities,
         int freq,
         std::shared_ptr<DeviceManagerInterface>& p_device_manager,
         std::shared_ptr<DataLogicInterface>& p_data_logic,
@@ -41,15 +44,25 @@ class MonitorTask : public std::enable_shared_from_this<MonitorTask> {
 
     void stop();
 
-    DeviceCapability getCapability();
+    std::vector<DeviceCapability> getCapabilities();
+
+    void setCapabilities(const std::vector<DeviceCapability>& capabilities);
+
+    int getFreq();
+
+    // takes effect from the next run
+    void setFreq(int freq);
 
     MonitorTaskType getType();
 
     bool finished();
 
    private:
-    DeviceCapability capability;
-    int freq;
+    // reads the capabilities of all the devices together and stores them as one batch
+    void collect(const std::vector<DeviceCapability>& capabilities, long long now);
+
+    std::vector<DeviceCapability> capabilities;
+    std::atomic<int> freq;
     std::mutex mutex;
     std::condition_variable data_cv;
     std::shared_ptr<DeviceManagerInterface> p_device_manager;
@@ -229,10 +229,10 @@ bool PolicyManager::isPolicyMeetCondition(std::shared_ptr<xpum_policy_data> p_po
         p_policy->tileId = 0;
         if (p_policy->preValue == 0 && p_policy->curValue == 1) {
             //Only care occur
-            XPUM_LOG_INFO("PolicyManager::isPolicyMeetCondition(): XPUM_POLICY_TYPE_GPU_MISSING return true");
+            XPUM_LOG_RATE_LIMITED(XPUM_LOG_INFO, 1, 10, "PolicyManager::isPolicyMeetCondition(): XPUM_POLICY_TYPE_GPU_MISSING return true");
             return true;
         }
-        XPUM_LOG_INFO("PolicyManager::isPolicyMeetCondition(): XPUM_POLICY_TYPE_GPU_MISSING return false");
+        XPUM_LOG_DEBUG("PolicyManager::isPolicyMeetCondition(): XPUM_POLICY_TYPE_GPU_MISSING return false");
         return false;
     }
 
@@ -248,11 +248,11 @@ bool PolicyManager::isPolicyMeetCondition(std::shared_ptr<xpum_policy_data> p_po
             strcpy(p_policy->description, freq_throttle_message.c_str());
             if (p_policy->curValue == 1) {
                 //Only care occur
-                XPUM_LOG_INFO("PolicyManager::isPolicyMeetCondition(): XPUM_POLICY_TYPE_GPU_THROTTLE return true");
+                XPUM_LOG_RATE_LIMITED(XPUM_LOG_INFO, 1, 10, "PolicyManager::isPolicyMeetCondition(): XPUM_POLICY_TYPE_GPU_THROTTLE return true");
                 return true;
             }
         }
-        XPUM_LOG_INFO("PolicyManager::isPolicyMeetCondition(): XPUM_POLICY_TYPE_GPU_THROTTLE return false");
+        XPUM_LOG_DEBUG("PolicyManager::isPolicyMeetCondition(): XPUM_POLICY_TYPE_GPU_THROTTLE return false");
         return false;
     }
 
@@ -13,6 +13,7 @@
 #include "core/core.h"
 #include "infrastructure/logger.h"
 #include "libcurl.h"
+#include "redfish_client.h"
 #include "detect_usb_interface.h"
 #include "util.h"
 
@@ -526,21 +527,10 @@ static bool getUpdateResult(std::string interface_host,
     std::string url = interface_host + taskUri;
     XPUM_LOG_INFO("getUpdateService path: {}", url);
 
-    CURL* curl;
-    CURLcode res = CURL_LAST;
-    std::string buffer;
-    curl = libcurl.curl_easy_init();
-    if (curl) {
-        libcurl.curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "GET");
-        libcurl.curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curlBasicConfig(curl, buffer, username, password);
-
-        res = libcurl.curl_easy_perform(curl);
-    }
-    libcurl.curl_easy_cleanup(curl);
+    auto response = RedfishClient(interface_host, username, password).get(taskUri);
     success = false;
-    if (res != CURLE_OK) {
-        switch (res) {
+    if (response.code != CURLE_OK) {
+        switch (response.code) {
             case CURLE_OPERATION_TIMEDOUT:
                 errMsg = "Request to " + url + " timeout";
                 break;
@@ -551,7 +541,7 @@ static bool getUpdateResult(std::string interface_host,
     }
     json taskJson;
     try {
-        taskJson = json::parse(buffer);
+        taskJson = json::parse(response.body);
     } catch (...) {
         // parse error
         errMsg = "Fail to parse task json";
@@ -650,6 +640,7 @@ void DELLRedfishAmcManager::flashAMCFirmware(FlashAmcFirmwareParam& param) {
         std::string taskUri = "/redfish/v1/Managers/iDRAC.Embedded.1/Oem/Dell/Jobs/" + jobID;
         XPUM_LOG_INFO("taskUri: {}", taskUri);
 
+        Backoff taskBackoff(std::chrono::milliseconds(500), std::chrono::seconds(5));
         while (true) {
             // get task result
             bool success;
@@ -680,9 +671,9 @@ void DELLRedfishAmcManager::flashAMCFirmware(FlashAmcFirmwareParam& param) {
                 }
             }
             this->percent.store(percent);
-            // task ongoing, wait 2 sec
+            // task ongoing, poll again later
             XPUM_LOG_INFO("Task {} on going", taskUri);
-            std::this_thread::sleep_for(std::chrono::seconds(2));
+            taskBackoff.wait();
         }
         param.callback();
         return xpum_firmware_flash_result_t::XPUM_DEVICE_FIRMWARE_FLASH_OK;
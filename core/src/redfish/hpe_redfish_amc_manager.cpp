@@ -13,6 +13,7 @@
 #include "core/core.h"
 #include "infrastructure/logger.h"
 #include "libcurl.h"
+#include "redfish_client.h"
 #include "detect_usb_interface.h"
 #include "util.h"
 
@@ -346,20 +347,9 @@ xpum_result_t getUpdateService(std::string username,
     // get gpu list
     std::string url = HPE_REDFISH_HOST_INTERFACE_HOST "/redfish/v1/UpdateService";
 
-    CURL* curl;
-    CURLcode res = CURL_LAST;
-    std::string buffer;
-    curl = libcurl.curl_easy_init();
-    if (curl) {
-        libcurl.curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "GET");
-        libcurl.curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curlBasicConfig(curl, buffer, username, password);
-
-        res = libcurl.curl_easy_perform(curl);
-    }
-    libcurl.curl_easy_cleanup(curl);
-    if (res != CURLE_OK) {
-        switch (res) {
+    auto response = RedfishClient(HPE_REDFISH_HOST_INTERFACE_HOST, username, password).get("/redfish/v1/UpdateService");
+    if (response.code != CURLE_OK) {
+        switch (response.code) {
             case CURLE_OPERATION_TIMEDOUT:
                 errMsg = "Request to " + url + " timeout";
                 break;
@@ -371,7 +361,7 @@ xpum_result_t getUpdateService(std::string username,
 
     json updateServiceJson;
     try {
-        updateServiceJson = json::parse(buffer);
+        updateServiceJson = json::parse(response.body);
     } catch (...) {
         // parse error
         errMsg = "Fail to parse UpdateService json";
@@ -592,6 +582,7 @@ void HEPRedfishAmcManager::flashAMCFirmware(FlashAmcFirmwareParam& param) {
         json obj;
         int failCount = 0;
 
+        Backoff taskBackoff(std::chrono::milliseconds(500), std::chrono::seconds(5));
         while (true) {
             // get UpdateService
             xpum_result_t result;
@@ -638,7 +629,7 @@ void HEPRedfishAmcManager::flashAMCFirmware(FlashAmcFirmwareParam& param) {
                 failCount++;
             }
 
-            std::this_thread::sleep_for(std::chrono::seconds(2));
+            taskBackoff.wait();
         }
     });
 
@@ -14,6 +14,7 @@
 #include "detect_usb_interface.h"
 #include "infrastructure/logger.h"
 #include "libcurl.h"
+#include "redfish_client.h"
 #include "util.h"
 
 
@@ -380,33 +381,15 @@ static xpum_result_t getGPUFwInventoryList(DNPRedfishHostInterface interface,
     return XPUM_GENERIC_ERROR;
 }
 
-static bool getAmcFwVersionByOdataId(DNPRedfishHostInterface interface,
-                                     std::string username,
-                                     std::string password,
+static bool getAmcFwVersionByOdataId(const RedfishClient& client,
+                                     const RedfishResponse& response,
                                      std::string odataid,
                                      std::string& version,
                                      std::string& errMsg) {
-    std::stringstream url;
-    url << "https://";
-    url << interface.ipv4_service_addr;
-    url << odataid;
-    CURL* curl;
-    CURLcode res = CURL_LAST;
-    std::string buffer;
-    curl = libcurl.curl_easy_init();
-    if (curl) {
-        libcurl.curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "GET");
-        libcurl.curl_easy_setopt(curl, CURLOPT_URL, url.str().c_str());
-
-        curlBasicConfig(curl, buffer, username, password);
-
-        res = libcurl.curl_easy_perform(curl);
-    }
-    libcurl.curl_easy_cleanup(curl);
-    if (res != CURLE_OK) {
-        switch (res) {
+    if (response.code != CURLE_OK) {
+        switch (response.code) {
             case CURLE_OPERATION_TIMEDOUT:
-                errMsg = "Request to " + url.str() + " timeout";
+                errMsg = "Request to " + client.baseUrl() + odataid + " timeout";
                 break;
             default:
                 errMsg = "Fail to get " + odataid;
@@ -415,7 +398,7 @@ static bool getAmcFwVersionByOdataId(DNPRedfishHostInterface interface,
     }
     json fwJson;
     try {
-        fwJson = json::parse(buffer);
+        fwJson = json::parse(response.body);
     } catch (...) {
         // parse error
         errMsg = "Fail to parse json from " + odataid;
@@ -437,10 +420,13 @@ void DenaliPassRedfishAmcManager::getAmcFirmwareVersions(GetAmcFirmwareVersionsP
         param.errCode = errCode;
         return;
     }
-    for (auto link : gpuOdataIdList) {
+    // the firmware of every GPU is queried at the same time
+    RedfishClient client("https://" + hostInterface.ipv4_service_addr, param.username, param.password);
+    auto responses = client.getAll(gpuOdataIdList);
+    for (std::size_t i = 0; i < gpuOdataIdList.size(); i++) {
         std::string version;
         std::string message;
-        if (getAmcFwVersionByOdataId(hostInterface, param.username, param.password, link, version, message)) {
+        if (getAmcFwVersionByOdataId(client, responses[i], gpuOdataIdList[i], version, message)) {
             param.versions.push_back(version);
         } else {
             param.errCode = XPUM_GENERIC_ERROR;
@@ -547,21 +533,10 @@ static bool getTaskResult(DNPRedfishHostInterface interface,
     url << interface.ipv4_service_addr;
     url << taskUri;
 
-    CURL* curl;
-    CURLcode res = CURL_LAST;
-    std::string buffer;
-    curl = libcurl.curl_easy_init();
-    if (curl) {
-        libcurl.curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "GET");
-        libcurl.curl_easy_setopt(curl, CURLOPT_URL, url.str().c_str());
-        curlBasicConfig(curl, buffer, username, password);
-
-        res = libcurl.curl_easy_perform(curl);
-    }
-    libcurl.curl_easy_cleanup(curl);
+    auto response = RedfishClient("https://" + interface.ipv4_service_addr, username, password).get(taskUri);
     success = false;
-    if (res != CURLE_OK) {
-        switch (res) {
+    if (response.code != CURLE_OK) {
+        switch (response.code) {
             case CURLE_OPERATION_TIMEDOUT:
                 errMsg = "Request to " + url.str() + " timeout";
                 break;
@@ -572,7 +547,7 @@ static bool getTaskResult(DNPRedfishHostInterface interface,
     }
     json taskJson;
     try {
-        taskJson = json::parse(buffer);
+        taskJson = json::parse(response.body);
     } catch (...) {
         // parse error
         errMsg = "Fail to parse task json";
@@ -644,6 +619,7 @@ void DenaliPassRedfishAmcManager::flashAMCFirmware(FlashAmcFirmwareParam& param)
             return xpum_firmware_flash_result_t::XPUM_DEVICE_FIRMWARE_FLASH_ERROR;
         }
 
+        Backoff taskBackoff(std::chrono::milliseconds(500), std::chrono::seconds(5));
         while (true) {
             bool finished;
             bool success;
@@ -675,9 +651,9 @@ void DenaliPassRedfishAmcManager::flashAMCFirmware(FlashAmcFirmwareParam& param)
                     break;
                 }
             }
-            // task ongoing, wait 2 sec
+            // task ongoing, poll again later
             XPUM_LOG_INFO("Task {} on going", taskLink);
-            std::this_thread::sleep_for(std::chrono::seconds(2));
+            taskBackoff.wait();
         }
         param.callback();
         return xpum_firmware_flash_result_t::XPUM_DEVICE_FIRMWARE_FLASH_OK;
@@ -14,6 +14,7 @@
 #include "detect_usb_interface.h"
 #include "infrastructure/logger.h"
 #include "libcurl.h"
+#include "redfish_client.h"
 #include "util.h"
 
 
@@ -602,32 +603,21 @@ static bool getJobResult(FlorenceRedfishHostInterface interface,
     url << interface.ipv4_service_addr;
     url << jobLink;
 
-    CURL* curl;
-    CURLcode res = CURL_LAST;
-    std::string buffer;
-    curl = libcurl.curl_easy_init();
-    if (curl) {
-        libcurl.curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "GET");
-        libcurl.curl_easy_setopt(curl, CURLOPT_URL, url.str().c_str());
-        curlBasicConfig(curl, buffer, username, password);
-
-        res = libcurl.curl_easy_perform(curl);
-    }
-    libcurl.curl_easy_cleanup(curl);
+    auto response = RedfishClient("https://" + interface.ipv4_service_addr, username, password).get(jobLink);
     success = false;
-    if (res != CURLE_OK) {
-        switch (res) {
+    if (response.code != CURLE_OK) {
+        switch (response.code) {
             case CURLE_OPERATION_TIMEDOUT:
                 errMsg = "Request to " + url.str() + " timeout";
                 break;
             default:
-                errMsg = "Fail to request " + url.str() + "; CURL error " + std::to_string(res);
+                errMsg = "Fail to request " + url.str() + "; CURL error " + std::to_string(response.code);
         }
         return false;
     }
     json jobJson;
     try {
-        jobJson = json::parse(buffer);
+        jobJson = json::parse(response.body);
     } catch (...) {
         // parse error
         errMsg = "Fail to parse task json";
@@ -700,6 +690,7 @@ void FlorenceRedfishAmcManager::flashAMCFirmware(FlashAmcFirmwareParam& param) {
 
         // get job link
         std::string jobLink;
+        Backoff taskBackoff(std::chrono::milliseconds(500), std::chrono::seconds(5));
         while (true) {
             bool finished;
             bool success;
@@ -724,9 +715,10 @@ void FlorenceRedfishAmcManager::flashAMCFirmware(FlashAmcFirmwareParam& param) {
             }
 
             XPUM_LOG_INFO("Task {} on going", taskLink);
-            std::this_thread::sleep_for(std::chrono::seconds(2));
+            taskBackoff.wait();
         }
 
+        Backoff jobBackoff(std::chrono::milliseconds(500), std::chrono::seconds(5));
         while (true) {
             bool finished;
             bool success;
@@ -760,9 +752,9 @@ void FlorenceRedfishAmcManager::flashAMCFirmware(FlashAmcFirmwareParam& param) {
                     break;
                 }
             }
-            // task ongoing, wait 2 sec
+            // job ongoing, poll again later
             XPUM_LOG_INFO("Job {} on going", jobLink);
-            std::this_thread::sleep_for(std::chrono::seconds(2));
+            jobBackoff.wait();
         }
 
         param.callback();
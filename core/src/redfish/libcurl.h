@@ -45,8 +45,13 @@ typedef enum {
     CINIT(USERNAME, STRINGPOINT, 173),
     CINIT(PASSWORD, STRINGPOINT, 174),
     CINIT(MIMEPOST, OBJECTPOINT, 269),
+    CINIT(HTTP_VERSION, LONG, 84),
+    CINIT(TCP_KEEPALIVE, LONG, 213),
+    CINIT(PIPEWAIT, LONG, 237),
 } CURLoption;
 
+#define CURL_HTTP_VERSION_2TLS 4L
+
 #define CURLINFO_LONG 0x200000
 
 typedef enum {
@@ -189,6 +194,45 @@ typedef enum {
 } CURLcode;
 
 
+typedef void CURLM;
+
+typedef enum {
+  CURLM_CALL_MULTI_PERFORM = -1, /* please call curl_multi_perform() or
+                                    curl_multi_socket*() soon */
+  CURLM_OK,
+  CURLM_BAD_HANDLE,      /* the passed-in handle is not a valid CURLM handle */
+  CURLM_BAD_EASY_HANDLE, /* an easy handle was not good/valid */
+  CURLM_OUT_OF_MEMORY,   /* if you ever get this, you're in deep sh*t */
+  CURLM_INTERNAL_ERROR,  /* this is a libcurl bug */
+  CURLM_LAST
+} CURLMcode;
+
+typedef enum {
+  CURLMSG_NONE, /* first, not used */
+  CURLMSG_DONE, /* This easy handle has completed. 'result' contains
+                   the CURLcode of the transfer */
+  CURLMSG_LAST  /* last, not used */
+} CURLMSG;
+
+struct CURLMsg {
+  CURLMSG msg;       /* what this message means */
+  CURL *easy_handle; /* the handle it concerns */
+  union {
+    void *whatever;    /* message-specific data */
+    CURLcode result;   /* return code for transfer */
+  } data;
+};
+typedef struct CURLMsg CURLMsg;
+
+struct curl_waitfd;
+
+#define CURLPIPE_MULTIPLEX 2L
+
+typedef enum {
+    CURLMOPT_PIPELINING = CURLOPTTYPE_LONG + 3,
+    CURLMOPT_MAX_HOST_CONNECTIONS = CURLOPTTYPE_LONG + 7,
+} CURLMoption;
+
 typedef struct curl_mime      curl_mime;
 typedef struct curl_mimepart  curl_mimepart;
 
@@ -285,6 +329,15 @@ typedef CURLcode (*curl_mime_filedata_t)(curl_mimepart *part, const char *filena
 typedef struct curl_slist *(*curl_slist_append_t)(struct curl_slist *, const char *);
 typedef curl_version_info_data *(*curl_version_info_t)(CURLversion age);
 typedef CURLcode (*curl_easy_getinfo_t)(CURL *curl, CURLINFO info, ...);
+typedef void (*curl_easy_reset_t)(CURL *curl);
+typedef CURLM *(*curl_multi_init_t)(void);
+typedef CURLMcode (*curl_multi_setopt_t)(CURLM *multi_handle, CURLMoption option, ...);
+typedef CURLMcode (*curl_multi_add_handle_t)(CURLM *multi_handle, CURL *curl_handle);
+typedef CURLMcode (*curl_multi_remove_handle_t)(CURLM *multi_handle, CURL *curl_handle);
+typedef CURLMcode (*curl_multi_perform_t)(CURLM *multi_handle, int *running_handles);
+typedef CURLMcode (*curl_multi_wait_t)(CURLM *multi_handle, struct curl_waitfd extra_fds[], unsigned int extra_nfds, int timeout_ms, int *ret);
+typedef CURLMsg *(*curl_multi_info_read_t)(CURLM *multi_handle, int *msgs_in_queue);
+typedef CURLMcode (*curl_multi_cleanup_t)(CURLM *multi_handle);
 
 struct CurlLibVersion {
     std::string name;
@@ -365,6 +418,15 @@ class LibCurlApi {
     curl_slist_append_t curl_slist_append;
     curl_version_info_t curl_version_info;
     curl_easy_getinfo_t curl_easy_getinfo;
+    curl_easy_reset_t curl_easy_reset;
+    curl_multi_init_t curl_multi_init;
+    curl_multi_setopt_t curl_multi_setopt;
+    curl_multi_add_handle_t curl_multi_add_handle;
+    curl_multi_remove_handle_t curl_multi_remove_handle;
+    curl_multi_perform_t curl_multi_perform;
+    curl_multi_wait_t curl_multi_wait;
+    curl_multi_info_read_t curl_multi_info_read;
+    curl_multi_cleanup_t curl_multi_cleanup;
 
    public:
     LibCurlApi() {
@@ -396,6 +458,15 @@ class LibCurlApi {
         curl_slist_append = reinterpret_cast<curl_slist_append_t>(dlsym(handle, "curl_slist_append"));
         curl_version_info = reinterpret_cast<curl_version_info_t>(dlsym(handle, "curl_version_info"));
         curl_easy_getinfo = reinterpret_cast<curl_easy_getinfo_t>(dlsym(handle, "curl_easy_getinfo"));
+        curl_easy_reset = reinterpret_cast<curl_easy_reset_t>(dlsym(handle, "curl_easy_reset"));
+        curl_multi_init = reinterpret_cast<curl_multi_init_t>(dlsym(handle, "curl_multi_init"));
+        curl_multi_setopt = reinterpret_cast<curl_multi_setopt_t>(dlsym(handle, "curl_multi_setopt"));
+        curl_multi_add_handle = reinterpret_cast<curl_multi_add_handle_t>(dlsym(handle, "curl_multi_add_handle"));
+        curl_multi_remove_handle = reinterpret_cast<curl_multi_remove_handle_t>(dlsym(handle, "curl_multi_remove_handle"));
+        curl_multi_perform = reinterpret_cast<curl_multi_perform_t>(dlsym(handle, "curl_multi_perform"));
+        curl_multi_wait = reinterpret_cast<curl_multi_wait_t>(dlsym(handle, "curl_multi_wait"));
+        curl_multi_info_read = reinterpret_cast<curl_multi_info_read_t>(dlsym(handle, "curl_multi_info_read"));
+        curl_multi_cleanup = reinterpret_cast<curl_multi_cleanup_t>(dlsym(handle, "curl_multi_cleanup"));
         
         if (!initialized()) {
             if (!libPath.compare("Unknown")) {
@@ -425,6 +496,20 @@ class LibCurlApi {
                curl_slist_append != NULL;
     }
 
+    // the multi interface is optional, requests run one by one without it
+    bool multiSupported() {
+        return initialized() &&
+               curl_easy_reset != NULL &&
+               curl_multi_init != NULL &&
+               curl_multi_setopt != NULL &&
+               curl_multi_add_handle != NULL &&
+               curl_multi_remove_handle != NULL &&
+               curl_multi_perform != NULL &&
+               curl_multi_wait != NULL &&
+               curl_multi_info_read != NULL &&
+               curl_multi_cleanup != NULL;
+    }
+
     std::string getLibCurlVersion() {
         if (handle == NULL || curl_version_info == NULL)
             return "Unknown";
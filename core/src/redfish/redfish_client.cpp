@@ -0,0 +1,206 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file redfish_client.cpp
+ */
+
+#include "redfish_client.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "amc/redfish_amc_manager.h"
+#include "infrastructure/logger.h"
+
+namespace xpum {
+
+static LibCurlApi libcurl;
+
+static size_t curlWriteToStringCallback(void* contents, size_t size, size_t nmemb, std::string* s) {
+    size_t newLength = size * nmemb;
+    try {
+        s->append((char*)contents, newLength);
+    } catch (std::bad_alloc& e) {
+        // handle memory problem
+        return 0;
+    }
+    return newLength;
+}
+
+/*
+  The handles kept for one Redfish service. Connections opened by a transfer
+  stay in the cache of the multi handle, or of the easy handle when the
+  multi interface is not available, and are reused by the next requests.
+*/
+
+class RedfishSession {
+   public:
+    RedfishSession() : multi(nullptr) {
+        if (libcurl.multiSupported()) {
+            multi = libcurl.curl_multi_init();
+        }
+        if (multi != nullptr) {
+            libcurl.curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+            libcurl.curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, RedfishClient::MAX_HOST_CONNECTIONS);
+        }
+    }
+
+    ~RedfishSession() {
+        for (auto curl : idle) {
+            libcurl.curl_easy_cleanup(curl);
+        }
+        if (multi != nullptr) {
+            libcurl.curl_multi_cleanup(multi);
+        }
+    }
+
+    CURL* acquire() {
+        if (idle.empty()) {
+            return libcurl.curl_easy_init();
+        }
+        CURL* curl = idle.back();
+        idle.pop_back();
+        // options are cleared, live connections and TLS sessions are kept
+        if (libcurl.curl_easy_reset != NULL) {
+            libcurl.curl_easy_reset(curl);
+        }
+        return curl;
+    }
+
+    void release(CURL* curl) {
+        if ((long)idle.size() < RedfishClient::MAX_HOST_CONNECTIONS) {
+            idle.push_back(curl);
+        } else {
+            libcurl.curl_easy_cleanup(curl);
+        }
+    }
+
+    std::mutex mutex;
+
+    CURLM* multi;
+
+   private:
+    std::vector<CURL*> idle;
+};
+
+static std::mutex sessions_mutex;
+
+static std::map<std::string, std::shared_ptr<RedfishSession>> sessions;
+
+static std::shared_ptr<RedfishSession> getSession(const std::string& base_url) {
+    std::lock_guard<std::mutex> lock(sessions_mutex);
+    auto& session = sessions[base_url];
+    if (session == nullptr) {
+        session = std::make_shared<RedfishSession>();
+    }
+    return session;
+}
+
+RedfishClient::RedfishClient(std::string base_url, std::string username, std::string password)
+    : base_url(base_url), username(username), password(password) {
+}
+
+void RedfishClient::reset() {
+    std::lock_guard<std::mutex> lock(sessions_mutex);
+    sessions.clear();
+}
+
+RedfishResponse RedfishClient::get(const std::string& path) {
+    return getAll({path}).at(0);
+}
+
+std::vector<RedfishResponse> RedfishClient::getAll(const std::vector<std::string>& paths) {
+    std::vector<RedfishResponse> responses(paths.size());
+    if (paths.empty() || !libcurl.initialized()) {
+        return responses;
+    }
+    auto session = getSession(base_url);
+    std::lock_guard<std::mutex> lock(session->mutex);
+
+    std::vector<std::string> urls;
+    std::vector<CURL*> handles;
+    for (std::size_t i = 0; i < paths.size(); i++) {
+        urls.push_back(base_url + paths[i]);
+    }
+    for (std::size_t i = 0; i < paths.size(); i++) {
+        CURL* curl = session->acquire();
+        if (curl == nullptr) {
+            break;
+        }
+        libcurl.curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "GET");
+        libcurl.curl_easy_setopt(curl, CURLOPT_URL, urls[i].c_str());
+        libcurl.curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+        libcurl.curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
+        libcurl.curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
+        libcurl.curl_easy_setopt(curl, CURLOPT_NOPROXY, "*");
+        libcurl.curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+        libcurl.curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+        libcurl.curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+
+        // timeout
+        libcurl.curl_easy_setopt(curl, CURLOPT_TIMEOUT, (long)XPUM_CURL_TIMEOUT);
+
+        // buffer
+        libcurl.curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlWriteToStringCallback);
+        libcurl.curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responses[i].body);
+
+        // credential
+        libcurl.curl_easy_setopt(curl, CURLOPT_HTTPAUTH, (long)CURLAUTH_BASIC);
+        libcurl.curl_easy_setopt(curl, CURLOPT_USERNAME, username.c_str());
+        libcurl.curl_easy_setopt(curl, CURLOPT_PASSWORD, password.c_str());
+        handles.push_back(curl);
+    }
+
+    if (session->multi == nullptr) {
+        for (std::size_t i = 0; i < handles.size(); i++) {
+            responses[i].code = libcurl.curl_easy_perform(handles[i]);
+        }
+    } else {
+        std::map<CURL*, std::size_t> indexes;
+        for (std::size_t i = 0; i < handles.size(); i++) {
+            if (libcurl.curl_multi_add_handle(session->multi, handles[i]) == CURLM_OK) {
+                indexes[handles[i]] = i;
+            } else {
+                responses[i].code = CURLE_FAILED_INIT;
+            }
+        }
+        int running = 0;
+        do {
+            if (libcurl.curl_multi_perform(session->multi, &running) != CURLM_OK) {
+                break;
+            }
+            if (running > 0) {
+                libcurl.curl_multi_wait(session->multi, nullptr, 0, 1000, nullptr);
+            }
+            CURLMsg* msg;
+            int left;
+            while ((msg = libcurl.curl_multi_info_read(session->multi, &left)) != nullptr) {
+                if (msg->msg == CURLMSG_DONE && indexes.count(msg->easy_handle) > 0) {
+                    responses[indexes[msg->easy_handle]].code = msg->data.result;
+                }
+            }
+        } while (running > 0);
+        for (auto& item : indexes) {
+            libcurl.curl_multi_remove_handle(session->multi, item.first);
+        }
+    }
+
+    for (std::size_t i = 0; i < handles.size(); i++) {
+        if (responses[i].code == CURLE_OK && libcurl.curl_easy_getinfo != NULL) {
+            libcurl.curl_easy_getinfo(handles[i], CURLINFO_RESPONSE_CODE, &responses[i].status);
+        }
+        session->release(handles[i]);
+    }
+    XPUM_LOG_DEBUG("Redfish {} GET requests to {} done", paths.size(), base_url);
+    return responses;
+}
+
+void Backoff::wait() {
+    std::this_thread::sleep_for(delay);
+    delay = std::min(delay * 2, max);
+}
+
+} // namespace xpum
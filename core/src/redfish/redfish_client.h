@@ -0,0 +1,86 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file redfish_client.h
+ */
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "libcurl.h"
+
+namespace xpum {
+
+struct RedfishResponse {
+    CURLcode code = CURL_LAST;
+    long status = 0;
+    std::string body;
+};
+
+/*
+  HTTP client shared by the Redfish AMC managers. The curl handles of a
+  service are kept between calls, so the TCP connection and the TLS session
+  to the BMC are set up once instead of for every request, and HTTP/2 is
+  negotiated when both libcurl and the BMC support it.
+
+  getAll() sends independent GET requests at the same time through the curl
+  multi interface, at most RedfishClient::MAX_HOST_CONNECTIONS connections to
+  a BMC. Requests to the same service are serialized between threads. With a
+  libcurl lacking the multi interface the requests run one after another.
+*/
+
+class RedfishClient {
+   public:
+    static const long MAX_HOST_CONNECTIONS = 8;
+
+    // base_url is the scheme, host and optional port, e.g. https://169.254.3.254:443
+    RedfishClient(std::string base_url, std::string username, std::string password);
+
+    RedfishResponse get(const std::string& path);
+
+    // responses are in the order of paths
+    std::vector<RedfishResponse> getAll(const std::vector<std::string>& paths);
+
+    const std::string& baseUrl() const {
+        return base_url;
+    }
+
+    // drops the kept connections of all services
+    static void reset();
+
+   private:
+    std::string base_url;
+
+    std::string username;
+
+    std::string password;
+};
+
+/*
+  Waits between two polls of a Redfish task, doubling the delay from
+  initial up to max so short tasks are seen finished early while long ones
+  are not polled every second.
+*/
+
+class Backoff {
+   public:
+    Backoff(std::chrono::milliseconds initial, std::chrono::milliseconds max)
+        : initial(initial), max(max), delay(initial) {}
+
+    void wait();
+
+    void reset() {
+        delay = initial;
+    }
+
+   private:
+    std::chrono::milliseconds initial;
+
+    std::chrono::milliseconds max;
+
+    std::chrono::milliseconds delay;
+};
+
+} // namespace xpum
@@ -13,6 +13,7 @@
 #include "detect_usb_interface.h"
 #include "infrastructure/logger.h"
 #include "libcurl.h"
+#include "redfish_client.h"
 #include "util.h"
 #include <regex>
 
@@ -57,6 +58,15 @@ static void curlBasicConfig(CURL* curl, std::string& buffer, std::string usernam
     libcurl.curl_easy_setopt(curl, CURLOPT_PASSWORD, password.c_str());
 }
 
+static RedfishClient redfishClient(RedfishHostInterface interface, std::string username, std::string password) {
+    std::stringstream url;
+    url << "https://";
+    url << interface.ipv4_service_addr;
+    if (interface.ipv4_service_port.length() > 0)
+        url << ":" << interface.ipv4_service_port;
+    return RedfishClient(url.str(), username, password);
+}
+
 static bool getBasePage(RedfishHostInterface interface) {
     std::string path = "/redfish/v1";
     std::stringstream url;
@@ -132,35 +142,15 @@ static bool parseErrorMsg(json obj, std::string& errMsg) {
     return false;
 }
 
-static bool getAmcFwVersionByOdataId(RedfishHostInterface interface,
-                                     std::string username,
-                                     std::string password,
+static bool getAmcFwVersionByOdataId(const RedfishClient& client,
+                                     const RedfishResponse& response,
                                      std::string odataid,
                                      std::string& version,
                                      std::string& errMsg) {
-    std::stringstream url;
-    url << "https://";
-    url << interface.ipv4_service_addr;
-    if (interface.ipv4_service_port.length() > 0)
-        url << ":" << interface.ipv4_service_port;
-    url << odataid;
-    CURL* curl;
-    CURLcode res = CURL_LAST;
-    std::string buffer;
-    curl = libcurl.curl_easy_init();
-    if (curl) {
-        libcurl.curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "GET");
-        libcurl.curl_easy_setopt(curl, CURLOPT_URL, url.str().c_str());
-
-        curlBasicConfig(curl, buffer, username, password);
-
-        res = libcurl.curl_easy_perform(curl);
-    }
-    libcurl.curl_easy_cleanup(curl);
-    if (res != CURLE_OK) {
-        switch (res) {
+    if (response.code != CURLE_OK) {
+        switch (response.code) {
             case CURLE_OPERATION_TIMEDOUT:
-                errMsg = "Request to " + url.str() + " timeout";
+                errMsg = "Request to " + client.baseUrl() + odataid + " timeout";
                 break;
             default:
                 errMsg = "Fail to get " + odataid;
@@ -169,7 +159,7 @@ static bool getAmcFwVersionByOdataId(RedfishHostInterface interface,
     }
     json fwJson;
     try {
-        fwJson = json::parse(buffer);
+        fwJson = json::parse(response.body);
     } catch (...) {
         // parse error
         errMsg = "Fail to parse json from " + odataid;
@@ -190,39 +180,21 @@ static xpum_result_t getGPUFwInventoryList(RedfishHostInterface interface,
                                     std::string& errMsg) {
     // get gpu list
     std::string path = "/redfish/v1/UpdateService/FirmwareInventory";
-    std::stringstream url;
-    url << "https://";
-    url << interface.ipv4_service_addr;
-    if (interface.ipv4_service_port.length() > 0)
-        url << ":" << interface.ipv4_service_port;
-    url << path;
-
-    CURL* curl;
-    CURLcode res = CURL_LAST;
-    std::string buffer;
-    curl = libcurl.curl_easy_init();
-    if (curl) {
-        libcurl.curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "GET");
-        libcurl.curl_easy_setopt(curl, CURLOPT_URL, url.str().c_str());
-
-        curlBasicConfig(curl, buffer, username, password);
-
-        res = libcurl.curl_easy_perform(curl);
-    }
-    libcurl.curl_easy_cleanup(curl);
-    if (res != CURLE_OK){
-        switch (res) {
+    auto client = redfishClient(interface, username, password);
+    auto response = client.get(path);
+    if (response.code != CURLE_OK){
+        switch (response.code) {
             case CURLE_OPERATION_TIMEDOUT:
-                errMsg = "Request to " + url.str() + " timeout";
+                errMsg = "Request to " + client.baseUrl() + path + " timeout";
                 break;
             default:
-                errMsg = "Fail to request " + url.str();
+                errMsg = "Fail to request " + client.baseUrl() + path;
         }
         return XPUM_GENERIC_ERROR;
     }
     json fwInventoryJson;
     try {
-        fwInventoryJson = json::parse(buffer);
+        fwInventoryJson = json::parse(response.body);
     } catch (...) {
         // parse error
         errMsg = "Fail to parse fw inventory json";
@@ -347,10 +319,13 @@ void SMCRedfishAmcManager::getAmcFirmwareVersions(GetAmcFirmwareVersionsParam& p
         param.errCode = errCode;
         return;
     }
-    for (auto link : gpuOdataIdList) {
+    // the firmware of every GPU is queried at the same time
+    auto client = redfishClient(hostInterface, param.username, param.password);
+    auto responses = client.getAll(gpuOdataIdList);
+    for (std::size_t i = 0; i < gpuOdataIdList.size(); i++) {
         std::string version;
         std::string message;
-        if (getAmcFwVersionByOdataId(hostInterface, param.username, param.password, link, version, message)) {
+        if (getAmcFwVersionByOdataId(client, responses[i], gpuOdataIdList[i], version, message)) {
             param.versions.push_back(version);
         } else {
             param.errCode = XPUM_GENERIC_ERROR;
@@ -1078,35 +1053,15 @@ static bool triggerUpdate(RedfishHostInterface interface,
     return false;
 }
 
-static bool getTargetUriByOdataId(RedfishHostInterface interface,
-                                  std::string username,
-                                  std::string password,
+static bool getTargetUriByOdataId(const RedfishClient& client,
+                                  const RedfishResponse& response,
                                   std::string odataid,
                                   std::string& targetUri,
                                   std::string& errMsg) {
-    std::stringstream url;
-    url << "https://";
-    url << interface.ipv4_service_addr;
-    if (interface.ipv4_service_port.length() > 0)
-        url << ":" << interface.ipv4_service_port;
-    url << odataid;
-    CURL* curl;
-    CURLcode res = CURL_LAST;
-    std::string buffer;
-    curl = libcurl.curl_easy_init();
-    if (curl) {
-        libcurl.curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "GET");
-        libcurl.curl_easy_setopt(curl, CURLOPT_URL, url.str().c_str());
-
-        curlBasicConfig(curl, buffer, username, password);
-
-        res = libcurl.curl_easy_perform(curl);
-    }
-    libcurl.curl_easy_cleanup(curl);
-    if (res != CURLE_OK){
-        switch (res) {
+    if (response.code != CURLE_OK){
+        switch (response.code) {
             case CURLE_OPERATION_TIMEDOUT:
-                errMsg = "Request to " + url.str() + " timeout";
+                errMsg = "Request to " + client.baseUrl() + odataid + " timeout";
                 break;
             default:
                 errMsg = "Fail to get " + odataid;
@@ -1115,7 +1070,7 @@ static bool getTargetUriByOdataId(RedfishHostInterface interface,
     }
     json fwJson;
     try {
-        fwJson = json::parse(buffer);
+        fwJson = json::parse(response.body);
     } catch (...) {
         // parse error
         errMsg = "Fail to parse json from " + odataid;
@@ -1208,13 +1163,14 @@ void SMCRedfishAmcManager::flashAMCFirmware(FlashAmcFirmwareParam& param) {
     XPUM_LOG_INFO("Get odata.ids:");
     
     std::vector<std::string> targetUriList;
-    for (auto oid : odataIds) {
-        XPUM_LOG_INFO("{}", oid);
+    auto client = redfishClient(hostInterface, param.username, param.password);
+    auto responses = client.getAll(odataIds);
+    for (std::size_t i = 0; i < odataIds.size(); i++) {
+        XPUM_LOG_INFO("{}", odataIds[i]);
         std::string targetUri;
-        if (getTargetUriByOdataId(hostInterface,
-                                  param.username,
-                                  param.password,
-                                  oid, targetUri,
+        if (getTargetUriByOdataId(client,
+                                  responses[i],
+                                  odataIds[i], targetUri,
                                   param.errMsg)) {
             targetUriList.push_back(targetUri);
         }
@@ -1230,7 +1186,7 @@ void SMCRedfishAmcManager::flashAMCFirmware(FlashAmcFirmwareParam& param) {
     task = std::async(std::launch::async, [this, targetUriList, pushUri, triggerUri, param] {
         FlashAmcFirmwareParam parameters = param;
         std::size_t gpuIndex = 0;
-        int waitTime = 30;
+        Backoff uploadBackoff(std::chrono::seconds(10), std::chrono::seconds(60));
         int retry = 3;
         for (; gpuIndex < targetUriList.size();) {
             auto targetLink = targetUriList.at(gpuIndex);
@@ -1242,8 +1198,8 @@ void SMCRedfishAmcManager::flashAMCFirmware(FlashAmcFirmwareParam& param) {
                              targetLink,
                              verifyTaskLink)) {
                 if (retry--) {
-                    XPUM_LOG_DEBUG("Sleep for {}s", waitTime);
-                    std::this_thread::sleep_for(std::chrono::seconds(waitTime));
+                    XPUM_LOG_DEBUG("Retry uploading image to {}", targetLink);
+                    uploadBackoff.wait();
                     continue;
                 }
                 XPUM_LOG_ERROR("Fail to upload image");
@@ -1252,9 +1208,11 @@ void SMCRedfishAmcManager::flashAMCFirmware(FlashAmcFirmwareParam& param) {
                 return xpum_firmware_flash_result_t::XPUM_DEVICE_FIRMWARE_FLASH_ERROR;
             }
             retry = 3;
+            uploadBackoff.reset();
             std::vector<std::string> taskUriList;
             if (server_model == SMC_2U_SYS_620C_TN12R_RSC_D2_668G4 || server_model == SMC_2U_SYS_620C_TN12R_RSC_D2R_668G4) {
                 // check image verify result
+                Backoff verifyBackoff(std::chrono::milliseconds(250), std::chrono::seconds(2));
                 while (true) {
                     bool finished = false;
                     bool success = false;
@@ -1272,7 +1230,7 @@ void SMCRedfishAmcManager::flashAMCFirmware(FlashAmcFirmwareParam& param) {
                         XPUM_LOG_INFO("GPU firmware was verified successfully");
                         break;
                     }
-                    std::this_thread::sleep_for(std::chrono::seconds(1));
+                    verifyBackoff.wait();
                 }
 
                 // trigger update
@@ -1296,6 +1254,7 @@ void SMCRedfishAmcManager::flashAMCFirmware(FlashAmcFirmwareParam& param) {
 
             auto taskUri = taskUriList.at(0); // get first task link
 
+            Backoff taskBackoff(std::chrono::milliseconds(500), std::chrono::seconds(5));
             while (true) {
                 // get task result
                 bool success;
@@ -1326,9 +1285,9 @@ void SMCRedfishAmcManager::flashAMCFirmware(FlashAmcFirmwareParam& param) {
                     }
                 }
                 this->percent.store((percent + gpuIndex * 100) / targetUriList.size());
-                // task ongoing, wait 2 sec
+                // task ongoing, poll again later
                 XPUM_LOG_DEBUG("Task {} on going: {}", taskUri, percent);
-                std::this_thread::sleep_for(std::chrono::seconds(2));
+                taskBackoff.wait();
             }
             gpuIndex++;
         }
@@ -1361,39 +1320,22 @@ static bool getOneTaskUpdateResult(RedfishHostInterface interface,
                                    bool& success,
                                    std::string& errMsg,
                                    int& percent) {
-    std::stringstream url;
-    url << "https://";
-    url << interface.ipv4_service_addr;
-    if (interface.ipv4_service_port.length() > 0)
-        url << ":" << interface.ipv4_service_port;
-    url << taskUri;
-
-    CURL* curl;
-    CURLcode res = CURL_LAST;
-    std::string buffer;
-    curl = libcurl.curl_easy_init();
-    if (curl) {
-        libcurl.curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "GET");
-        libcurl.curl_easy_setopt(curl, CURLOPT_URL, url.str().c_str());
-        curlBasicConfig(curl, buffer, username, password);
-
-        res = libcurl.curl_easy_perform(curl);
-    }
-    libcurl.curl_easy_cleanup(curl);
+    auto client = redfishClient(interface, username, password);
+    auto response = client.get(taskUri);
     success = false;
-    if (res != CURLE_OK) {
-        switch (res) {
+    if (response.code != CURLE_OK) {
+        switch (response.code) {
             case CURLE_OPERATION_TIMEDOUT:
-                errMsg = "Request to " + url.str() + " timeout";
+                errMsg = "Request to " + client.baseUrl() + taskUri + " timeout";
                 break;
             default:
-                errMsg = "Fail to request " + url.str();;
+                errMsg = "Fail to request " + client.baseUrl() + taskUri;
         }
         return false;
     }
     json taskJson;
     try {
-        taskJson = json::parse(buffer);
+        taskJson = json::parse(response.body);
     } catch (...) {
         // parse error
         errMsg = "Fail to parse task json";
@@ -1479,39 +1421,21 @@ static xpum_result_t getGPUPCIeSlots(RedfishHostInterface interface,
                                      std::string& errMsg) {
     // get gpu list
     std::string path = "/redfish/v1/Chassis/1/PCIeDevices";
-    std::stringstream url;
-    url << "https://";
-    url << interface.ipv4_service_addr;
-    if (interface.ipv4_service_port.length() > 0)
-        url << ":" << interface.ipv4_service_port;
-    url << path;
-
-    CURL* curl;
-    CURLcode res = CURL_LAST;
-    std::string buffer;
-    curl = libcurl.curl_easy_init();
-    if (curl) {
-        libcurl.curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "GET");
-        libcurl.curl_easy_setopt(curl, CURLOPT_URL, url.str().c_str());
-
-        curlBasicConfig(curl, buffer, username, password);
-
-        res = libcurl.curl_easy_perform(curl);
-    }
-    libcurl.curl_easy_cleanup(curl);
-    if (res != CURLE_OK){
-        switch (res) {
+    auto client = redfishClient(interface, username, password);
+    auto response = client.get(path);
+    if (response.code != CURLE_OK){
+        switch (response.code) {
             case CURLE_OPERATION_TIMEDOUT:
-                errMsg = "Request to " + url.str() + " timeout";
+                errMsg = "Request to " + client.baseUrl() + path + " timeout";
                 break;
             default:
-                errMsg = "Fail to request " + url.str();
+                errMsg = "Fail to request " + client.baseUrl() + path;
         }
         return XPUM_GENERIC_ERROR;
     }
     json fwInventoryJson;
     try {
-        fwInventoryJson = json::parse(buffer);
+        fwInventoryJson = json::parse(response.body);
     } catch (...) {
         // parse error
         errMsg = "Fail to parse PCIe device collection json";
@@ -1534,45 +1458,24 @@ static xpum_result_t getGPUPCIeSlots(RedfishHostInterface interface,
     return XPUM_GENERIC_ERROR;
 }
 
-static xpum_result_t getSlotIdAndSerialNumber(RedfishHostInterface interface,
-                                              std::string username,
-                                              std::string password,
+static xpum_result_t getSlotIdAndSerialNumber(const RedfishClient& client,
+                                              const RedfishResponse& response,
                                               std::string path,
                                               std::string& errMsg,
                                               SlotSerialNumberAndFwVersion& data) {
-    std::stringstream url;
-    url << "https://";
-    url << interface.ipv4_service_addr;
-    if (interface.ipv4_service_port.length() > 0)
-        url << ":" << interface.ipv4_service_port;
-    url << path;
-
-    CURL* curl;
-    CURLcode res = CURL_LAST;
-    std::string buffer;
-    curl = libcurl.curl_easy_init();
-    if (curl) {
-        libcurl.curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "GET");
-        libcurl.curl_easy_setopt(curl, CURLOPT_URL, url.str().c_str());
-
-        curlBasicConfig(curl, buffer, username, password);
-
-        res = libcurl.curl_easy_perform(curl);
-    }
-    libcurl.curl_easy_cleanup(curl);
-    if (res != CURLE_OK){
-        switch (res) {
+    if (response.code != CURLE_OK){
+        switch (response.code) {
             case CURLE_OPERATION_TIMEDOUT:
-                errMsg = "Request to " + url.str() + " timeout";
+                errMsg = "Request to " + client.baseUrl() + path + " timeout";
                 break;
             default:
-                errMsg = "Fail to request " + url.str();
+                errMsg = "Fail to request " + client.baseUrl() + path;
         }
         return XPUM_GENERIC_ERROR;
     }
     json fwInventoryJson;
     try {
-        fwInventoryJson = json::parse(buffer);
+        fwInventoryJson = json::parse(response.body);
     } catch (...) {
         // parse error
         errMsg = "Fail to parse PCIe device json";
@@ -1600,10 +1503,13 @@ void SMCRedfishAmcManager::getAMCSlotSerialNumbers(GetAmcSlotSerialNumbersParam&
     auto res = getGPUPCIeSlots(hostInterface, param.username, param.password, gpuOdataIdList, param.errMsg);
     if (res)
         return;
-    for (auto link : gpuOdataIdList) {
+    // the slots are queried at the same time
+    auto client = redfishClient(hostInterface, param.username, param.password);
+    auto responses = client.getAll(gpuOdataIdList);
+    for (std::size_t i = 0; i < gpuOdataIdList.size(); i++) {
         std::string errMsg;
         SlotSerialNumberAndFwVersion data;
-        if (getSlotIdAndSerialNumber(hostInterface, param.username, param.password, link, errMsg, data) == XPUM_OK) {
+        if (getSlotIdAndSerialNumber(client, responses[i], gpuOdataIdList[i], errMsg, data) == XPUM_OK) {
             param.serialNumberList.push_back(data);
         }
     }
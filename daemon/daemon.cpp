@@ -26,6 +26,7 @@
 #include <thread>
 
 #include "logger.h"
+#include "metrics_exporter.h"
 #include "xpum_api.h"
 #include "xpum_core_service_impl.h"
 #include "xpum_core_service_unprivileged_impl.h"
@@ -58,6 +59,8 @@ char* enabled_metrics = nullptr;
 std::size_t log_max_size = 10 * 1024 * 1024;
 std::size_t log_max_files = 3;
 std::string log_level = "";
+std::string metrics_address = "127.0.0.1";
+uint16_t metrics_port = 0;
 
 std::mutex xpummutex;
 std::atomic_bool stop(false);
@@ -77,6 +80,8 @@ void print_help(const char* app_name) {
     printf("   -l, --log_file=filename          logfile to write\n");
     printf("       --log_max_size=number        max size of log file in MB\n");
     printf("       --log_max_files=number       max number of log files\n");
+    printf("       --metrics_port=PORT          serve Prometheus metrics at http://ADDRESS:PORT/metrics\n");
+    printf("       --metrics_address=ADDRESS    listen address of the metrics endpoint (default 127.0.0.1)\n");
     printf("   -m, --enable_metrics=METRICS     list enabled metric indexes, seperated by comma,\n");
     printf("                                    use hyphen to indicate a range (e.g., 0,4-7,27-29)\n");
     printf("        Index   Metric                                              Default\n");
@@ -279,6 +284,15 @@ bool to_size_t(const char* number, size_t& size) {
     }
 }
 
+bool to_port(const char* number, uint16_t& port) {
+    size_t tmp;
+    if (!to_size_t(number, tmp) || tmp == 0 || tmp > 65535) {
+        return false;
+    }
+    port = tmp;
+    return true;
+}
+
 bool to_log_level(const char* level, std::string& log_level) {
     std::string tmp = level;
     for (auto p = tmp.begin(); tmp.end() != p; ++p)
@@ -303,6 +317,9 @@ void parse_opts(int argc, char* argv[]) {
         {"log_max_size", required_argument, &lopt, 1},
         {"log_max_files", required_argument, &lopt, 2},
         {"log_level", required_argument, &lopt, 3},
+        // metrics endpoint options:
+        {"metrics_port", required_argument, &lopt, 4},
+        {"metrics_address", required_argument, &lopt, 5},
         {NULL, 0, 0, 0}};
     int value, option_index = 0;
     while ((value = getopt_long(argc, argv, "s:p:d:l:m:h", long_options, &option_index)) != -1) {
@@ -319,6 +336,13 @@ void parse_opts(int argc, char* argv[]) {
                     case 3:
                         valid = to_log_level(optarg, log_level);
                         break;
+                    case 4:
+                        valid = to_port(optarg, metrics_port);
+                        break;
+                    case 5:
+                        metrics_address = optarg;
+                        valid = !metrics_address.empty();
+                        break;
                     default:
                         break;
                 }
@@ -396,9 +420,22 @@ int main(int argc, char* argv[]) {
         XPUM_LOG_ERROR("XPUM: Load xpum library failed! {}", res);
     }
 
+    unique_ptr<MetricsExporter> metricsExporter;
+    if (metrics_port != 0 && res == xpum::XPUM_OK) {
+        metricsExporter.reset(new MetricsExporter(metrics_address, metrics_port));
+        if (!metricsExporter->start()) {
+            metricsExporter.reset();
+        }
+    }
+
     XPUM_LOG_INFO("XPUM: start XPUM RPC Server.");
     runRPCServers();
 
+    if (metricsExporter != nullptr) {
+        metricsExporter->stop();
+        metricsExporter.reset();
+    }
+
     XPUM_LOG_INFO("XPUM: Shut down.");
     res = xpum::xpumShutdown();
     XPUM_LOG_INFO("XPUM: xpum service is closed.");
@@ -407,7 +444,7 @@ int main(int argc, char* argv[]) {
         unlink(pid_file_name);
     }
 
-    Logger::flush();
+    Logger::close();
 
     return 0;
 }
@@ -7,6 +7,7 @@
 #pragma once
 #include <string>
 
+#include "spdlog/async.h"
 #include "spdlog/cfg/env.h"
 #include "spdlog/sinks/rotating_file_sink.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
@@ -15,21 +16,36 @@
 #define XPUM_LOG_INFO(...) spdlog::info(__VA_ARGS__)
 #define XPUM_LOG_WARN(...) spdlog::warn(__VA_ARGS__)
 #define XPUM_LOG_ERROR(...) spdlog::error(__VA_ARGS__)
+#define XPUM_LOG_FATAL(...) spdlog::critical(__VA_ARGS__)
+
+#ifdef XPUM_LOG_NO_DEBUG
+#define XPUM_LOG_DEBUG(...) (void)0
+#define XPUM_LOG_TRACE(...) (void)0
+#else
 #define XPUM_LOG_DEBUG(...) spdlog::debug(__VA_ARGS__)
 #define XPUM_LOG_TRACE(...) spdlog::trace(__VA_ARGS__)
-#define XPUM_LOG_FATAL(...) spdlog::critical(__VA_ARGS__)
+#endif
 
 namespace xpum::daemon {
 
+/*
+  The daemon logs asynchronously: formatting and writing to the sinks happen
+  on a dedicated thread, and when the queue is full the oldest messages are
+  dropped instead of blocking the sampling threads.
+*/
+
 class Logger {
    public:
+    static const std::size_t ASYNC_QUEUE_SIZE = 8192;
+
     static void init(const std::string& log_level, const char* log_file_name = nullptr, std::size_t max_size = 10 * 1024 * 1024, std::size_t max_files = 3) {
         std::vector<spdlog::sink_ptr> sinks;
         sinks.emplace_back(std::make_shared<spdlog::sinks::stdout_color_sink_mt>());
         if (log_file_name != nullptr) {
             sinks.emplace_back(std::make_shared<spdlog::sinks::rotating_file_sink_mt>(log_file_name, max_size, max_files, false));
         }
-        auto logger = std::make_shared<spdlog::logger>("daemon", begin(sinks), end(sinks));
+        spdlog::init_thread_pool(ASYNC_QUEUE_SIZE, 1);
+        auto logger = std::make_shared<spdlog::async_logger>("daemon", begin(sinks), end(sinks), spdlog::thread_pool(), spdlog::async_overflow_policy::overrun_oldest);
         logger->flush_on(spdlog::level::info);
         spdlog::flush_every(std::chrono::seconds(3));
         spdlog::set_default_logger(logger);
@@ -0,0 +1,507 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file metrics_exporter.cpp
+ */
+
+#include "metrics_exporter.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef XPUM_METRICS_GZIP
+#include <zlib.h>
+#endif
+
+#include "logger.h"
+#include "xpum_api.h"
+
+namespace xpum::daemon {
+
+struct MetricMember {
+    xpum_stats_type_t type;
+    const char* labels;
+};
+
+/*
+  Names, help texts and conversions follow
+  rest/prometheus_exporter/prometheus_exporter_types.py so that dashboards
+  work with either exporter. Counters carry the _total suffix as written by
+  the Python client library.
+*/
+
+struct MetricFamily {
+    const char* name;
+    const char* help;
+    bool counter;
+    double factor;
+    std::vector<MetricMember> members;
+};
+
+static const std::vector<MetricFamily> metric_families = {
+    {"xpum_engine_ratio", "GPU active time of the elapsed time (in %), per GPU tile", false, 0.01,
+     {{XPUM_STATS_GPU_UTILIZATION, ""}}},
+    {"xpum_engine_group_ratio", "Avg utilization of engine group (in %), per GPU tile", false, 0.01,
+     {{XPUM_STATS_ENGINE_GROUP_COMPUTE_ALL_UTILIZATION, "type=\"compute\","},
+      {XPUM_STATS_ENGINE_GROUP_MEDIA_ALL_UTILIZATION, "type=\"media\","},
+      {XPUM_STATS_ENGINE_GROUP_COPY_ALL_UTILIZATION, "type=\"copy\","},
+      {XPUM_STATS_ENGINE_GROUP_RENDER_ALL_UTILIZATION, "type=\"render\","},
+      {XPUM_STATS_ENGINE_GROUP_3D_ALL_UTILIZATION, "type=\"3d\","}}},
+    {"xpum_eu_active_ratio", "GPU EU Array Active (in %), per tile", false, 0.01,
+     {{XPUM_STATS_EU_ACTIVE, ""}}},
+    {"xpum_eu_stall_ratio", "GPU EU Array Stall (in %), per tile", false, 0.01,
+     {{XPUM_STATS_EU_STALL, ""}}},
+    {"xpum_eu_idle_ratio", "GPU EU Array Idle (in %), per tile", false, 0.01,
+     {{XPUM_STATS_EU_IDLE, ""}}},
+    {"xpum_power_watts", "Avg GPU power (in watts), per GPU and per card", false, 1,
+     {{XPUM_STATS_POWER, ""}}},
+    {"xpum_energy_joules", "Total GPU energy consumption since boot (in Joules), per GPU", true, 0.001,
+     {{XPUM_STATS_ENERGY, ""}}},
+    {"xpum_temperature_celsius", "Avg GPU temperature (in Celsius degree), per tile", false, 1,
+     {{XPUM_STATS_GPU_CORE_TEMPERATURE, "location=\"gpu\","},
+      {XPUM_STATS_MEMORY_TEMPERATURE, "location=\"mem\","}}},
+    {"xpum_frequency_mhz", "Avg (GPU) frequency (in MHz), per GPU tile", false, 1,
+     {{XPUM_STATS_GPU_FREQUENCY, "location=\"gpu\",type=\"actual\","},
+      {XPUM_STATS_GPU_REQUEST_FREQUENCY, "location=\"gpu\",type=\"request\","}}},
+    {"xpum_memory_used_bytes", "Used GPU memory (in bytes), per GPU tile", false, 1,
+     {{XPUM_STATS_MEMORY_USED, ""}}},
+    {"xpum_memory_ratio", "Used GPU memory / Total used GPU memory (in %), per GPU tile", false, 0.01,
+     {{XPUM_STATS_MEMORY_UTILIZATION, ""}}},
+    {"xpum_memory_bandwidth_ratio", "Avg memory throughput / max memory bandwidth (in %), per GPU tile", false, 0.01,
+     {{XPUM_STATS_MEMORY_BANDWIDTH, ""}}},
+    {"xpum_memory_read_bytes", "Total memory read bytes (in bytes), per GPU tile", true, 1,
+     {{XPUM_STATS_MEMORY_READ, ""}}},
+    {"xpum_memory_write_bytes", "Total memory write bytes (in bytes), per GPU tile", true, 1,
+     {{XPUM_STATS_MEMORY_WRITE, ""}}},
+    {"xpum_resets", "Total number of GPU reset since Sysman init, per GPU", true, 1,
+     {{XPUM_STATS_RAS_ERROR_CAT_RESET, ""}}},
+    {"xpum_programming_errors", "Total number of GPU programming errors since Sysman init, per GPU", true, 1,
+     {{XPUM_STATS_RAS_ERROR_CAT_PROGRAMMING_ERRORS, ""}}},
+    {"xpum_driver_errors", "Total number of GPU driver errors since Sysman init, per GPU", true, 1,
+     {{XPUM_STATS_RAS_ERROR_CAT_DRIVER_ERRORS, ""}}},
+    {"xpum_cache_errors", "Total number of GPU cache errors since Sysman init, per GPU", true, 1,
+     {{XPUM_STATS_RAS_ERROR_CAT_CACHE_ERRORS_CORRECTABLE, "type=\"correctable\","},
+      {XPUM_STATS_RAS_ERROR_CAT_CACHE_ERRORS_UNCORRECTABLE, "type=\"uncorrectable\","}}},
+    {"xpum_non_compute_errors", "Total number of GPU non-compute errors since Sysman init, per GPU", true, 1,
+     {{XPUM_STATS_RAS_ERROR_CAT_NON_COMPUTE_ERRORS_CORRECTABLE, "type=\"correctable\","},
+      {XPUM_STATS_RAS_ERROR_CAT_NON_COMPUTE_ERRORS_UNCORRECTABLE, "type=\"uncorrectable\","}}},
+    {"xpum_pcie_read_bytes", "Total PCIe read bytes (in bytes), per GPU", true, 1,
+     {{XPUM_STATS_PCIE_READ, ""}}},
+    {"xpum_pcie_write_bytes", "Total PCIe write bytes (in bytes), per GPU", true, 1,
+     {{XPUM_STATS_PCIE_WRITE, ""}}},
+};
+
+/*
+  Operation lock statistics of the devices, from
+  xpumGetDeviceOperationStats. Not in the Python exporter.
+*/
+
+struct OperationFamily {
+    const char* name;
+    const char* help;
+    bool counter;
+    double factor;
+    uint64_t xpum_device_operation_stats_t::*field;
+};
+
+static const std::vector<OperationFamily> operation_families = {
+    {"xpum_device_operation_paused_reads", "Telemetry reads skipped while a firmware flash, reset or PPR held the GPU", true, 1,
+     &xpum_device_operation_stats_t::pausedReads},
+    {"xpum_device_operations", "Firmware flash, reset and PPR operations that got the GPU", true, 1,
+     &xpum_device_operation_stats_t::operationCount},
+    {"xpum_device_operations_refused", "Firmware flash, reset and PPR operations that did not get the GPU", true, 1,
+     &xpum_device_operation_stats_t::refusedOperationCount},
+    {"xpum_device_operation_wait_seconds", "Time the operations waited for the GPU", true, 0.000001,
+     &xpum_device_operation_stats_t::waitTime},
+    {"xpum_device_operation_max_wait_seconds", "Longest time an operation waited for the GPU", false, 0.000001,
+     &xpum_device_operation_stats_t::maxWaitTime},
+};
+
+static const int POLL_INTERVAL_MS = 500;
+
+static const int SOCKET_TIMEOUT_S = 5;
+
+static const size_t MAX_REQUEST_SIZE = 8192;
+
+static void appendLabel(std::string& out, const char* name, const char* value) {
+    out += name;
+    out += "=\"";
+    for (const char* p = value; *p != '\0'; p++) {
+        if (*p == '\\' || *p == '"') {
+            out += '\\';
+            out += *p;
+        } else if (*p == '\n') {
+            out += "\\n";
+        } else {
+            out += *p;
+        }
+    }
+    out += "\",";
+}
+
+static bool sendAll(int fd, const char* data, size_t len) {
+    while (len > 0) {
+        ssize_t n = send(fd, data, len, MSG_NOSIGNAL);
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        len -= n;
+    }
+    return true;
+}
+
+static void sendResponse(int fd, const char* status, const char* content_type, const char* encoding, const std::string* payload, bool head) {
+    char header[256];
+    int len = snprintf(header, sizeof(header),
+                       "HTTP/1.1 %s\r\nContent-Type: %s\r\n%s%s%sContent-Length: %zu\r\nConnection: close\r\n\r\n",
+                       status, content_type,
+                       encoding != nullptr ? "Content-Encoding: " : "",
+                       encoding != nullptr ? encoding : "",
+                       encoding != nullptr ? "\r\n" : "",
+                       payload != nullptr ? payload->size() : 0);
+    if (len <= 0 || !sendAll(fd, header, len)) {
+        return;
+    }
+    if (payload != nullptr && !head) {
+        sendAll(fd, payload->data(), payload->size());
+    }
+}
+
+MetricsExporter::MetricsExporter(const std::string& address, uint16_t port)
+    : address(address), port(port), listen_fd(-1), stopped(true) {
+    for (auto& family : metric_families) {
+        for (auto& member : family.members) {
+            metric_types.push_back(member.type);
+        }
+    }
+}
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+}
+
+bool MetricsExporter::start() {
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, address.c_str(), &addr.sin_addr) != 1) {
+        XPUM_LOG_ERROR("XPUM: invalid metrics listen address {}", address);
+        return false;
+    }
+
+    listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_fd < 0) {
+        XPUM_LOG_ERROR("XPUM: failed to create metrics socket: {}", strerror(errno));
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    if (bind(listen_fd, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(listen_fd, 16) < 0) {
+        XPUM_LOG_ERROR("XPUM: failed to listen for metrics at {}:{}: {}", address, port, strerror(errno));
+        close(listen_fd);
+        listen_fd = -1;
+        return false;
+    }
+
+    stopped = false;
+    server_thread = std::thread(&MetricsExporter::serve, this);
+    XPUM_LOG_INFO("XPUM: metrics endpoint is listening at http://{}:{}/metrics", address, port);
+    return true;
+}
+
+void MetricsExporter::stop() {
+    if (stopped.exchange(true)) {
+        return;
+    }
+    if (server_thread.joinable()) {
+        server_thread.join();
+    }
+    if (listen_fd >= 0) {
+        close(listen_fd);
+        listen_fd = -1;
+    }
+}
+
+void MetricsExporter::serve() {
+    pollfd pfd;
+    pfd.fd = listen_fd;
+    pfd.events = POLLIN;
+    while (!stopped) {
+        pfd.revents = 0;
+        int ret = poll(&pfd, 1, POLL_INTERVAL_MS);
+        if (ret <= 0 || (pfd.revents & POLLIN) == 0) {
+            continue;
+        }
+        int fd = accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            continue;
+        }
+        timeval timeout{SOCKET_TIMEOUT_S, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        handleConnection(fd);
+        close(fd);
+    }
+}
+
+void MetricsExporter::handleConnection(int fd) {
+    char buf[MAX_REQUEST_SIZE];
+    size_t len = 0;
+    while (len < sizeof(buf) - 1) {
+        ssize_t n = recv(fd, buf + len, sizeof(buf) - 1 - len, 0);
+        if (n <= 0) {
+            return;
+        }
+        len += n;
+        buf[len] = '\0';
+        if (strstr(buf, "\r\n\r\n") != nullptr || strstr(buf, "\n\n") != nullptr) {
+            break;
+        }
+    }
+    buf[len] = '\0';
+
+    bool head = strncmp(buf, "HEAD ", 5) == 0;
+    if (strncmp(buf, "GET ", 4) != 0 && !head) {
+        sendResponse(fd, "405 Method Not Allowed", "text/plain", nullptr, nullptr, head);
+        return;
+    }
+    const char* path = buf + (head ? 5 : 4);
+    size_t path_len = strcspn(path, " ?\r\n");
+    if (path_len != strlen("/metrics") || strncmp(path, "/metrics", path_len) != 0) {
+        sendResponse(fd, "404 Not Found", "text/plain", nullptr, nullptr, head);
+        return;
+    }
+
+    bool accept_gzip = false;
+#ifdef XPUM_METRICS_GZIP
+    for (char* line = strchr(buf, '\n'); line != nullptr; line = strchr(line, '\n')) {
+        line++;
+        if (strncasecmp(line, "Accept-Encoding:", 16) == 0) {
+            char* end = strchr(line, '\n');
+            std::string value(line + 16, end != nullptr ? end - line - 16 : strlen(line + 16));
+            accept_gzip = value.find("gzip") != std::string::npos;
+            break;
+        }
+    }
+#endif
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+    render();
+    const char* content_type = "text/plain; version=0.0.4; charset=utf-8";
+    if (accept_gzip && compress()) {
+        sendResponse(fd, "200 OK", content_type, "gzip", &gzip_body, head);
+    } else {
+        sendResponse(fd, "200 OK", content_type, nullptr, &body, head);
+    }
+}
+
+void MetricsExporter::updateLabels() {
+    int count = 0;
+    if (xpumGetDeviceList(nullptr, &count) != XPUM_OK || count < 0) {
+        count = 0;
+    }
+    std::vector<xpum_device_basic_info> list(count);
+    if (count > 0 && xpumGetDeviceList(list.data(), &count) != XPUM_OK) {
+        count = 0;
+    }
+    list.resize(count);
+
+    bool changed = list.size() != devices.size();
+    for (size_t i = 0; !changed && i < list.size(); i++) {
+        changed = list[i].deviceId != devices[i].deviceId ||
+                  strcmp(list[i].uuid, devices[i].uuid) != 0 ||
+                  strcmp(list[i].PCIBDFAddress, devices[i].PCIBDFAddress) != 0;
+    }
+    if (!changed) {
+        return;
+    }
+
+    devices.swap(list);
+    device_ids.clear();
+    series_prefix.clear();
+    device_label_sets.clear();
+    const char* node = std::getenv("NODE_NAME");
+
+    std::string labels;
+    for (auto& device : devices) {
+        device_ids.push_back(device.deviceId);
+
+        uint32_t tile_count = 0;
+        xpum_device_properties_t properties;
+        if (xpumGetDeviceProperties(device.deviceId, &properties) == XPUM_OK) {
+            for (int i = 0; i < properties.propertyLen; i++) {
+                if (properties.properties[i].name == XPUM_DEVICE_PROPERTY_NUMBER_OF_TILES) {
+                    tile_count = std::atoi(properties.properties[i].value);
+                }
+            }
+        }
+
+        std::string device_labels;
+        appendLabel(device_labels, "uuid", device.uuid);
+        appendLabel(device_labels, "dev_name", device.deviceName);
+        appendLabel(device_labels, "pci_dev", device.PCIDeviceId);
+        appendLabel(device_labels, "vendor", device.VendorName);
+        appendLabel(device_labels, "pci_bdf", device.PCIBDFAddress);
+        const char* dev_file = strrchr(device.drmDevice, '/');
+        if (device.drmDevice[0] != '\0') {
+            appendLabel(device_labels, "dev_file", dev_file != nullptr ? dev_file + 1 : device.drmDevice);
+        }
+        if (node != nullptr) {
+            appendLabel(device_labels, "node", node);
+        }
+        device_label_sets[device.deviceId] = device_labels;
+
+        for (int32_t tile = -1; tile < (int32_t)tile_count; tile++) {
+            labels = device_labels;
+            if (tile >= 0) {
+                appendLabel(labels, "sub_dev", std::to_string(tile).c_str());
+            }
+            for (auto& family : metric_families) {
+                for (auto& member : family.members) {
+                    std::string& prefix = series_prefix[SeriesKey(device.deviceId, tile, member.type)];
+                    prefix = family.name;
+                    if (family.counter) {
+                        prefix += "_total";
+                    }
+                    prefix += '{';
+                    prefix += labels;
+                    prefix += member.labels;
+                    prefix += "src=\"direct\"} ";
+                }
+            }
+        }
+    }
+}
+
+void MetricsExporter::render() {
+    updateLabels();
+    body.clear();
+    if (device_ids.empty()) {
+        return;
+    }
+
+    uint32_t count = 0;
+    xpum_result_t res = xpumGetRealtimeMetricsBatch(device_ids.data(), device_ids.size(),
+                                                    metric_types.data(), metric_types.size(), nullptr, &count);
+    if (res == XPUM_OK) {
+        metrics.resize(count);
+        res = xpumGetRealtimeMetricsBatch(device_ids.data(), device_ids.size(),
+                                          metric_types.data(), metric_types.size(), metrics.data(), &count);
+    }
+    if (res != XPUM_OK) {
+        XPUM_LOG_WARN("XPUM: failed to read metrics for exporter: {}", res);
+        // the device list may have changed, rebuild the labels on the next scrape
+        devices.clear();
+        return;
+    }
+    metrics.resize(count);
+
+    char value[64];
+    for (auto& family : metric_families) {
+        bool header = false;
+        for (auto& entry : metrics) {
+            int32_t tile = entry.isTileData ? entry.tileId : -1;
+            for (auto& member : family.members) {
+                const xpum_device_realtime_metric_t* data = nullptr;
+                for (int32_t i = 0; i < entry.count; i++) {
+                    if (entry.dataList[i].metricsType == member.type) {
+                        data = &entry.dataList[i];
+                        break;
+                    }
+                }
+                if (data == nullptr) {
+                    continue;
+                }
+                auto it = series_prefix.find(SeriesKey(entry.deviceId, tile, member.type));
+                if (it == series_prefix.end()) {
+                    continue;
+                }
+                if (!header) {
+                    const char* suffix = family.counter ? "_total" : "";
+                    body += "# HELP ";
+                    body += family.name;
+                    body += suffix;
+                    body += ' ';
+                    body += family.help;
+                    body += "\n# TYPE ";
+                    body += family.name;
+                    body += suffix;
+                    body += family.counter ? " counter\n" : " gauge\n";
+                    header = true;
+                }
+                double v = (double)data->value / (data->scale > 0 ? data->scale : 1) * family.factor;
+                int len = snprintf(value, sizeof(value), "%.15g\n", v);
+                body += it->second;
+                body.append(value, len);
+            }
+        }
+    }
+
+    operation_stats.resize(device_ids.size());
+    for (size_t i = 0; i < device_ids.size(); i++) {
+        if (xpumGetDeviceOperationStats(device_ids[i], &operation_stats[i]) != XPUM_OK) {
+            operation_stats[i].deviceId = -1;
+        }
+    }
+    for (auto& family : operation_families) {
+        const char* suffix = family.counter ? "_total" : "";
+        body += "# HELP ";
+        body += family.name;
+        body += suffix;
+        body += ' ';
+        body += family.help;
+        body += "\n# TYPE ";
+        body += family.name;
+        body += suffix;
+        body += family.counter ? " counter\n" : " gauge\n";
+        for (auto& stats : operation_stats) {
+            auto it = device_label_sets.find(stats.deviceId);
+            if (it == device_label_sets.end()) {
+                continue;
+            }
+            double v = (double)(stats.*family.field) * family.factor;
+            int len = snprintf(value, sizeof(value), "%.15g\n", v);
+            body += family.name;
+            body += suffix;
+            body += '{';
+            body += it->second;
+            body += "src=\"direct\"} ";
+            body.append(value, len);
+        }
+    }
+}
+
+bool MetricsExporter::compress() {
+#ifdef XPUM_METRICS_GZIP
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    // 16 + MAX_WBITS selects the gzip wrapper
+    if (deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+    gzip_body.resize(deflateBound(&stream, body.size()));
+    stream.next_in = (Bytef*)body.data();
+    stream.avail_in = body.size();
+    stream.next_out = (Bytef*)&gzip_body[0];
+    stream.avail_out = gzip_body.size();
+    int ret = deflate(&stream, Z_FINISH);
+    gzip_body.resize(stream.total_out);
+    deflateEnd(&stream);
+    return ret == Z_STREAM_END;
+#else
+    return false;
+#endif
+}
+
+} // end namespace xpum::daemon
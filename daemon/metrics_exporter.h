@@ -0,0 +1,90 @@
+/*
+ *  Copyright (C) 2021-2023 Intel Corporation
+ *  SPDX-License-Identifier: MIT
+ *  @file metrics_exporter.h
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "xpum_structs.h"
+
+namespace xpum::daemon {
+
+/*
+  Serves the latest metric values in the Prometheus text exposition format
+  at GET /metrics, so that scrapers do not need to go through the gRPC
+  interface and the Python exporter. The listener is a single thread that
+  handles one connection at a time, which is enough for a few scrapers
+  polling every few seconds.
+
+  Label sets are rendered once per (device, tile, metric) and only rebuilt
+  when the device list changes; the exposition body and the compressed
+  body are kept in buffers that are reused between scrapes.
+*/
+
+class MetricsExporter {
+   public:
+    MetricsExporter(const std::string& address, uint16_t port);
+
+    ~MetricsExporter();
+
+    bool start();
+
+    void stop();
+
+   private:
+    typedef std::tuple<xpum_device_id_t, int32_t, xpum_stats_type_t> SeriesKey;
+
+    void serve();
+
+    void handleConnection(int fd);
+
+    void updateLabels();
+
+    void render();
+
+    bool compress();
+
+   private:
+    std::string address;
+
+    uint16_t port;
+
+    int listen_fd;
+
+    std::atomic<bool> stopped;
+
+    std::thread server_thread;
+
+    std::mutex mutex;
+
+    std::vector<xpum_device_basic_info> devices;
+
+    std::vector<xpum_device_id_t> device_ids;
+
+    std::vector<xpum_stats_type_t> metric_types;
+
+    std::vector<xpum_device_realtime_metrics_t> metrics;
+
+    std::map<SeriesKey, std::string> series_prefix;
+
+    // labels of each device, for the series that are not per tile
+    std::map<xpum_device_id_t, std::string> device_label_sets;
+
+    std::vector<xpum_device_operation_stats_t> operation_stats;
+
+    std::string body;
+
+    std::string gzip_body;
+};
+
+} // end namespace xpum::daemon
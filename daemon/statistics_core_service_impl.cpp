@@ -105,10 +105,14 @@ inline bool metricsTypeAllowList(xpum_stats_type_t metricsType) {
 ::grpc::Status XpumCoreServiceImpl::getStatisticsByGroup(::grpc::ServerContext* context, const ::XpumGetStatsByGroupRequest* request, ::XpumGetStatsResponse* response) {
     xpum_device_id_t groupId = request->groupid();
     uint64_t sessionId = request->sessionid();
-    uint32_t count = 5 * XPUM_MAX_NUM_DEVICES;
-    xpum_device_stats_t dataList[count];
+    uint32_t count = 0;
     uint64_t begin, end;
-    xpum_result_t res = xpumGetStatsByGroup(groupId, dataList, &count, &begin, &end, sessionId);
+    std::vector<xpum_device_stats_t> dataList;
+    xpum_result_t res = xpumGetStatsByGroup(groupId, nullptr, &count, &begin, &end, sessionId);
+    if (res == XPUM_OK) {
+        dataList.resize(count);
+        res = xpumGetStatsByGroup(groupId, dataList.data(), &count, &begin, &end, sessionId);
+    }
     response->set_errorno(res);
     if (res != XPUM_OK) {
         switch (res) {
@@ -200,10 +204,14 @@ inline bool metricsTypeAllowList(xpum_stats_type_t metricsType) {
 ::grpc::Status XpumCoreServiceImpl::getStatisticsByGroupNotForPrometheus(::grpc::ServerContext* context, const ::XpumGetStatsByGroupRequest* request, ::XpumGetStatsResponse* response) {
     xpum_device_id_t groupId = request->groupid();
     uint64_t sessionId = request->sessionid();
-    uint32_t count = 5 * XPUM_MAX_NUM_DEVICES;
-    xpum_device_stats_t dataList[count];
+    uint32_t count = 0;
     uint64_t begin, end;
-    xpum_result_t res = xpumGetStatsByGroup(groupId, dataList, &count, &begin, &end, sessionId);
+    std::vector<xpum_device_stats_t> dataList;
+    xpum_result_t res = xpumGetStatsByGroup(groupId, nullptr, &count, &begin, &end, sessionId);
+    if (res == XPUM_OK) {
+        dataList.resize(count);
+        res = xpumGetStatsByGroup(groupId, dataList.data(), &count, &begin, &end, sessionId);
+    }
     response->set_errorno(res);
     if (res != XPUM_OK) {
         switch (res) {
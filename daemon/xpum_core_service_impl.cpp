@@ -620,6 +620,8 @@ grpc::Status XpumCoreServiceImpl::getTopology(grpc::ServerContext* context, cons
             component->set_finished(task_info.componentList[i].finished);
             component->set_result(static_cast<DiagnosticsTaskResult>(task_info.componentList[i].result));
             component->set_message(task_info.componentList[i].message);
+            component->set_starttime(task_info.componentList[i].startTime);
+            component->set_endtime(task_info.componentList[i].endTime);
         }
     } else {
         switch (res) {
@@ -748,6 +750,8 @@ grpc::Status XpumCoreServiceImpl::getTopology(grpc::ServerContext* context, cons
                 component->set_finished(taskInfos[i].componentList[j].finished);
                 component->set_result(static_cast<DiagnosticsTaskResult>(taskInfos[i].componentList[j].result));
                 component->set_message(taskInfos[i].componentList[j].message);
+                component->set_starttime(taskInfos[i].componentList[j].startTime);
+                component->set_endtime(taskInfos[i].componentList[j].endTime);
             }
         }
     } else {
@@ -966,12 +970,15 @@ grpc::Status XpumCoreServiceImpl::getTopology(grpc::ServerContext* context, cons
     return grpc::Status::OK;
 }
 
-::grpc::Status XpumCoreServiceImpl::getMetrics(::grpc::ServerContext* context, const ::DeviceId* request, ::DeviceStatsInfoArray* response) {
-    xpum_device_id_t deviceId = request->id();
-    int count = 5;
-    xpum_device_metrics_t dataList[count];
-    xpum_result_t res = xpumGetMetrics(deviceId, dataList, &count);
-    if (res != XPUM_OK || count < 0) {
+static void fillRealtimeMetrics(xpum_device_id_t deviceIdList[], uint32_t deviceCount, ::DeviceStatsInfoArray* response) {
+    uint32_t count = 0;
+    xpum_result_t res = xpumGetRealtimeMetricsEx(deviceIdList, deviceCount, nullptr, &count);
+    std::vector<xpum_device_realtime_metrics_t> dataList;
+    if (res == XPUM_OK) {
+        dataList.resize(count);
+        res = xpumGetRealtimeMetricsEx(deviceIdList, deviceCount, dataList.data(), &count);
+    }
+    if (res != XPUM_OK) {
         switch (res) {
             case XPUM_LEVEL_ZERO_INITIALIZATION_ERROR:
                 response->set_errormsg("Level Zero Initialization Error");
@@ -980,62 +987,48 @@ grpc::Status XpumCoreServiceImpl::getTopology(grpc::ServerContext* context, cons
                 response->set_errormsg("Error");
                 break;
         }
+        response->set_errorno(res);
+        return;
     }
-    for (int i = 0; i < count; i++) {
+    for (uint32_t i = 0; i < count; i++) {
         DeviceStatsInfo* deviceStatsInfo = response->add_datalist();
-        xpum_device_metrics_t& stats = dataList[i];
+        xpum_device_realtime_metrics_t& stats = dataList[i];
         deviceStatsInfo->set_deviceid(stats.deviceId);
         deviceStatsInfo->set_istiledata(stats.isTileData);
         deviceStatsInfo->set_tileid(stats.tileId);
         deviceStatsInfo->set_count(stats.count);
         for (int j = 0; j < stats.count; j++) {
-            xpum_device_metric_data_t& data = stats.dataList[j];
+            xpum_device_realtime_metric_t& data = stats.dataList[j];
             DeviceStatsData* deviceStatsData = deviceStatsInfo->add_datalist();
             deviceStatsData->mutable_metricstype()->set_value(data.metricsType);
             deviceStatsData->set_iscounter(data.isCounter);
             deviceStatsData->set_value(data.value);
         }
     }
-        
     response->set_errorno(res);
+}
 
+::grpc::Status XpumCoreServiceImpl::getMetrics(::grpc::ServerContext* context, const ::DeviceId* request, ::DeviceStatsInfoArray* response) {
+    xpum_device_id_t deviceId = request->id();
+    fillRealtimeMetrics(&deviceId, 1, response);
     return grpc::Status::OK;
 }
 
 ::grpc::Status XpumCoreServiceImpl::getMetricsByGroup(::grpc::ServerContext* context, const ::GroupId* request,
                                                       ::DeviceStatsInfoArray* response) {
     xpum_group_id_t groupId = request->id();
-    int count = 16;
-    xpum_device_metrics_t dataList[count];
-    xpum_result_t res = xpumGetMetricsByGroup(groupId, dataList, &count);
-    if (res != XPUM_OK || count < 0) {
-        switch (res) {
-            case XPUM_LEVEL_ZERO_INITIALIZATION_ERROR:
-                response->set_errormsg("Level Zero Initialization Error");
-                break;
-            default:
-                response->set_errormsg("Error");
-                break;
-        }
+    xpum_group_info_t groupInfo;
+    xpum_result_t res = xpumGroupGetInfo(groupId, &groupInfo);
+    if (res != XPUM_OK) {
+        response->set_errormsg("Error");
+        response->set_errorno(res);
+        return grpc::Status::OK;
     }
-    for (int i = 0; i < count; i++) {
-        DeviceStatsInfo* deviceStatsInfo = response->add_datalist();
-        xpum_device_metrics_t& stats = dataList[i];
-        deviceStatsInfo->set_deviceid(stats.deviceId);
-        deviceStatsInfo->set_istiledata(stats.isTileData);
-        deviceStatsInfo->set_tileid(stats.tileId);
-        deviceStatsInfo->set_count(stats.count);
-        for (int j = 0; j < stats.count; j++) {
-            xpum_device_metric_data_t& data = stats.dataList[j];
-            DeviceStatsData* deviceStatsData = deviceStatsInfo->add_datalist();
-            deviceStatsData->mutable_metricstype()->set_value(data.metricsType);
-            deviceStatsData->set_iscounter(data.isCounter);
-            deviceStatsData->set_value(data.value);
-        }
+    if (groupInfo.count <= 0) {
+        response->set_errorno(XPUM_OK);
+        return grpc::Status::OK;
     }
-        
-    response->set_errorno(res);
-
+    fillRealtimeMetrics(groupInfo.deviceList, groupInfo.count, response);
     return grpc::Status::OK;
 }
 